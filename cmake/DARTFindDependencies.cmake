@@ -88,6 +88,9 @@ endif()
 # Boost
 dart_find_package(Boost)
 
+# Threads (used by simulation::WorldBatch)
+find_package(Threads REQUIRED)
+
 # octomap
 dart_find_package(octomap)
 if(MSVC)
@@ -141,6 +141,10 @@ bool BodyNodeCollisionFilter::ignoresCollision(
   if (!skel1->isMobile() && !skel2->isMobile())
     return true;
 
+  // Sleeping Skeletons don't move, so only check them against awake ones
+  if (skel1->isSleeping() && skel2->isSleeping())
+    return true;
+
   if (skel1 == skel2)
   {
     if (!skel1->isEnabledSelfCollisionCheck())
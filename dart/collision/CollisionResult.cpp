@@ -40,10 +40,32 @@
 namespace dart {
 namespace collision {
 
+//==============================================================================
+CollisionResult& CollisionResult::operator=(const CollisionResult& other)
+{
+  if (this == &other)
+    return *this;
+
+  mContacts.clear();
+  mContacts.insert(
+      mContacts.end(), other.mContacts.begin(), other.mContacts.end());
+  mCollidingBodyNodes = other.mCollidingBodyNodes;
+  mCollidingShapeFrames = other.mCollidingShapeFrames;
+  mAreCollidingObjectsRecorded = other.mAreCollidingObjectsRecorded;
+
+  return *this;
+}
+
 //==============================================================================
 void CollisionResult::addContact(const Contact& contact)
 {
+  assert(contact.collisionObject1 && contact.collisionObject2);
+
   mContacts.push_back(contact);
+
+  if (!mAreCollidingObjectsRecorded)
+    return;
+
   addObject(contact.collisionObject1);
   addObject(contact.collisionObject2);
 }
@@ -93,13 +115,63 @@ CollisionResult::getCollidingShapeFrames() const
 //==============================================================================
 bool CollisionResult::inCollision(const dynamics::BodyNode* bn) const
 {
-  return (mCollidingBodyNodes.find(bn) != mCollidingBodyNodes.end());
+  if (mAreCollidingObjectsRecorded)
+    return (mCollidingBodyNodes.find(bn) != mCollidingBodyNodes.end());
+
+  for (const auto& contact : mContacts)
+  {
+    for (const auto* object :
+         {contact.collisionObject1, contact.collisionObject2})
+    {
+      const dynamics::ShapeFrame* frame = object->getShapeFrame();
+      if (frame->isShapeNode() && frame->asShapeNode()->getBodyNodePtr() == bn)
+        return true;
+    }
+  }
+
+  return false;
 }
 
 //==============================================================================
 bool CollisionResult::inCollision(const dynamics::ShapeFrame* frame) const
 {
-  return (mCollidingShapeFrames.find(frame) != mCollidingShapeFrames.end());
+  if (mAreCollidingObjectsRecorded)
+    return (mCollidingShapeFrames.find(frame) != mCollidingShapeFrames.end());
+
+  for (const auto& contact : mContacts)
+  {
+    if (contact.collisionObject1->getShapeFrame() == frame
+        || contact.collisionObject2->getShapeFrame() == frame)
+      return true;
+  }
+
+  return false;
+}
+
+//==============================================================================
+void CollisionResult::setCollidingObjectsRecorded(bool recorded)
+{
+  if (recorded == mAreCollidingObjectsRecorded)
+    return;
+
+  mAreCollidingObjectsRecorded = recorded;
+  mCollidingShapeFrames.clear();
+  mCollidingBodyNodes.clear();
+
+  if (!recorded)
+    return;
+
+  for (const auto& contact : mContacts)
+  {
+    addObject(contact.collisionObject1);
+    addObject(contact.collisionObject2);
+  }
+}
+
+//==============================================================================
+bool CollisionResult::areCollidingObjectsRecorded() const
+{
+  return mAreCollidingObjectsRecorded;
 }
 
 //==============================================================================
@@ -122,6 +194,12 @@ void CollisionResult::clear()
   mCollidingBodyNodes.clear();
 }
 
+//==============================================================================
+void CollisionResult::reserve(std::size_t numContacts)
+{
+  mContacts.reserve(numContacts);
+}
+
 //==============================================================================
 void CollisionResult::addObject(CollisionObject* object)
 {
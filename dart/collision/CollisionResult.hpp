@@ -51,6 +51,23 @@ namespace collision {
 class CollisionResult
 {
 public:
+  /// Default constructor
+  CollisionResult() = default;
+
+  /// Copy constructor
+  CollisionResult(const CollisionResult& other) = default;
+
+  /// Move constructor
+  CollisionResult(CollisionResult&& other) = default;
+
+  /// Copy assignment operator. The memory of the contacts of this
+  /// CollisionResult is reused, so copying into the same CollisionResult
+  /// repeatedly doesn't allocate memory once it is large enough.
+  CollisionResult& operator=(const CollisionResult& other);
+
+  /// Move assignment operator
+  CollisionResult& operator=(CollisionResult&& other) = default;
+
   /// Add one contact
   void addContact(const Contact& contact);
 
@@ -74,12 +91,25 @@ public:
   const std::unordered_set<const dynamics::ShapeFrame*>&
   getCollidingShapeFrames() const;
 
-  /// Returns true if the given BodyNode is in collision
+  /// Returns true if the given BodyNode is in collision. This looks the
+  /// BodyNode up in the contacts if the colliding objects are not recorded.
   bool inCollision(const dynamics::BodyNode* bn) const;
 
-  /// Returns true if the given ShapeFrame is in collision
+  /// Returns true if the given ShapeFrame is in collision. This looks the
+  /// ShapeFrame up in the contacts if the colliding objects are not recorded.
   bool inCollision(const dynamics::ShapeFrame* frame) const;
 
+  /// Set whether addContact() records the BodyNodes and ShapeFrames of the
+  /// contacts in the sets returned by getCollidingBodyNodes() and
+  /// getCollidingShapeFrames(). Inserting into these sets allocates memory, so
+  /// the real-time mode of World turns this off, which leaves the sets empty.
+  /// This is on by default.
+  void setCollidingObjectsRecorded(bool recorded);
+
+  /// Return whether addContact() records the colliding BodyNodes and
+  /// ShapeFrames
+  bool areCollidingObjectsRecorded() const;
+
   /// Return binary collision result
   bool isCollision() const;
 
@@ -89,6 +119,10 @@ public:
   /// Clear all the contacts
   void clear();
 
+  /// Reserve memory for \c numContacts contacts, so that adding up to that
+  /// many contacts doesn't allocate memory
+  void reserve(std::size_t numContacts);
+
 protected:
   void addObject(CollisionObject* object);
 
@@ -100,6 +134,9 @@ protected:
 
   /// Set of ShapeFrames that are colliding
   std::unordered_set<const dynamics::ShapeFrame*> mCollidingShapeFrames;
+
+  /// Whether addContact() records the colliding BodyNodes and ShapeFrames
+  bool mAreCollidingObjectsRecorded = true;
 };
 
 } // namespace collision
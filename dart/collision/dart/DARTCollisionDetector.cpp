@@ -51,6 +51,7 @@ bool checkPair(
     CollisionObject* o1,
     CollisionObject* o2,
     const CollisionOption& option,
+    CollisionResult& pairResult,
     CollisionResult* result = nullptr);
 
 bool isClose(
@@ -155,7 +156,8 @@ bool DARTCollisionDetector::collide(
       if (filter && filter->ignoresCollision(collObj1, collObj2))
         continue;
 
-      collisionFound = checkPair(collObj1, collObj2, option, result);
+      collisionFound = checkPair(
+          collObj1, collObj2, option, casted->mPairResult, result);
 
       if (result)
       {
@@ -217,7 +219,8 @@ bool DARTCollisionDetector::collide(
       if (filter && filter->ignoresCollision(collObj1, collObj2))
         continue;
 
-      collisionFound = checkPair(collObj1, collObj2, option, result);
+      collisionFound = checkPair(
+          collObj1, collObj2, option, casted1->mPairResult, result);
 
       if (result)
       {
@@ -323,9 +326,10 @@ bool checkPair(
     CollisionObject* o1,
     CollisionObject* o2,
     const CollisionOption& option,
+    CollisionResult& pairResult,
     CollisionResult* result)
 {
-  CollisionResult pairResult;
+  pairResult.clear();
 
   // Perform narrow-phase detection
   collide(o1, o2, pairResult);
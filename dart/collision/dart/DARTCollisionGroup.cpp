@@ -42,7 +42,9 @@ DARTCollisionGroup::DARTCollisionGroup(
     const CollisionDetectorPtr& collisionDetector)
   : CollisionGroup(collisionDetector)
 {
-  // Do nothing
+  // The primitive shape pairs generate at most a few contacts each
+  mPairResult.reserve(8u);
+  mPairResult.setCollidingObjectsRecorded(false);
 }
 
 //==============================================================================
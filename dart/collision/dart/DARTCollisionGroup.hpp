@@ -34,6 +34,7 @@
 #define DART_COLLISION_DART_DARTCOLLISIONGROUP_HPP_
 
 #include "dart/collision/CollisionGroup.hpp"
+#include "dart/collision/CollisionResult.hpp"
 
 namespace dart {
 namespace collision {
@@ -74,6 +75,10 @@ protected:
 protected:
   /// CollisionObjects added to this DARTCollisionGroup
   std::vector<CollisionObject*> mCollisionObjects;
+
+  /// Scratch result of the narrow-phase check of a single pair, kept to reuse
+  /// its storage across the pairs
+  CollisionResult mPairResult;
 };
 
 } // namespace collision
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/common/MemoryPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+namespace dart {
+namespace common {
+
+namespace {
+
+//==============================================================================
+std::size_t roundUpToAlignment(std::size_t size)
+{
+  return (size + MemoryPool::Alignment - 1u) / MemoryPool::Alignment
+         * MemoryPool::Alignment;
+}
+
+//==============================================================================
+unsigned char* alignUp(unsigned char* pointer)
+{
+  const auto address = reinterpret_cast<std::uintptr_t>(pointer);
+  const auto offset = roundUpToAlignment(address) - address;
+  return pointer + offset;
+}
+
+//==============================================================================
+/// Allocate \c size bytes aligned to MemoryPool::Alignment from the heap. The
+/// pointer returned by operator new is stored right before the aligned memory.
+void* alignedHeapAllocate(std::size_t size)
+{
+  auto* memory = static_cast<unsigned char*>(
+      ::operator new(size + MemoryPool::Alignment + sizeof(void*)));
+  auto* aligned = alignUp(memory + sizeof(void*));
+  reinterpret_cast<void**>(aligned)[-1] = memory;
+
+  return aligned;
+}
+
+//==============================================================================
+void alignedHeapDeallocate(void* pointer)
+{
+  ::operator delete(reinterpret_cast<void**>(pointer)[-1]);
+}
+
+} // namespace
+
+//==============================================================================
+constexpr std::size_t MemoryPool::Alignment;
+
+//==============================================================================
+MemoryPool::MemoryPool(std::size_t blockSize)
+  : mBlockSize(roundUpToAlignment(std::max(blockSize, sizeof(FreeBlock)))),
+    mFreeList(nullptr),
+    mNumBlocks(0u),
+    mNumUsedBlocks(0u),
+    mIsGrowable(true),
+    mNumOverflows(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+MemoryPool::~MemoryPool()
+{
+  assert(mNumUsedBlocks == 0u);
+}
+
+//==============================================================================
+std::size_t MemoryPool::getBlockSize() const
+{
+  return mBlockSize;
+}
+
+//==============================================================================
+void MemoryPool::reserve(std::size_t numBlocks)
+{
+  if (numBlocks > mNumBlocks)
+    addChunk(numBlocks - mNumBlocks);
+}
+
+//==============================================================================
+std::size_t MemoryPool::getNumBlocks() const
+{
+  return mNumBlocks;
+}
+
+//==============================================================================
+std::size_t MemoryPool::getNumUsedBlocks() const
+{
+  return mNumUsedBlocks;
+}
+
+//==============================================================================
+void MemoryPool::setGrowable(bool growable)
+{
+  mIsGrowable = growable;
+}
+
+//==============================================================================
+bool MemoryPool::isGrowable() const
+{
+  return mIsGrowable;
+}
+
+//==============================================================================
+std::size_t MemoryPool::getNumOverflows() const
+{
+  return mNumOverflows;
+}
+
+//==============================================================================
+void MemoryPool::resetNumOverflows()
+{
+  mNumOverflows = 0u;
+}
+
+//==============================================================================
+void* MemoryPool::allocate(std::size_t size)
+{
+  if (size > mBlockSize || (!mFreeList && !mIsGrowable))
+  {
+    ++mNumOverflows;
+    return alignedHeapAllocate(size);
+  }
+
+  // Double the number of blocks when running out of them
+  if (!mFreeList)
+    addChunk(std::max<std::size_t>(mNumBlocks, 16u));
+
+  FreeBlock* block = mFreeList;
+  mFreeList = block->mNext;
+  ++mNumUsedBlocks;
+
+  return block;
+}
+
+//==============================================================================
+void MemoryPool::deallocate(void* pointer, std::size_t /*size*/)
+{
+  if (!pointer)
+    return;
+
+  if (!owns(pointer))
+  {
+    alignedHeapDeallocate(pointer);
+    return;
+  }
+
+  assert(mNumUsedBlocks > 0u);
+  auto* block = static_cast<FreeBlock*>(pointer);
+  block->mNext = mFreeList;
+  mFreeList = block;
+  --mNumUsedBlocks;
+}
+
+//==============================================================================
+void MemoryPool::addChunk(std::size_t numBlocks)
+{
+  Chunk chunk;
+  chunk.mMemory.reset(new unsigned char[numBlocks * mBlockSize + Alignment]);
+  chunk.mBegin = alignUp(chunk.mMemory.get());
+  chunk.mEnd = chunk.mBegin + numBlocks * mBlockSize;
+
+  // Thread the new blocks in front of the free list, in address order
+  for (auto i = numBlocks; i > 0u; --i)
+  {
+    auto* block = reinterpret_cast<FreeBlock*>(
+        chunk.mBegin + (i - 1u) * mBlockSize);
+    block->mNext = mFreeList;
+    mFreeList = block;
+  }
+
+  mChunks.push_back(std::move(chunk));
+  mNumBlocks += numBlocks;
+}
+
+//==============================================================================
+bool MemoryPool::owns(const void* pointer) const
+{
+  const auto* bytes = static_cast<const unsigned char*>(pointer);
+  for (const auto& chunk : mChunks)
+  {
+    if (chunk.mBegin <= bytes && bytes < chunk.mEnd)
+      return true;
+  }
+
+  return false;
+}
+
+} // namespace common
+} // namespace dart
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COMMON_MEMORYPOOL_HPP_
+#define DART_COMMON_MEMORYPOOL_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace dart {
+namespace common {
+
+/// MemoryPool hands out memory blocks of a fixed size from a free list, so
+/// that objects that are created and destroyed over and over again (e.g., the
+/// constraints that ConstraintSolver creates every step) reuse the same memory
+/// instead of going through the heap every time. Use it through PoolAllocator,
+/// typically with std::allocate_shared().
+///
+/// The pool grows by chunks of blocks when it runs out of free blocks. When
+/// growing is disabled with setGrowable(false), for instance in real-time
+/// loops that must not allocate memory, the requests that can't be served
+/// from the reserved blocks fall back to the heap and are counted by
+/// getNumOverflows(). Requests larger than the block size always fall back to
+/// the heap.
+///
+/// MemoryPool is not thread-safe.
+class MemoryPool
+{
+public:
+  /// Alignment of the blocks in bytes
+  static constexpr std::size_t Alignment = 64u;
+
+  /// Constructor
+  ///
+  /// \param[in] blockSize Size of the blocks in bytes. It's rounded up to a
+  /// multiple of Alignment.
+  explicit MemoryPool(std::size_t blockSize);
+
+  /// Destructor. All the blocks must have been returned to the pool.
+  ~MemoryPool();
+
+  MemoryPool(const MemoryPool&) = delete;
+  MemoryPool& operator=(const MemoryPool&) = delete;
+
+  /// Return the size of the blocks in bytes
+  std::size_t getBlockSize() const;
+
+  /// Allocate memory so that at least \c numBlocks blocks are owned by this
+  /// pool in total, whether they are free or in use
+  void reserve(std::size_t numBlocks);
+
+  /// Return the number of blocks owned by this pool
+  std::size_t getNumBlocks() const;
+
+  /// Return the number of blocks that are in use
+  std::size_t getNumUsedBlocks() const;
+
+  /// Set whether the pool allocates more blocks when it runs out of them
+  void setGrowable(bool growable);
+
+  /// Return true if the pool allocates more blocks when it runs out of them
+  bool isGrowable() const;
+
+  /// Return the number of requests that fell back to the heap, either because
+  /// they were larger than the block size or because the pool ran out of
+  /// blocks while growing was disabled
+  std::size_t getNumOverflows() const;
+
+  /// Reset the count of getNumOverflows() to zero
+  void resetNumOverflows();
+
+  /// Return memory for \c size bytes
+  void* allocate(std::size_t size);
+
+  /// Return memory obtained from allocate() to the pool
+  void deallocate(void* pointer, std::size_t size);
+
+private:
+  /// Node of the free list, stored in the free blocks themselves
+  struct FreeBlock
+  {
+    FreeBlock* mNext;
+  };
+
+  /// Memory that holds a number of contiguous blocks
+  struct Chunk
+  {
+    /// Memory allocated from the heap
+    std::unique_ptr<unsigned char[]> mMemory;
+
+    /// First block, aligned to Alignment
+    unsigned char* mBegin;
+
+    /// End of the last block
+    unsigned char* mEnd;
+  };
+
+  /// Allocate a chunk of \c numBlocks blocks and add them to the free list
+  void addChunk(std::size_t numBlocks);
+
+  /// Return true if \c pointer is a block of this pool
+  bool owns(const void* pointer) const;
+
+  /// Size of the blocks in bytes
+  std::size_t mBlockSize;
+
+  /// Chunks of blocks
+  std::vector<Chunk> mChunks;
+
+  /// First free block
+  FreeBlock* mFreeList;
+
+  /// Number of blocks owned by this pool
+  std::size_t mNumBlocks;
+
+  /// Number of blocks that are in use
+  std::size_t mNumUsedBlocks;
+
+  /// Whether the pool allocates more blocks when it runs out of them
+  bool mIsGrowable;
+
+  /// Number of requests that fell back to the heap
+  std::size_t mNumOverflows;
+};
+
+/// PoolAllocator is a standard allocator that allocates from a MemoryPool. It
+/// shares the ownership of the pool, so the pool lives as long as any object
+/// allocated from it, e.g., a std::shared_ptr created with
+/// std::allocate_shared().
+template <typename T>
+class PoolAllocator
+{
+public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind
+  {
+    using other = PoolAllocator<U>;
+  };
+
+  /// Constructor
+  explicit PoolAllocator(std::shared_ptr<MemoryPool> pool);
+
+  /// Converting constructor
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& other);
+
+  /// Allocate memory for \c n objects of type T
+  T* allocate(std::size_t n);
+
+  /// Deallocate memory obtained from allocate()
+  void deallocate(T* pointer, std::size_t n);
+
+  /// Return the pool this allocator allocates from
+  const std::shared_ptr<MemoryPool>& getPool() const;
+
+private:
+  /// The pool this allocator allocates from
+  std::shared_ptr<MemoryPool> mPool;
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs);
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs);
+
+} // namespace common
+} // namespace dart
+
+#include "dart/common/detail/MemoryPool-impl.hpp"
+
+#endif // DART_COMMON_MEMORYPOOL_HPP_
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/common/Profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+#include "dart/common/Console.hpp"
+
+namespace dart {
+namespace common {
+
+namespace {
+
+// Singleton is not thread safe, so the profiler is created before main()
+// rather than by the first thread that enters a zone
+Profiler& theProfiler = Profiler::getSingleton();
+
+} // namespace
+
+//==============================================================================
+Profiler::Statistics::Statistics()
+  : mCount(0u),
+    mTotalTime(0.0),
+    mMinTime(std::numeric_limits<double>::infinity()),
+    mMaxTime(0.0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+double Profiler::Statistics::getAverageTime() const
+{
+  if (0u == mCount)
+    return 0.0;
+
+  return mTotalTime / static_cast<double>(mCount);
+}
+
+//==============================================================================
+Profiler::Profiler()
+  : mIsEnabled(false),
+    mMaxNumEvents(1000000u),
+    mNumEvents(0u),
+    mStartTime(std::chrono::steady_clock::now())
+{
+  // Do nothing
+}
+
+//==============================================================================
+void Profiler::setEnabled(bool enabled)
+{
+#if !DART_ENABLE_PROFILING
+  if (enabled)
+  {
+    dtwarn << "[Profiler::setEnabled] DART was built without "
+           << "DART_ENABLE_PROFILING, so the built-in zones won't be "
+           << "recorded. Only the zones of code built with profiling will.\n";
+  }
+#endif
+
+  mIsEnabled = enabled;
+}
+
+//==============================================================================
+bool Profiler::isEnabled() const
+{
+  return mIsEnabled;
+}
+
+//==============================================================================
+void Profiler::setMaxNumEvents(std::size_t maxNumEvents)
+{
+  mMaxNumEvents = maxNumEvents;
+}
+
+//==============================================================================
+std::size_t Profiler::getMaxNumEvents() const
+{
+  return mMaxNumEvents;
+}
+
+//==============================================================================
+void Profiler::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  // Lock all the buffers at once so that no zone is recorded against the old
+  // start time into a cleared buffer
+  for (auto& buffer : mThreadBuffers)
+    buffer->mMutex.lock();
+
+  for (auto& buffer : mThreadBuffers)
+  {
+    buffer->mEvents.clear();
+    buffer->mStatistics.clear();
+  }
+  mNumEvents = 0u;
+  mStartTime = std::chrono::steady_clock::now();
+
+  for (auto& buffer : mThreadBuffers)
+    buffer->mMutex.unlock();
+}
+
+//==============================================================================
+void Profiler::record(
+    const char* name,
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point end)
+{
+  using Seconds = std::chrono::duration<double>;
+
+  const double duration = Seconds(end - start).count();
+
+  ThreadBuffer& buffer = getThreadBuffer();
+  std::lock_guard<std::mutex> lock(buffer.mMutex);
+
+  auto& statistics = buffer.mStatistics[name];
+  ++statistics.mCount;
+  statistics.mTotalTime += duration;
+  statistics.mMinTime = std::min(statistics.mMinTime, duration);
+  statistics.mMaxTime = std::max(statistics.mMaxTime, duration);
+
+  if (mNumEvents++ < mMaxNumEvents)
+  {
+    Event event;
+    event.mName = name;
+    event.mThreadIndex = buffer.mThreadIndex;
+    event.mStartTime = Seconds(start - mStartTime).count();
+    event.mDuration = duration;
+    buffer.mEvents.push_back(event);
+  }
+}
+
+//==============================================================================
+std::vector<Profiler::Event> Profiler::getEvents() const
+{
+  std::vector<Event> events;
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (const auto& buffer : mThreadBuffers)
+    {
+      std::lock_guard<std::mutex> bufferLock(buffer->mMutex);
+      events.insert(
+          events.end(), buffer->mEvents.begin(), buffer->mEvents.end());
+    }
+  }
+
+  std::stable_sort(
+      events.begin(), events.end(), [](const Event& a, const Event& b) {
+        return a.mStartTime < b.mStartTime;
+      });
+
+  return events;
+}
+
+//==============================================================================
+std::map<std::string, Profiler::Statistics> Profiler::getStatistics() const
+{
+  std::map<std::string, Statistics> statistics;
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  for (const auto& buffer : mThreadBuffers)
+  {
+    std::lock_guard<std::mutex> bufferLock(buffer->mMutex);
+
+    // The same zone name may have different addresses, for example when it
+    // is used in different libraries
+    for (const auto& zone : buffer->mStatistics)
+    {
+      const auto& zoneStatistics = zone.second;
+      auto& merged = statistics[zone.first];
+      merged.mCount += zoneStatistics.mCount;
+      merged.mTotalTime += zoneStatistics.mTotalTime;
+      merged.mMinTime = std::min(merged.mMinTime, zoneStatistics.mMinTime);
+      merged.mMaxTime = std::max(merged.mMaxTime, zoneStatistics.mMaxTime);
+    }
+  }
+
+  return statistics;
+}
+
+//==============================================================================
+void Profiler::print(std::ostream& os) const
+{
+  const auto statistics = getStatistics();
+
+  os << std::left << std::setw(48) << "Zone" << std::right << std::setw(10)
+     << "Count" << std::setw(14) << "Total [ms]" << std::setw(14)
+     << "Average [us]" << std::setw(12) << "Min [us]" << std::setw(12)
+     << "Max [us]"
+     << "\n";
+
+  for (const auto& zone : statistics)
+  {
+    const auto& stats = zone.second;
+    os << std::left << std::setw(48) << zone.first << std::right
+       << std::setw(10) << stats.mCount << std::setw(14) << std::fixed
+       << std::setprecision(3) << stats.mTotalTime * 1e3 << std::setw(14)
+       << stats.getAverageTime() * 1e6 << std::setw(12)
+       << stats.mMinTime * 1e6 << std::setw(12) << stats.mMaxTime * 1e6
+       << "\n";
+  }
+}
+
+//==============================================================================
+void Profiler::writeChromeTrace(std::ostream& os) const
+{
+  const auto events = getEvents();
+
+  // Complete events ("ph": "X") with timestamps in microseconds
+  os << "{\"traceEvents\":[";
+  os << std::fixed << std::setprecision(3);
+  for (std::size_t i = 0u; i < events.size(); ++i)
+  {
+    const auto& event = events[i];
+    if (i > 0u)
+      os << ",";
+
+    os << "\n{\"name\":\"" << event.mName << "\",\"cat\":\"dart\","
+       << "\"ph\":\"X\",\"pid\":0,\"tid\":" << event.mThreadIndex
+       << ",\"ts\":" << event.mStartTime * 1e6
+       << ",\"dur\":" << event.mDuration * 1e6 << "}";
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+//==============================================================================
+bool Profiler::exportChromeTrace(const std::string& path) const
+{
+  std::ofstream file(path);
+  if (!file.is_open())
+  {
+    dtwarn << "[Profiler::exportChromeTrace] Failed to open '" << path
+           << "' for writing.\n";
+    return false;
+  }
+
+  writeChromeTrace(file);
+
+  return file.good();
+}
+
+//==============================================================================
+Profiler::ThreadBuffer& Profiler::getThreadBuffer()
+{
+  // The profiler is a singleton, so a single buffer per thread is enough
+  thread_local ThreadBuffer* threadBuffer = nullptr;
+  if (threadBuffer)
+    return *threadBuffer;
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  mThreadBuffers.emplace_back(new ThreadBuffer());
+  threadBuffer = mThreadBuffers.back().get();
+  threadBuffer->mThreadIndex = mThreadBuffers.size() - 1u;
+
+  return *threadBuffer;
+}
+
+//==============================================================================
+ProfileZone::ProfileZone(const char* name) : mName(name), mProfiler(nullptr)
+{
+  auto& profiler = Profiler::getSingleton();
+  if (!profiler.isEnabled())
+    return;
+
+  mProfiler = &profiler;
+  mStartTime = std::chrono::steady_clock::now();
+}
+
+//==============================================================================
+ProfileZone::~ProfileZone()
+{
+  stop();
+}
+
+//==============================================================================
+void ProfileZone::stop()
+{
+  if (!mProfiler)
+    return;
+
+  mProfiler->record(mName, mStartTime, std::chrono::steady_clock::now());
+  mProfiler = nullptr;
+}
+
+} // namespace common
+} // namespace dart
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COMMON_PROFILER_HPP_
+#define DART_COMMON_PROFILER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dart/common/Singleton.hpp"
+#include "dart/config.hpp"
+
+namespace dart {
+namespace common {
+
+/// Profiler collects the time spent in named zones of code, such as the
+/// phases of World::step(). Zones are marked with DART_PROFILE_SCOPE(), which
+/// compiles to nothing unless DART is built with DART_ENABLE_PROFILING.
+///
+/// Even when profiling is compiled in, nothing is recorded until the profiler
+/// is enabled with setEnabled(true), and a disabled zone only costs one atomic
+/// load. Zones can be recorded from any thread (e.g., the workers of a
+/// WorldBatch). Each thread records into its own buffer, keyed by the address
+/// of the zone name, so threads don't contend with each other while
+/// recording. The buffers are merged by zone name when they are queried.
+///
+/// The profiler keeps aggregated statistics per zone name and, up to
+/// getMaxNumEvents(), the individual events, which can be exported to the
+/// Chrome trace event format and opened in chrome://tracing or Perfetto.
+class Profiler final : public Singleton<Profiler>
+{
+public:
+  /// A single execution of a zone
+  struct Event
+  {
+    /// Name of the zone
+    const char* mName;
+
+    /// Index of the thread that executed the zone, in the order the threads
+    /// were first seen by the profiler
+    std::size_t mThreadIndex;
+
+    /// Start time in seconds since the profiler was created or last cleared
+    double mStartTime;
+
+    /// Duration in seconds
+    double mDuration;
+  };
+
+  /// Aggregated statistics of all the executions of a zone
+  struct Statistics
+  {
+    /// Number of executions
+    std::size_t mCount;
+
+    /// Total time in seconds
+    double mTotalTime;
+
+    /// Shortest execution time in seconds
+    double mMinTime;
+
+    /// Longest execution time in seconds
+    double mMaxTime;
+
+    /// Constructor
+    Statistics();
+
+    /// Return the average execution time in seconds
+    double getAverageTime() const;
+  };
+
+  /// Set whether zones are recorded
+  void setEnabled(bool enabled);
+
+  /// Return true if zones are recorded
+  bool isEnabled() const;
+
+  /// Set the largest number of events that are kept for export. Statistics
+  /// are still aggregated once this limit is reached.
+  void setMaxNumEvents(std::size_t maxNumEvents);
+
+  /// Get the largest number of events that are kept for export
+  std::size_t getMaxNumEvents() const;
+
+  /// Discard the recorded events and statistics, and restart the clock
+  void clear();
+
+  /// Record an execution of the zone \c name that started at \c start and
+  /// ended at \c end. This is called by ProfileZone.
+  void record(
+      const char* name,
+      std::chrono::steady_clock::time_point start,
+      std::chrono::steady_clock::time_point end);
+
+  /// Return the recorded events
+  std::vector<Event> getEvents() const;
+
+  /// Return the statistics of each zone, sorted by name
+  std::map<std::string, Statistics> getStatistics() const;
+
+  /// Print the statistics of each zone
+  void print(std::ostream& os) const;
+
+  /// Write the recorded events in the Chrome trace event format
+  void writeChromeTrace(std::ostream& os) const;
+
+  /// Write the recorded events to a file in the Chrome trace event format.
+  /// Returns false if the file can't be opened.
+  bool exportChromeTrace(const std::string& path) const;
+
+protected:
+  friend class Singleton<Profiler>;
+
+  /// Constructor
+  Profiler();
+
+  /// Events and statistics recorded by one thread
+  struct ThreadBuffer
+  {
+    /// Protects the members below. Only contended while the buffers are
+    /// queried or cleared.
+    std::mutex mMutex;
+
+    /// Index of the thread, in the order the threads were first seen
+    std::size_t mThreadIndex;
+
+    /// Recorded events
+    std::vector<Event> mEvents;
+
+    /// Statistics of each zone, keyed by the address of its name
+    std::unordered_map<const char*, Statistics> mStatistics;
+  };
+
+  /// Return the buffer of the calling thread, which is created the first time
+  /// the thread records a zone
+  ThreadBuffer& getThreadBuffer();
+
+  /// Whether zones are recorded
+  std::atomic<bool> mIsEnabled;
+
+  /// Largest number of events that are kept for export
+  std::atomic<std::size_t> mMaxNumEvents;
+
+  /// Number of events recorded since the profiler was last cleared, including
+  /// the ones beyond mMaxNumEvents
+  std::atomic<std::size_t> mNumEvents;
+
+  /// Protects the list of buffers
+  mutable std::mutex mMutex;
+
+  /// Time the profiler was created or last cleared. Only changed while the
+  /// mutexes of all the buffers are locked.
+  std::chrono::steady_clock::time_point mStartTime;
+
+  /// Buffers of the threads seen by the profiler. They are kept after their
+  /// threads exit so that their zones can still be queried.
+  std::vector<std::unique_ptr<ThreadBuffer>> mThreadBuffers;
+};
+
+/// ProfileZone records the time between its construction and destruction as
+/// an execution of a zone. Use DART_PROFILE_SCOPE() instead of instantiating
+/// it directly so that the zone is removed when profiling is compiled out.
+class ProfileZone
+{
+public:
+  /// Start timing the zone \c name, which should be a string literal
+  explicit ProfileZone(const char* name);
+
+  /// Stop timing the zone and record it
+  ~ProfileZone();
+
+  ProfileZone(const ProfileZone&) = delete;
+  ProfileZone& operator=(const ProfileZone&) = delete;
+
+  /// Stop timing the zone and record it before the end of its scope. The
+  /// destructor doesn't record it again.
+  void stop();
+
+private:
+  /// Name of the zone
+  const char* mName;
+
+  /// Profiler to record the zone to, or nullptr if profiling is disabled
+  Profiler* mProfiler;
+
+  /// Time the zone started
+  std::chrono::steady_clock::time_point mStartTime;
+};
+
+} // namespace common
+} // namespace dart
+
+#define DART_PROFILE_CONCAT_IMPL(a, b) a##b
+#define DART_PROFILE_CONCAT(a, b) DART_PROFILE_CONCAT_IMPL(a, b)
+
+#if DART_ENABLE_PROFILING
+/// Record the time spent until the end of the enclosing scope as the zone
+/// \c name, which should be a string literal
+#  define DART_PROFILE_SCOPE(name)                                             \
+    ::dart::common::ProfileZone DART_PROFILE_CONCAT(                           \
+        dartProfileZone, __LINE__)(name)
+/// Start recording the zone \c name, which should be a string literal, until
+/// DART_PROFILE_END(zone) is reached or the enclosing scope ends
+#  define DART_PROFILE_BEGIN(zone, name)                                       \
+    ::dart::common::ProfileZone zone(name)
+/// Stop recording a zone started with DART_PROFILE_BEGIN()
+#  define DART_PROFILE_END(zone) zone.stop()
+#else
+#  define DART_PROFILE_SCOPE(name) static_cast<void>(0)
+#  define DART_PROFILE_BEGIN(zone, name) static_cast<void>(0)
+#  define DART_PROFILE_END(zone) static_cast<void>(0)
+#endif
+
+#endif // DART_COMMON_PROFILER_HPP_
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COMMON_DETAIL_MEMORYPOOL_IMPL_HPP_
+#define DART_COMMON_DETAIL_MEMORYPOOL_IMPL_HPP_
+
+#include "dart/common/MemoryPool.hpp"
+
+namespace dart {
+namespace common {
+
+//==============================================================================
+template <typename T>
+PoolAllocator<T>::PoolAllocator(std::shared_ptr<MemoryPool> pool)
+  : mPool(std::move(pool))
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename T>
+template <typename U>
+PoolAllocator<T>::PoolAllocator(const PoolAllocator<U>& other)
+  : mPool(other.getPool())
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename T>
+T* PoolAllocator<T>::allocate(std::size_t n)
+{
+  static_assert(
+      alignof(T) <= MemoryPool::Alignment,
+      "The alignment of T exceeds the alignment of the MemoryPool blocks");
+
+  return static_cast<T*>(mPool->allocate(n * sizeof(T)));
+}
+
+//==============================================================================
+template <typename T>
+void PoolAllocator<T>::deallocate(T* pointer, std::size_t n)
+{
+  mPool->deallocate(pointer, n * sizeof(T));
+}
+
+//==============================================================================
+template <typename T>
+const std::shared_ptr<MemoryPool>& PoolAllocator<T>::getPool() const
+{
+  return mPool;
+}
+
+//==============================================================================
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs)
+{
+  return lhs.getPool() == rhs.getPool();
+}
+
+//==============================================================================
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+} // namespace common
+} // namespace dart
+
+#endif // DART_COMMON_DETAIL_MEMORYPOOL_IMPL_HPP_
@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/constraint/ApgdBoxedLcpSolver.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include "dart/external/odelcpsolver/matrix.h"
+
+namespace dart {
+namespace constraint {
+
+namespace {
+
+/// Step of the projected gradient whose norm is the residual
+constexpr double residualStep = 1e-6;
+
+/// Bound on the doublings of the Lipschitz estimate within an iteration
+constexpr int maxNumBacktracks = 64;
+
+} // namespace
+
+//==============================================================================
+ApgdBoxedLcpSolver::Option::Option(int maxIteration, double tolerance)
+  : mMaxIteration(maxIteration), mTolerance(tolerance)
+{
+  // Do nothing
+}
+
+//==============================================================================
+ApgdBoxedLcpSolver::ApgdBoxedLcpSolver() : mNumIterations(0), mResidual(0.0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+const std::string& ApgdBoxedLcpSolver::getType() const
+{
+  return getStaticType();
+}
+
+//==============================================================================
+const std::string& ApgdBoxedLcpSolver::getStaticType()
+{
+  static const std::string type = "ApgdBoxedLcpSolver";
+  return type;
+}
+
+//==============================================================================
+bool ApgdBoxedLcpSolver::solve(
+    int n,
+    double* A,
+    double* x,
+    double* b,
+    int nub,
+    double* lo,
+    double* hi,
+    int* findex,
+    bool /*earlyTermination*/)
+{
+  using RowMajorMatrixXd
+      = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  const Eigen::Map<const RowMajorMatrixXd, 0, Eigen::OuterStride<>> mapA(
+      A, n, n, Eigen::OuterStride<>(dPAD(n)));
+  const Eigen::Map<const Eigen::VectorXd> mapB(b, n);
+
+  reserve(n);
+  mNumIterations = 0;
+  mIsInterrupted = false;
+
+  // A problem that is not finite has no solution to converge to
+  if (!mapA.allFinite() || !mapB.allFinite())
+    return false;
+
+  // Group the friction rows by their normal rows
+  mCones.clear();
+  mConeRows.clear();
+  mConeIndices.assign(static_cast<std::size_t>(n), -1);
+  for (int i = nub; findex && i < n; ++i)
+  {
+    const int j = findex[i];
+    if (j < 0)
+      continue;
+
+    assert(j < n);
+    if (j < nub || findex[j] >= 0 || lo[j] != 0.0 || std::isfinite(hi[j]))
+      return false;
+
+    if (mConeIndices[j] < 0)
+    {
+      mConeIndices[j] = static_cast<int>(mCones.size());
+      mCones.push_back({j, 0, 0});
+    }
+    ++mCones[mConeIndices[j]].mEnd;
+  }
+
+  int numConeRows = 0;
+  for (Cone& cone : mCones)
+  {
+    const int size = cone.mEnd;
+    cone.mBegin = numConeRows;
+    cone.mEnd = numConeRows;
+    numConeRows += size;
+  }
+
+  mConeRows.resize(static_cast<std::size_t>(numConeRows));
+  for (int i = nub; findex && i < n; ++i)
+  {
+    if (findex[i] >= 0)
+      mConeRows[mCones[mConeIndices[findex[i]]].mEnd++] = i;
+  }
+
+  auto xk = mX.head(n);
+  auto axk = mAX.head(n);
+  auto y = mY.head(n);
+  auto ay = mAY.head(n);
+  auto xNext = mXNext.head(n);
+  auto axNext = mAXNext.head(n);
+  auto xBest = mXBest.head(n);
+  auto gradient = mGradient.head(n);
+  auto shiftedB = mShiftedB.head(n);
+
+  // Initial estimate of the Lipschitz constant of the gradient, which is the
+  // largest eigenvalue of A
+  double lipschitz = mapA.rowwise().sum().norm() / std::sqrt(n);
+  if (!(lipschitz > 0.0))
+    lipschitz = 1.0;
+
+  // Start with the shifts of the sliding velocities of the initial guess,
+  // which are the velocities before the impulses when the guess is zero
+  xk = Eigen::Map<const Eigen::VectorXd>(x, n);
+  project(n, nub, lo, hi, findex, mX);
+  xBest = xk;
+  shiftedB = mapB;
+  updateShifts(n, A, b, hi);
+
+  bool success = false;
+  bool diverged = false;
+  while (true)
+  {
+    axk.noalias() = mapA * xk;
+    y = xk;
+    ay = axk;
+    xBest = xk;
+    mResidual
+        = computeResidual(n, nub, lo, hi, mShiftedB.data(), findex, mX, mAX);
+
+    double theta = 1.0;
+    while (mResidual > mOption.mTolerance
+           && mNumIterations < mOption.mMaxIteration)
+    {
+      // Stop at the best iterate once the budget is spent
+      if (checkBudget(mNumIterations))
+        break;
+
+      ++mNumIterations;
+      gradient = ay - shiftedB;
+
+      // Backtrack until the step is within the curvature of the objective.
+      // A step that overflows never is, so the solve fails instead.
+      diverged = true;
+      for (int i = 0; i < maxNumBacktracks; ++i)
+      {
+        xNext = y - gradient / lipschitz;
+        project(n, nub, lo, hi, findex, mXNext);
+        axNext.noalias() = mapA * xNext;
+
+        const double stepNorm = (xNext - y).squaredNorm();
+        const double curvature = (xNext - y).dot(axNext - ay);
+        if (!std::isfinite(stepNorm) || !std::isfinite(curvature))
+          break;
+
+        if (curvature <= lipschitz * stepNorm || stepNorm == 0.0)
+        {
+          diverged = false;
+          break;
+        }
+
+        lipschitz *= 2.0;
+      }
+
+      if (diverged)
+        break;
+
+      const double residual = computeResidual(
+          n, nub, lo, hi, mShiftedB.data(), findex, mXNext, mAXNext);
+      if (residual < mResidual)
+      {
+        mResidual = residual;
+        xBest = xNext;
+      }
+
+      const double thetaNext
+          = 0.5 * theta * (std::sqrt(theta * theta + 4.0) - theta);
+      const double beta = theta * (1.0 - theta) / (theta * theta + thetaNext);
+
+      // Restart the momentum when it moves uphill
+      if (gradient.dot(xNext - xk) > 0.0)
+      {
+        y = xNext;
+        ay = axNext;
+        theta = 1.0;
+      }
+      else
+      {
+        y = xNext + beta * (xNext - xk);
+        ay = axNext + beta * (axNext - axk);
+        theta = thetaNext;
+      }
+
+      xk = xNext;
+      axk = axNext;
+      lipschitz *= 0.9;
+    }
+
+    if (diverged || mResidual > mOption.mTolerance || mIsInterrupted)
+      break;
+
+    const double change = updateShifts(n, A, b, hi);
+    if (change <= mOption.mTolerance)
+    {
+      success = true;
+      break;
+    }
+
+    if (++mNumIterations >= mOption.mMaxIteration
+        || checkBudget(mNumIterations))
+    {
+      break;
+    }
+
+    xk = xBest;
+  }
+
+  // Keep the initial guess rather than an iterate that is not finite
+  if (xBest.allFinite())
+    Eigen::Map<Eigen::VectorXd>(x, n) = xBest;
+
+  return success;
+}
+
+//==============================================================================
+void ApgdBoxedLcpSolver::reserve(int n)
+{
+  if (mX.size() >= n)
+    return;
+
+  mCones.reserve(static_cast<std::size_t>(n));
+  mConeRows.reserve(static_cast<std::size_t>(n));
+  mConeIndices.reserve(static_cast<std::size_t>(n));
+  mX.resize(n);
+  mY.resize(n);
+  mXNext.resize(n);
+  mXBest.resize(n);
+  mAX.resize(n);
+  mAY.resize(n);
+  mAXNext.resize(n);
+  mGradient.resize(n);
+  mShiftedB.resize(n);
+  mProjected.resize(n);
+}
+
+//==============================================================================
+bool ApgdBoxedLcpSolver::isInterruptible() const
+{
+  return true;
+}
+
+#ifndef NDEBUG
+//==============================================================================
+bool ApgdBoxedLcpSolver::canSolve(int n, const double* A)
+{
+  const int nskip = dPAD(n);
+
+  // The gradient projection converges for symmetric positive semidefinite A,
+  // which has no negative diagonal.
+  for (int i = 0; i < n; ++i)
+  {
+    if (A[nskip * i + i] < 0.0)
+      return false;
+
+    for (int j = 0; j < i; ++j)
+    {
+      if (std::abs(A[nskip * i + j] - A[nskip * j + i]) > 1e-9)
+        return false;
+    }
+  }
+
+  return true;
+}
+#endif
+
+//==============================================================================
+void ApgdBoxedLcpSolver::setOption(const ApgdBoxedLcpSolver::Option& option)
+{
+  mOption = option;
+}
+
+//==============================================================================
+const ApgdBoxedLcpSolver::Option& ApgdBoxedLcpSolver::getOption() const
+{
+  return mOption;
+}
+
+//==============================================================================
+int ApgdBoxedLcpSolver::getNumIterations() const
+{
+  return mNumIterations;
+}
+
+//==============================================================================
+double ApgdBoxedLcpSolver::getResidual() const
+{
+  return mResidual;
+}
+
+//==============================================================================
+void ApgdBoxedLcpSolver::project(
+    int n,
+    int nub,
+    const double* lo,
+    const double* hi,
+    const int* findex,
+    Eigen::VectorXd& x) const
+{
+  for (int i = nub; i < n; ++i)
+  {
+    if (mConeIndices[i] < 0 && !(findex && findex[i] >= 0))
+      x[i] = std::min(std::max(x[i], lo[i]), hi[i]);
+  }
+
+  // Project the normal and friction rows of each cone in the coordinates
+  // where the cone is isotropic with the largest friction coefficient, mu
+  for (const Cone& cone : mCones)
+  {
+    double mu = 0.0;
+    for (int k = cone.mBegin; k < cone.mEnd; ++k)
+      mu = std::max(mu, std::abs(hi[mConeRows[k]]));
+
+    double tangent = 0.0;
+    for (int k = cone.mBegin; k < cone.mEnd; ++k)
+    {
+      const int i = mConeRows[k];
+      const double c = std::abs(hi[i]);
+      if (c > 0.0)
+      {
+        const double scaled = x[i] * mu / c;
+        tangent += scaled * scaled;
+      }
+      else
+        x[i] = 0.0;
+    }
+    tangent = std::sqrt(tangent);
+
+    double& normal = x[cone.mNormal];
+    if (tangent <= mu * normal)
+      continue;
+
+    if (mu * tangent <= -normal)
+    {
+      normal = 0.0;
+      for (int k = cone.mBegin; k < cone.mEnd; ++k)
+        x[mConeRows[k]] = 0.0;
+      continue;
+    }
+
+    normal = (mu * tangent + normal) / (mu * mu + 1.0);
+    const double scale = mu * normal / tangent;
+    for (int k = cone.mBegin; k < cone.mEnd; ++k)
+      x[mConeRows[k]] *= scale;
+  }
+}
+
+//==============================================================================
+double ApgdBoxedLcpSolver::updateShifts(
+    int n, const double* A, const double* b, const double* hi)
+{
+  using RowMajorMatrixXd
+      = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  const Eigen::Map<const RowMajorMatrixXd, 0, Eigen::OuterStride<>> mapA(
+      A, n, n, Eigen::OuterStride<>(dPAD(n)));
+
+  // The minimizer lets sliding contacts separate with a normal velocity of
+  // the norm of their scaled sliding velocity. Shifting b of the normal rows
+  // by that velocity turns the minimizer into a solution of the Coulomb
+  // friction problem once the shifts stop changing (De Saxce's fixed point).
+  auto velocity = mGradient.head(n);
+  velocity.noalias() = mapA * mXBest.head(n);
+  velocity -= Eigen::Map<const Eigen::VectorXd>(b, n);
+
+  double change = 0.0;
+  for (const Cone& cone : mCones)
+  {
+    double slidingVelocity = 0.0;
+    for (int k = cone.mBegin; k < cone.mEnd; ++k)
+    {
+      const int i = mConeRows[k];
+      const double scaled = hi[i] * velocity[i];
+      slidingVelocity += scaled * scaled;
+    }
+
+    const double shifted = b[cone.mNormal] - std::sqrt(slidingVelocity);
+    change = std::max(change, std::abs(shifted - mShiftedB[cone.mNormal]));
+    mShiftedB[cone.mNormal] = shifted;
+  }
+
+  return change;
+}
+
+//==============================================================================
+double ApgdBoxedLcpSolver::computeResidual(
+    int n,
+    int nub,
+    const double* lo,
+    const double* hi,
+    const double* b,
+    const int* findex,
+    const Eigen::VectorXd& x,
+    const Eigen::VectorXd& ax)
+{
+  // (x - P(x - h*g))/h approaches the projected gradient as h gets small
+  mProjected.head(n)
+      = x.head(n)
+        - residualStep * (ax.head(n) - Eigen::Map<const Eigen::VectorXd>(b, n));
+  project(n, nub, lo, hi, findex, mProjected);
+
+  return (x.head(n) - mProjected.head(n)).lpNorm<Eigen::Infinity>()
+         / residualStep;
+}
+
+} // namespace constraint
+} // namespace dart
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_CONSTRAINT_APGDBOXEDLCPSOLVER_HPP_
+#define DART_CONSTRAINT_APGDBOXEDLCPSOLVER_HPP_
+
+#include <vector>
+#include <Eigen/Dense>
+#include "dart/constraint/BoxedLcpSolver.hpp"
+
+namespace dart {
+namespace constraint {
+
+/// Accelerated projected gradient descent (APGD) solver that bounds friction
+/// by the Coulomb cone instead of the box of the boxed LCP.
+///
+/// The friction rows that refer to the same normal row through findex form a
+/// cone, |(x_1/hi_1, ..., x_k/hi_k)| <= x_normal, so two friction rows of a
+/// contact bound its friction force by an ellipse, or a circle for isotropic
+/// friction, rather than by a square. The other rows are bounded by [lo, hi].
+///
+/// The solver minimizes 0.5*x'*A*x - b'*x over these sets with Nesterov's
+/// accelerated gradient projection, adaptive step sizes and restarts. The
+/// minimizer solves the cone complementarity relaxation of the contact
+/// problem, where sliding contacts separate. b of the normal rows is then
+/// shifted by the sliding velocities and the minimization repeated from the
+/// last solution until the shifts converge, which solves the Coulomb friction
+/// problem itself.
+///
+/// The normal of friction rows must have lo = 0 and no upper bound, and must
+/// not be a friction row itself. x is used as the initial guess.
+class ApgdBoxedLcpSolver : public BoxedLcpSolver
+{
+public:
+  struct Option
+  {
+    /// Maximum number of gradient steps and updates of the shifts of b
+    int mMaxIteration;
+
+    /// Tolerance of the projected gradient and of the changes of the shifts,
+    /// which are velocities
+    double mTolerance;
+
+    Option(int maxIteration = 100, double tolerance = 1e-4);
+  };
+
+  /// Constructor
+  ApgdBoxedLcpSolver();
+
+  // Documentation inherited.
+  const std::string& getType() const override;
+
+  /// Returns type for this class
+  static const std::string& getStaticType();
+
+  /// Solves the problem as described in the class documentation. Returns
+  /// false if the solver didn't converge within the maximum number of
+  /// iterations or its budget, in which case x is the best iterate of the last
+  /// minimization.
+  bool solve(
+      int n,
+      double* A,
+      double* x,
+      double* b,
+      int nub,
+      double* lo,
+      double* hi,
+      int* findex,
+      bool earlyTermination) override;
+
+  // Documentation inherited.
+  void reserve(int n) override;
+
+  // Documentation inherited.
+  bool isInterruptible() const override;
+
+#ifndef NDEBUG
+  // Documentation inherited.
+  bool canSolve(int n, const double* A) override;
+#endif
+
+  /// Sets options
+  void setOption(const Option& option);
+
+  /// Returns options.
+  const Option& getOption() const;
+
+  /// Returns the number of iterations of the last solve
+  int getNumIterations() const override;
+
+  /// Returns the norm of the projected gradient of the last minimization of
+  /// the last solve
+  double getResidual() const;
+
+protected:
+  /// Friction rows that refer to the same normal row
+  struct Cone
+  {
+    int mNormal;
+
+    /// Range of the friction rows in mConeRows
+    int mBegin;
+    int mEnd;
+  };
+
+  /// Projects the first n entries of x onto the feasible set
+  void project(
+      int n,
+      int nub,
+      const double* lo,
+      const double* hi,
+      const int* findex,
+      Eigen::VectorXd& x) const;
+
+  /// Shifts b of the normal rows by the sliding velocities at the best iterate
+  /// and returns the largest change of the shifts
+  double updateShifts(
+      int n, const double* A, const double* b, const double* hi);
+
+  /// Returns the norm of the projected gradient at x, where ax = A*x
+  double computeResidual(
+      int n,
+      int nub,
+      const double* lo,
+      const double* hi,
+      const double* b,
+      const int* findex,
+      const Eigen::VectorXd& x,
+      const Eigen::VectorXd& ax);
+
+  Option mOption;
+
+  int mNumIterations;
+
+  double mResidual;
+
+  /// Friction cones of the current problem
+  std::vector<Cone> mCones;
+
+  /// Friction rows of mCones
+  std::vector<int> mConeRows;
+
+  /// Index in mCones of the cone that each normal row bounds, or -1
+  std::vector<int> mConeIndices;
+
+  /// Current iterate, extrapolated iterate, next iterate, best iterate and
+  /// their products with A
+  Eigen::VectorXd mX;
+  Eigen::VectorXd mY;
+  Eigen::VectorXd mXNext;
+  Eigen::VectorXd mXBest;
+  Eigen::VectorXd mAX;
+  Eigen::VectorXd mAY;
+  Eigen::VectorXd mAXNext;
+
+  /// Gradient at the extrapolated iterate
+  Eigen::VectorXd mGradient;
+
+  /// b with the normal rows shifted by the sliding velocities of the contacts
+  Eigen::VectorXd mShiftedB;
+
+  /// Buffer of computeResidual()
+  Eigen::VectorXd mProjected;
+};
+
+} // namespace constraint
+} // namespace dart
+
+#endif // DART_CONSTRAINT_APGDBOXEDLCPSOLVER_HPP_
@@ -165,7 +165,7 @@ void BallJointConstraint::getInformation(ConstraintInfo* _lcp)
   if (mBodyNode2)
     negativeVel += mJacobian2 * mBodyNode2->getSpatialVelocity();
 
-  mViolation *= mErrorReductionParameter * _lcp->invTimeStep;
+  mViolation *= mParameters.errorReductionParameter * _lcp->invTimeStep;
 
   _lcp->b[0] = negativeVel[0] - mViolation[0];
   _lcp->b[1] = negativeVel[1] - mViolation[1];
@@ -284,7 +284,7 @@ void BallJointConstraint::getVelocityChange(double* _vel, bool _withCfm)
   if (_withCfm)
   {
     _vel[mAppliedImpulseIndex]
-        += _vel[mAppliedImpulseIndex] * mConstraintForceMixing;
+        += _vel[mAppliedImpulseIndex] * mParameters.constraintForceMixing;
   }
 }
 
@@ -32,7 +32,10 @@
 
 #include "dart/constraint/BoxedLcpConstraintSolver.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cmath>
 #ifndef NDEBUG
 #  include <iomanip>
 #  include <iostream>
@@ -41,6 +44,7 @@
 #include "dart/external/odelcpsolver/lcp.h"
 
 #include "dart/common/Console.hpp"
+#include "dart/common/Profiler.hpp"
 #include "dart/constraint/ConstraintBase.hpp"
 #include "dart/constraint/DantzigBoxedLcpSolver.hpp"
 #include "dart/constraint/PgsBoxedLcpSolver.hpp"
@@ -49,6 +53,66 @@
 namespace dart {
 namespace constraint {
 
+namespace {
+
+/// Computing the impulse response of a BodyNode or point mass costs six
+/// impulse tests, so the cache only pays off when its BodyNodes and point
+/// masses have at least this many constraint rows on average
+constexpr std::size_t minNumRowsPerCachedResponse = 6u;
+
+//==============================================================================
+/// Grows \c storage to hold at least \c rows x \c cols entries. The storage is
+/// never shrunk, so that smaller LCPs reuse it instead of allocating memory.
+/// The LCP terms are accessed through data() with their own leading dimension
+/// rather than through the shape of the storage.
+template <typename Derived>
+void reserveLcpStorage(
+    Eigen::PlainObjectBase<Derived>& storage, int rows, int cols = 1)
+{
+  if (storage.size() < rows * cols)
+    storage.resize(rows, cols);
+}
+
+//==============================================================================
+/// Returns the largest natural residual of the solution \c x of the LCP in the
+/// format of BoxedLcpSolver::solve(), as BoxedLcpProblem::computeResidual()
+/// does but without allocating memory
+double computeLcpResidual(
+    int n,
+    const double* A,
+    const double* x,
+    const double* b,
+    const double* lo,
+    const double* hi,
+    const int* findex)
+{
+  const int nSkip = dPAD(n);
+  const Eigen::Map<const Eigen::VectorXd> xMap(x, n);
+
+  double residual = 0.0;
+  for (int i = 0; i < n; ++i)
+  {
+    // w = A * x - b is the slack of A * x = b + w
+    const double w
+        = Eigen::Map<const Eigen::VectorXd>(A + nSkip * i, n).dot(xMap) - b[i];
+
+    double lower = lo[i];
+    double upper = hi[i];
+    if (findex[i] >= 0)
+    {
+      upper = std::abs(hi[i] * x[findex[i]]);
+      lower = -upper;
+    }
+
+    const double projected = std::min(std::max(x[i] - w, lower), upper);
+    residual = std::max(residual, std::abs(x[i] - projected));
+  }
+
+  return residual;
+}
+
+} // namespace
+
 //==============================================================================
 BoxedLcpConstraintSolver::BoxedLcpConstraintSolver(
     double timeStep,
@@ -79,7 +143,13 @@ BoxedLcpConstraintSolver::BoxedLcpConstraintSolver(
 //==============================================================================
 BoxedLcpConstraintSolver::BoxedLcpConstraintSolver(
     BoxedLcpSolverPtr boxedLcpSolver, BoxedLcpSolverPtr secondaryBoxedLcpSolver)
-  : ConstraintSolver()
+  : ConstraintSolver(),
+    mIsCachingImpulseResponses(true),
+    mCaptureSlowSolveTime(std::numeric_limits<double>::infinity()),
+    mCaptureFallbacks(true),
+    mMaxSolveTime(std::numeric_limits<double>::infinity()),
+    mMaxNumSolveIterations(std::numeric_limits<std::size_t>::max()),
+    mSolveDeadline(std::chrono::steady_clock::time_point::max())
 {
   if (boxedLcpSolver)
   {
@@ -114,6 +184,9 @@ void BoxedLcpConstraintSolver::setBoxedLcpSolver(BoxedLcpSolverPtr lcpSolver)
   }
 
   mBoxedLcpSolver = std::move(lcpSolver);
+
+  if (mIsRealTime)
+    mBoxedLcpSolver->reserve(static_cast<int>(mMaxNumConstraintRows));
 }
 
 //==============================================================================
@@ -135,6 +208,9 @@ void BoxedLcpConstraintSolver::setSecondaryBoxedLcpSolver(
   }
 
   mSecondaryBoxedLcpSolver = std::move(lcpSolver);
+
+  if (mIsRealTime && mSecondaryBoxedLcpSolver)
+    mSecondaryBoxedLcpSolver->reserve(static_cast<int>(mMaxNumConstraintRows));
 }
 
 //==============================================================================
@@ -144,6 +220,134 @@ ConstBoxedLcpSolverPtr BoxedLcpConstraintSolver::getSecondaryBoxedLcpSolver()
   return mSecondaryBoxedLcpSolver;
 }
 
+//==============================================================================
+void BoxedLcpConstraintSolver::setCachingImpulseResponses(bool caching)
+{
+  mIsCachingImpulseResponses = caching;
+}
+
+//==============================================================================
+bool BoxedLcpConstraintSolver::isCachingImpulseResponses() const
+{
+  return mIsCachingImpulseResponses;
+}
+
+//==============================================================================
+bool BoxedLcpConstraintSolver::startLcpCapture(
+    const std::string& path, double slowSolveTime, bool captureFallbacks)
+{
+  auto writer = std::make_unique<BoxedLcpCorpusWriter>();
+  if (!writer->open(path))
+    return false;
+
+  mLcpCorpusWriter = std::move(writer);
+  mCaptureSlowSolveTime = slowSolveTime;
+  mCaptureFallbacks = captureFallbacks;
+
+  return true;
+}
+
+//==============================================================================
+void BoxedLcpConstraintSolver::stopLcpCapture()
+{
+  mLcpCorpusWriter.reset();
+}
+
+//==============================================================================
+bool BoxedLcpConstraintSolver::isCapturingLcps() const
+{
+  return mLcpCorpusWriter != nullptr;
+}
+
+//==============================================================================
+BoxedLcpConstraintSolver::SolveReport::SolveReport()
+  : numLcps(0u),
+    numInterruptedLcps(0u),
+    numIterations(0u),
+    maxResidual(0.0),
+    elapsedTime(0.0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void BoxedLcpConstraintSolver::setSolveBudget(
+    double maxSolveTime, std::size_t maxNumIterations)
+{
+  if (!(maxSolveTime >= 0.0))
+  {
+    dtwarn << "[BoxedLcpConstraintSolver::setSolveBudget] Attempting to set "
+           << "a negative time budget [" << maxSolveTime << "], which is not "
+           << "allowed. Ignoring.\n";
+    return;
+  }
+
+  mMaxSolveTime = maxSolveTime;
+  mMaxNumSolveIterations = maxNumIterations;
+
+  // The residuals of the solutions are computed from the backups of the LCPs
+  if (mIsRealTime)
+    reserveRealTimeMemory();
+}
+
+//==============================================================================
+void BoxedLcpConstraintSolver::clearSolveBudget()
+{
+  setSolveBudget(
+      std::numeric_limits<double>::infinity(),
+      std::numeric_limits<std::size_t>::max());
+}
+
+//==============================================================================
+bool BoxedLcpConstraintSolver::hasSolveBudget() const
+{
+  return mMaxSolveTime < std::numeric_limits<double>::infinity()
+         || mMaxNumSolveIterations < std::numeric_limits<std::size_t>::max();
+}
+
+//==============================================================================
+double BoxedLcpConstraintSolver::getMaxSolveTime() const
+{
+  return mMaxSolveTime;
+}
+
+//==============================================================================
+std::size_t BoxedLcpConstraintSolver::getMaxNumSolveIterations() const
+{
+  return mMaxNumSolveIterations;
+}
+
+//==============================================================================
+const BoxedLcpConstraintSolver::SolveReport&
+BoxedLcpConstraintSolver::getLastSolveReport() const
+{
+  return mSolveReport;
+}
+
+//==============================================================================
+void BoxedLcpConstraintSolver::beginSolve()
+{
+  mSolveReport = SolveReport();
+  mSolveStart = std::chrono::steady_clock::now();
+
+  // A time budget beyond the range of the clock is no deadline at all
+  const double maxDuration
+      = std::chrono::duration<double>(
+            std::chrono::steady_clock::time_point::max() - mSolveStart)
+            .count();
+  if (mMaxSolveTime < maxDuration)
+  {
+    mSolveDeadline
+        = mSolveStart
+          + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(mMaxSolveTime));
+  }
+  else
+  {
+    mSolveDeadline = std::chrono::steady_clock::time_point::max();
+  }
+}
+
 //==============================================================================
 void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
 {
@@ -155,21 +359,26 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
   if (0u == n)
     return;
 
+  DART_PROFILE_BEGIN(assembleLcpZone, "BoxedLcpConstraintSolver::assembleLcp");
+
   const int nSkip = dPAD(n);
-#ifdef NDEBUG // release
-  mA.resize(n, nSkip);
-#else // debug
-  mA.setZero(n, nSkip);
+  reserveLcpStorage(mA, n, nSkip);
+  reserveLcpStorage(mX, n);
+  reserveLcpStorage(mB, n);
+  reserveLcpStorage(mW, n);
+  reserveLcpStorage(mLo, n);
+  reserveLcpStorage(mHi, n);
+  reserveLcpStorage(mFIndex, n);
+  reserveLcpStorage(mOffset, numConstraints);
+
+  double* A = mA.data();
+#ifndef NDEBUG // debug
+  std::fill(A, A + n * nSkip, 0.0);
 #endif
-  mX.resize(n);
-  mB.resize(n);
-  mW.setZero(n); // set w to 0
-  mLo.resize(n);
-  mHi.resize(n);
-  mFIndex.setConstant(n, -1); // set findex to -1
+  mW.head(n).setZero(); // set w to 0
+  mFIndex.head(n).setConstant(-1); // set findex to -1
 
   // Compute offset indices
-  mOffset.resize(numConstraints);
   mOffset[0] = 0;
   for (std::size_t i = 1; i < numConstraints; ++i)
   {
@@ -178,12 +387,56 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
     mOffset[i] = mOffset[i - 1] + constraint->getDimension();
   }
 
+  // Contacts and soft contacts run their impulse tests on the impulse
+  // responses of their BodyNodes and point masses, which are computed once
+  // per BodyNode or point mass instead of once per row
+  mImpulseResponses.clear();
+  mCachedConstraintsOfGroup.resize(numConstraints);
+  std::size_t otherConstraintsEnd = 0u;
+  std::size_t numCachedRows = 0u;
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    ConstraintBase* cached = group.getConstraint(i).get();
+    if (!mIsCachingImpulseResponses || !cached->supportsImpulseResponseCache())
+      cached = nullptr;
+
+    mCachedConstraintsOfGroup[i] = cached;
+    if (cached)
+    {
+      cached->addBodyNodesTo(mImpulseResponses);
+      numCachedRows += cached->getDimension();
+    }
+    else
+    {
+      otherConstraintsEnd = i + 1;
+    }
+  }
+
+  // Sparse contacts, e.g., a single contact per BodyNode, are cheaper to
+  // test row by row
+  const std::size_t numResponses = mImpulseResponses.getNumBodyNodes()
+                                   + mImpulseResponses.getNumPointMasses();
+  if (numCachedRows < minNumRowsPerCachedResponse * numResponses)
+  {
+    mImpulseResponses.clear();
+    std::fill(
+        mCachedConstraintsOfGroup.begin(),
+        mCachedConstraintsOfGroup.end(),
+        nullptr);
+    otherConstraintsEnd = numConstraints;
+  }
+  else if (numResponses > 0u)
+  {
+    mImpulseResponses.update();
+  }
+
   // For each constraint
   ConstraintInfo constInfo;
   constInfo.invTimeStep = 1.0 / mTimeStep;
   for (std::size_t i = 0; i < numConstraints; ++i)
   {
     const ConstraintBasePtr& constraint = group.getConstraint(i);
+    ConstraintBase* cached = mCachedConstraintsOfGroup[i];
 
     constInfo.x = mX.data() + mOffset[i];
     constInfo.lo = mLo.data() + mOffset[i];
@@ -195,113 +448,221 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
     // Fill vectors: lo, hi, b, w
     constraint->getInformation(&constInfo);
 
-    // Fill a matrix by impulse tests: A
-    constraint->excite();
+    // Adjust findex for global index
     for (std::size_t j = 0; j < constraint->getDimension(); ++j)
     {
-      // Adjust findex for global index
       if (mFIndex[mOffset[i] + j] >= 0)
         mFIndex[mOffset[i] + j] += mOffset[i];
+    }
+
+    // Fill upper triangle blocks of A matrix that belong to contacts from
+    // the cached impulse responses
+    if (cached)
+    {
+      cached->applyUnitImpulses(mImpulseResponses);
+      for (std::size_t k = i; k < numConstraints; ++k)
+      {
+        if (!mCachedConstraintsOfGroup[k])
+          continue;
 
-      // Apply impulse for mipulse test
-      constraint->applyUnitImpulse(j);
+        const int index = nSkip * mOffset[i] + mOffset[k];
+        mCachedConstraintsOfGroup[k]->getVelocityChanges(
+            mImpulseResponses, A + index, nSkip, k == i);
+      }
+    }
 
-      // Fill upper triangle blocks of A matrix
-      int index = nSkip * (mOffset[i] + j) + mOffset[i];
-      constraint->getVelocityChange(mA.data() + index, true);
-      for (std::size_t k = i + 1; k < numConstraints; ++k)
+    // Fill the rest of the upper triangle blocks of A matrix by impulse
+    // tests on the Skeletons
+    if (!cached || otherConstraintsEnd > i + 1)
+    {
+      constraint->excite();
+      for (std::size_t j = 0; j < constraint->getDimension(); ++j)
       {
-        index = nSkip * (mOffset[i] + j) + mOffset[k];
-        group.getConstraint(k)->getVelocityChange(mA.data() + index, false);
+        // Apply impulse for mipulse test
+        constraint->applyUnitImpulse(j);
+
+        int index = nSkip * (mOffset[i] + j) + mOffset[i];
+        if (!cached)
+          constraint->getVelocityChange(A + index, true);
+
+        for (std::size_t k = i + 1; k < numConstraints; ++k)
+        {
+          if (cached && mCachedConstraintsOfGroup[k])
+            continue;
+
+          index = nSkip * (mOffset[i] + j) + mOffset[k];
+          group.getConstraint(k)->getVelocityChange(A + index, false);
+        }
       }
+      constraint->unexcite();
+    }
 
-      // Filling symmetric part of A matrix
+    // Filling symmetric part of A matrix
+    for (std::size_t j = 0; j < constraint->getDimension(); ++j)
+    {
       for (std::size_t k = 0; k < i; ++k)
       {
         const int indexI = mOffset[i] + j;
-        for (std::size_t l = 0; l < group.getConstraint(k)->getDimension(); ++l)
+        const std::size_t dimension = group.getConstraint(k)->getDimension();
+        for (std::size_t l = 0; l < dimension; ++l)
         {
           const int indexJ = mOffset[k] + l;
-          mA(indexI, indexJ) = mA(indexJ, indexI);
+          A[nSkip * indexI + indexJ] = A[nSkip * indexJ + indexI];
         }
       }
     }
 
     assert(isSymmetric(
-        n, mA.data(), mOffset[i], mOffset[i] + constraint->getDimension() - 1));
-
-    constraint->unexcite();
+        n, A, mOffset[i], mOffset[i] + constraint->getDimension() - 1));
   }
 
-  assert(isSymmetric(n, mA.data()));
+  assert(isSymmetric(n, A));
+  DART_PROFILE_END(assembleLcpZone);
 
   // Print LCP formulation
   //  dtdbg << "Before solve:" << std::endl;
   //  print(n, A, x, lo, hi, b, w, findex);
   //  std::cout << std::endl;
 
+  DART_PROFILE_BEGIN(solveLcpZone, "BoxedLcpConstraintSolver::solveLcp");
+
   // Solve LCP using the primary solver and fallback to secondary solver when
   // the parimary solver failed.
-  if (mSecondaryBoxedLcpSolver)
+  const bool isBudgeted = hasSolveBudget();
+  if (mSecondaryBoxedLcpSolver || isBudgeted)
+  {
+    // Make backups for the secondary LCP solver and for the residual because
+    // the solvers modify the original terms.
+    const int nSkip = dPAD(n);
+    reserveLcpStorage(mABackup, n, nSkip);
+    reserveLcpStorage(mXBackup, n);
+    reserveLcpStorage(mBBackup, n);
+    reserveLcpStorage(mLoBackup, n);
+    reserveLcpStorage(mHiBackup, n);
+    reserveLcpStorage(mFIndexBackup, n);
+
+    std::copy(mA.data(), mA.data() + n * nSkip, mABackup.data());
+    mXBackup.head(n) = mX.head(n);
+    mBBackup.head(n) = mB.head(n);
+    mLoBackup.head(n) = mLo.head(n);
+    mHiBackup.head(n) = mHi.head(n);
+    mFIndexBackup.head(n) = mFIndex.head(n);
+  }
+
+  // Keep a copy of the original terms and time the solvers when capturing
+  const bool capture = (mLcpCorpusWriter != nullptr);
+  std::chrono::steady_clock::time_point start;
+  if (capture)
   {
-    // Make backups for the secondary LCP solver because the primary solver
-    // modifies the original terms.
-    mABackup = mA;
-    mXBackup = mX;
-    mBBackup = mB;
-    mLoBackup = mLo;
-    mHiBackup = mHi;
-    mFIndexBackup = mFIndex;
+    const Eigen::Map<
+        const Eigen::Matrix<double, -1, -1, Eigen::RowMajor>,
+        0,
+        Eigen::OuterStride<>>
+        A(mA.data(), n, n, Eigen::OuterStride<>(dPAD(n)));
+    mCapturedLcp.A = A;
+    mCapturedLcp.x = mX.head(n);
+    mCapturedLcp.b = mB.head(n);
+    mCapturedLcp.lo = mLo.head(n);
+    mCapturedLcp.hi = mHi.head(n);
+    mCapturedLcp.findex = mFIndex.head(n);
+    start = std::chrono::steady_clock::now();
   }
+
+  // A primary solver that can't be interrupted is left out once the budget
+  // of the step is spent
+  const bool skipsPrimary = isBudgeted && mSecondaryBoxedLcpSolver
+                            && !mBoxedLcpSolver->isInterruptible()
+                            && isSolveBudgetSpent();
+
   const bool earlyTermination = (mSecondaryBoxedLcpSolver != nullptr);
   assert(mBoxedLcpSolver);
-  bool success = mBoxedLcpSolver->solve(
-      n,
-      mA.data(),
-      mX.data(),
-      mB.data(),
-      0,
-      mLo.data(),
-      mHi.data(),
-      mFIndex.data(),
-      earlyTermination);
+  bool success = false;
+  bool isInterrupted = false;
+  if (!skipsPrimary)
+  {
+    success = solveLcp(*mBoxedLcpSolver, n, earlyTermination);
+    isInterrupted = mBoxedLcpSolver->isInterrupted();
+  }
 
   // Sanity check. LCP solvers should not report success with nan values, but
   // it could happen. So we set the sucees to false for nan values.
-  if (success && mX.hasNaN())
+  if (success && mX.head(n).hasNaN())
     success = false;
 
-  if (!success && mSecondaryBoxedLcpSolver)
+  // The best iterate of an interrupted solver is used as it is because the
+  // budget for the secondary solver is spent as well
+  if (!success && mSecondaryBoxedLcpSolver
+      && (!isInterrupted || mX.head(n).hasNaN()))
   {
-    mSecondaryBoxedLcpSolver->solve(
-        n,
-        mABackup.data(),
-        mXBackup.data(),
-        mBBackup.data(),
-        0,
-        mLoBackup.data(),
-        mHiBackup.data(),
-        mFIndexBackup.data(),
-        false);
-    mX = mXBackup;
+    // Solve the original terms, keeping the backups for the residual
+    const int nSkip = dPAD(n);
+    std::copy(mABackup.data(), mABackup.data() + n * nSkip, mA.data());
+    mX.head(n) = mXBackup.head(n);
+    mB.head(n) = mBBackup.head(n);
+    mLo.head(n) = mLoBackup.head(n);
+    mHi.head(n) = mHiBackup.head(n);
+    mFIndex.head(n) = mFIndexBackup.head(n);
+
+    solveLcp(*mSecondaryBoxedLcpSolver, n, false);
+    isInterrupted = mSecondaryBoxedLcpSolver->isInterrupted();
+  }
+
+  if (capture)
+  {
+    mCapturedLcp.solveTime = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+    mCapturedLcp.isFallback = !success;
+    if ((mCaptureFallbacks && !success)
+        || mCapturedLcp.solveTime >= mCaptureSlowSolveTime)
+    {
+      mLcpCorpusWriter->write(mCapturedLcp);
+    }
   }
 
-  if (mX.hasNaN())
+  if (mX.head(n).hasNaN())
   {
     dterr << "[BoxedLcpConstraintSolver] The solution of LCP includes NAN "
-          << "values: " << mX.transpose() << ". We're setting it zero for "
+          << "values: " << mX.head(n).transpose()
+          << ". We're setting it zero for "
           << "safety. Consider using more robust solver such as PGS as a "
           << "secondary solver. If this happens even with PGS solver, please "
           << "report this as a bug.\n";
-    mX.setZero();
+    mX.head(n).setZero();
+  }
+
+  ++mSolveReport.numLcps;
+  if (isInterrupted)
+    ++mSolveReport.numInterruptedLcps;
+
+  if (isBudgeted)
+  {
+    mSolveReport.maxResidual = std::max(
+        mSolveReport.maxResidual,
+        computeLcpResidual(
+            n,
+            mABackup.data(),
+            mX.data(),
+            mBBackup.data(),
+            mLoBackup.data(),
+            mHiBackup.data(),
+            mFIndexBackup.data()));
   }
 
+  mSolveReport.elapsedTime = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now()
+                                 - mSolveStart)
+                                 .count();
+  DART_PROFILE_END(solveLcpZone);
+
   // Print LCP formulation
   //  dtdbg << "After solve:" << std::endl;
   //  print(n, A, x, lo, hi, b, w, findex);
   //  std::cout << std::endl;
 
   // Apply constraint impulses
+  DART_PROFILE_SCOPE("BoxedLcpConstraintSolver::applyImpulses");
+
   for (std::size_t i = 0; i < numConstraints; ++i)
   {
     const ConstraintBasePtr& constraint = group.getConstraint(i);
@@ -310,6 +671,94 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
   }
 }
 
+//==============================================================================
+void BoxedLcpConstraintSolver::reserveRealTimeMemory()
+{
+  ConstraintSolver::reserveRealTimeMemory();
+
+  const int n = static_cast<int>(mMaxNumConstraintRows);
+  const int nSkip = dPAD(n);
+  reserveLcpStorage(mA, n, nSkip);
+  reserveLcpStorage(mX, n);
+  reserveLcpStorage(mB, n);
+  reserveLcpStorage(mW, n);
+  reserveLcpStorage(mLo, n);
+  reserveLcpStorage(mHi, n);
+  reserveLcpStorage(mFIndex, n);
+  reserveLcpStorage(mOffset, n);
+
+  // Every constraint has at least one row and a contact has two BodyNodes or
+  // point masses
+  mCachedConstraintsOfGroup.reserve(mMaxNumConstraintRows);
+  mImpulseResponses.reserve(
+      2u * mMaxNumConstraintRows, 2u * mMaxNumConstraintRows);
+
+  mBoxedLcpSolver->reserve(n);
+
+  if (mSecondaryBoxedLcpSolver || hasSolveBudget())
+  {
+    reserveLcpStorage(mABackup, n, nSkip);
+    reserveLcpStorage(mXBackup, n);
+    reserveLcpStorage(mBBackup, n);
+    reserveLcpStorage(mLoBackup, n);
+    reserveLcpStorage(mHiBackup, n);
+    reserveLcpStorage(mFIndexBackup, n);
+  }
+
+  if (mSecondaryBoxedLcpSolver)
+    mSecondaryBoxedLcpSolver->reserve(n);
+}
+
+//==============================================================================
+bool BoxedLcpConstraintSolver::solveLcp(
+    BoxedLcpSolver& solver, int n, bool earlyTermination)
+{
+  if (hasSolveBudget())
+  {
+    // Every constrained group gets at least one iteration
+    std::size_t numIterations = 1u;
+    if (mSolveReport.numIterations < mMaxNumSolveIterations)
+    {
+      numIterations = std::max(
+          numIterations, mMaxNumSolveIterations - mSolveReport.numIterations);
+    }
+
+    solver.setBudget(
+        static_cast<int>(std::min<std::size_t>(
+            numIterations,
+            static_cast<std::size_t>(std::numeric_limits<int>::max()))),
+        mSolveDeadline);
+  }
+  else
+  {
+    solver.clearBudget();
+  }
+
+  const bool success = solver.solve(
+      n,
+      mA.data(),
+      mX.data(),
+      mB.data(),
+      0,
+      mLo.data(),
+      mHi.data(),
+      mFIndex.data(),
+      earlyTermination);
+
+  mSolveReport.numIterations
+      += static_cast<std::size_t>(solver.getNumIterations());
+
+  return success;
+}
+
+//==============================================================================
+bool BoxedLcpConstraintSolver::isSolveBudgetSpent() const
+{
+  return mSolveReport.numIterations >= mMaxNumSolveIterations
+         || (mSolveDeadline != std::chrono::steady_clock::time_point::max()
+             && std::chrono::steady_clock::now() >= mSolveDeadline);
+}
+
 //==============================================================================
 #ifndef NDEBUG
 bool BoxedLcpConstraintSolver::isSymmetric(std::size_t n, double* A)
@@ -33,7 +33,14 @@
 #ifndef DART_CONSTRAINT_BOXEDLCPCONSTRAINTSOLVER_HPP_
 #define DART_CONSTRAINT_BOXEDLCPCONSTRAINTSOLVER_HPP_
 
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "dart/constraint/BoxedLcpProblem.hpp"
 #include "dart/constraint/ConstraintSolver.hpp"
+#include "dart/constraint/ImpulseResponseCache.hpp"
 #include "dart/constraint/SmartPointer.hpp"
 
 namespace dart {
@@ -97,10 +104,117 @@ public:
   /// failed
   ConstBoxedLcpSolverPtr getSecondaryBoxedLcpSolver() const;
 
+  /// Sets whether the contacts and soft contacts of a constrained group build
+  /// their part of the LCP from the impulse responses of their BodyNodes and
+  /// point masses, which are computed once per BodyNode or point mass, instead
+  /// of impulse tests on the Skeletons for each constraint row. A constrained
+  /// group uses the cache only if its contacts have at least six rows per
+  /// BodyNode or point mass on average, since computing a response costs six
+  /// impulse tests. This is enabled by default. See ImpulseResponseCache.
+  void setCachingImpulseResponses(bool caching);
+
+  /// Returns true if the contacts build their part of the LCP from cached
+  /// impulse responses
+  bool isCachingImpulseResponses() const;
+
+  /// Starts writing the LCPs solved by this solver to a corpus file so that
+  /// they can be reproduced offline. See readBoxedLcpCorpus().
+  ///
+  /// \param[in] path Path of the corpus file
+  /// \param[in] slowSolveTime LCPs that take at least this many seconds to
+  /// solve are captured. Pass zero to capture every LCP.
+  /// \param[in] captureFallbacks Whether to capture the LCPs that the primary
+  /// solver fails to solve.
+  /// \return False if the file can't be opened.
+  bool startLcpCapture(
+      const std::string& path,
+      double slowSolveTime = std::numeric_limits<double>::infinity(),
+      bool captureFallbacks = true);
+
+  /// Stops capturing LCPs and closes the corpus file
+  void stopLcpCapture();
+
+  /// Returns true if LCPs are being captured
+  bool isCapturingLcps() const;
+
+  /// Work and accuracy of the LCPs solved in a step
+  struct SolveReport
+  {
+    /// Number of LCPs solved, one per constrained group
+    std::size_t numLcps;
+
+    /// Number of LCPs whose solver was stopped by the budget before it
+    /// converged
+    std::size_t numInterruptedLcps;
+
+    /// Total number of iterations of the LCP solvers
+    std::size_t numIterations;
+
+    /// Largest residual of the solutions of the LCPs as defined by
+    /// BoxedLcpProblem::computeResidual(). It's only computed while a budget
+    /// is set, and zero otherwise.
+    double maxResidual;
+
+    /// Time in seconds from the start of the step to the end of its last LCP
+    /// solve
+    double elapsedTime;
+
+    /// Constructor
+    SolveReport();
+  };
+
+  /// Limits the work of the LCP solvers in each step, for real-time loops with
+  /// hard deadlines. The time is measured from the start of solve(), so
+  /// collision detection and the assembly of the LCPs count against it, and
+  /// the iterations are summed over the constrained groups of the step.
+  ///
+  /// Once the budget is spent, interruptible solvers such as PgsBoxedLcpSolver
+  /// and ApgdBoxedLcpSolver return their best iterate instead of converging,
+  /// and the secondary solver isn't tried after them. Every constrained group
+  /// still gets at least one iteration. A primary solver that can't be
+  /// interrupted, such as DantzigBoxedLcpSolver, is skipped in favor of the
+  /// secondary solver once the budget is spent, but runs to completion once
+  /// started.
+  ///
+  /// \param[in] maxSolveTime Time budget of a step in seconds. Pass infinity
+  /// to limit only the iterations.
+  /// \param[in] maxNumIterations Iteration budget of a step.
+  void setSolveBudget(
+      double maxSolveTime,
+      std::size_t maxNumIterations = std::numeric_limits<std::size_t>::max());
+
+  /// Removes the budget set by setSolveBudget()
+  void clearSolveBudget();
+
+  /// Returns true if the work of the LCP solvers in each step is limited
+  bool hasSolveBudget() const;
+
+  /// Returns the time budget of a step in seconds
+  double getMaxSolveTime() const;
+
+  /// Returns the iteration budget of a step
+  std::size_t getMaxNumSolveIterations() const;
+
+  /// Returns the work and accuracy of the LCPs solved in the last step
+  const SolveReport& getLastSolveReport() const;
+
 protected:
+  // Documentation inherited.
+  void beginSolve() override;
+
   // Documentation inherited.
   void solveConstrainedGroup(ConstrainedGroup& group) override;
 
+  /// Solves the LCP in mA, mX, mB, mLo, mHi and mFIndex with \c solver within
+  /// the rest of the budget of the step, and counts its iterations
+  bool solveLcp(BoxedLcpSolver& solver, int n, bool earlyTermination);
+
+  /// Returns true if the budget of the current step is spent
+  bool isSolveBudgetSpent() const;
+
+  // Documentation inherited.
+  void reserveRealTimeMemory() override;
+
   /// Boxed LCP solver
   BoxedLcpSolverPtr mBoxedLcpSolver;
   // TODO(JS): Hold as unique_ptr because there is no reason to share. Make this
@@ -111,7 +225,8 @@ protected:
   // TODO(JS): Hold as unique_ptr because there is no reason to share. Make this
   // change in DART 7 because it's API breaking change.
 
-  /// Cache data for boxed LCP formulation
+  /// Cache data for boxed LCP formulation. The LCP caches only grow, and hold
+  /// the terms of the current LCP in their first entries.
   Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> mA;
 
   /// Cache data for boxed LCP formulation
@@ -154,6 +269,44 @@ protected:
   /// Cache data for boxed LCP formulation
   Eigen::VectorXi mOffset;
 
+  /// Whether the contacts use mImpulseResponses
+  bool mIsCachingImpulseResponses;
+
+  /// Impulse responses of the BodyNodes and point masses of the contacts in
+  /// the constrained group being solved
+  ImpulseResponseCache mImpulseResponses;
+
+  /// Constraints of the constrained group being solved that use
+  /// mImpulseResponses, or nullptr for the other constraints
+  std::vector<ConstraintBase*> mCachedConstraintsOfGroup;
+
+  /// Corpus the captured LCPs are written to. nullptr when not capturing.
+  std::unique_ptr<BoxedLcpCorpusWriter> mLcpCorpusWriter;
+
+  /// LCPs that take at least this many seconds to solve are captured
+  double mCaptureSlowSolveTime;
+
+  /// Whether LCPs that the primary solver fails to solve are captured
+  bool mCaptureFallbacks;
+
+  /// Copy of the LCP being solved, taken before the solvers modify it
+  BoxedLcpProblem mCapturedLcp;
+
+  /// Time budget of a step in seconds
+  double mMaxSolveTime;
+
+  /// Iteration budget of a step
+  std::size_t mMaxNumSolveIterations;
+
+  /// Start of the current step
+  std::chrono::steady_clock::time_point mSolveStart;
+
+  /// Time point at which the time budget of the current step runs out
+  std::chrono::steady_clock::time_point mSolveDeadline;
+
+  /// Work and accuracy of the LCPs solved in the current or last step
+  SolveReport mSolveReport;
+
 #ifndef NDEBUG
 private:
   /// Return true if the matrix is symmetric
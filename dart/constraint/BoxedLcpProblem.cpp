@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/constraint/BoxedLcpProblem.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "dart/external/odelcpsolver/common.h"
+
+#include "dart/common/Console.hpp"
+#include "dart/constraint/BoxedLcpSolver.hpp"
+
+namespace dart {
+namespace constraint {
+
+namespace {
+
+constexpr char kMagic[8] = {'D', 'A', 'R', 'T', 'L', 'C', 'P', '1'};
+
+constexpr std::uint8_t kFallbackFlag = 1u;
+
+using RowMajorMatrixXd
+    = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+//==============================================================================
+template <typename T>
+void writeValue(std::ostream& stream, const T& value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//==============================================================================
+template <typename T>
+bool readValue(std::istream& stream, T& value)
+{
+  return static_cast<bool>(
+      stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+//==============================================================================
+template <typename Derived>
+void writeArray(std::ostream& stream, const Eigen::DenseBase<Derived>& array)
+{
+  stream.write(
+      reinterpret_cast<const char*>(array.derived().data()),
+      static_cast<std::streamsize>(
+          array.size() * sizeof(typename Derived::Scalar)));
+}
+
+//==============================================================================
+template <typename Derived>
+bool readArray(std::istream& stream, Eigen::DenseBase<Derived>& array)
+{
+  return static_cast<bool>(stream.read(
+      reinterpret_cast<char*>(array.derived().data()),
+      static_cast<std::streamsize>(
+          array.size() * sizeof(typename Derived::Scalar))));
+}
+
+} // namespace
+
+//==============================================================================
+int BoxedLcpProblem::getDimension() const
+{
+  return static_cast<int>(b.size());
+}
+
+//==============================================================================
+bool BoxedLcpProblem::solve(
+    BoxedLcpSolver& solver,
+    Eigen::VectorXd& solution,
+    bool earlyTermination) const
+{
+  const int n = getDimension();
+  if (0 == n)
+  {
+    solution.resize(0);
+    return true;
+  }
+
+  // The solvers modify their inputs and expect the rows of A to be padded
+  RowMajorMatrixXd A = RowMajorMatrixXd::Zero(n, dPAD(n));
+  A.leftCols(n) = this->A;
+  solution = x;
+  Eigen::VectorXd bCopy = b;
+  Eigen::VectorXd loCopy = lo;
+  Eigen::VectorXd hiCopy = hi;
+  Eigen::VectorXi findexCopy = findex;
+
+  return solver.solve(
+      n,
+      A.data(),
+      solution.data(),
+      bCopy.data(),
+      0,
+      loCopy.data(),
+      hiCopy.data(),
+      findexCopy.data(),
+      earlyTermination);
+}
+
+//==============================================================================
+double BoxedLcpProblem::computeResidual(const Eigen::VectorXd& solution) const
+{
+  const int n = getDimension();
+  if (solution.size() != n || solution.hasNaN())
+    return std::numeric_limits<double>::infinity();
+
+  // w = A * x - b is the slack of A * x = b + w
+  const Eigen::VectorXd w = A * solution - b;
+
+  double residual = 0.0;
+  for (int i = 0; i < n; ++i)
+  {
+    double lower = lo[i];
+    double upper = hi[i];
+    if (findex[i] >= 0)
+    {
+      upper = std::abs(hi[i] * solution[findex[i]]);
+      lower = -upper;
+    }
+
+    // Natural residual, x - clamp(x - w, lo, hi), which vanishes if and only
+    // if x and w satisfy one of the boxed complementarity conditions
+    const double projected
+        = std::min(std::max(solution[i] - w[i], lower), upper);
+    residual = std::max(residual, std::abs(solution[i] - projected));
+  }
+
+  return residual;
+}
+
+//==============================================================================
+BoxedLcpCorpusWriter::BoxedLcpCorpusWriter() : mNumProblems(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+BoxedLcpCorpusWriter::~BoxedLcpCorpusWriter()
+{
+  close();
+}
+
+//==============================================================================
+bool BoxedLcpCorpusWriter::open(const std::string& path)
+{
+  close();
+
+  mStream.open(path, std::ios::binary | std::ios::trunc);
+  if (!mStream.is_open())
+  {
+    dtwarn << "[BoxedLcpCorpusWriter::open] Failed to open '" << path
+           << "' for writing.\n";
+    return false;
+  }
+
+  mStream.write(kMagic, sizeof(kMagic));
+  mNumProblems = 0u;
+
+  return true;
+}
+
+//==============================================================================
+void BoxedLcpCorpusWriter::write(const BoxedLcpProblem& problem)
+{
+  if (!mStream.is_open())
+  {
+    dtwarn << "[BoxedLcpCorpusWriter::write] Attempting to write to a corpus "
+           << "that is not open. Ignoring this request.\n";
+    return;
+  }
+
+  const int n = problem.getDimension();
+  assert(problem.A.rows() == n && problem.A.cols() == n);
+  assert(problem.x.size() == n && problem.lo.size() == n);
+  assert(problem.hi.size() == n && problem.findex.size() == n);
+
+  writeValue(mStream, static_cast<std::uint32_t>(n));
+  writeValue(
+      mStream,
+      static_cast<std::uint8_t>(problem.isFallback ? kFallbackFlag : 0u));
+  writeValue(mStream, problem.solveTime);
+
+  // A is written row by row regardless of its storage order
+  const RowMajorMatrixXd A = problem.A;
+  writeArray(mStream, A);
+  writeArray(mStream, problem.x);
+  writeArray(mStream, problem.b);
+  writeArray(mStream, problem.lo);
+  writeArray(mStream, problem.hi);
+
+  const Eigen::Matrix<std::int32_t, Eigen::Dynamic, 1> findex
+      = problem.findex.cast<std::int32_t>();
+  writeArray(mStream, findex);
+
+  ++mNumProblems;
+}
+
+//==============================================================================
+void BoxedLcpCorpusWriter::close()
+{
+  if (mStream.is_open())
+    mStream.close();
+}
+
+//==============================================================================
+bool BoxedLcpCorpusWriter::isOpen() const
+{
+  return mStream.is_open();
+}
+
+//==============================================================================
+std::size_t BoxedLcpCorpusWriter::getNumProblems() const
+{
+  return mNumProblems;
+}
+
+//==============================================================================
+std::vector<BoxedLcpProblem> readBoxedLcpCorpus(const std::string& path)
+{
+  std::vector<BoxedLcpProblem> problems;
+
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream.is_open())
+  {
+    dtwarn << "[readBoxedLcpCorpus] Failed to open '" << path << "'.\n";
+    return problems;
+  }
+
+  char magic[sizeof(kMagic)];
+  if (!stream.read(magic, sizeof(magic))
+      || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+  {
+    dtwarn << "[readBoxedLcpCorpus] '" << path << "' is not an LCP corpus.\n";
+    return problems;
+  }
+
+  std::uint32_t n;
+  while (readValue(stream, n))
+  {
+    BoxedLcpProblem problem;
+    std::uint8_t flags = 0u;
+    RowMajorMatrixXd A(n, n);
+    Eigen::Matrix<std::int32_t, Eigen::Dynamic, 1> findex(n);
+    problem.x.resize(n);
+    problem.b.resize(n);
+    problem.lo.resize(n);
+    problem.hi.resize(n);
+
+    const bool success = readValue(stream, flags)
+                         && readValue(stream, problem.solveTime)
+                         && readArray(stream, A) && readArray(stream, problem.x)
+                         && readArray(stream, problem.b)
+                         && readArray(stream, problem.lo)
+                         && readArray(stream, problem.hi)
+                         && readArray(stream, findex);
+    if (!success)
+    {
+      dtwarn << "[readBoxedLcpCorpus] '" << path << "' is truncated after "
+             << problems.size() << " problems. Ignoring the rest.\n";
+      break;
+    }
+
+    problem.A = A;
+    problem.findex = findex.cast<int>();
+    problem.isFallback = (flags & kFallbackFlag) != 0u;
+    problems.push_back(std::move(problem));
+  }
+
+  return problems;
+}
+
+} // namespace constraint
+} // namespace dart
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_CONSTRAINT_BOXEDLCPPROBLEM_HPP_
+#define DART_CONSTRAINT_BOXEDLCPPROBLEM_HPP_
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace dart {
+namespace constraint {
+
+class BoxedLcpSolver;
+
+/// BoxedLcpProblem is a self-contained copy of a boxed LCP as it was passed to
+/// a BoxedLcpSolver, so that it can be stored and solved again outside of the
+/// simulation that produced it.
+///
+/// The terms follow the convention of BoxedLcpSolver::solve() except that A is
+/// stored as a dense n x n matrix without the row padding the solvers expect.
+struct BoxedLcpProblem
+{
+  /// A term of the LCP formulation
+  Eigen::MatrixXd A;
+
+  /// Initial guess of x
+  Eigen::VectorXd x;
+
+  /// b term of the LCP formulation
+  Eigen::VectorXd b;
+
+  /// Lower bound of x
+  Eigen::VectorXd lo;
+
+  /// Upper bound of x
+  Eigen::VectorXd hi;
+
+  /// Indices to corresponding normal contact constraints, or -1
+  Eigen::VectorXi findex;
+
+  /// Time in seconds the problem took to solve when it was captured
+  double solveTime = 0.0;
+
+  /// Whether the primary solver failed on this problem when it was captured
+  bool isFallback = false;
+
+  /// Returns the dimension of the problem
+  int getDimension() const;
+
+  /// Solves a copy of this problem, leaving the problem itself untouched.
+  ///
+  /// \param[in] solver The solver to use.
+  /// \param[out] solution The solution found by the solver.
+  /// \param[in] earlyTermination See BoxedLcpSolver::solve().
+  /// \return Success reported by the solver.
+  bool solve(
+      BoxedLcpSolver& solver,
+      Eigen::VectorXd& solution,
+      bool earlyTermination = false) const;
+
+  /// Returns the largest violation of the boxed complementarity conditions by
+  /// the given solution, which is zero for an exact solution. Friction bounds
+  /// are scaled by the solution of the corresponding normal constraints.
+  double computeResidual(const Eigen::VectorXd& solution) const;
+};
+
+/// BoxedLcpCorpusWriter appends BoxedLcpProblems to a compact binary file,
+/// which can be read back with readBoxedLcpCorpus().
+class BoxedLcpCorpusWriter
+{
+public:
+  /// Default constructor
+  BoxedLcpCorpusWriter();
+
+  /// Destructor. Closes the file if it is still open.
+  ~BoxedLcpCorpusWriter();
+
+  /// Open a corpus file for writing, discarding its previous content. Returns
+  /// false if the file can't be opened.
+  bool open(const std::string& path);
+
+  /// Append a problem to the corpus
+  void write(const BoxedLcpProblem& problem);
+
+  /// Flush and close the file
+  void close();
+
+  /// Return true if a file is open for writing
+  bool isOpen() const;
+
+  /// Return the number of problems written since the file was opened
+  std::size_t getNumProblems() const;
+
+private:
+  /// Output file
+  std::ofstream mStream;
+
+  /// Number of problems written since the file was opened
+  std::size_t mNumProblems;
+};
+
+/// Read all the problems stored in a corpus file written by
+/// BoxedLcpCorpusWriter. A truncated last problem, as left by a simulation
+/// that crashed while capturing, is skipped with a warning.
+std::vector<BoxedLcpProblem> readBoxedLcpCorpus(const std::string& path);
+
+} // namespace constraint
+} // namespace dart
+
+#endif // DART_CONSTRAINT_BOXEDLCPPROBLEM_HPP_
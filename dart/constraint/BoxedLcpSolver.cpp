@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/constraint/BoxedLcpSolver.hpp"
+
+#include <limits>
+
+namespace dart {
+namespace constraint {
+
+//==============================================================================
+BoxedLcpSolver::BoxedLcpSolver()
+  : mMaxNumBudgetIterations(std::numeric_limits<int>::max()),
+    mBudgetDeadline(std::chrono::steady_clock::time_point::max()),
+    mIsInterrupted(false)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void BoxedLcpSolver::reserve(int /*n*/)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void BoxedLcpSolver::setBudget(
+    int maxNumIterations, const std::chrono::steady_clock::time_point& deadline)
+{
+  mMaxNumBudgetIterations = maxNumIterations;
+  mBudgetDeadline = deadline;
+}
+
+//==============================================================================
+void BoxedLcpSolver::clearBudget()
+{
+  mMaxNumBudgetIterations = std::numeric_limits<int>::max();
+  mBudgetDeadline = std::chrono::steady_clock::time_point::max();
+}
+
+//==============================================================================
+bool BoxedLcpSolver::isInterruptible() const
+{
+  return false;
+}
+
+//==============================================================================
+int BoxedLcpSolver::getNumIterations() const
+{
+  return 0;
+}
+
+//==============================================================================
+bool BoxedLcpSolver::isInterrupted() const
+{
+  return mIsInterrupted;
+}
+
+//==============================================================================
+bool BoxedLcpSolver::checkBudget(int numIterations)
+{
+  // Reading the clock is skipped without a deadline
+  mIsInterrupted
+      = numIterations > 0
+        && (numIterations >= mMaxNumBudgetIterations
+            || (mBudgetDeadline != std::chrono::steady_clock::time_point::max()
+                && std::chrono::steady_clock::now() >= mBudgetDeadline));
+
+  return mIsInterrupted;
+}
+
+} // namespace constraint
+} // namespace dart
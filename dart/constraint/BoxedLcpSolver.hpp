@@ -33,6 +33,7 @@
 #ifndef DART_CONSTRAINT_BOXEDLCPSOLVER_HPP_
 #define DART_CONSTRAINT_BOXEDLCPSOLVER_HPP_
 
+#include <chrono>
 #include <string>
 #include <Eigen/Core>
 
@@ -101,9 +102,59 @@ public:
       bool earlyTermination = false)
       = 0;
 
+  /// Allocates the memory that solve() needs for problems of up to \c n
+  /// dimensions, so that solving them doesn't allocate memory. The default
+  /// implementation does nothing, so solvers that don't override this may
+  /// allocate memory in solve().
+  virtual void reserve(int n);
+
+  /// Limits the work of the following calls of solve(). Interruptible solvers
+  /// stop once they have run \c maxNumIterations iterations or the steady
+  /// clock has passed \c deadline, whichever comes first, and leave their
+  /// best iterate in x. solve() then returns false and isInterrupted() returns
+  /// true. The other solvers run to completion regardless.
+  void setBudget(
+      int maxNumIterations,
+      const std::chrono::steady_clock::time_point& deadline);
+
+  /// Removes the limit set by setBudget()
+  void clearBudget();
+
+  /// Returns true if solve() can be stopped by the budget set by setBudget().
+  /// The default implementation returns false.
+  virtual bool isInterruptible() const;
+
+  /// Returns the number of iterations of the last call of solve(). The default
+  /// implementation returns zero for solvers that don't iterate.
+  virtual int getNumIterations() const;
+
+  /// Returns true if the last call of solve() stopped because its budget ran
+  /// out before it converged
+  bool isInterrupted() const;
+
 #ifndef NDEBUG
   virtual bool canSolve(int n, const double* A) = 0;
 #endif
+
+protected:
+  /// Constructor
+  BoxedLcpSolver();
+
+  /// Returns true if the budget doesn't allow another iteration after
+  /// \c numIterations iterations, and marks the solve as interrupted if so.
+  /// A solve is never stopped before its first iteration. Interruptible
+  /// solvers call this before each iteration, and reset mIsInterrupted at the
+  /// start of solve().
+  bool checkBudget(int numIterations);
+
+  /// Maximum number of iterations of solve()
+  int mMaxNumBudgetIterations;
+
+  /// Time point at which solve() stops iterating
+  std::chrono::steady_clock::time_point mBudgetDeadline;
+
+  /// Whether the last call of solve() stopped because its budget ran out
+  bool mIsInterrupted;
 };
 
 } // namespace constraint
@@ -32,6 +32,9 @@
 
 #include "dart/constraint/ConstraintBase.hpp"
 
+#include <cassert>
+
+#include "dart/common/Console.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 
 namespace dart {
@@ -43,6 +46,13 @@ ConstraintBase::ConstraintBase() : mDim(0)
   // Do nothing
 }
 
+//==============================================================================
+ConstraintBase::ConstraintBase(const ConstraintParameters& parameters)
+  : mDim(0), mParameters(parameters)
+{
+  // Do nothing
+}
+
 //==============================================================================
 ConstraintBase::~ConstraintBase()
 {
@@ -66,6 +76,55 @@ std::size_t ConstraintBase::getDimension() const
   return mDim;
 }
 
+//==============================================================================
+void ConstraintBase::setParameters(const ConstraintParameters& parameters)
+{
+  if (parameters.isValid())
+    mParameters = parameters;
+  else
+    mParameters = parameters.clamped("ConstraintBase::setParameters");
+}
+
+//==============================================================================
+const ConstraintParameters& ConstraintBase::getParameters() const
+{
+  return mParameters;
+}
+
+//==============================================================================
+bool ConstraintBase::supportsImpulseResponseCache() const
+{
+  return false;
+}
+
+//==============================================================================
+void ConstraintBase::addBodyNodesTo(ImpulseResponseCache& /*cache*/) const
+{
+  dterr << "[ConstraintBase::addBodyNodesTo] This constraint does not "
+        << "support ImpulseResponseCache.\n";
+  assert(false);
+}
+
+//==============================================================================
+void ConstraintBase::applyUnitImpulses(ImpulseResponseCache& /*cache*/) const
+{
+  dterr << "[ConstraintBase::applyUnitImpulses] This constraint does not "
+        << "support ImpulseResponseCache.\n";
+  assert(false);
+}
+
+//==============================================================================
+void ConstraintBase::getVelocityChanges(
+    const ImpulseResponseCache& /*cache*/,
+    double* /*vel*/,
+    int /*nSkip*/,
+    bool /*withCfm*/) const
+{
+  dterr << "[ConstraintBase::getVelocityChanges] This constraint does not "
+        << "support ImpulseResponseCache.\n";
+  assert(false);
+}
+
 //==============================================================================
 void ConstraintBase::uniteSkeletons()
 {
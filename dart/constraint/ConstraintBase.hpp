@@ -35,6 +35,7 @@
 
 #include <cstddef>
 
+#include "dart/constraint/ConstraintParameters.hpp"
 #include "dart/dynamics/SmartPointer.hpp"
 
 namespace dart {
@@ -45,6 +46,8 @@ class Skeleton;
 
 namespace constraint {
 
+class ImpulseResponseCache;
+
 /// ConstraintInfo
 struct ConstraintInfo
 {
@@ -80,6 +83,15 @@ public:
   /// Return dimesion of this constranit
   std::size_t getDimension() const;
 
+  /// Set the error correction and regularization parameters of this
+  /// constraint. Parameters that are out of their valid ranges are clamped
+  /// with a warning.
+  void setParameters(const ConstraintParameters& parameters);
+
+  /// Get the error correction and regularization parameters of this
+  /// constraint
+  const ConstraintParameters& getParameters() const;
+
   /// Update constraint using updated Skeleton's states
   virtual void update() = 0;
 
@@ -104,6 +116,36 @@ public:
   /// Return true if this constraint is active
   virtual bool isActive() const = 0;
 
+  /// Return true if this constraint can run its impulse tests on an
+  /// ImpulseResponseCache instead of the Skeletons. The default is false.
+  virtual bool supportsImpulseResponseCache() const;
+
+  /// Add the reactive BodyNodes and point masses of this constraint to
+  /// \c cache. Called only if supportsImpulseResponseCache() returns true.
+  virtual void addBodyNodesTo(ImpulseResponseCache& cache) const;
+
+  /// Apply unit impulses on all the rows of this constraint to \c cache. This
+  /// is applyUnitImpulse() for all the rows at once, using the impulse
+  /// responses of the cache instead of the Skeletons. Called only if
+  /// supportsImpulseResponseCache() returns true.
+  virtual void applyUnitImpulses(ImpulseResponseCache& cache) const;
+
+  /// Get the velocity changes of the rows of this constraint per unit impulse
+  /// on each row applied to \c cache. This is getVelocityChange() for all the
+  /// applied rows at once. Called only if supportsImpulseResponseCache()
+  /// returns true.
+  ///
+  /// \param[out] vel Row-major matrix whose i-th row holds the velocity
+  /// changes per unit impulse on the i-th applied row.
+  /// \param[in] nSkip Distance between the rows of \c vel.
+  /// \param[in] withCfm Whether to add constraint force mixing, which is for
+  /// the unit impulses of this constraint itself.
+  virtual void getVelocityChanges(
+      const ImpulseResponseCache& cache,
+      double* vel,
+      int nSkip,
+      bool withCfm) const;
+
   ///
   virtual dynamics::SkeletonPtr getRootSkeleton() const = 0;
 
@@ -130,9 +172,15 @@ protected:
   /// Default contructor
   ConstraintBase();
 
+  /// Constructor that starts from the given parameters
+  explicit ConstraintBase(const ConstraintParameters& parameters);
+
 protected:
   /// Dimension of constraint
   std::size_t mDim;
+
+  /// Error correction and regularization parameters of this constraint
+  ConstraintParameters mParameters;
 };
 
 } // namespace constraint
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/constraint/ConstraintParameters.hpp"
+
+#include "dart/common/Console.hpp"
+
+namespace dart {
+namespace constraint {
+
+//==============================================================================
+ConstraintParameters::ConstraintParameters(
+    double errorAllowance,
+    double errorReductionParameter,
+    double maxErrorReductionVelocity,
+    double constraintForceMixing)
+  : errorAllowance(errorAllowance),
+    errorReductionParameter(errorReductionParameter),
+    maxErrorReductionVelocity(maxErrorReductionVelocity),
+    constraintForceMixing(constraintForceMixing)
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool ConstraintParameters::isValid() const
+{
+  return errorAllowance >= 0.0 && errorReductionParameter >= 0.0
+         && errorReductionParameter <= 1.0 && maxErrorReductionVelocity >= 0.0
+         && constraintForceMixing >= 1e-9;
+}
+
+//==============================================================================
+ConstraintParameters ConstraintParameters::clamped(const char* caller) const
+{
+  ConstraintParameters parameters = *this;
+
+  if (errorAllowance < 0.0)
+  {
+    dtwarn << "[" << caller << "] Error allowance[" << errorAllowance
+           << "] is lower than 0.0. It is set to 0.0.\n";
+    parameters.errorAllowance = 0.0;
+  }
+
+  if (errorReductionParameter < 0.0)
+  {
+    dtwarn << "[" << caller << "] Error reduction parameter["
+           << errorReductionParameter
+           << "] is lower than 0.0. It is set to 0.0.\n";
+    parameters.errorReductionParameter = 0.0;
+  }
+  else if (errorReductionParameter > 1.0)
+  {
+    dtwarn << "[" << caller << "] Error reduction parameter["
+           << errorReductionParameter
+           << "] is greater than 1.0. It is set to 1.0.\n";
+    parameters.errorReductionParameter = 1.0;
+  }
+
+  if (maxErrorReductionVelocity < 0.0)
+  {
+    dtwarn << "[" << caller << "] Maximum error reduction velocity["
+           << maxErrorReductionVelocity
+           << "] is lower than 0.0. It is set to 0.0.\n";
+    parameters.maxErrorReductionVelocity = 0.0;
+  }
+
+  if (constraintForceMixing < 1e-9)
+  {
+    dtwarn << "[" << caller << "] Constraint force mixing parameter["
+           << constraintForceMixing
+           << "] is lower than 1e-9. It is set to 1e-9.\n";
+    parameters.constraintForceMixing = 1e-9;
+  }
+
+  return parameters;
+}
+
+} // namespace constraint
+} // namespace dart
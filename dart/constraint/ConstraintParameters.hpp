@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_CONSTRAINT_CONSTRAINTPARAMETERS_HPP_
+#define DART_CONSTRAINT_CONSTRAINTPARAMETERS_HPP_
+
+namespace dart {
+namespace constraint {
+
+/// Error correction and regularization parameters of a constraint. Every
+/// constraint holds its own copy, which ConstraintSolver sets for the
+/// constraints it creates, so that differently tuned worlds don't share any
+/// state. The constraints that don't correct a position error only use
+/// constraintForceMixing.
+struct ConstraintParameters
+{
+  /// Constraint error that is allowed without any correction
+  double errorAllowance;
+
+  /// Fraction of the constraint error in the range of [0, 1] that is corrected
+  /// in a time step
+  double errorReductionParameter;
+
+  /// Maximum velocity of the error correction
+  double maxErrorReductionVelocity;
+
+  /// Constraint force mixing parameter of at least 1e-9, which is
+  /// added to the diagonal of the LCP relative to the diagonal entries
+  /// \sa http://www.ode.org/ode-latest-userguide.html#sec_3_8_0
+  double constraintForceMixing;
+
+  /// Constructor
+  ConstraintParameters(
+      double errorAllowance = 0.0,
+      double errorReductionParameter = 0.01,
+      double maxErrorReductionVelocity = 1e-3,
+      double constraintForceMixing = 1e-5);
+
+  /// Returns true if all the parameters are in their valid ranges
+  bool isValid() const;
+
+  /// Returns these parameters clamped to their valid ranges. Each parameter
+  /// that is out of its range is reported in a warning on behalf of
+  /// \c caller.
+  ConstraintParameters clamped(const char* caller) const;
+};
+
+} // namespace constraint
+} // namespace dart
+
+#endif // DART_CONSTRAINT_CONSTRAINTPARAMETERS_HPP_
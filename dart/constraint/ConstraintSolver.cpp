@@ -32,6 +32,9 @@
 
 #include "dart/constraint/ConstraintSolver.hpp"
 
+#include <algorithm>
+#include <array>
+
 #include "dart/collision/CollisionFilter.hpp"
 #include "dart/collision/CollisionGroup.hpp"
 #include "dart/collision/CollisionObject.hpp"
@@ -39,6 +42,7 @@
 #include "dart/collision/dart/DARTCollisionDetector.hpp"
 #include "dart/collision/fcl/FCLCollisionDetector.hpp"
 #include "dart/common/Console.hpp"
+#include "dart/common/Profiler.hpp"
 #include "dart/constraint/ConstrainedGroup.hpp"
 #include "dart/constraint/ContactConstraint.hpp"
 #include "dart/constraint/JointCoulombFrictionConstraint.hpp"
@@ -57,13 +61,67 @@ namespace constraint {
 
 using namespace dynamics;
 
+namespace {
+
+/// Size of the MemoryPool blocks of the automatically created constraints.
+/// std::allocate_shared() stores the reference counts of the shared_ptr and a
+/// copy of the allocator together with the constraint, hence the margin.
+constexpr std::size_t constraintBlockSize
+    = std::max(
+          {sizeof(ContactConstraint),
+           sizeof(SoftContactConstraint),
+           sizeof(JointLimitConstraint),
+           sizeof(ServoMotorConstraint),
+           sizeof(MimicMotorConstraint),
+           sizeof(JointCoulombFrictionConstraint)})
+      + 64u;
+
+/// Maximum number of constraints that are created automatically for a Joint:
+/// Coulomb friction, joint limit, servo motor, and mimic motor
+constexpr std::size_t maxNumConstraintsPerJoint = 4u;
+
+//==============================================================================
+template <typename ConstraintT, typename... Args>
+std::shared_ptr<ConstraintT> allocateConstraint(
+    const std::shared_ptr<common::MemoryPool>& pool, Args&&... args)
+{
+  return std::allocate_shared<ConstraintT>(
+      common::PoolAllocator<ConstraintT>(pool), std::forward<Args>(args)...);
+}
+
+//==============================================================================
+/// Orders the stored contact impulses by their pairs of collision objects
+template <typename ContactImpulseT>
+bool lessCollisionObjects(const ContactImpulseT& a, const ContactImpulseT& b)
+{
+  return std::make_pair(a.collisionObject1, a.collisionObject2)
+         < std::make_pair(b.collisionObject1, b.collisionObject2);
+}
+
+} // namespace
+
 //==============================================================================
 ConstraintSolver::ConstraintSolver(double timeStep)
   : mCollisionDetector(collision::FCLCollisionDetector::create()),
     mCollisionGroup(mCollisionDetector->createCollisionGroupAsSharedPtr()),
     mCollisionOption(collision::CollisionOption(
         true, 1000u, std::make_shared<collision::BodyNodeCollisionFilter>())),
-    mTimeStep(timeStep)
+    mTimeStep(timeStep),
+    mIsDeterministic(false),
+    mIsRealTime(false),
+    mMaxNumConstraintRows(0u),
+    mNumRealTimeOverflows(0u),
+    mIsWarmStarting(false),
+    mMaxWarmStartContactDistance(1e-2),
+    mContactParameters(ContactConstraint::getDefaultParameters()),
+    mSoftContactParameters(SoftContactConstraint::getDefaultParameters()),
+    mJointLimitParameters(JointLimitConstraint::getDefaultParameters()),
+    mServoMotorParameters(ServoMotorConstraint::getDefaultParameters()),
+    mMimicMotorParameters(MimicMotorConstraint::getDefaultParameters()),
+    mJointCoulombFrictionParameters(
+        JointCoulombFrictionConstraint::getDefaultParameters()),
+    mConstraintPool(std::make_shared<common::MemoryPool>(constraintBlockSize)),
+    mNumConstrainedGroups(0u)
 {
   assert(timeStep > 0.0);
 
@@ -82,7 +140,22 @@ ConstraintSolver::ConstraintSolver()
     mCollisionGroup(mCollisionDetector->createCollisionGroupAsSharedPtr()),
     mCollisionOption(collision::CollisionOption(
         true, 1000u, std::make_shared<collision::BodyNodeCollisionFilter>())),
-    mTimeStep(0.001)
+    mTimeStep(0.001),
+    mIsDeterministic(false),
+    mIsRealTime(false),
+    mMaxNumConstraintRows(0u),
+    mNumRealTimeOverflows(0u),
+    mIsWarmStarting(false),
+    mMaxWarmStartContactDistance(1e-2),
+    mContactParameters(ContactConstraint::getDefaultParameters()),
+    mSoftContactParameters(SoftContactConstraint::getDefaultParameters()),
+    mJointLimitParameters(JointLimitConstraint::getDefaultParameters()),
+    mServoMotorParameters(ServoMotorConstraint::getDefaultParameters()),
+    mMimicMotorParameters(MimicMotorConstraint::getDefaultParameters()),
+    mJointCoulombFrictionParameters(
+        JointCoulombFrictionConstraint::getDefaultParameters()),
+    mConstraintPool(std::make_shared<common::MemoryPool>(constraintBlockSize)),
+    mNumConstrainedGroups(0u)
 {
   auto cd = std::static_pointer_cast<collision::FCLCollisionDetector>(
       mCollisionDetector);
@@ -112,6 +185,9 @@ void ConstraintSolver::addSkeleton(const SkeletonPtr& skeleton)
   mCollisionGroup->subscribeTo(skeleton);
   mSkeletons.push_back(skeleton);
   mConstrainedGroups.reserve(mSkeletons.size());
+
+  if (mIsRealTime)
+    reserveRealTimeMemory();
 }
 
 //==============================================================================
@@ -175,6 +251,9 @@ void ConstraintSolver::addConstraint(const ConstraintBasePtr& constraint)
   }
 
   mManualConstraints.push_back(constraint);
+
+  if (mIsRealTime)
+    reserveRealTimeMemory();
 }
 
 //==============================================================================
@@ -242,6 +321,7 @@ std::vector<ConstConstraintBasePtr> ConstraintSolver::getConstraints() const
 void ConstraintSolver::clearLastCollisionResult()
 {
   mCollisionResult.clear();
+  mContactAnchors.clear();
 }
 
 //==============================================================================
@@ -338,6 +418,176 @@ const collision::CollisionResult& ConstraintSolver::getLastCollisionResult()
   return mCollisionResult;
 }
 
+//==============================================================================
+void ConstraintSolver::setDeterministic(bool deterministic)
+{
+  mIsDeterministic = deterministic;
+}
+
+//==============================================================================
+bool ConstraintSolver::isDeterministic() const
+{
+  return mIsDeterministic;
+}
+
+//==============================================================================
+void ConstraintSolver::setWarmStarting(
+    bool warmStarting, double maxContactDistance)
+{
+  mIsWarmStarting = warmStarting;
+  mMaxWarmStartContactDistance = maxContactDistance;
+  mContactImpulses.clear();
+}
+
+//==============================================================================
+bool ConstraintSolver::isWarmStarting() const
+{
+  return mIsWarmStarting;
+}
+
+//==============================================================================
+const std::vector<ConstraintSolver::ContactImpulse>&
+ConstraintSolver::getContactImpulses() const
+{
+  return mContactImpulses;
+}
+
+//==============================================================================
+void ConstraintSolver::setContactImpulses(
+    const std::vector<ContactImpulse>& impulses)
+{
+  assert(std::is_sorted(
+      impulses.begin(),
+      impulses.end(),
+      lessCollisionObjects<ContactImpulse>));
+
+  // Copy into the existing storage, which is reserved for real-time solving
+  mContactImpulses.clear();
+  mContactImpulses.insert(
+      mContactImpulses.end(), impulses.begin(), impulses.end());
+}
+
+//==============================================================================
+void ConstraintSolver::setRealTime(
+    bool realTime, std::size_t maxNumContacts, std::size_t maxNumConstraintRows)
+{
+  mIsRealTime = realTime;
+  mNumRealTimeOverflows = 0u;
+  mConstraintPool->resetNumOverflows();
+  mConstraintPool->setGrowable(!realTime);
+  mCollisionResult.setCollidingObjectsRecorded(!realTime);
+
+  if (!realTime)
+    return;
+
+  mCollisionOption.maxNumContacts = maxNumContacts;
+  mMaxNumConstraintRows = maxNumConstraintRows;
+  reserveRealTimeMemory();
+}
+
+//==============================================================================
+bool ConstraintSolver::isRealTime() const
+{
+  return mIsRealTime;
+}
+
+//==============================================================================
+std::size_t ConstraintSolver::getMaxNumConstraintRows() const
+{
+  return mMaxNumConstraintRows;
+}
+
+//==============================================================================
+std::size_t ConstraintSolver::getNumRealTimeOverflows() const
+{
+  return mNumRealTimeOverflows + mConstraintPool->getNumOverflows();
+}
+
+//==============================================================================
+void ConstraintSolver::setContactParameters(
+    const ConstraintParameters& parameters)
+{
+  mContactParameters
+      = parameters.clamped("ConstraintSolver::setContactParameters");
+}
+
+//==============================================================================
+const ConstraintParameters& ConstraintSolver::getContactParameters() const
+{
+  return mContactParameters;
+}
+
+//==============================================================================
+void ConstraintSolver::setSoftContactParameters(
+    const ConstraintParameters& parameters)
+{
+  mSoftContactParameters
+      = parameters.clamped("ConstraintSolver::setSoftContactParameters");
+}
+
+//==============================================================================
+const ConstraintParameters& ConstraintSolver::getSoftContactParameters() const
+{
+  return mSoftContactParameters;
+}
+
+//==============================================================================
+void ConstraintSolver::setJointLimitParameters(
+    const ConstraintParameters& parameters)
+{
+  mJointLimitParameters
+      = parameters.clamped("ConstraintSolver::setJointLimitParameters");
+}
+
+//==============================================================================
+const ConstraintParameters& ConstraintSolver::getJointLimitParameters() const
+{
+  return mJointLimitParameters;
+}
+
+//==============================================================================
+void ConstraintSolver::setServoMotorParameters(
+    const ConstraintParameters& parameters)
+{
+  mServoMotorParameters
+      = parameters.clamped("ConstraintSolver::setServoMotorParameters");
+}
+
+//==============================================================================
+const ConstraintParameters& ConstraintSolver::getServoMotorParameters() const
+{
+  return mServoMotorParameters;
+}
+
+//==============================================================================
+void ConstraintSolver::setMimicMotorParameters(
+    const ConstraintParameters& parameters)
+{
+  mMimicMotorParameters
+      = parameters.clamped("ConstraintSolver::setMimicMotorParameters");
+}
+
+//==============================================================================
+const ConstraintParameters& ConstraintSolver::getMimicMotorParameters() const
+{
+  return mMimicMotorParameters;
+}
+
+//==============================================================================
+void ConstraintSolver::setJointCoulombFrictionParameters(
+    const ConstraintParameters& parameters)
+{
+  mJointCoulombFrictionParameters = parameters.clamped(
+      "ConstraintSolver::setJointCoulombFrictionParameters");
+}
+
+//==============================================================================
+const ConstraintParameters&
+ConstraintSolver::getJointCoulombFrictionParameters() const
+{
+  return mJointCoulombFrictionParameters;
+}
+
 //==============================================================================
 void ConstraintSolver::setLCPSolver(std::unique_ptr<LCPSolver> /*lcpSolver*/)
 {
@@ -361,6 +611,16 @@ LCPSolver* ConstraintSolver::getLCPSolver() const
 //==============================================================================
 void ConstraintSolver::solve()
 {
+  solve(true);
+}
+
+//==============================================================================
+void ConstraintSolver::solve(bool detectCollision)
+{
+  DART_PROFILE_SCOPE("ConstraintSolver::solve");
+
+  beginSolve();
+
   for (auto& skeleton : mSkeletons)
   {
     skeleton->clearConstraintImpulses();
@@ -370,13 +630,18 @@ void ConstraintSolver::solve()
   }
 
   // Update constraints and collect active constraints
-  updateConstraints();
+  updateConstraints(detectCollision);
 
   // Build constrained groups
   buildConstrainedGroups();
 
   // Solve constrained groups
   solveConstrainedGroups();
+
+  // Store the impulses right away rather than at the start of the next step,
+  // so that they are saved and restored with the state of the World
+  if (mIsWarmStarting)
+    storeContactImpulses();
 }
 
 //==============================================================================
@@ -388,6 +653,24 @@ void ConstraintSolver::setFromOtherConstraintSolver(
 
   addSkeletons(other.getSkeletons());
   mManualConstraints = other.mManualConstraints;
+  mIsDeterministic = other.mIsDeterministic;
+  mContactParameters = other.mContactParameters;
+  mSoftContactParameters = other.mSoftContactParameters;
+  mJointLimitParameters = other.mJointLimitParameters;
+  mServoMotorParameters = other.mServoMotorParameters;
+  mMimicMotorParameters = other.mMimicMotorParameters;
+  mJointCoulombFrictionParameters = other.mJointCoulombFrictionParameters;
+  setWarmStarting(other.mIsWarmStarting, other.mMaxWarmStartContactDistance);
+  setRealTime(
+      other.mIsRealTime,
+      other.mCollisionOption.maxNumContacts,
+      other.mMaxNumConstraintRows);
+}
+
+//==============================================================================
+void ConstraintSolver::beginSolve()
+{
+  // Do nothing
 }
 
 //==============================================================================
@@ -449,37 +732,66 @@ bool ConstraintSolver::checkAndAddConstraint(
 }
 
 //==============================================================================
-void ConstraintSolver::updateConstraints()
+void ConstraintSolver::updateConstraints(bool detectCollision)
 {
+  DART_PROFILE_SCOPE("ConstraintSolver::updateConstraints");
+
   // Clear previous active constraint list
   mActiveConstraints.clear();
+  mActiveCompliantContactConstraints.clear();
+
+  // Destroy the automatic constraints of the previous step before creating the
+  // new ones, so that the new ones reuse their memory. The constrained groups
+  // still refer to them until they are rebuilt.
+  for (auto& constrainedGroup : mConstrainedGroups)
+    constrainedGroup.removeAllConstraints();
+  mContactConstraints.clear();
+  mSoftContactConstraints.clear();
+  mJointLimitConstraints.clear();
+  mServoMotorConstraints.clear();
+  mMimicMotorConstraints.clear();
+  mJointCoulombFrictionConstraints.clear();
 
   //----------------------------------------------------------------------------
-  // Update manual constraints
+  // Update automatic constraints: contact constraints
   //----------------------------------------------------------------------------
-  for (auto& manualConstraint : mManualConstraints)
+  if (detectCollision)
   {
-    manualConstraint->update();
+    DART_PROFILE_SCOPE("ConstraintSolver::detectCollision");
 
-    if (manualConstraint->isActive())
-      mActiveConstraints.push_back(manualConstraint);
-  }
+    mCollisionResult.clear();
 
-  //----------------------------------------------------------------------------
-  // Update automatic constraints: contact constraints
-  //----------------------------------------------------------------------------
-  mCollisionResult.clear();
+    mCollisionGroup->collide(mCollisionOption, &mCollisionResult);
 
-  mCollisionGroup->collide(mCollisionOption, &mCollisionResult);
+    // Pairs of sleeping Skeletons are skipped by the collision filter, so the
+    // result lacks the other contacts of the Skeletons woken up here. Only
+    // those contacts are detected again, which may wake up more Skeletons.
+    std::size_t numVisitedContacts = 0u;
+    while (wakeUpTouchedSkeletons(numVisitedContacts))
+    {
+      numVisitedContacts = mCollisionResult.getNumContacts();
+      collideWokenSkeletons();
+    }
 
-  // Destroy previous contact constraints
-  mContactConstraints.clear();
+    // The collision detector stops at the maximum number of contacts, so
+    // reaching it means that contacts may have been dropped
+    if (mIsRealTime
+        && mCollisionResult.getNumContacts() >= mCollisionOption.maxNumContacts)
+    {
+      ++mNumRealTimeOverflows;
+    }
 
-  // Destroy previous soft contact constraints
-  mSoftContactConstraints.clear();
+    storeContactAnchors();
+  }
+  else
+  {
+    updateContactDepths();
+  }
+
+  updateContactOrder();
 
   // Create new contact constraints
-  for (auto i = 0u; i < mCollisionResult.getNumContacts(); ++i)
+  for (const auto i : mContactOrder)
   {
     auto& contact = mCollisionResult.getContact(i);
 
@@ -511,21 +823,75 @@ void ConstraintSolver::updateConstraints()
     if (isSoftContact(contact))
     {
       mSoftContactConstraints.push_back(
-          std::make_shared<SoftContactConstraint>(contact, mTimeStep));
+          allocateConstraint<SoftContactConstraint>(
+              mConstraintPool, contact, mTimeStep));
+      mSoftContactConstraints.back()->setParameters(mSoftContactParameters);
     }
     else
     {
-      mContactConstraints.push_back(
-          std::make_shared<ContactConstraint>(contact, mTimeStep));
+      mContactConstraints.push_back(allocateConstraint<ContactConstraint>(
+          mConstraintPool, contact, mTimeStep));
+      mContactConstraints.back()->setParameters(mContactParameters);
     }
   }
 
-  // Add the new contact constraints to dynamic constraint list
+  // The contact points between a pair of compliant shapes share the stiffness
+  // and damping of the shapes, so that their total force doesn't depend on
+  // how many points the collision detector reports. The collision detectors
+  // report the contacts of a pair of shapes one after another, and so does
+  // the deterministic order.
+  for (auto first = mContactConstraints.begin();
+       first != mContactConstraints.end();)
+  {
+    const collision::Contact& contact = (*first)->mContact;
+    const auto last = std::find_if(
+        first + 1,
+        mContactConstraints.end(),
+        [&](const ContactConstraintPtr& other) {
+          return other->mContact.collisionObject1 != contact.collisionObject1
+                 || other->mContact.collisionObject2
+                        != contact.collisionObject2;
+        });
+
+    if ((*first)->isCompliant() && last - first > 1)
+    {
+      for (auto it = first; it != last; ++it)
+        (*it)->shareCompliance(static_cast<std::size_t>(last - first));
+    }
+
+    first = last;
+  }
+
+  if (mIsWarmStarting)
+    warmStartContactConstraints();
+
   for (const auto& contactConstraint : mContactConstraints)
   {
     contactConstraint->update();
 
-    if (contactConstraint->isActive())
+    if (contactConstraint->isActive() && contactConstraint->isCompliant())
+      mActiveCompliantContactConstraints.push_back(contactConstraint);
+  }
+
+  // The other constraints read the velocities of the Skeletons when they are
+  // updated, so the compliant contacts are solved before that
+  solveCompliantContacts();
+
+  //----------------------------------------------------------------------------
+  // Update manual constraints
+  //----------------------------------------------------------------------------
+  for (auto& manualConstraint : mManualConstraints)
+  {
+    manualConstraint->update();
+
+    if (manualConstraint->isActive())
+      mActiveConstraints.push_back(manualConstraint);
+  }
+
+  // Add the new contact constraints to dynamic constraint list
+  for (const auto& contactConstraint : mContactConstraints)
+  {
+    if (contactConstraint->isActive() && !contactConstraint->isCompliant())
       mActiveConstraints.push_back(contactConstraint);
   }
 
@@ -541,15 +907,14 @@ void ConstraintSolver::updateConstraints()
   //----------------------------------------------------------------------------
   // Update automatic constraints: joint constraints
   //----------------------------------------------------------------------------
-  // Destroy previous joint constraints
-  mJointLimitConstraints.clear();
-  mServoMotorConstraints.clear();
-  mMimicMotorConstraints.clear();
-  mJointCoulombFrictionConstraints.clear();
-
   // Create new joint constraints
   for (const auto& skel : mSkeletons)
   {
+    // Sleeping Skeletons don't move, so their joint constraints can't be
+    // violated
+    if (skel->isSleeping())
+      continue;
+
     const std::size_t numJoints = skel->getNumJoints();
     for (std::size_t i = 0; i < numJoints; i++)
     {
@@ -564,7 +929,10 @@ void ConstraintSolver::updateConstraints()
         if (joint->getCoulombFriction(j) != 0.0)
         {
           mJointCoulombFrictionConstraints.push_back(
-              std::make_shared<JointCoulombFrictionConstraint>(joint));
+              allocateConstraint<JointCoulombFrictionConstraint>(
+                  mConstraintPool, joint));
+          mJointCoulombFrictionConstraints.back()->setParameters(
+              mJointCoulombFrictionParameters);
           break;
         }
       }
@@ -572,23 +940,28 @@ void ConstraintSolver::updateConstraints()
       if (joint->areLimitsEnforced())
       {
         mJointLimitConstraints.push_back(
-            std::make_shared<JointLimitConstraint>(joint));
+            allocateConstraint<JointLimitConstraint>(mConstraintPool, joint));
+        mJointLimitConstraints.back()->setParameters(mJointLimitParameters);
       }
 
       if (joint->getActuatorType() == dynamics::Joint::SERVO)
       {
         mServoMotorConstraints.push_back(
-            std::make_shared<ServoMotorConstraint>(joint));
+            allocateConstraint<ServoMotorConstraint>(mConstraintPool, joint));
+        mServoMotorConstraints.back()->setParameters(mServoMotorParameters);
       }
 
       if (joint->getActuatorType() == dynamics::Joint::MIMIC
           && joint->getMimicJoint())
       {
-        mMimicMotorConstraints.push_back(std::make_shared<MimicMotorConstraint>(
-            joint,
-            joint->getMimicJoint(),
-            joint->getMimicMultiplier(),
-            joint->getMimicOffset()));
+        mMimicMotorConstraints.push_back(
+            allocateConstraint<MimicMotorConstraint>(
+                mConstraintPool,
+                joint,
+                joint->getMimicJoint(),
+                joint->getMimicMultiplier(),
+                joint->getMimicOffset()));
+        mMimicMotorConstraints.back()->setParameters(mMimicMotorParameters);
       }
     }
   }
@@ -627,33 +1000,339 @@ void ConstraintSolver::updateConstraints()
   }
 }
 
+//==============================================================================
+bool ConstraintSolver::wakeUpTouchedSkeletons(std::size_t firstContact)
+{
+  bool woken = false;
+
+  for (auto i = firstContact; i < mCollisionResult.getNumContacts(); ++i)
+  {
+    const auto& contact = mCollisionResult.getContact(i);
+
+    auto shapeNode1 = const_cast<dynamics::ShapeFrame*>(
+                          contact.collisionObject1->getShapeFrame())
+                          ->asShapeNode();
+    auto shapeNode2 = const_cast<dynamics::ShapeFrame*>(
+                          contact.collisionObject2->getShapeFrame())
+                          ->asShapeNode();
+    if (!shapeNode1 || !shapeNode2)
+      continue;
+
+    const auto skel1 = shapeNode1->getSkeleton();
+    const auto skel2 = shapeNode2->getSkeleton();
+
+    // An immobile Skeleton is awake while it is moved by the user, so it wakes
+    // up the mobile Skeletons that it pushes
+    if (!skel1->isSleeping() && skel2->isSleeping() && skel2->isMobile())
+    {
+      wakeUp(skel2.get());
+      woken = true;
+    }
+    else if (!skel2->isSleeping() && skel1->isSleeping() && skel1->isMobile())
+    {
+      wakeUp(skel1.get());
+      woken = true;
+    }
+  }
+
+  return woken;
+}
+
+//==============================================================================
+void ConstraintSolver::wakeUp(dynamics::Skeleton* skeleton)
+{
+  skeleton->setSleeping(false);
+  mWokenSkeletons.push_back(skeleton);
+}
+
+//==============================================================================
+void ConstraintSolver::collideWokenSkeletons()
+{
+  // Pairs of Skeletons that are still sleeping are skipped by the collision
+  // filter, so this only detects the contacts of the woken Skeletons
+  auto group = mCollisionDetector->createCollisionGroup();
+  for (auto* skeleton : mWokenSkeletons)
+    group->addShapeFramesOf(skeleton);
+  for (const auto& skeleton : mSkeletons)
+  {
+    if (skeleton->isSleeping())
+      group->addShapeFramesOf(skeleton.get());
+  }
+  mWokenSkeletons.clear();
+
+  collision::CollisionResult result;
+  result.setCollidingObjectsRecorded(false);
+  group->collide(mCollisionOption, &result);
+
+  for (const auto& contact : result.getContacts())
+  {
+    if (mCollisionResult.getNumContacts() >= mCollisionOption.maxNumContacts)
+      break;
+
+    mCollisionResult.addContact(contact);
+  }
+}
+
+//==============================================================================
+void ConstraintSolver::storeContactAnchors()
+{
+  const auto numContacts = mCollisionResult.getNumContacts();
+
+  mContactAnchors.resize(numContacts);
+  for (auto i = 0u; i < numContacts; ++i)
+  {
+    const auto& contact = mCollisionResult.getContact(i);
+    const auto* shapeFrame1 = contact.collisionObject1->getShapeFrame();
+    const auto* shapeFrame2 = contact.collisionObject2->getShapeFrame();
+
+    auto& anchor = mContactAnchors[i];
+    anchor.localPoint1
+        = shapeFrame1->getWorldTransform().inverse() * contact.point;
+    anchor.localPoint2
+        = shapeFrame2->getWorldTransform().inverse() * contact.point;
+    anchor.penetrationDepth = contact.penetrationDepth;
+  }
+}
+
+//==============================================================================
+void ConstraintSolver::updateContactDepths()
+{
+  const auto numContacts = mCollisionResult.getNumContacts();
+
+  // The last collision result was replaced since the anchors were stored
+  if (mContactAnchors.size() != numContacts)
+    return;
+
+  for (auto i = 0u; i < numContacts; ++i)
+  {
+    auto& contact = mCollisionResult.getContact(i);
+    const auto& anchor = mContactAnchors[i];
+
+    const Eigen::Vector3d point1
+        = contact.collisionObject1->getShapeFrame()->getWorldTransform()
+          * anchor.localPoint1;
+    const Eigen::Vector3d point2
+        = contact.collisionObject2->getShapeFrame()->getWorldTransform()
+          * anchor.localPoint2;
+
+    // The normal points from the second object to the first one, so moving
+    // the first object along the normal separates them
+    contact.point = 0.5 * (point1 + point2);
+    contact.penetrationDepth
+        = anchor.penetrationDepth - contact.normal.dot(point1 - point2);
+  }
+}
+
+//==============================================================================
+void ConstraintSolver::updateContactOrder()
+{
+  const auto numContacts = mCollisionResult.getNumContacts();
+
+  mContactOrder.resize(numContacts);
+  for (auto i = 0u; i < numContacts; ++i)
+    mContactOrder[i] = i;
+
+  if (!mIsDeterministic || numContacts < 2u)
+    return;
+
+  // Identify each colliding ShapeNode by indices that don't depend on memory
+  // addresses: the index of its Skeleton in this solver, the index of its
+  // BodyNode in the Skeleton, and its index in the BodyNode.
+  mSkeletonIndices.clear();
+  for (auto i = 0u; i < mSkeletons.size(); ++i)
+    mSkeletonIndices.emplace_back(mSkeletons[i].get(), i);
+  std::sort(mSkeletonIndices.begin(), mSkeletonIndices.end());
+
+  using ShapeKey = std::array<std::size_t, 3>;
+  const auto getShapeKey
+      = [&](const collision::CollisionObject* object) -> ShapeKey {
+    const auto* shapeNode = object->getShapeFrame()->asShapeNode();
+    if (!shapeNode)
+      return {{mSkeletons.size(), 0u, 0u}};
+
+    const auto* bodyNode = shapeNode->getBodyNodePtr().get();
+    const auto* skeleton = bodyNode->getSkeleton().get();
+    const auto result = std::lower_bound(
+        mSkeletonIndices.begin(),
+        mSkeletonIndices.end(),
+        std::make_pair(skeleton, std::size_t(0u)));
+    const bool found
+        = result != mSkeletonIndices.end() && result->first == skeleton;
+    return {{found ? result->second : mSkeletons.size(),
+             bodyNode->getIndexInSkeleton(),
+             shapeNode->getIndexInBodyNode()}};
+  };
+
+  mContactShapeKeys.resize(numContacts);
+  for (auto i = 0u; i < numContacts; ++i)
+  {
+    const auto& contact = mCollisionResult.getContact(i);
+    mContactShapeKeys[i][0] = getShapeKey(contact.collisionObject1);
+    mContactShapeKeys[i][1] = getShapeKey(contact.collisionObject2);
+  }
+
+  const auto lexicographicLess
+      = [](const Eigen::Vector3d& a, const Eigen::Vector3d& b) {
+          return std::lexicographical_compare(
+              a.data(), a.data() + 3, b.data(), b.data() + 3);
+        };
+
+  // Ties are broken by the contact geometry, which is deterministic for a
+  // given pair of shapes regardless of the order the pairs were checked in,
+  // and finally by the order of the collision detector. That makes the order
+  // total, so std::sort() sorts stably without the temporary buffer that
+  // std::stable_sort() allocates.
+  std::sort(
+      mContactOrder.begin(),
+      mContactOrder.end(),
+      [&](std::size_t i, std::size_t j) {
+        const auto& shapeKeysI = mContactShapeKeys[i];
+        const auto& shapeKeysJ = mContactShapeKeys[j];
+        if (shapeKeysI != shapeKeysJ)
+          return shapeKeysI < shapeKeysJ;
+
+        const auto& contactI = mCollisionResult.getContact(i);
+        const auto& contactJ = mCollisionResult.getContact(j);
+
+        if (contactI.point != contactJ.point)
+          return lexicographicLess(contactI.point, contactJ.point);
+
+        if (contactI.normal != contactJ.normal)
+          return lexicographicLess(contactI.normal, contactJ.normal);
+
+        if (contactI.penetrationDepth != contactJ.penetrationDepth)
+          return contactI.penetrationDepth < contactJ.penetrationDepth;
+
+        return i < j;
+      });
+}
+
+//==============================================================================
+void ConstraintSolver::storeContactImpulses()
+{
+  mContactImpulses.clear();
+  for (const auto& contactConstraint : mContactConstraints)
+  {
+    const collision::Contact& contact = contactConstraint->mContact;
+    mContactImpulses.push_back(
+        {contact.collisionObject1,
+         contact.collisionObject2,
+         contact.point,
+         contact.force * contactConstraint->mTimeStep});
+  }
+
+  std::sort(
+      mContactImpulses.begin(),
+      mContactImpulses.end(),
+      lessCollisionObjects<ContactImpulse>);
+}
+
+//==============================================================================
+void ConstraintSolver::warmStartContactConstraints()
+{
+  const double maxSquaredDistance
+      = mMaxWarmStartContactDistance * mMaxWarmStartContactDistance;
+
+  for (const auto& contactConstraint : mContactConstraints)
+  {
+    const collision::Contact& contact = contactConstraint->mContact;
+    const ContactImpulse key{contact.collisionObject1,
+                             contact.collisionObject2,
+                             contact.point,
+                             Eigen::Vector3d::Zero()};
+    const auto range = std::equal_range(
+        mContactImpulses.begin(),
+        mContactImpulses.end(),
+        key,
+        lessCollisionObjects<ContactImpulse>);
+
+    // Take the impulse of the closest contact of the same pair
+    const ContactImpulse* closest = nullptr;
+    double closestSquaredDistance = maxSquaredDistance;
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      const double squaredDistance = (it->point - contact.point).squaredNorm();
+      if (squaredDistance <= closestSquaredDistance)
+      {
+        closest = &*it;
+        closestSquaredDistance = squaredDistance;
+      }
+    }
+
+    if (closest)
+      contactConstraint->setInitialImpulse(closest->impulse);
+  }
+}
+
+//==============================================================================
+void ConstraintSolver::solveCompliantContacts()
+{
+  if (mActiveCompliantContactConstraints.empty())
+    return;
+
+  DART_PROFILE_SCOPE("ConstraintSolver::solveCompliantContacts");
+
+  buildConstrainedGroups(mActiveCompliantContactConstraints);
+  solveConstrainedGroups();
+
+  // Apply the impulses of the compliant contacts right away, and clear them so
+  // that they are not applied again with the impulses of the other
+  // constraints
+  for (auto& skeleton : mSkeletons)
+  {
+    if (!skeleton->isImpulseApplied())
+      continue;
+
+    if (skeleton->isMobile() && !skeleton->isSleeping())
+      skeleton->computeImpulseForwardDynamics();
+
+    skeleton->setImpulseApplied(false);
+    skeleton->clearConstraintImpulses();
+  }
+}
+
 //==============================================================================
 void ConstraintSolver::buildConstrainedGroups()
 {
-  // Clear constrained groups
-  mConstrainedGroups.clear();
+  buildConstrainedGroups(mActiveConstraints);
+}
+
+//==============================================================================
+void ConstraintSolver::buildConstrainedGroups(
+    const std::vector<ConstraintBasePtr>& constraints)
+{
+  DART_PROFILE_SCOPE("ConstraintSolver::buildConstrainedGroups");
+
+  // Clear constrained groups. The groups themselves are kept so that the
+  // memory of their constraint lists is reused.
+  for (auto& constrainedGroup : mConstrainedGroups)
+  {
+    constrainedGroup.removeAllConstraints();
+    constrainedGroup.mRootSkeleton = nullptr;
+  }
+  mNumConstrainedGroups = 0u;
 
   // Exit if there is no active constraint
-  if (mActiveConstraints.empty())
+  if (constraints.empty())
     return;
 
   //----------------------------------------------------------------------------
   // Unite skeletons according to constraints's relationships
   //----------------------------------------------------------------------------
-  for (const auto& activeConstraint : mActiveConstraints)
+  for (const auto& activeConstraint : constraints)
     activeConstraint->uniteSkeletons();
 
   //----------------------------------------------------------------------------
   // Build constraint groups
   //----------------------------------------------------------------------------
-  for (const auto& activeConstraint : mActiveConstraints)
+  for (const auto& activeConstraint : constraints)
   {
     bool found = false;
     const auto& skel = activeConstraint->getRootSkeleton();
 
-    for (const auto& constrainedGroup : mConstrainedGroups)
+    for (auto i = 0u; i < mNumConstrainedGroups; ++i)
     {
-      if (constrainedGroup.mRootSkeleton == skel)
+      if (mConstrainedGroups[i].mRootSkeleton == skel)
       {
         found = true;
         break;
@@ -663,17 +1342,33 @@ void ConstraintSolver::buildConstrainedGroups()
     if (found)
       continue;
 
-    ConstrainedGroup newConstGroup;
-    newConstGroup.mRootSkeleton = skel;
-    skel->mUnionIndex = mConstrainedGroups.size();
-    mConstrainedGroups.push_back(newConstGroup);
+    if (mNumConstrainedGroups == mConstrainedGroups.size())
+      mConstrainedGroups.emplace_back();
+
+    mConstrainedGroups[mNumConstrainedGroups].mRootSkeleton = skel;
+    skel->mUnionIndex = mNumConstrainedGroups;
+    ++mNumConstrainedGroups;
   }
 
-  // Add active constraints to constrained groups
-  for (const auto& activeConstraint : mActiveConstraints)
+  // Add active constraints to constrained groups. In real-time mode, the
+  // constraints that don't fit in the rows of their group are dropped.
+  mConstrainedGroupDimensions.assign(mNumConstrainedGroups, 0u);
+  for (const auto& activeConstraint : constraints)
   {
     const auto& skel = activeConstraint->getRootSkeleton();
-    mConstrainedGroups[skel->mUnionIndex].addConstraint(activeConstraint);
+    const std::size_t index = skel->mUnionIndex;
+    const std::size_t dimension = activeConstraint->getDimension();
+
+    if (mIsRealTime
+        && mConstrainedGroupDimensions[index] + dimension
+               > mMaxNumConstraintRows)
+    {
+      ++mNumRealTimeOverflows;
+      continue;
+    }
+
+    mConstrainedGroups[index].addConstraint(activeConstraint);
+    mConstrainedGroupDimensions[index] += dimension;
   }
 
   //----------------------------------------------------------------------------
@@ -686,8 +1381,10 @@ void ConstraintSolver::buildConstrainedGroups()
 //==============================================================================
 void ConstraintSolver::solveConstrainedGroups()
 {
-  for (auto& constraintGroup : mConstrainedGroups)
-    solveConstrainedGroup(constraintGroup);
+  DART_PROFILE_SCOPE("ConstraintSolver::solveConstrainedGroups");
+
+  for (auto i = 0u; i < mNumConstrainedGroups; ++i)
+    solveConstrainedGroup(mConstrainedGroups[i]);
 }
 
 //==============================================================================
@@ -710,5 +1407,47 @@ bool ConstraintSolver::isSoftContact(const collision::Contact& contact) const
   return bodyNode1IsSoft || bodyNode2IsSoft;
 }
 
+//==============================================================================
+void ConstraintSolver::reserveRealTimeMemory()
+{
+  std::size_t numJoints = 0u;
+  for (const auto& skeleton : mSkeletons)
+    numJoints += skeleton->getNumJoints();
+
+  const std::size_t maxNumContacts = mCollisionOption.maxNumContacts;
+  const std::size_t maxNumJointConstraints
+      = maxNumConstraintsPerJoint * numJoints;
+  const std::size_t maxNumConstraints
+      = maxNumContacts + maxNumJointConstraints + mManualConstraints.size();
+
+  mCollisionResult.reserve(maxNumContacts);
+  mContactOrder.reserve(maxNumContacts);
+  mContactAnchors.reserve(maxNumContacts);
+  mContactImpulses.reserve(maxNumContacts);
+  mContactShapeKeys.reserve(maxNumContacts);
+  mSkeletonIndices.reserve(mSkeletons.size());
+  mWokenSkeletons.reserve(mSkeletons.size());
+
+  mConstraintPool->reserve(maxNumContacts + maxNumJointConstraints);
+  mContactConstraints.reserve(maxNumContacts);
+  mSoftContactConstraints.reserve(maxNumContacts);
+  mJointLimitConstraints.reserve(numJoints);
+  mServoMotorConstraints.reserve(numJoints);
+  mMimicMotorConstraints.reserve(numJoints);
+  mJointCoulombFrictionConstraints.reserve(numJoints);
+  mActiveConstraints.reserve(maxNumConstraints);
+  mActiveCompliantContactConstraints.reserve(maxNumContacts);
+
+  // Each Skeleton is the root of at most one group, and each constraint has at
+  // least one row
+  const std::size_t maxNumGroupConstraints
+      = std::min(maxNumConstraints, mMaxNumConstraintRows);
+  if (mConstrainedGroups.size() < mSkeletons.size())
+    mConstrainedGroups.resize(mSkeletons.size());
+  for (auto& constrainedGroup : mConstrainedGroups)
+    constrainedGroup.mConstraints.reserve(maxNumGroupConstraints);
+  mConstrainedGroupDimensions.reserve(mConstrainedGroups.size());
+}
+
 } // namespace constraint
 } // namespace dart
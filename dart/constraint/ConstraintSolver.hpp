@@ -33,14 +33,19 @@
 #ifndef DART_CONSTRAINT_CONSTRAINTSOVER_HPP_
 #define DART_CONSTRAINT_CONSTRAINTSOVER_HPP_
 
+#include <array>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include <Eigen/Dense>
 
 #include "dart/collision/CollisionDetector.hpp"
 #include "dart/common/Deprecated.hpp"
+#include "dart/common/MemoryPool.hpp"
 #include "dart/constraint/ConstrainedGroup.hpp"
 #include "dart/constraint/ConstraintBase.hpp"
+#include "dart/constraint/ConstraintParameters.hpp"
 #include "dart/constraint/SmartPointer.hpp"
 
 namespace dart {
@@ -169,6 +174,130 @@ public:
   /// Return the last collision checking result
   const collision::CollisionResult& getLastCollisionResult() const;
 
+  /// Set whether the constraints are created in a deterministic order. When
+  /// enabled, the contacts reported by the collision detector are sorted by
+  /// the indices of the colliding Skeletons, BodyNodes, and ShapeNodes and by
+  /// their geometry before the contact constraints are created, so the order
+  /// of the constraints (and thus the bits of the solution) doesn't depend on
+  /// the internal ordering of the collision detector or on memory addresses.
+  void setDeterministic(bool deterministic);
+
+  /// Return true if the constraints are created in a deterministic order
+  bool isDeterministic() const;
+
+  /// Set whether the contact constraints start from the impulses of the same
+  /// contacts in the previous step. A contact is considered the same as one of
+  /// the previous step if it's between the same pair of collision objects and
+  /// its point moved by at most \c maxContactDistance. The impulses are passed
+  /// to the LCP as its initial x, which PgsBoxedLcpSolver iterates from and
+  /// DantzigBoxedLcpSolver tries as a guess of the index sets when its warm
+  /// starting is enabled.
+  void setWarmStarting(bool warmStarting, double maxContactDistance = 1e-2);
+
+  /// Return true if the contact constraints start from the impulses of the
+  /// same contacts in the previous step
+  bool isWarmStarting() const;
+
+  /// Impulse of a contact constraint in the world frame
+  struct ContactImpulse
+  {
+    const collision::CollisionObject* collisionObject1;
+    const collision::CollisionObject* collisionObject2;
+    Eigen::Vector3d point;
+    Eigen::Vector3d impulse;
+  };
+
+  /// Return the impulses of the contact constraints of the last step, sorted
+  /// by their pairs of collision objects, which the next step starts from when
+  /// warm starting is enabled. They are empty otherwise.
+  const std::vector<ContactImpulse>& getContactImpulses() const;
+
+  /// Set the impulses that the next step starts from, e.g., to restore a
+  /// saved state. The impulses must be sorted like getContactImpulses().
+  void setContactImpulses(const std::vector<ContactImpulse>& impulses);
+
+  /// Set whether solve() runs without allocating memory, for hard real-time
+  /// loops. Enabling it allocates up front the memory for up to
+  /// \c maxNumContacts contacts, which also becomes the maxNumContacts of the
+  /// collision option, and for constrained groups of up to
+  /// \c maxNumConstraintRows constraint rows (the dimension of their LCPs).
+  ///
+  /// While enabled, the maxima are enforced instead of allocating more memory:
+  /// the contacts beyond maxNumContacts are not reported by the collision
+  /// detector, and the constraints that don't fit in the rows of their
+  /// constrained group are left unsolved for the step. Each time this happens
+  /// it's counted by getNumRealTimeOverflows().
+  ///
+  /// Contacts with soft bodies and collision detectors that allocate memory
+  /// internally aren't covered by this mode. Of the collision detectors, only
+  /// DARTCollisionDetector doesn't allocate memory; FCLCollisionDetector
+  /// allocates when it post-processes its contacts.
+  void setRealTime(
+      bool realTime,
+      std::size_t maxNumContacts = 1000u,
+      std::size_t maxNumConstraintRows = 3000u);
+
+  /// Return true if solve() runs without allocating memory
+  bool isRealTime() const;
+
+  /// Return the largest number of constraint rows of a constrained group in
+  /// real-time mode
+  std::size_t getMaxNumConstraintRows() const;
+
+  /// Return the number of times a maximum of the real-time mode was exceeded
+  /// since the mode was last set. Zero means that no contact or constraint was
+  /// dropped and that no memory was allocated for the constraints.
+  std::size_t getNumRealTimeOverflows() const;
+
+  /// Set the parameters of the contact constraints created by this solver.
+  /// Every solver holds its own parameters, which start from the static
+  /// defaults of ContactConstraint when it's constructed, so that worlds with
+  /// different parameters can be simulated concurrently. Parameters that are
+  /// out of their valid ranges are clamped with a warning.
+  void setContactParameters(const ConstraintParameters& parameters);
+
+  /// Return the parameters of the contact constraints created by this solver
+  const ConstraintParameters& getContactParameters() const;
+
+  /// Set the parameters of the soft contact constraints created by this solver
+  void setSoftContactParameters(const ConstraintParameters& parameters);
+
+  /// Return the parameters of the soft contact constraints created by this
+  /// solver
+  const ConstraintParameters& getSoftContactParameters() const;
+
+  /// Set the parameters of the joint limit constraints created by this solver
+  void setJointLimitParameters(const ConstraintParameters& parameters);
+
+  /// Return the parameters of the joint limit constraints created by this
+  /// solver
+  const ConstraintParameters& getJointLimitParameters() const;
+
+  /// Set the parameters of the servo motor constraints created by this solver.
+  /// Only the constraint force mixing parameter is used.
+  void setServoMotorParameters(const ConstraintParameters& parameters);
+
+  /// Return the parameters of the servo motor constraints created by this
+  /// solver
+  const ConstraintParameters& getServoMotorParameters() const;
+
+  /// Set the parameters of the mimic motor constraints created by this solver.
+  /// Only the constraint force mixing parameter is used.
+  void setMimicMotorParameters(const ConstraintParameters& parameters);
+
+  /// Return the parameters of the mimic motor constraints created by this
+  /// solver
+  const ConstraintParameters& getMimicMotorParameters() const;
+
+  /// Set the parameters of the joint Coulomb friction constraints created by
+  /// this solver. Only the constraint force mixing parameter is used.
+  void setJointCoulombFrictionParameters(
+      const ConstraintParameters& parameters);
+
+  /// Return the parameters of the joint Coulomb friction constraints created
+  /// by this solver
+  const ConstraintParameters& getJointCoulombFrictionParameters() const;
+
   /// Set LCP solver
   DART_DEPRECATED(6.7)
   void setLCPSolver(std::unique_ptr<LCPSolver> lcpSolver);
@@ -180,11 +309,22 @@ public:
   /// Solve constraint impulses and apply them to the skeletons
   void solve();
 
+  /// Solve constraint impulses and apply them to the skeletons. If
+  /// \c detectCollision is false, collision detection is skipped and the
+  /// contacts of the last collision result are used to create the contact
+  /// constraints again, with their points and penetration depths updated to
+  /// the current transforms of the colliding ShapeFrames.
+  void solve(bool detectCollision);
+
   /// Sets this constraint solver using other constraint solver. All the
   /// properties and registered skeletons and constraints will be copied over.
   virtual void setFromOtherConstraintSolver(const ConstraintSolver& other);
 
 protected:
+  /// Called at the beginning of every solve(), before the constraints are
+  /// updated. Does nothing by default.
+  virtual void beginSolve();
+
   // TODO(JS): Docstring
   virtual void solveConstrainedGroup(ConstrainedGroup& group) = 0;
 
@@ -201,17 +341,73 @@ protected:
   bool checkAndAddConstraint(const ConstraintBasePtr& constraint);
 
   /// Update constraints
-  void updateConstraints();
+  void updateConstraints(bool detectCollision = true);
+
+  /// Wake up the sleeping Skeletons that are in contact with awake ones
+  /// according to the contacts of the last collision result from index
+  /// \c firstContact on. Returns true if any Skeleton was woken up.
+  bool wakeUpTouchedSkeletons(std::size_t firstContact);
+
+  /// Wake up a sleeping Skeleton in the middle of a step. Only the Skeleton is
+  /// flagged awake: it takes part in the constraints of this step, and
+  /// World::step() computes its dynamics from the next step on.
+  void wakeUp(dynamics::Skeleton* skeleton);
+
+  /// Detect the contacts of the Skeletons woken up since the last collision
+  /// check with each other and with the sleeping Skeletons, and add them to
+  /// the last collision result
+  void collideWokenSkeletons();
+
+  /// Store the points of the contacts of the last collision result in the
+  /// frames of their ShapeFrames along with their penetration depths
+  void storeContactAnchors();
+
+  /// Update the points and penetration depths of the contacts of the last
+  /// collision result to the current transforms of their ShapeFrames
+  void updateContactDepths();
+
+  /// Compute the order in which the contacts of the last collision result are
+  /// turned into contact constraints
+  void updateContactOrder();
+
+  /// Store the impulses of the contact constraints of the last step
+  void storeContactImpulses();
+
+  /// Set the initial impulses of the contact constraints from the stored
+  /// impulses of the same contacts in the last step
+  void warmStartContactConstraints();
+
+  /// Solve the active compliant contacts in their own constrained groups and
+  /// apply their impulses to the Skeletons. See
+  /// ContactConstraint::isCompliant().
+  ///
+  /// The other constraints are solved afterwards, so the compliant contacts
+  /// don't see their impulses of the same step. A load that reaches a
+  /// compliant contact through rigid constraints settles slightly deeper,
+  /// by (h * k + c) / k times the velocity change that the rigid constraints
+  /// give the contact per step, where h is the time step, k the stiffness and
+  /// c the damping of the contact.
+  void solveCompliantContacts();
 
   /// Build constrained groupsContact
   void buildConstrainedGroups();
 
+  /// Build constrained groups of \c constraints
+  void buildConstrainedGroups(
+      const std::vector<ConstraintBasePtr>& constraints);
+
   /// Solve constrained groups
   void solveConstrainedGroups();
 
   /// Return true if at least one of colliding body is soft body
   bool isSoftContact(const collision::Contact& contact) const;
 
+  /// Allocate the memory that solve() uses in real-time mode for the current
+  /// Skeletons and constraints. Called when the real-time mode is enabled and
+  /// when Skeletons or constraints are added while it's enabled. Solvers that
+  /// keep their own buffers should override this and call the base version.
+  virtual void reserveRealTimeMemory();
+
   using CollisionDetector = collision::CollisionDetector;
 
   /// Collision detector
@@ -229,6 +425,81 @@ protected:
   /// Time step
   double mTimeStep;
 
+  /// Whether the constraints are created in a deterministic order
+  bool mIsDeterministic;
+
+  /// Whether solve() runs without allocating memory
+  bool mIsRealTime;
+
+  /// Largest number of constraint rows of a constrained group in real-time
+  /// mode
+  std::size_t mMaxNumConstraintRows;
+
+  /// Number of contacts and constraints dropped in real-time mode
+  std::size_t mNumRealTimeOverflows;
+
+  /// Whether the contact constraints start from the impulses of the last step
+  bool mIsWarmStarting;
+
+  /// Largest distance that a contact point can move between two steps and
+  /// still be considered the same contact for warm starting
+  double mMaxWarmStartContactDistance;
+
+  /// Parameters of the contact constraints
+  ConstraintParameters mContactParameters;
+
+  /// Parameters of the soft contact constraints
+  ConstraintParameters mSoftContactParameters;
+
+  /// Parameters of the joint limit constraints
+  ConstraintParameters mJointLimitParameters;
+
+  /// Parameters of the servo motor constraints
+  ConstraintParameters mServoMotorParameters;
+
+  /// Parameters of the mimic motor constraints
+  ConstraintParameters mMimicMotorParameters;
+
+  /// Parameters of the joint Coulomb friction constraints
+  ConstraintParameters mJointCoulombFrictionParameters;
+
+  /// Impulses of the contact constraints of the last step sorted by their
+  /// pairs of collision objects, used for warm starting
+  std::vector<ContactImpulse> mContactImpulses;
+
+  /// Memory of the constraints that are created automatically every step
+  std::shared_ptr<common::MemoryPool> mConstraintPool;
+
+  /// Skeletons sorted by address with their indices in mSkeletons, used to
+  /// order the contacts deterministically
+  std::vector<std::pair<const dynamics::Skeleton*, std::size_t>>
+      mSkeletonIndices;
+
+  /// Indices of the colliding Skeleton, BodyNode, and ShapeNode of both
+  /// objects of each contact, used to order the contacts deterministically
+  std::vector<std::array<std::array<std::size_t, 3>, 2>> mContactShapeKeys;
+
+  /// Indices of the contacts of the last collision result in the order they
+  /// are turned into contact constraints
+  std::vector<std::size_t> mContactOrder;
+
+  /// Point of a contact in the frames of both colliding ShapeFrames and its
+  /// penetration depth when it was detected
+  struct ContactAnchor
+  {
+    Eigen::Vector3d localPoint1;
+    Eigen::Vector3d localPoint2;
+    double penetrationDepth;
+  };
+
+  /// Anchors of the contacts of the last collision result, used to update the
+  /// contacts when they are reused without detecting collisions
+  std::vector<ContactAnchor> mContactAnchors;
+
+  /// Skeletons woken up since the last collision check, whose contacts with
+  /// sleeping Skeletons are still missing from the collision result
+  std::vector<dynamics::Skeleton*> mWokenSkeletons;
+
   /// Skeleton list
   std::vector<dynamics::SkeletonPtr> mSkeletons;
 
@@ -257,8 +528,19 @@ protected:
   /// Active constraints
   std::vector<ConstraintBasePtr> mActiveConstraints;
 
-  /// Constraint group list
+  /// Active compliant contact constraints, which are solved before and
+  /// separately from mActiveConstraints
+  std::vector<ConstraintBasePtr> mActiveCompliantContactConstraints;
+
+  /// Constraint group list. Only the first mNumConstrainedGroups groups are
+  /// used; the others are kept so that their memory is reused.
   std::vector<ConstrainedGroup> mConstrainedGroups;
+
+  /// Number of constrained groups built by the last buildConstrainedGroups()
+  std::size_t mNumConstrainedGroups;
+
+  /// Total dimension of the constraints of each constrained group
+  std::vector<std::size_t> mConstrainedGroupDimensions;
 };
 
 } // namespace constraint
@@ -32,6 +32,7 @@
 
 #include "dart/constraint/ContactConstraint.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include "dart/external/odelcpsolver/lcp.h"
@@ -58,10 +59,8 @@
 namespace dart {
 namespace constraint {
 
-double ContactConstraint::mErrorAllowance = DART_ERROR_ALLOWANCE;
-double ContactConstraint::mErrorReductionParameter = DART_ERP;
-double ContactConstraint::mMaxErrorReductionVelocity = DART_MAX_ERV;
-double ContactConstraint::mConstraintForceMixing = DART_CFM;
+ConstraintParameters ContactConstraint::mDefaultParameters(
+    DART_ERROR_ALLOWANCE, DART_ERP, DART_MAX_ERV, DART_CFM);
 
 constexpr double DART_DEFAULT_FRICTION_COEFF = 1.0;
 constexpr double DART_DEFAULT_RESTITUTION_COEFF = 0.0;
@@ -70,7 +69,7 @@ const Eigen::Vector3d DART_DEFAULT_FRICTION_DIR = Eigen::Vector3d::UnitZ();
 //==============================================================================
 ContactConstraint::ContactConstraint(
     collision::Contact& contact, double timeStep)
-  : ConstraintBase(),
+  : ConstraintBase(mDefaultParameters),
     mTimeStep(timeStep),
     mBodyNodeA(const_cast<dynamics::ShapeFrame*>(
                    contact.collisionObject1->getShapeFrame())
@@ -84,6 +83,7 @@ ContactConstraint::ContactConstraint(
                    .get()),
     mContact(contact),
     mFirstFrictionalDirection(DART_DEFAULT_FRICTION_DIR),
+    mInitialImpulse(Eigen::Vector3d::Zero()),
     mIsFrictionOn(true),
     mAppliedImpulseIndex(dynamics::INVALID_INDEX),
     mIsBounceOn(false),
@@ -110,6 +110,37 @@ ContactConstraint::ContactConstraint(
   else
     mIsBounceOn = false;
 
+  //----------------------------------------------
+  // Compliance
+  //----------------------------------------------
+  // The shapes are springs in series, where a rigid shape has infinite
+  // stiffness and no damping of its own
+  const double stiffnessA = computeContactStiffness(shapeNodeA);
+  const double stiffnessB = computeContactStiffness(shapeNodeB);
+  const double dampingA = computeContactDamping(shapeNodeA);
+  const double dampingB = computeContactDamping(shapeNodeB);
+  if (stiffnessA > 0.0 && stiffnessB > 0.0)
+  {
+    const double sum = stiffnessA + stiffnessB;
+    mContactStiffness = stiffnessA * stiffnessB / sum;
+    mContactDamping = (stiffnessB * dampingA + stiffnessA * dampingB) / sum;
+  }
+  else if (stiffnessA > 0.0)
+  {
+    mContactStiffness = stiffnessA;
+    mContactDamping = dampingA;
+  }
+  else if (stiffnessB > 0.0)
+  {
+    mContactStiffness = stiffnessB;
+    mContactDamping = dampingB;
+  }
+  else
+  {
+    mContactStiffness = 0.0;
+    mContactDamping = 0.0;
+  }
+
   //----------------------------------------------
   // Friction
   //----------------------------------------------
@@ -306,16 +337,16 @@ void ContactConstraint::setErrorAllowance(double allowance)
     dtwarn << "Error reduction parameter[" << allowance
            << "] is lower than 0.0. "
            << "It is set to 0.0." << std::endl;
-    mErrorAllowance = 0.0;
+    mDefaultParameters.errorAllowance = 0.0;
   }
 
-  mErrorAllowance = allowance;
+  mDefaultParameters.errorAllowance = allowance;
 }
 
 //==============================================================================
 double ContactConstraint::getErrorAllowance()
 {
-  return mErrorAllowance;
+  return mDefaultParameters.errorAllowance;
 }
 
 //==============================================================================
@@ -326,22 +357,22 @@ void ContactConstraint::setErrorReductionParameter(double erp)
   {
     dtwarn << "Error reduction parameter[" << erp << "] is lower than 0.0. "
            << "It is set to 0.0." << std::endl;
-    mErrorReductionParameter = 0.0;
+    mDefaultParameters.errorReductionParameter = 0.0;
   }
   if (erp > 1.0)
   {
     dtwarn << "Error reduction parameter[" << erp << "] is greater than 1.0. "
            << "It is set to 1.0." << std::endl;
-    mErrorReductionParameter = 1.0;
+    mDefaultParameters.errorReductionParameter = 1.0;
   }
 
-  mErrorReductionParameter = erp;
+  mDefaultParameters.errorReductionParameter = erp;
 }
 
 //==============================================================================
 double ContactConstraint::getErrorReductionParameter()
 {
-  return mErrorReductionParameter;
+  return mDefaultParameters.errorReductionParameter;
 }
 
 //==============================================================================
@@ -353,16 +384,16 @@ void ContactConstraint::setMaxErrorReductionVelocity(double erv)
     dtwarn << "Maximum error reduction velocity[" << erv
            << "] is lower than 0.0. "
            << "It is set to 0.0." << std::endl;
-    mMaxErrorReductionVelocity = 0.0;
+    mDefaultParameters.maxErrorReductionVelocity = 0.0;
   }
 
-  mMaxErrorReductionVelocity = erv;
+  mDefaultParameters.maxErrorReductionVelocity = erv;
 }
 
 //==============================================================================
 double ContactConstraint::getMaxErrorReductionVelocity()
 {
-  return mMaxErrorReductionVelocity;
+  return mDefaultParameters.maxErrorReductionVelocity;
 }
 
 //==============================================================================
@@ -374,16 +405,22 @@ void ContactConstraint::setConstraintForceMixing(double cfm)
     dtwarn << "Constraint force mixing parameter[" << cfm
            << "] is lower than 1e-9. "
            << "It is set to 1e-9." << std::endl;
-    mConstraintForceMixing = 1e-9;
+    mDefaultParameters.constraintForceMixing = 1e-9;
   }
 
-  mConstraintForceMixing = cfm;
+  mDefaultParameters.constraintForceMixing = cfm;
 }
 
 //==============================================================================
 double ContactConstraint::getConstraintForceMixing()
 {
-  return mConstraintForceMixing;
+  return mDefaultParameters.constraintForceMixing;
+}
+
+//==============================================================================
+const ConstraintParameters& ContactConstraint::getDefaultParameters()
+{
+  return mDefaultParameters;
 }
 
 //==============================================================================
@@ -398,6 +435,18 @@ const Eigen::Vector3d& ContactConstraint::getFrictionDirection1() const
   return mFirstFrictionalDirection;
 }
 
+//==============================================================================
+void ContactConstraint::setInitialImpulse(const Eigen::Vector3d& impulse)
+{
+  mInitialImpulse = impulse;
+}
+
+//==============================================================================
+const Eigen::Vector3d& ContactConstraint::getInitialImpulse() const
+{
+  return mInitialImpulse;
+}
+
 //==============================================================================
 void ContactConstraint::update()
 {
@@ -441,46 +490,55 @@ void ContactConstraint::getInformation(ConstraintInfo* info)
     //------------------------------------------------------------------------
     // Bouncing
     //------------------------------------------------------------------------
-    // A. Penetration correction
-    double bouncingVelocity = mContact.penetrationDepth - mErrorAllowance;
-    if (bouncingVelocity < 0.0)
+    if (isCompliant())
     {
-      bouncingVelocity = 0.0;
+      info->b[0] += getCompliantVelocity();
     }
     else
     {
-      bouncingVelocity *= mErrorReductionParameter * info->invTimeStep;
-      if (bouncingVelocity > mMaxErrorReductionVelocity)
-        bouncingVelocity = mMaxErrorReductionVelocity;
-    }
-
-    // B. Restitution
-    if (mIsBounceOn)
-    {
-      double& negativeRelativeVel = info->b[0];
-      double restitutionVel = negativeRelativeVel * mRestitutionCoeff;
+      // A. Penetration correction
+      double bouncingVelocity
+          = mContact.penetrationDepth - mParameters.errorAllowance;
+      if (bouncingVelocity < 0.0)
+      {
+        bouncingVelocity = 0.0;
+      }
+      else
+      {
+        bouncingVelocity
+            *= mParameters.errorReductionParameter * info->invTimeStep;
+        if (bouncingVelocity > mParameters.maxErrorReductionVelocity)
+          bouncingVelocity = mParameters.maxErrorReductionVelocity;
+      }
 
-      if (restitutionVel > DART_BOUNCING_VELOCITY_THRESHOLD)
+      // B. Restitution
+      if (mIsBounceOn)
       {
-        if (restitutionVel > bouncingVelocity)
-        {
-          bouncingVelocity = restitutionVel;
+        double& negativeRelativeVel = info->b[0];
+        double restitutionVel = negativeRelativeVel * mRestitutionCoeff;
 
-          if (bouncingVelocity > DART_MAX_BOUNCING_VELOCITY)
+        if (restitutionVel > DART_BOUNCING_VELOCITY_THRESHOLD)
+        {
+          if (restitutionVel > bouncingVelocity)
           {
-            bouncingVelocity = DART_MAX_BOUNCING_VELOCITY;
+            bouncingVelocity = restitutionVel;
+
+            if (bouncingVelocity > DART_MAX_BOUNCING_VELOCITY)
+            {
+              bouncingVelocity = DART_MAX_BOUNCING_VELOCITY;
+            }
           }
         }
       }
-    }
 
-    info->b[0] += bouncingVelocity;
+      info->b[0] += bouncingVelocity;
+    }
 
-    // TODO(JS): Initial guess
-    // x
-    info->x[0] = 0.0;
-    info->x[1] = 0.0;
-    info->x[2] = 0.0;
+    // Initial guess
+    const TangentBasisMatrix D = getTangentBasisMatrixODE(mContact.normal);
+    info->x[0] = std::max(mContact.normal.dot(mInitialImpulse), 0.0);
+    info->x[1] = D.col(0).dot(mInitialImpulse);
+    info->x[2] = D.col(1).dot(mInitialImpulse);
   }
   //----------------------------------------------------------------------------
   // Frictionless case
@@ -498,42 +556,50 @@ void ContactConstraint::getInformation(ConstraintInfo* info)
     //------------------------------------------------------------------------
     // Bouncing
     //------------------------------------------------------------------------
-    // A. Penetration correction
-    double bouncingVelocity = mContact.penetrationDepth - DART_ERROR_ALLOWANCE;
-    if (bouncingVelocity < 0.0)
+    if (isCompliant())
     {
-      bouncingVelocity = 0.0;
+      info->b[0] += getCompliantVelocity();
     }
     else
     {
-      bouncingVelocity *= mErrorReductionParameter * info->invTimeStep;
-      if (bouncingVelocity > mMaxErrorReductionVelocity)
-        bouncingVelocity = mMaxErrorReductionVelocity;
-    }
-
-    // B. Restitution
-    if (mIsBounceOn)
-    {
-      double& negativeRelativeVel = info->b[0];
-      double restitutionVel = negativeRelativeVel * mRestitutionCoeff;
+      // A. Penetration correction
+      double bouncingVelocity
+          = mContact.penetrationDepth - mParameters.errorAllowance;
+      if (bouncingVelocity < 0.0)
+      {
+        bouncingVelocity = 0.0;
+      }
+      else
+      {
+        bouncingVelocity
+            *= mParameters.errorReductionParameter * info->invTimeStep;
+        if (bouncingVelocity > mParameters.maxErrorReductionVelocity)
+          bouncingVelocity = mParameters.maxErrorReductionVelocity;
+      }
 
-      if (restitutionVel > DART_BOUNCING_VELOCITY_THRESHOLD)
+      // B. Restitution
+      if (mIsBounceOn)
       {
-        if (restitutionVel > bouncingVelocity)
+        double& negativeRelativeVel = info->b[0];
+        double restitutionVel = negativeRelativeVel * mRestitutionCoeff;
+
+        if (restitutionVel > DART_BOUNCING_VELOCITY_THRESHOLD)
         {
-          bouncingVelocity = restitutionVel;
+          if (restitutionVel > bouncingVelocity)
+          {
+            bouncingVelocity = restitutionVel;
 
-          if (bouncingVelocity > DART_MAX_BOUNCING_VELOCITY)
-            bouncingVelocity = DART_MAX_BOUNCING_VELOCITY;
+            if (bouncingVelocity > DART_MAX_BOUNCING_VELOCITY)
+              bouncingVelocity = DART_MAX_BOUNCING_VELOCITY;
+          }
         }
       }
-    }
 
-    info->b[0] += bouncingVelocity;
+      info->b[0] += bouncingVelocity;
+    }
 
-    // TODO(JS): Initial guess
-    // x
-    info->x[0] = 0.0;
+    // Initial guess
+    info->x[0] = std::max(mContact.normal.dot(mInitialImpulse), 0.0);
   }
 }
 
@@ -626,7 +692,84 @@ void ContactConstraint::getVelocityChange(double* vel, bool withCfm)
   if (withCfm)
   {
     vel[mAppliedImpulseIndex]
-        += vel[mAppliedImpulseIndex] * mConstraintForceMixing;
+        += vel[mAppliedImpulseIndex] * mParameters.constraintForceMixing;
+
+    // The compliance of the spring-damper acts as an absolute cfm on the
+    // normal direction
+    if (isCompliant() && mAppliedImpulseIndex == 0u)
+      vel[0] += getCompliance();
+  }
+}
+
+//==============================================================================
+bool ContactConstraint::supportsImpulseResponseCache() const
+{
+  return true;
+}
+
+//==============================================================================
+void ContactConstraint::addBodyNodesTo(ImpulseResponseCache& cache) const
+{
+  if (mBodyNodeA->isReactive())
+    cache.addBodyNode(mBodyNodeA);
+
+  if (mBodyNodeB->isReactive())
+    cache.addBodyNode(mBodyNodeB);
+}
+
+//==============================================================================
+void ContactConstraint::applyUnitImpulses(ImpulseResponseCache& cache) const
+{
+  assert(mBodyNodeA->isReactive() || mBodyNodeB->isReactive());
+
+  cache.clearUnitImpulses();
+
+  if (mBodyNodeA->isReactive())
+    cache.applyUnitImpulses(mBodyNodeA, mSpatialNormalA);
+
+  if (mBodyNodeB->isReactive())
+    cache.applyUnitImpulses(mBodyNodeB, mSpatialNormalB);
+}
+
+//==============================================================================
+void ContactConstraint::getVelocityChanges(
+    const ImpulseResponseCache& cache,
+    double* vel,
+    int nSkip,
+    bool withCfm) const
+{
+  assert(vel != nullptr && "Null pointer is not allowed.");
+
+  using RowMajorMatrixXd
+      = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  Eigen::Map<RowMajorMatrixXd, 0, Eigen::OuterStride<>> velMap(
+      vel,
+      cache.getNumUnitImpulses(),
+      static_cast<int>(mDim),
+      Eigen::OuterStride<>(nSkip));
+  velMap.setZero();
+
+  if (mBodyNodeA->isReactive())
+  {
+    if (const auto* velocityChanges = cache.getVelocityChanges(mBodyNodeA))
+      velMap.noalias() += velocityChanges->transpose() * mSpatialNormalA;
+  }
+
+  if (mBodyNodeB->isReactive())
+  {
+    if (const auto* velocityChanges = cache.getVelocityChanges(mBodyNodeB))
+      velMap.noalias() += velocityChanges->transpose() * mSpatialNormalB;
+  }
+
+  // Add small values to the diagnal to keep it away from singular, similar to
+  // cfm variable in ODE
+  if (withCfm)
+  {
+    assert(velMap.rows() == velMap.cols());
+    velMap.diagonal() += velMap.diagonal() * mParameters.constraintForceMixing;
+
+    if (isCompliant())
+      velMap(0, 0) += getCompliance();
   }
 }
 
@@ -672,7 +815,7 @@ void ContactConstraint::applyImpulse(double* lambda)
       mBodyNodeB->addConstraintImpulse(mSpatialNormalB.col(0) * lambda[0]);
 
     // Add contact impulse (force) toward the tangential w.r.t. world frame
-    const Eigen::MatrixXd D = getTangentBasisMatrixODE(mContact.normal);
+    const TangentBasisMatrix D = getTangentBasisMatrixODE(mContact.normal);
     mContact.force += D.col(0) * lambda[1] / mTimeStep;
 
     // Tangential direction-1 impulsive force
@@ -816,6 +959,50 @@ Eigen::Vector3d ContactConstraint::computeWorldFirstFrictionDir(
   return shapeNode->getWorldTransform().linear() * frictionDir;
 }
 
+//==============================================================================
+bool ContactConstraint::isCompliant() const
+{
+  return mContactStiffness > 0.0;
+}
+
+//==============================================================================
+double ContactConstraint::getContactStiffness() const
+{
+  return mContactStiffness;
+}
+
+//==============================================================================
+double ContactConstraint::getContactDamping() const
+{
+  return mContactDamping;
+}
+
+//==============================================================================
+double ContactConstraint::computeContactStiffness(
+    const dynamics::ShapeNode* shapeNode)
+{
+  assert(shapeNode);
+
+  auto dynamicAspect = shapeNode->getDynamicsAspect();
+  if (dynamicAspect == nullptr)
+    return 0.0;
+
+  return std::max(dynamicAspect->getContactStiffness(), 0.0);
+}
+
+//==============================================================================
+double ContactConstraint::computeContactDamping(
+    const dynamics::ShapeNode* shapeNode)
+{
+  assert(shapeNode);
+
+  auto dynamicAspect = shapeNode->getDynamicsAspect();
+  if (dynamicAspect == nullptr)
+    return 0.0;
+
+  return std::max(dynamicAspect->getContactDamping(), 0.0);
+}
+
 //==============================================================================
 double ContactConstraint::computeRestitutionCoefficient(
     const dynamics::ShapeNode* shapeNode)
@@ -847,6 +1034,39 @@ dynamics::SkeletonPtr ContactConstraint::getRootSkeleton() const
     return mBodyNodeB->getSkeleton()->mUnionRootSkeleton.lock();
 }
 
+//==============================================================================
+double ContactConstraint::getCompliance() const
+{
+  assert(isCompliant());
+
+  // Backward Euler of the spring-damper force f = k * d - c * v, where d is
+  // the penetration depth and v the separating velocity, gives the impulse
+  // h * f = h * k * d - h * (h * k + c) * v+ for the velocity v+ after the
+  // step. The impulse per unit v+ is the inverse of the compliance.
+  return 1.0 / (mTimeStep * (mTimeStep * mContactStiffness + mContactDamping));
+}
+
+//==============================================================================
+double ContactConstraint::getCompliantVelocity() const
+{
+  assert(isCompliant());
+
+  // The velocity v+ at which the spring-damper force vanishes, which plays
+  // the role of the error reduction velocity of the rigid contacts
+  const double depth = std::max(mContact.penetrationDepth, 0.0);
+  return mContactStiffness * depth
+         / (mTimeStep * mContactStiffness + mContactDamping);
+}
+
+//==============================================================================
+void ContactConstraint::shareCompliance(std::size_t numContacts)
+{
+  assert(numContacts > 0u);
+
+  mContactStiffness /= static_cast<double>(numContacts);
+  mContactDamping /= static_cast<double>(numContacts);
+}
+
 //==============================================================================
 void ContactConstraint::updateFirstFrictionalDirection()
 {
@@ -34,7 +34,10 @@
 #define DART_CONSTRAINT_CONTACTCONSTRAINT_HPP_
 
 #include "dart/collision/CollisionDetector.hpp"
+#include "dart/common/Deprecated.hpp"
 #include "dart/constraint/ConstraintBase.hpp"
+#include "dart/constraint/ConstraintParameters.hpp"
+#include "dart/constraint/ImpulseResponseCache.hpp"
 #include "dart/math/MathTypes.hpp"
 
 namespace dart {
@@ -66,36 +69,111 @@ public:
   // Property settings
   //----------------------------------------------------------------------------
 
-  /// Set global error reduction parameter
+  /// Set the default constraint error allowance
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::setContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static void setErrorAllowance(double allowance);
 
-  /// Get global error reduction parameter
+  /// Get the default constraint error allowance
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::getContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static double getErrorAllowance();
 
-  /// Set global error reduction parameter
+  /// Set the default error reduction parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::setContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static void setErrorReductionParameter(double erp);
 
-  /// Get global error reduction parameter
+  /// Get the default error reduction parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::getContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static double getErrorReductionParameter();
 
-  /// Set global error reduction parameter
+  /// Set the default maximum error reduction velocity
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::setContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static void setMaxErrorReductionVelocity(double erv);
 
-  /// Get global error reduction parameter
+  /// Get the default maximum error reduction velocity
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::getContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static double getMaxErrorReductionVelocity();
 
-  /// Set global constraint force mixing parameter
+  /// Set the default constraint force mixing parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::setContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static void setConstraintForceMixing(double cfm);
 
-  /// Get global constraint force mixing parameter
+  /// Get the default constraint force mixing parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::getContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static double getConstraintForceMixing();
 
+  /// Get the default parameters of the constraints that are created
+  /// afterwards
+  static const ConstraintParameters& getDefaultParameters();
+
   /// Set first frictional direction
   void setFrictionDirection(const Eigen::Vector3d& dir);
 
   /// Get first frictional direction
   const Eigen::Vector3d& getFrictionDirection1() const;
 
+  /// Set the impulse in the world frame that this constraint reports as the
+  /// initial guess of its LCP, such as the impulse of the same contact in the
+  /// previous step
+  void setInitialImpulse(const Eigen::Vector3d& impulse);
+
+  /// Get the impulse in the world frame that this constraint reports as the
+  /// initial guess of its LCP
+  const Eigen::Vector3d& getInitialImpulse() const;
+
+  /// Returns true if at least one of the shapes has a positive contact
+  /// stiffness in its DynamicsAspect. The normal impulse of a compliant
+  /// contact is the implicit spring-damper impulse instead of the impulse
+  /// that stops the penetration, and ConstraintSolver solves compliant
+  /// contacts ahead of and separately from the other constraints.
+  bool isCompliant() const;
+
+  /// Returns the stiffness of the contact, which combines the stiffnesses of
+  /// the shapes as springs in series. The contact points between the same
+  /// pair of shapes share it as springs in parallel, so this is the stiffness
+  /// of the shapes divided by the number of contact points. Zero for rigid
+  /// contacts.
+  double getContactStiffness() const;
+
+  /// Returns the damping of the contact, which the contact points between the
+  /// same pair of shapes share like the stiffness
+  double getContactDamping() const;
+
+  //----------------------------------------------------------------------------
+  // Impulse tests with cached impulse responses
+  //----------------------------------------------------------------------------
+
+  // Documentation inherited
+  bool supportsImpulseResponseCache() const override;
+
+  // Documentation inherited
+  void addBodyNodesTo(ImpulseResponseCache& cache) const override;
+
+  // Documentation inherited
+  void applyUnitImpulses(ImpulseResponseCache& cache) const override;
+
+  // Documentation inherited
+  void getVelocityChanges(
+      const ImpulseResponseCache& cache,
+      double* vel,
+      int nSkip,
+      bool withCfm) const override;
+
   //----------------------------------------------------------------------------
   // Friendship
   //----------------------------------------------------------------------------
@@ -148,6 +226,8 @@ protected:
       const dynamics::ShapeNode* shapenode);
   static double computeRestitutionCoefficient(
       const dynamics::ShapeNode* shapeNode);
+  static double computeContactStiffness(const dynamics::ShapeNode* shapeNode);
+  static double computeContactDamping(const dynamics::ShapeNode* shapeNode);
 
 private:
   using TangentBasisMatrix = Eigen::Matrix<double, 3, 2>;
@@ -163,6 +243,19 @@ private:
   ///
   TangentBasisMatrix getTangentBasisMatrixODE(const Eigen::Vector3d& n);
 
+  /// Returns the normal velocity change per unit normal impulse that the
+  /// spring-damper of a compliant contact adds to the LCP
+  double getCompliance() const;
+
+  /// Returns the normal velocity at which the spring-damper force of a
+  /// compliant contact vanishes
+  double getCompliantVelocity() const;
+
+  /// Shares the stiffness and damping of the shapes among the given number of
+  /// contact points between them. ConstraintSolver calls this once for each
+  /// new contact between compliant shapes.
+  void shareCompliance(std::size_t numContacts);
+
 private:
   /// Time step
   double mTimeStep;
@@ -188,14 +281,25 @@ private:
   /// Coefficient of restitution
   double mRestitutionCoeff;
 
+  /// Stiffness of the compliant contact model. Zero for rigid contacts.
+  double mContactStiffness;
+
+  /// Damping of the compliant contact model
+  double mContactDamping;
+
+  /// Initial guess of the contact impulse in the world frame
+  Eigen::Vector3d mInitialImpulse;
+
   /// Whether this contact is self-collision.
   bool mIsSelfCollision;
 
-  /// Local body jacobians for mBodyNode1
-  Eigen::Matrix<double, 6, Eigen::Dynamic> mSpatialNormalA;
+  /// Local body jacobians for mBodyNode1. It has one column without friction
+  /// and three with friction, which are stored inline to avoid heap
+  /// allocations.
+  Eigen::Matrix<double, 6, Eigen::Dynamic, 0, 6, 3> mSpatialNormalA;
 
   /// Local body jacobians for mBodyNode2
-  Eigen::Matrix<double, 6, Eigen::Dynamic> mSpatialNormalB;
+  Eigen::Matrix<double, 6, Eigen::Dynamic, 0, 6, 3> mSpatialNormalB;
 
   ///
   bool mIsFrictionOn;
@@ -209,20 +313,8 @@ private:
   ///
   bool mActive;
 
-  /// Global constraint error allowance
-  static double mErrorAllowance;
-
-  /// Global constraint error redection parameter in the range of [0, 1]. The
-  /// default is 0.01.
-  static double mErrorReductionParameter;
-
-  /// Maximum error reduction velocity
-  static double mMaxErrorReductionVelocity;
-
-  /// Global constraint force mixing parameter in the range of [1e-9, 1]. The
-  /// default is 1e-5
-  /// \sa http://www.ode.org/ode-latest-userguide.html#sec_3_8_0
-  static double mConstraintForceMixing;
+  /// Default parameters of the constraints that are created afterwards
+  static ConstraintParameters mDefaultParameters;
 };
 // TODO(JS): Create SelfContactConstraint.
 
@@ -37,6 +37,18 @@
 namespace dart {
 namespace constraint {
 
+//==============================================================================
+DantzigBoxedLcpSolver::DantzigBoxedLcpSolver()
+  : mWorkspace(std::make_unique<external::ode::dLCPWorkspace>()),
+    mIsWarmStarting(false),
+    mNumWarmStarts(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+DantzigBoxedLcpSolver::~DantzigBoxedLcpSolver() = default;
+
 //==============================================================================
 const std::string& DantzigBoxedLcpSolver::getType() const
 {
@@ -62,8 +74,51 @@ bool DantzigBoxedLcpSolver::solve(
     int* findex,
     bool earlyTermination)
 {
+  if (mIsWarmStarting
+      && external::ode::dSolveLCPFromGuess(
+          n, A, x, b, lo, hi, findex, mWorkspace.get()))
+  {
+    ++mNumWarmStarts;
+    return true;
+  }
+
   return external::ode::dSolveLCP(
-      n, A, x, b, nullptr, 0, lo, hi, findex, earlyTermination);
+      n,
+      A,
+      x,
+      b,
+      nullptr,
+      0,
+      lo,
+      hi,
+      findex,
+      earlyTermination,
+      mWorkspace.get());
+}
+
+//==============================================================================
+void DantzigBoxedLcpSolver::reserve(int n)
+{
+  mWorkspace->reserve(n);
+}
+
+//==============================================================================
+void DantzigBoxedLcpSolver::setWarmStarting(bool warmStarting)
+{
+  mIsWarmStarting = warmStarting;
+  mNumWarmStarts = 0u;
+}
+
+//==============================================================================
+bool DantzigBoxedLcpSolver::isWarmStarting() const
+{
+  return mIsWarmStarting;
+}
+
+//==============================================================================
+std::size_t DantzigBoxedLcpSolver::getNumWarmStarts() const
+{
+  return mNumWarmStarts;
 }
 
 #ifndef NDEBUG
@@ -33,14 +33,29 @@
 #ifndef DART_CONSTRAINT_DANTZIGBOXEDLCPSOLVER_HPP_
 #define DART_CONSTRAINT_DANTZIGBOXEDLCPSOLVER_HPP_
 
+#include <memory>
+
 #include "dart/constraint/BoxedLcpSolver.hpp"
 
 namespace dart {
+
+namespace external {
+namespace ode {
+struct dLCPWorkspace;
+} // namespace ode
+} // namespace external
+
 namespace constraint {
 
 class DantzigBoxedLcpSolver : public BoxedLcpSolver
 {
 public:
+  /// Constructor
+  DantzigBoxedLcpSolver();
+
+  /// Destructor
+  ~DantzigBoxedLcpSolver() override;
+
   // Documentation inherited.
   const std::string& getType() const override;
 
@@ -59,10 +74,41 @@ public:
       int* findex,
       bool earlyTermination) override;
 
+  // Documentation inherited.
+  void reserve(int n) override;
+
+  /// Sets whether solve() first tries the index sets guessed by the initial x,
+  /// which is typically the solution of the previous step. The guess is
+  /// accepted only if a single factorization of its clamped rows solves the
+  /// LCP; otherwise the Dantzig pivoting starts from scratch as usual. This
+  /// turns most solves of resting contacts into a single factorization when
+  /// the constraints report their previous impulses (see
+  /// ConstraintSolver::setWarmStarting()). Disabled by default.
+  void setWarmStarting(bool warmStarting);
+
+  /// Returns true if solve() first tries the index sets guessed by the
+  /// initial x
+  bool isWarmStarting() const;
+
+  /// Returns the number of solves that were solved by the guess of the initial
+  /// x since warm starting was last set
+  std::size_t getNumWarmStarts() const;
+
 #ifndef NDEBUG
   // Documentation inherited.
   bool canSolve(int n, const double* A) override;
 #endif
+
+protected:
+  /// Scratch memory of the Dantzig solver, which is reused across the solves
+  /// and only grows
+  std::unique_ptr<external::ode::dLCPWorkspace> mWorkspace;
+
+  /// Whether solve() first tries the index sets guessed by the initial x
+  bool mIsWarmStarting;
+
+  /// Number of solves that were solved by the guess of the initial x
+  std::size_t mNumWarmStarts;
 };
 
 } // namespace constraint
@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/constraint/ImpulseResponseCache.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/PointMass.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+
+namespace dart {
+namespace constraint {
+
+//==============================================================================
+ImpulseResponseCache::ImpulseResponseCache() : mNumUnitImpulses(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void ImpulseResponseCache::clear()
+{
+  mEntries.clear();
+  mGroups.clear();
+  mLookup.clear();
+  mExcitedGroups.clear();
+  mPointMasses.clear();
+  mExcitedPointMasses.clear();
+  mNumUnitImpulses = 0;
+}
+
+//==============================================================================
+void ImpulseResponseCache::addBodyNode(dynamics::BodyNode* bodyNode)
+{
+  assert(bodyNode);
+
+  mEntries.emplace_back();
+  mEntries.back().mBodyNode = bodyNode;
+}
+
+//==============================================================================
+void ImpulseResponseCache::addPointMass(dynamics::PointMass* pointMass)
+{
+  assert(pointMass);
+
+  mPointMasses.emplace_back();
+  mPointMasses.back().mPointMass = pointMass;
+}
+
+//==============================================================================
+void ImpulseResponseCache::update()
+{
+  for (auto& entry : mEntries)
+    entry.mSkeleton = entry.mBodyNode->getSkeleton().get();
+
+  // Sort the BodyNodes by their Skeletons so that the BodyNodes of each
+  // Skeleton are adjacent, and remove the duplicates
+  std::sort(
+      mEntries.begin(), mEntries.end(), [](const Entry& a, const Entry& b) {
+        if (a.mSkeleton != b.mSkeleton)
+          return std::less<dynamics::Skeleton*>()(a.mSkeleton, b.mSkeleton);
+        return a.mBodyNode->getIndexInSkeleton()
+               < b.mBodyNode->getIndexInSkeleton();
+      });
+  mEntries.erase(
+      std::unique(
+          mEntries.begin(),
+          mEntries.end(),
+          [](const Entry& a, const Entry& b) {
+            return a.mBodyNode == b.mBodyNode;
+          }),
+      mEntries.end());
+
+  mGroups.clear();
+  mLookup.clear();
+  mExcitedGroups.clear();
+  mExcitedPointMasses.clear();
+  mNumUnitImpulses = 0;
+  std::size_t numResponses = 0u;
+  for (std::size_t i = 0u; i < mEntries.size(); ++i)
+  {
+    if (i == 0u || mEntries[i].mSkeleton != mEntries[i - 1u].mSkeleton)
+    {
+      if (!mGroups.empty())
+        numResponses += mGroups.back().mSize * mGroups.back().mSize;
+      mGroups.push_back({i, 0u, numResponses, false});
+    }
+
+    ++mGroups.back().mSize;
+    mEntries[i].mGroup = mGroups.size() - 1u;
+    mLookup.emplace_back(mEntries[i].mBodyNode, i);
+  }
+  if (!mGroups.empty())
+    numResponses += mGroups.back().mSize * mGroups.back().mSize;
+
+  std::sort(
+      mLookup.begin(),
+      mLookup.end(),
+      [](const std::pair<const dynamics::BodyNode*, std::size_t>& a,
+         const std::pair<const dynamics::BodyNode*, std::size_t>& b) {
+        return std::less<const dynamics::BodyNode*>()(a.first, b.first);
+      });
+  if (mResponses.size() < numResponses)
+    mResponses.resize(numResponses);
+
+  // Apply the unit spatial impulses to each BodyNode, and store the velocity
+  // changes of the BodyNodes of the same Skeleton
+  Eigen::Vector6d impulse;
+  for (const Group& group : mGroups)
+  {
+    dynamics::Skeleton* skeleton = mEntries[group.mBegin].mSkeleton;
+
+    for (std::size_t j = 0u; j < group.mSize; ++j)
+    {
+      dynamics::BodyNode* source = mEntries[group.mBegin + j].mBodyNode;
+
+      skeleton->clearConstraintImpulses();
+      for (int k = 0; k < 6; ++k)
+      {
+        impulse.setZero();
+        impulse[k] = 1.0;
+        skeleton->updateBiasImpulse(source, impulse);
+        skeleton->updateVelocityChange();
+
+        for (std::size_t i = 0u; i < group.mSize; ++i)
+        {
+          mResponses[group.mResponseOffset + i * group.mSize + j].col(k)
+              = mEntries[group.mBegin + i].mBodyNode->getBodyVelocityChange();
+        }
+      }
+    }
+  }
+
+  // The point masses need no impulse recursion. See the class documentation.
+  std::sort(
+      mPointMasses.begin(),
+      mPointMasses.end(),
+      [](const PointMassEntry& a, const PointMassEntry& b) {
+        return std::less<dynamics::PointMass*>()(a.mPointMass, b.mPointMass);
+      });
+  mPointMasses.erase(
+      std::unique(
+          mPointMasses.begin(),
+          mPointMasses.end(),
+          [](const PointMassEntry& a, const PointMassEntry& b) {
+            return a.mPointMass == b.mPointMass;
+          }),
+      mPointMasses.end());
+
+  for (auto& entry : mPointMasses)
+  {
+    entry.mPsi = entry.mPointMass->getPsi();
+    entry.mIsImpulseApplied = false;
+  }
+}
+
+//==============================================================================
+std::size_t ImpulseResponseCache::getNumBodyNodes() const
+{
+  return mEntries.size();
+}
+
+//==============================================================================
+std::size_t ImpulseResponseCache::getNumPointMasses() const
+{
+  return mPointMasses.size();
+}
+
+//==============================================================================
+const Eigen::Matrix6d& ImpulseResponseCache::getResponse(
+    const dynamics::BodyNode* bodyNode, const dynamics::BodyNode* source) const
+{
+  const std::size_t index = getIndex(bodyNode);
+  const std::size_t sourceIndex = getIndex(source);
+  const Group& group = mGroups[mEntries[index].mGroup];
+  assert(mEntries[sourceIndex].mGroup == mEntries[index].mGroup);
+
+  const std::size_t i = index - group.mBegin;
+  const std::size_t j = sourceIndex - group.mBegin;
+
+  return mResponses[group.mResponseOffset + i * group.mSize + j];
+}
+
+//==============================================================================
+void ImpulseResponseCache::clearUnitImpulses()
+{
+  for (const std::size_t group : mExcitedGroups)
+    mGroups[group].mIsImpulseApplied = false;
+
+  for (const std::size_t pointMass : mExcitedPointMasses)
+    mPointMasses[pointMass].mIsImpulseApplied = false;
+
+  mExcitedGroups.clear();
+  mExcitedPointMasses.clear();
+  mNumUnitImpulses = 0;
+}
+
+//==============================================================================
+void ImpulseResponseCache::applyUnitImpulses(
+    const dynamics::BodyNode* bodyNode, const RowImpulses& impulses)
+{
+  assert(mNumUnitImpulses == 0 || mNumUnitImpulses == impulses.cols());
+  mNumUnitImpulses = static_cast<int>(impulses.cols());
+
+  const std::size_t j = getIndex(bodyNode);
+  Group& group = mGroups[mEntries[j].mGroup];
+
+  if (!group.mIsImpulseApplied)
+  {
+    for (std::size_t i = 0u; i < group.mSize; ++i)
+      mEntries[group.mBegin + i].mVelocityChanges.setZero(6, impulses.cols());
+
+    group.mIsImpulseApplied = true;
+    mExcitedGroups.push_back(mEntries[j].mGroup);
+  }
+
+  const Eigen::Matrix6d* responses
+      = &mResponses[group.mResponseOffset + j - group.mBegin];
+  for (std::size_t i = 0u; i < group.mSize; ++i)
+  {
+    RowImpulses& velocityChanges = mEntries[group.mBegin + i].mVelocityChanges;
+    assert(velocityChanges.cols() == impulses.cols());
+    velocityChanges.noalias() += responses[i * group.mSize] * impulses;
+  }
+}
+
+//==============================================================================
+void ImpulseResponseCache::applyUnitImpulses(
+    const dynamics::PointMass* pointMass, const PointMassImpulses& impulses)
+{
+  assert(mNumUnitImpulses == 0 || mNumUnitImpulses == impulses.cols());
+  mNumUnitImpulses = static_cast<int>(impulses.cols());
+
+  const std::size_t index = getIndex(pointMass);
+  PointMassEntry& entry = mPointMasses[index];
+
+  if (!entry.mIsImpulseApplied)
+  {
+    entry.mVelocityChanges.setZero(3, impulses.cols());
+    entry.mIsImpulseApplied = true;
+    mExcitedPointMasses.push_back(index);
+  }
+
+  assert(entry.mVelocityChanges.cols() == impulses.cols());
+  entry.mVelocityChanges.noalias() += entry.mPsi * impulses;
+}
+
+//==============================================================================
+int ImpulseResponseCache::getNumUnitImpulses() const
+{
+  return mNumUnitImpulses;
+}
+
+//==============================================================================
+const ImpulseResponseCache::RowImpulses*
+ImpulseResponseCache::getVelocityChanges(
+    const dynamics::BodyNode* bodyNode) const
+{
+  const Entry& entry = mEntries[getIndex(bodyNode)];
+  if (!mGroups[entry.mGroup].mIsImpulseApplied)
+    return nullptr;
+
+  return &entry.mVelocityChanges;
+}
+
+//==============================================================================
+const ImpulseResponseCache::PointMassImpulses*
+ImpulseResponseCache::getVelocityChanges(
+    const dynamics::PointMass* pointMass) const
+{
+  const PointMassEntry& entry = mPointMasses[getIndex(pointMass)];
+  if (!entry.mIsImpulseApplied)
+    return nullptr;
+
+  return &entry.mVelocityChanges;
+}
+
+//==============================================================================
+void ImpulseResponseCache::reserve(
+    std::size_t numBodyNodes, std::size_t numPointMasses)
+{
+  // Enough responses for BodyNodes of distinct Skeletons. Skeletons with more
+  // than one BodyNode in the cache grow mResponses once to their size.
+  if (mResponses.size() < numBodyNodes)
+    mResponses.resize(numBodyNodes);
+
+  mEntries.reserve(numBodyNodes);
+  mGroups.reserve(numBodyNodes);
+  mLookup.reserve(numBodyNodes);
+  mExcitedGroups.reserve(numBodyNodes);
+  mPointMasses.reserve(numPointMasses);
+  mExcitedPointMasses.reserve(numPointMasses);
+}
+
+//==============================================================================
+std::size_t ImpulseResponseCache::getIndex(
+    const dynamics::BodyNode* bodyNode) const
+{
+  const auto it = std::lower_bound(
+      mLookup.begin(),
+      mLookup.end(),
+      bodyNode,
+      [](const std::pair<const dynamics::BodyNode*, std::size_t>& entry,
+         const dynamics::BodyNode* key) {
+        return std::less<const dynamics::BodyNode*>()(entry.first, key);
+      });
+  assert(it != mLookup.end() && it->first == bodyNode);
+
+  return it->second;
+}
+
+//==============================================================================
+std::size_t ImpulseResponseCache::getIndex(
+    const dynamics::PointMass* pointMass) const
+{
+  const auto it = std::lower_bound(
+      mPointMasses.begin(),
+      mPointMasses.end(),
+      pointMass,
+      [](const PointMassEntry& entry, const dynamics::PointMass* key) {
+        return std::less<const dynamics::PointMass*>()(entry.mPointMass, key);
+      });
+  assert(it != mPointMasses.end() && it->mPointMass == pointMass);
+
+  return static_cast<std::size_t>(it - mPointMasses.begin());
+}
+
+} // namespace constraint
+} // namespace dart
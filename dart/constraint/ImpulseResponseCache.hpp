@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_CONSTRAINT_IMPULSERESPONSECACHE_HPP_
+#define DART_CONSTRAINT_IMPULSERESPONSECACHE_HPP_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/common/Memory.hpp"
+#include "dart/math/MathTypes.hpp"
+
+namespace dart {
+
+namespace dynamics {
+class BodyNode;
+class PointMass;
+class Skeleton;
+} // namespace dynamics
+
+namespace constraint {
+
+/// ImpulseResponseCache holds the responses of BodyNodes to unit impulses on
+/// BodyNodes of the same Skeleton, which are the blocks of the inverse
+/// operational space inertia between the BodyNodes.
+///
+/// The LCP of a constrained group is built by impulse tests, which run the
+/// articulated body impulse recursion of a Skeleton once per constraint row.
+/// The rows of all the contacts on a BodyNode are impulses on the same
+/// BodyNode, so their tests can share the responses to the six unit spatial
+/// impulses on it. The cache computes those responses once per BodyNode and
+/// then plays the role of the Skeletons in the impulse tests: it combines the
+/// responses into the velocity changes of the BodyNodes per unit impulse.
+///
+/// The cache also holds the point masses of SoftBodyNodes that soft contacts
+/// are applied to. The impulse recursion passes no impulse from a point mass
+/// to its SoftBodyNode, so an impulse on a point mass only changes the
+/// velocity of the point mass itself, by its Psi times the impulse. The
+/// responses of the point masses are therefore read once per point mass
+/// without any impulse recursion.
+class ImpulseResponseCache
+{
+public:
+  /// Velocity changes of a BodyNode per unit impulse on each of the rows of a
+  /// constraint, or the impulses of the rows, in the frame of the BodyNode
+  using RowImpulses = Eigen::Matrix<double, 6, Eigen::Dynamic, 0, 6, 3>;
+
+  /// Velocity changes of a point mass per unit impulse on each of the rows of
+  /// a constraint, or the impulses of the rows, in the frame of the parent
+  /// SoftBodyNode of the point mass
+  using PointMassImpulses = Eigen::Matrix<double, 3, Eigen::Dynamic, 0, 3, 3>;
+
+  /// Constructor
+  ImpulseResponseCache();
+
+  /// Removes all the BodyNodes and point masses. The memory is kept for reuse.
+  void clear();
+
+  /// Adds a BodyNode that impulses are applied to and whose velocity changes
+  /// are read. Adding the same BodyNode more than once is allowed.
+  void addBodyNode(dynamics::BodyNode* bodyNode);
+
+  /// Adds a point mass that impulses are applied to and whose velocity changes
+  /// are read. Adding the same point mass more than once is allowed.
+  void addPointMass(dynamics::PointMass* pointMass);
+
+  /// Computes the responses between the added BodyNodes of each Skeleton and
+  /// the responses of the added point masses. This uses the impulse recursion
+  /// of the Skeletons, which clears their constraint impulses.
+  void update();
+
+  /// Returns the number of BodyNodes in the cache
+  std::size_t getNumBodyNodes() const;
+
+  /// Returns the number of point masses in the cache
+  std::size_t getNumPointMasses() const;
+
+  /// Returns the velocity change of \c bodyNode per unit spatial impulse on
+  /// \c source, where both are in the cache and in the same Skeleton
+  const Eigen::Matrix6d& getResponse(
+      const dynamics::BodyNode* bodyNode,
+      const dynamics::BodyNode* source) const;
+
+  /// Clears the unit impulses applied by applyUnitImpulses()
+  void clearUnitImpulses();
+
+  /// Applies the unit impulses of the rows of a constraint to \c bodyNode,
+  /// which adds their responses to the velocity changes of the BodyNodes in
+  /// the same Skeleton. All the impulses applied between two calls of
+  /// clearUnitImpulses() must have the same number of rows.
+  void applyUnitImpulses(
+      const dynamics::BodyNode* bodyNode, const RowImpulses& impulses);
+
+  /// Applies the unit impulses of the rows of a constraint to \c pointMass,
+  /// which changes the velocity of \c pointMass only. The same rules as for
+  /// the unit impulses on BodyNodes apply.
+  void applyUnitImpulses(
+      const dynamics::PointMass* pointMass, const PointMassImpulses& impulses);
+
+  /// Returns the number of rows of the unit impulses applied since the last
+  /// clearUnitImpulses()
+  int getNumUnitImpulses() const;
+
+  /// Returns the velocity changes of \c bodyNode per unit impulse on each
+  /// row, or nullptr if no unit impulse was applied to its Skeleton
+  const RowImpulses* getVelocityChanges(
+      const dynamics::BodyNode* bodyNode) const;
+
+  /// Returns the velocity changes of \c pointMass per unit impulse on each
+  /// row, or nullptr if no unit impulse was applied to \c pointMass
+  const PointMassImpulses* getVelocityChanges(
+      const dynamics::PointMass* pointMass) const;
+
+  /// Allocates the memory for up to \c numBodyNodes BodyNodes and
+  /// \c numPointMasses point masses
+  void reserve(std::size_t numBodyNodes, std::size_t numPointMasses = 0u);
+
+private:
+  struct Entry
+  {
+    dynamics::BodyNode* mBodyNode;
+
+    dynamics::Skeleton* mSkeleton;
+
+    /// Index of the group of the Skeleton
+    std::size_t mGroup;
+
+    /// Velocity changes per unit impulse on each row
+    RowImpulses mVelocityChanges;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  /// BodyNodes of the same Skeleton, which are adjacent in mEntries
+  struct Group
+  {
+    std::size_t mBegin;
+
+    std::size_t mSize;
+
+    /// Index of the first response between the BodyNodes in mResponses
+    std::size_t mResponseOffset;
+
+    /// Whether unit impulses were applied to the Skeleton
+    bool mIsImpulseApplied;
+  };
+
+  struct PointMassEntry
+  {
+    dynamics::PointMass* mPointMass;
+
+    /// Velocity change of the point mass per unit impulse on it
+    double mPsi;
+
+    /// Whether unit impulses were applied to the point mass
+    bool mIsImpulseApplied;
+
+    /// Velocity changes per unit impulse on each row
+    PointMassImpulses mVelocityChanges;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  /// Returns the index of \c bodyNode in mEntries
+  std::size_t getIndex(const dynamics::BodyNode* bodyNode) const;
+
+  /// Returns the index of \c pointMass in mPointMasses
+  std::size_t getIndex(const dynamics::PointMass* pointMass) const;
+
+  /// BodyNodes sorted by their Skeletons
+  common::aligned_vector<Entry> mEntries;
+
+  /// Groups of the BodyNodes of each Skeleton
+  std::vector<Group> mGroups;
+
+  /// BodyNodes sorted by address, and their indices in mEntries
+  std::vector<std::pair<const dynamics::BodyNode*, std::size_t>> mLookup;
+
+  /// Responses between the BodyNodes of each group, which are stored in the
+  /// row-major order of (BodyNode, source) per group
+  common::aligned_vector<Eigen::Matrix6d> mResponses;
+
+  /// Groups with unit impulses applied since the last clearUnitImpulses()
+  std::vector<std::size_t> mExcitedGroups;
+
+  /// Point masses sorted by address
+  common::aligned_vector<PointMassEntry> mPointMasses;
+
+  /// Point masses with unit impulses applied since the last
+  /// clearUnitImpulses()
+  std::vector<std::size_t> mExcitedPointMasses;
+
+  /// Number of rows of the applied unit impulses
+  int mNumUnitImpulses;
+};
+
+} // namespace constraint
+} // namespace dart
+
+#endif // DART_CONSTRAINT_IMPULSERESPONSECACHE_HPP_
@@ -45,14 +45,14 @@
 namespace dart {
 namespace constraint {
 
-double JointConstraint::mErrorAllowance = DART_ERROR_ALLOWANCE;
-double JointConstraint::mErrorReductionParameter = DART_ERP;
-double JointConstraint::mMaxErrorReductionVelocity = DART_MAX_ERV;
-double JointConstraint::mConstraintForceMixing = DART_CFM;
+ConstraintParameters JointConstraint::mDefaultParameters(
+    DART_ERROR_ALLOWANCE, DART_ERP, DART_MAX_ERV, DART_CFM);
 
 //==============================================================================
 JointConstraint::JointConstraint(dynamics::BodyNode* _body)
-  : ConstraintBase(), mBodyNode1(_body), mBodyNode2(nullptr)
+  : ConstraintBase(mDefaultParameters),
+    mBodyNode1(_body),
+    mBodyNode2(nullptr)
 {
   assert(_body);
 }
@@ -60,7 +60,9 @@ JointConstraint::JointConstraint(dynamics::BodyNode* _body)
 //==============================================================================
 JointConstraint::JointConstraint(
     dynamics::BodyNode* _body1, dynamics::BodyNode* _body2)
-  : ConstraintBase(), mBodyNode1(_body1), mBodyNode2(_body2)
+  : ConstraintBase(mDefaultParameters),
+    mBodyNode1(_body1),
+    mBodyNode2(_body2)
 {
   assert(_body1);
   assert(_body2);
@@ -80,16 +82,16 @@ void JointConstraint::setErrorAllowance(double _allowance)
     dtwarn << "Error reduction parameter[" << _allowance
            << "] is lower than 0.0. "
            << "It is set to 0.0." << std::endl;
-    mErrorAllowance = 0.0;
+    mDefaultParameters.errorAllowance = 0.0;
   }
 
-  mErrorAllowance = _allowance;
+  mDefaultParameters.errorAllowance = _allowance;
 }
 
 //==============================================================================
 double JointConstraint::getErrorAllowance()
 {
-  return mErrorAllowance;
+  return mDefaultParameters.errorAllowance;
 }
 
 //==============================================================================
@@ -100,22 +102,22 @@ void JointConstraint::setErrorReductionParameter(double _erp)
   {
     dtwarn << "Error reduction parameter[" << _erp << "] is lower than 0.0. "
            << "It is set to 0.0." << std::endl;
-    mErrorReductionParameter = 0.0;
+    mDefaultParameters.errorReductionParameter = 0.0;
   }
   if (_erp > 1.0)
   {
     dtwarn << "Error reduction parameter[" << _erp << "] is greater than 1.0. "
            << "It is set to 1.0." << std::endl;
-    mErrorReductionParameter = 1.0;
+    mDefaultParameters.errorReductionParameter = 1.0;
   }
 
-  mErrorReductionParameter = _erp;
+  mDefaultParameters.errorReductionParameter = _erp;
 }
 
 //==============================================================================
 double JointConstraint::getErrorReductionParameter()
 {
-  return mErrorReductionParameter;
+  return mDefaultParameters.errorReductionParameter;
 }
 
 //==============================================================================
@@ -127,16 +129,16 @@ void JointConstraint::setMaxErrorReductionVelocity(double _erv)
     dtwarn << "Maximum error reduction velocity[" << _erv
            << "] is lower than 0.0. "
            << "It is set to 0.0." << std::endl;
-    mMaxErrorReductionVelocity = 0.0;
+    mDefaultParameters.maxErrorReductionVelocity = 0.0;
   }
 
-  mMaxErrorReductionVelocity = _erv;
+  mDefaultParameters.maxErrorReductionVelocity = _erv;
 }
 
 //==============================================================================
 double JointConstraint::getMaxErrorReductionVelocity()
 {
-  return mMaxErrorReductionVelocity;
+  return mDefaultParameters.maxErrorReductionVelocity;
 }
 
 //==============================================================================
@@ -148,16 +150,22 @@ void JointConstraint::setConstraintForceMixing(double _cfm)
     dtwarn << "Constraint force mixing parameter[" << _cfm
            << "] is lower than 1e-9. "
            << "It is set to 1e-9." << std::endl;
-    mConstraintForceMixing = 1e-9;
+    mDefaultParameters.constraintForceMixing = 1e-9;
   }
 
-  mConstraintForceMixing = _cfm;
+  mDefaultParameters.constraintForceMixing = _cfm;
 }
 
 //==============================================================================
 double JointConstraint::getConstraintForceMixing()
 {
-  return mConstraintForceMixing;
+  return mDefaultParameters.constraintForceMixing;
+}
+
+//==============================================================================
+const ConstraintParameters& JointConstraint::getDefaultParameters()
+{
+  return mDefaultParameters;
 }
 
 //==============================================================================
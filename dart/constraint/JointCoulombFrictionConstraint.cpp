@@ -44,12 +44,13 @@
 namespace dart {
 namespace constraint {
 
-double JointCoulombFrictionConstraint::mConstraintForceMixing = DART_CFM;
+ConstraintParameters JointCoulombFrictionConstraint::mDefaultParameters(
+    0.0, 0.0, 0.0, DART_CFM);
 
 //==============================================================================
 JointCoulombFrictionConstraint::JointCoulombFrictionConstraint(
     dynamics::Joint* _joint)
-  : ConstraintBase(),
+  : ConstraintBase(mDefaultParameters),
     mJoint(_joint),
     mBodyNode(_joint->getChildBodyNode()),
     mAppliedImpulseIndex(0)
@@ -99,16 +100,23 @@ void JointCoulombFrictionConstraint::setConstraintForceMixing(double _cfm)
     dtwarn << "Constraint force mixing parameter[" << _cfm
            << "] is lower than 1e-9. "
            << "It is set to 1e-9." << std::endl;
-    mConstraintForceMixing = 1e-9;
+    mDefaultParameters.constraintForceMixing = 1e-9;
   }
 
-  mConstraintForceMixing = _cfm;
+  mDefaultParameters.constraintForceMixing = _cfm;
 }
 
 //==============================================================================
 double JointCoulombFrictionConstraint::getConstraintForceMixing()
 {
-  return mConstraintForceMixing;
+  return mDefaultParameters.constraintForceMixing;
+}
+
+//==============================================================================
+const ConstraintParameters&
+JointCoulombFrictionConstraint::getDefaultParameters()
+{
+  return mDefaultParameters;
 }
 
 //==============================================================================
@@ -238,7 +246,7 @@ void JointCoulombFrictionConstraint::getVelocityChange(
   if (_withCfm)
   {
     _delVel[mAppliedImpulseIndex]
-        += _delVel[mAppliedImpulseIndex] * mConstraintForceMixing;
+        += _delVel[mAppliedImpulseIndex] * mParameters.constraintForceMixing;
   }
 
   assert(localIndex == mDim);
@@ -49,14 +49,12 @@
 namespace dart {
 namespace constraint {
 
-double JointLimitConstraint::mErrorAllowance = DART_ERROR_ALLOWANCE;
-double JointLimitConstraint::mErrorReductionParameter = DART_ERP;
-double JointLimitConstraint::mMaxErrorReductionVelocity = DART_MAX_ERV;
-double JointLimitConstraint::mConstraintForceMixing = DART_CFM;
+ConstraintParameters JointLimitConstraint::mDefaultParameters(
+    DART_ERROR_ALLOWANCE, DART_ERP, DART_MAX_ERV, DART_CFM);
 
 //==============================================================================
 JointLimitConstraint::JointLimitConstraint(dynamics::Joint* joint)
-  : ConstraintBase(),
+  : ConstraintBase(mDefaultParameters),
     mJoint(joint),
     mBodyNode(joint->getChildBodyNode()),
     mAppliedImpulseIndex(0)
@@ -92,16 +90,16 @@ void JointLimitConstraint::setErrorAllowance(double allowance)
     dtwarn << "Error reduction parameter[" << allowance
            << "] is lower than 0.0. "
            << "It is set to 0.0." << std::endl;
-    mErrorAllowance = 0.0;
+    mDefaultParameters.errorAllowance = 0.0;
   }
 
-  mErrorAllowance = allowance;
+  mDefaultParameters.errorAllowance = allowance;
 }
 
 //==============================================================================
 double JointLimitConstraint::getErrorAllowance()
 {
-  return mErrorAllowance;
+  return mDefaultParameters.errorAllowance;
 }
 
 //==============================================================================
@@ -112,22 +110,22 @@ void JointLimitConstraint::setErrorReductionParameter(double erp)
   {
     dtwarn << "Error reduction parameter[" << erp << "] is lower than 0.0. "
            << "It is set to 0.0." << std::endl;
-    mErrorReductionParameter = 0.0;
+    mDefaultParameters.errorReductionParameter = 0.0;
   }
   if (erp > 1.0)
   {
     dtwarn << "Error reduction parameter[" << erp << "] is greater than 1.0. "
            << "It is set to 1.0." << std::endl;
-    mErrorReductionParameter = 1.0;
+    mDefaultParameters.errorReductionParameter = 1.0;
   }
 
-  mErrorReductionParameter = erp;
+  mDefaultParameters.errorReductionParameter = erp;
 }
 
 //==============================================================================
 double JointLimitConstraint::getErrorReductionParameter()
 {
-  return mErrorReductionParameter;
+  return mDefaultParameters.errorReductionParameter;
 }
 
 //==============================================================================
@@ -139,16 +137,16 @@ void JointLimitConstraint::setMaxErrorReductionVelocity(double erv)
     dtwarn << "Maximum error reduction velocity[" << erv
            << "] is lower than 0.0. "
            << "It is set to 0.0." << std::endl;
-    mMaxErrorReductionVelocity = 0.0;
+    mDefaultParameters.maxErrorReductionVelocity = 0.0;
   }
 
-  mMaxErrorReductionVelocity = erv;
+  mDefaultParameters.maxErrorReductionVelocity = erv;
 }
 
 //==============================================================================
 double JointLimitConstraint::getMaxErrorReductionVelocity()
 {
-  return mMaxErrorReductionVelocity;
+  return mDefaultParameters.maxErrorReductionVelocity;
 }
 
 //==============================================================================
@@ -160,16 +158,22 @@ void JointLimitConstraint::setConstraintForceMixing(double cfm)
     dtwarn << "Constraint force mixing parameter[" << cfm
            << "] is lower than 1e-9. "
            << "It is set to 1e-9." << std::endl;
-    mConstraintForceMixing = 1e-9;
+    mDefaultParameters.constraintForceMixing = 1e-9;
   }
 
-  mConstraintForceMixing = cfm;
+  mDefaultParameters.constraintForceMixing = cfm;
 }
 
 //==============================================================================
 double JointLimitConstraint::getConstraintForceMixing()
 {
-  return mConstraintForceMixing;
+  return mDefaultParameters.constraintForceMixing;
+}
+
+//==============================================================================
+const ConstraintParameters& JointLimitConstraint::getDefaultParameters()
+{
+  return mDefaultParameters;
 }
 
 //==============================================================================
@@ -180,22 +184,18 @@ void JointLimitConstraint::update()
 
   const int dof = static_cast<int>(mJoint->getNumDofs());
 
-  const Eigen::VectorXd positions = mJoint->getPositions();
-  const Eigen::VectorXd velocities = mJoint->getVelocities();
-
-  const Eigen::VectorXd positionLowerLimits = mJoint->getPositionLowerLimits();
-  const Eigen::VectorXd positionUpperLimits = mJoint->getPositionUpperLimits();
-
-  const Eigen::VectorXd velocityLowerLimits = mJoint->getVelocityLowerLimits();
-  const Eigen::VectorXd velocityUpperLimits = mJoint->getVelocityUpperLimits();
-
+  // The joint states are read per coordinate because the vector getters
+  // return copies, which would allocate memory every step
   for (int i = 0; i < dof; ++i)
   {
+    const double position = mJoint->getPosition(i);
+    const double velocity = mJoint->getVelocity(i);
+
     // Check lower position bound
-    mViolation[i] = positions[i] - positionLowerLimits[i];
+    mViolation[i] = position - mJoint->getPositionLowerLimit(i);
     if (mViolation[i] < 0.0)
     {
-      mNegativeVel[i] = -velocities[i];
+      mNegativeVel[i] = -velocity;
       mLowerBound[i] = 0.0;
       mUpperBound[i] = static_cast<double>(dInfinity);
 
@@ -214,10 +214,10 @@ void JointLimitConstraint::update()
     }
 
     // Check upper position bound
-    mViolation[i] = positions[i] - positionUpperLimits[i];
+    mViolation[i] = position - mJoint->getPositionUpperLimit(i);
     if (mViolation[i] > 0.0)
     {
-      mNegativeVel[i] = -velocities[i];
+      mNegativeVel[i] = -velocity;
       mLowerBound[i] = -static_cast<double>(dInfinity);
       mUpperBound[i] = 0.0;
 
@@ -238,7 +238,7 @@ void JointLimitConstraint::update()
     mIsPositionLimitViolated[i] = false;
 
     // Check lower velocity bound
-    mViolation[i] = velocities[i] - velocityLowerLimits[i];
+    mViolation[i] = velocity - mJoint->getVelocityLowerLimit(i);
     if (mViolation[i] < 0.0)
     {
       mNegativeVel[i] = -mViolation[i];
@@ -260,7 +260,7 @@ void JointLimitConstraint::update()
     }
 
     // Check upper velocity bound
-    mViolation[i] = velocities[i] - velocityUpperLimits[i];
+    mViolation[i] = velocity - mJoint->getVelocityUpperLimit(i);
     if (mViolation[i] > 0.0)
     {
       mNegativeVel[i] = -mViolation[i];
@@ -299,14 +299,14 @@ void JointLimitConstraint::getInformation(ConstraintInfo* lcp)
       double bouncingVel = -mViolation[i];
 
       if (bouncingVel > 0.0)
-        bouncingVel = -mErrorAllowance;
+        bouncingVel = -mParameters.errorAllowance;
       else
-        bouncingVel = +mErrorAllowance;
+        bouncingVel = +mParameters.errorAllowance;
 
-      bouncingVel *= lcp->invTimeStep * mErrorReductionParameter;
+      bouncingVel *= lcp->invTimeStep * mParameters.errorReductionParameter;
 
-      if (bouncingVel > mMaxErrorReductionVelocity)
-        bouncingVel = mMaxErrorReductionVelocity;
+      if (bouncingVel > mParameters.maxErrorReductionVelocity)
+        bouncingVel = mParameters.maxErrorReductionVelocity;
 
       lcp->b[index] = mNegativeVel[i] + bouncingVel;
 
@@ -414,7 +414,7 @@ void JointLimitConstraint::getVelocityChange(double* delVel, bool withCfm)
   if (withCfm)
   {
     delVel[mAppliedImpulseIndex]
-        += delVel[mAppliedImpulseIndex] * mConstraintForceMixing;
+        += delVel[mAppliedImpulseIndex] * mParameters.constraintForceMixing;
   }
 
   assert(localIndex == mDim);
@@ -35,7 +35,9 @@
 
 #include <Eigen/Dense>
 
+#include "dart/common/Deprecated.hpp"
 #include "dart/constraint/ConstraintBase.hpp"
+#include "dart/constraint/ConstraintParameters.hpp"
 
 namespace dart {
 
@@ -66,30 +68,58 @@ public:
   // Property settings
   //----------------------------------------------------------------------------
 
-  /// Set global error reduction parameter
+  /// Set the default constraint error allowance
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::setJointLimitParameters() instead.
+  DART_DEPRECATED(6.10)
   static void setErrorAllowance(double allowance);
 
-  /// Get global error reduction parameter
+  /// Get the default constraint error allowance
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::getJointLimitParameters() instead.
+  DART_DEPRECATED(6.10)
   static double getErrorAllowance();
 
-  /// Set global error reduction parameter
+  /// Set the default error reduction parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::setJointLimitParameters() instead.
+  DART_DEPRECATED(6.10)
   static void setErrorReductionParameter(double erp);
 
-  /// Get global error reduction parameter
+  /// Get the default error reduction parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::getJointLimitParameters() instead.
+  DART_DEPRECATED(6.10)
   static double getErrorReductionParameter();
 
-  /// Set global error reduction parameter
+  /// Set the default maximum error reduction velocity
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::setJointLimitParameters() instead.
+  DART_DEPRECATED(6.10)
   static void setMaxErrorReductionVelocity(double erv);
 
-  /// Get global error reduction parameter
+  /// Get the default maximum error reduction velocity
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::getJointLimitParameters() instead.
+  DART_DEPRECATED(6.10)
   static double getMaxErrorReductionVelocity();
 
-  /// Set global constraint force mixing parameter
+  /// Set the default constraint force mixing parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::setJointLimitParameters() instead.
+  DART_DEPRECATED(6.10)
   static void setConstraintForceMixing(double cfm);
 
-  /// Get global constraint force mixing parameter
+  /// Get the default constraint force mixing parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::getJointLimitParameters() instead.
+  DART_DEPRECATED(6.10)
   static double getConstraintForceMixing();
 
+  /// Get the default parameters of the constraints that are created
+  /// afterwards
+  static const ConstraintParameters& getDefaultParameters();
+
   //----------------------------------------------------------------------------
   // Friendship
   //----------------------------------------------------------------------------
@@ -163,20 +193,8 @@ private:
   /// Lower limit of the constraint impulse.
   Eigen::Matrix<double, 6, 1> mLowerBound;
 
-  /// Global constraint error allowance
-  static double mErrorAllowance;
-
-  /// Global constraint error redection parameter in the range of [0, 1]. The
-  /// default is 0.01.
-  static double mErrorReductionParameter;
-
-  /// Maximum error reduction velocity
-  static double mMaxErrorReductionVelocity;
-
-  /// Global constraint force mixing parameter in the range of [1e-9, 1]. The
-  /// default is 1e-5
-  /// \sa http://www.ode.org/ode-latest-userguide.html#sec_3_8_0
-  static double mConstraintForceMixing;
+  /// Default parameters of the constraints that are created afterwards
+  static ConstraintParameters mDefaultParameters;
 };
 
 } // namespace constraint
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/constraint/LemkeBoxedLcpSolver.hpp"
+
+#include <cassert>
+#include <cmath>
+#include "dart/external/odelcpsolver/matrix.h"
+
+namespace dart {
+namespace constraint {
+
+//==============================================================================
+LemkeBoxedLcpSolver::LemkeBoxedLcpSolver()
+{
+  // Do nothing
+}
+
+//==============================================================================
+const std::string& LemkeBoxedLcpSolver::getType() const
+{
+  return getStaticType();
+}
+
+//==============================================================================
+const std::string& LemkeBoxedLcpSolver::getStaticType()
+{
+  static const std::string type = "LemkeBoxedLcpSolver";
+  return type;
+}
+
+//==============================================================================
+bool LemkeBoxedLcpSolver::solve(
+    int n,
+    double* A,
+    double* x,
+    double* b,
+    int nub,
+    double* lo,
+    double* hi,
+    int* findex,
+    bool /*earlyTermination*/)
+{
+  using RowMajorMatrixXd
+      = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  const Eigen::Map<const RowMajorMatrixXd, 0, Eigen::OuterStride<>> mapA(
+      A, n, n, Eigen::OuterStride<>(dPAD(n)));
+
+  reserve(n);
+
+  mVariables.clear();
+  mT.topRows(n).setZero();
+  mX0.head(n).setZero();
+
+  const auto addVariable = [&](int row, double sign) {
+    const int index = static_cast<int>(mVariables.size());
+    mVariables.push_back({row, sign, -1});
+    mT(row, index) = sign;
+
+    return index;
+  };
+
+  const auto addMultiplier = [&](int bounded) {
+    const int index = static_cast<int>(mVariables.size());
+    mVariables.push_back({mVariables[bounded].mRow, 0.0, bounded});
+    mVariables[bounded].mPartner = index;
+  };
+
+  // The rows with constant bounds come first so that the friction rows can
+  // refer to the variables of their normals.
+  for (int i = 0; i < n; ++i)
+  {
+    if (i < nub)
+    {
+      // x = u+ - u-
+      addVariable(i, 1.0);
+      addVariable(i, -1.0);
+      continue;
+    }
+
+    if (findex && findex[i] >= 0)
+      continue;
+
+    const bool hasLo = std::isfinite(lo[i]);
+    const bool hasHi = std::isfinite(hi[i]);
+
+    if (hasLo && hasHi)
+    {
+      if (hi[i] < lo[i])
+        return false;
+
+      mX0[i] = lo[i];
+
+      // x = lo + u, where u <= hi - lo
+      if (hi[i] > lo[i])
+        addMultiplier(addVariable(i, 1.0));
+    }
+    else if (hasLo)
+    {
+      // x = lo + u
+      mX0[i] = lo[i];
+      addVariable(i, 1.0);
+    }
+    else if (hasHi)
+    {
+      // x = hi - u
+      mX0[i] = hi[i];
+      addVariable(i, -1.0);
+    }
+    else
+    {
+      // x = u+ - u-
+      addVariable(i, 1.0);
+      addVariable(i, -1.0);
+    }
+  }
+
+  for (int i = nub; findex && i < n; ++i)
+  {
+    const int j = findex[i];
+    if (j < 0)
+      continue;
+
+    assert(j < n);
+    if (j < nub || findex[j] >= 0 || !(lo[j] >= 0.0))
+      return false;
+
+    // x_i = u - c*x_j, where u <= 2*c*x_j
+    const double c = std::abs(hi[i]);
+    const int numVariables = static_cast<int>(mVariables.size());
+    if (c == 0.0 || (mX0[j] == 0.0 && mT.row(j).head(numVariables).isZero()))
+      continue;
+
+    const int index = addVariable(i, 1.0);
+    mT.row(i).head(index) -= c * mT.row(j).head(index);
+    mX0[i] = -c * mX0[j];
+    addMultiplier(index);
+  }
+
+  const int m = static_cast<int>(mVariables.size());
+  auto z = mZ.head(m);
+  if (m > 0)
+  {
+    const auto T = mT.topLeftCorner(n, m);
+    mAT.topLeftCorner(n, m).noalias() = mapA * T;
+    mAX0.head(n).noalias() = mapA * mX0.head(n);
+
+    // Rows of the bounded variables are the signed rows of w = A*x - b plus
+    // the multipliers of their upper bounds, and rows of the multipliers are
+    // the distances of the bounded variables to their upper bounds.
+    for (int k = 0; k < m; ++k)
+    {
+      const Variable& variable = mVariables[k];
+      const int i = variable.mRow;
+
+      if (variable.mSign != 0.0)
+      {
+        mM.row(k).head(m) = variable.mSign * mAT.row(i).head(m);
+        mQ[k] = variable.mSign * (mAX0[i] - b[i]);
+        if (variable.mPartner >= 0)
+          mM(k, variable.mPartner) += 1.0;
+      }
+      else if (i >= nub && findex && findex[i] >= 0)
+      {
+        const double c = std::abs(hi[i]);
+        mM.row(k).head(m) = 2.0 * c * T.row(findex[i]);
+        mM(k, variable.mPartner) -= 1.0;
+        mQ[k] = 2.0 * c * mX0[findex[i]];
+      }
+      else
+      {
+        mM.row(k).head(m).setZero();
+        mM(k, variable.mPartner) = -1.0;
+        mQ[k] = hi[i] - lo[i];
+      }
+    }
+
+    if (mLemke.solve(mM.topLeftCorner(m, m), mQ.head(m), z) != 0)
+      return false;
+  }
+
+  Eigen::Map<Eigen::VectorXd>(x, n).noalias()
+      = mT.topLeftCorner(n, m) * z + mX0.head(n);
+
+  return true;
+}
+
+//==============================================================================
+void LemkeBoxedLcpSolver::reserve(int n)
+{
+  if (mT.rows() >= n)
+    return;
+
+  // Every row becomes at most two standard LCP variables.
+  const int m = 2 * n;
+  mVariables.reserve(static_cast<std::size_t>(m));
+  mM.resize(m, m);
+  mT.resize(n, m);
+  mAT.resize(n, m);
+  mQ.resize(m);
+  mZ.resize(m);
+  mX0.resize(n);
+  mAX0.resize(n);
+  mLemke.reserve(m);
+}
+
+#ifndef NDEBUG
+//==============================================================================
+bool LemkeBoxedLcpSolver::canSolve(int n, const double* A)
+{
+  const int nskip = dPAD(n);
+
+  // Lemke's algorithm only terminates with a solution for well-behaved A, such
+  // as positive semidefinite matrices, which have no negative diagonal.
+  for (int i = 0; i < n; ++i)
+  {
+    if (A[nskip * i + i] < 0.0)
+      return false;
+  }
+
+  return true;
+}
+#endif
+
+//==============================================================================
+void LemkeBoxedLcpSolver::setMaxIterations(int maxIterations)
+{
+  mLemke.setMaxIterations(maxIterations);
+}
+
+//==============================================================================
+int LemkeBoxedLcpSolver::getMaxIterations() const
+{
+  return mLemke.getMaxIterations();
+}
+
+} // namespace constraint
+} // namespace dart
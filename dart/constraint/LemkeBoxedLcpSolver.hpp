@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_CONSTRAINT_LEMKEBOXEDLCPSOLVER_HPP_
+#define DART_CONSTRAINT_LEMKEBOXEDLCPSOLVER_HPP_
+
+#include <vector>
+#include <Eigen/Dense>
+#include "dart/constraint/BoxedLcpSolver.hpp"
+#include "dart/lcpsolver/Lemke.hpp"
+
+namespace dart {
+namespace constraint {
+
+/// Boxed LCP solver that rewrites the problem as a standard LCP and solves it
+/// with Lemke's algorithm.
+///
+/// Every bounded row becomes one or two standard LCP variables: a row with a
+/// lower or an upper bound becomes a nonnegative variable, a row with both
+/// bounds becomes a variable and the multiplier of its upper bound, and a
+/// friction row becomes a variable and the multiplier of its bound on the
+/// normal impulse. Lemke's algorithm is slower than the Dantzig solver but
+/// doesn't rely on the principal pivots of A, which makes it a robust
+/// secondary solver for degenerate contact problems.
+///
+/// The normal of a friction row must have a nonnegative lower bound and must
+/// not be a friction row itself.
+class LemkeBoxedLcpSolver : public BoxedLcpSolver
+{
+public:
+  /// Constructor
+  LemkeBoxedLcpSolver();
+
+  // Documentation inherited.
+  const std::string& getType() const override;
+
+  /// Returns type for this class
+  static const std::string& getStaticType();
+
+  // Documentation inherited.
+  bool solve(
+      int n,
+      double* A,
+      double* x,
+      double* b,
+      int nub,
+      double* lo,
+      double* hi,
+      int* findex,
+      bool earlyTermination) override;
+
+  // Documentation inherited.
+  void reserve(int n) override;
+
+#ifndef NDEBUG
+  // Documentation inherited.
+  bool canSolve(int n, const double* A) override;
+#endif
+
+  /// Sets the maximum number of pivots of a solve
+  void setMaxIterations(int maxIterations);
+
+  /// Returns the maximum number of pivots of a solve
+  int getMaxIterations() const;
+
+protected:
+  /// Standard LCP variable that a row of the boxed LCP is rewritten into
+  struct Variable
+  {
+    /// Row of the boxed LCP
+    int mRow;
+
+    /// Coefficient of the variable in x of its row, which is 1 or -1, or 0 if
+    /// the variable is the multiplier of an upper bound
+    double mSign;
+
+    /// The multiplier of the upper bound of the variable, or the bounded
+    /// variable of the multiplier. -1 if the row has no upper bound.
+    int mPartner;
+  };
+
+  lcpsolver::LemkeSolver mLemke;
+
+  /// Standard LCP variables of the current problem
+  std::vector<Variable> mVariables;
+
+  /// M term of the standard LCP
+  Eigen::MatrixXd mM;
+
+  /// Maps the standard LCP variables to the boxed LCP variables as x = T*z + x0
+  Eigen::MatrixXd mT;
+
+  /// A*T
+  Eigen::MatrixXd mAT;
+
+  Eigen::VectorXd mQ;
+  Eigen::VectorXd mZ;
+  Eigen::VectorXd mX0;
+  Eigen::VectorXd mAX0;
+};
+
+} // namespace constraint
+} // namespace dart
+
+#endif // DART_CONSTRAINT_LEMKEBOXEDLCPSOLVER_HPP_
@@ -46,7 +46,8 @@
 namespace dart {
 namespace constraint {
 
-double MimicMotorConstraint::mConstraintForceMixing = DART_CFM;
+ConstraintParameters MimicMotorConstraint::mDefaultParameters(
+    0.0, 0.0, 0.0, DART_CFM);
 
 //==============================================================================
 MimicMotorConstraint::MimicMotorConstraint(
@@ -54,7 +55,7 @@ MimicMotorConstraint::MimicMotorConstraint(
     const dynamics::Joint* mimicJoint,
     double multiplier,
     double offset)
-  : ConstraintBase(),
+  : ConstraintBase(mDefaultParameters),
     mJoint(joint),
     mMimicJoint(mimicJoint),
     mMultiplier(multiplier),
@@ -111,16 +112,22 @@ void MimicMotorConstraint::setConstraintForceMixing(double cfm)
            << "Constraint force mixing parameter[" << cfm
            << "] is lower than 1e-9. "
            << "It is set to 1e-9.\n";
-    mConstraintForceMixing = 1e-9;
+    mDefaultParameters.constraintForceMixing = 1e-9;
   }
 
-  mConstraintForceMixing = cfm;
+  mDefaultParameters.constraintForceMixing = cfm;
 }
 
 //==============================================================================
 double MimicMotorConstraint::getConstraintForceMixing()
 {
-  return mConstraintForceMixing;
+  return mDefaultParameters.constraintForceMixing;
+}
+
+//==============================================================================
+const ConstraintParameters& MimicMotorConstraint::getDefaultParameters()
+{
+  return mDefaultParameters;
 }
 
 //==============================================================================
@@ -248,7 +255,7 @@ void MimicMotorConstraint::getVelocityChange(double* delVel, bool withCfm)
   if (withCfm)
   {
     delVel[mAppliedImpulseIndex]
-        += delVel[mAppliedImpulseIndex] * mConstraintForceMixing;
+        += delVel[mAppliedImpulseIndex] * mParameters.constraintForceMixing;
   }
 
   assert(localIndex == mDim);
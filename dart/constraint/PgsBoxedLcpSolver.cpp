@@ -60,6 +60,12 @@ PgsBoxedLcpSolver::Option::Option(
   // Do nothing
 }
 
+//==============================================================================
+PgsBoxedLcpSolver::PgsBoxedLcpSolver() : mNumIterations(0), mRandomSeed(0ul)
+{
+  // Do nothing
+}
+
 //==============================================================================
 const std::string& PgsBoxedLcpSolver::getType() const
 {
@@ -87,6 +93,13 @@ bool PgsBoxedLcpSolver::solve(
 {
   const int nskip = dPAD(n);
 
+  mNumIterations = 0;
+  mIsInterrupted = false;
+
+  // Shuffle the constraints the same way whatever was solved before, so that
+  // a World restored from a saved state follows the same trajectory
+  mRandomSeed = 0ul;
+
   // If all the variables are unbounded then we can just factor, solve, and
   // return.R
   if (nub >= n)
@@ -161,6 +174,8 @@ bool PgsBoxedLcpSolver::solve(
     }
   }
 
+  mNumIterations = 1;
+
   if (possibleToTerminate)
   {
     return true;
@@ -177,6 +192,12 @@ bool PgsBoxedLcpSolver::solve(
 
   for (int iter = 1; iter < mOption.mMaxIteration; ++iter)
   {
+    // Stop at the current iterate once the budget is spent
+    if (checkBudget(iter))
+      break;
+
+    ++mNumIterations;
+
     if (mOption.mRandomizeConstraintOrder)
     {
       if ((iter & 7) == 0)
@@ -184,7 +205,10 @@ bool PgsBoxedLcpSolver::solve(
         for (std::size_t i = 1; i < mCacheOrder.size(); ++i)
         {
           const int tmp = mCacheOrder[i];
-          const int swapi = external::ode::dRandInt(i + 1);
+          // Same linear congruential generator as external::ode::dRand()
+          mRandomSeed
+              = (1664525ul * mRandomSeed + 1013904223ul) & 0xfffffffful;
+          const std::size_t swapi = mRandomSeed % (i + 1);
           mCacheOrder[i] = mCacheOrder[swapi];
           mCacheOrder[swapi] = tmp;
         }
@@ -244,6 +268,25 @@ bool PgsBoxedLcpSolver::solve(
   return possibleToTerminate;
 }
 
+//==============================================================================
+void PgsBoxedLcpSolver::reserve(int n)
+{
+  mCacheOrder.reserve(n);
+  mCacheD.reserve(n);
+}
+
+//==============================================================================
+bool PgsBoxedLcpSolver::isInterruptible() const
+{
+  return true;
+}
+
+//==============================================================================
+int PgsBoxedLcpSolver::getNumIterations() const
+{
+  return mNumIterations;
+}
+
 #ifndef NDEBUG
 //==============================================================================
 bool PgsBoxedLcpSolver::canSolve(int n, const double* A)
@@ -59,6 +59,9 @@ public:
         bool randomizeConstraintOrder = false);
   };
 
+  /// Constructor
+  PgsBoxedLcpSolver();
+
   // Documentation inherited.
   const std::string& getType() const override;
 
@@ -77,6 +80,15 @@ public:
       int* findex,
       bool earlyTermination) override;
 
+  // Documentation inherited.
+  void reserve(int n) override;
+
+  // Documentation inherited.
+  bool isInterruptible() const override;
+
+  /// Returns the number of sweeps over the constraints of the last solve
+  int getNumIterations() const override;
+
 #ifndef NDEBUG
   // Documentation inherited.
   bool canSolve(int n, const double* A) override;
@@ -91,6 +103,15 @@ public:
 protected:
   Option mOption;
 
+  /// Number of sweeps over the constraints of the last solve
+  int mNumIterations;
+
+  /// State of the random number generator that shuffles the constraint order.
+  /// Each solver has its own so that solvers running in different threads
+  /// don't affect each other's results, and it is reset at the beginning of
+  /// every solve() so that the result only depends on the problem.
+  unsigned long mRandomSeed;
+
   mutable std::vector<int> mCacheOrder;
   mutable std::vector<double> mCacheD;
   mutable Eigen::VectorXd mCachedNormalizedA;
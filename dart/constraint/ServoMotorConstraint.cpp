@@ -46,11 +46,12 @@
 namespace dart {
 namespace constraint {
 
-double ServoMotorConstraint::mConstraintForceMixing = DART_CFM;
+ConstraintParameters ServoMotorConstraint::mDefaultParameters(
+    0.0, 0.0, 0.0, DART_CFM);
 
 //==============================================================================
 ServoMotorConstraint::ServoMotorConstraint(dynamics::Joint* joint)
-  : ConstraintBase(),
+  : ConstraintBase(mDefaultParameters),
     mJoint(joint),
     mBodyNode(joint->getChildBodyNode()),
     mAppliedImpulseIndex(0)
@@ -101,16 +102,22 @@ void ServoMotorConstraint::setConstraintForceMixing(double cfm)
            << "Constraint force mixing parameter[" << cfm
            << "] is lower than 1e-9. "
            << "It is set to 1e-9." << std::endl;
-    mConstraintForceMixing = 1e-9;
+    mDefaultParameters.constraintForceMixing = 1e-9;
   }
 
-  mConstraintForceMixing = cfm;
+  mDefaultParameters.constraintForceMixing = cfm;
 }
 
 //==============================================================================
 double ServoMotorConstraint::getConstraintForceMixing()
 {
-  return mConstraintForceMixing;
+  return mDefaultParameters.constraintForceMixing;
+}
+
+//==============================================================================
+const ConstraintParameters& ServoMotorConstraint::getDefaultParameters()
+{
+  return mDefaultParameters;
 }
 
 //==============================================================================
@@ -239,7 +246,7 @@ void ServoMotorConstraint::getVelocityChange(double* delVel, bool withCfm)
   if (withCfm)
   {
     delVel[mAppliedImpulseIndex]
-        += delVel[mAppliedImpulseIndex] * mConstraintForceMixing;
+        += delVel[mAppliedImpulseIndex] * mParameters.constraintForceMixing;
   }
 
   assert(localIndex == mDim);
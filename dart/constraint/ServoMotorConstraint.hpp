@@ -33,7 +33,9 @@
 #ifndef DART_CONSTRAINT_SERVOMOTORCONSTRAINT_HPP_
 #define DART_CONSTRAINT_SERVOMOTORCONSTRAINT_HPP_
 
+#include "dart/common/Deprecated.hpp"
 #include "dart/constraint/ConstraintBase.hpp"
+#include "dart/constraint/ConstraintParameters.hpp"
 
 namespace dart {
 
@@ -64,12 +66,22 @@ public:
   // Property settings
   //----------------------------------------------------------------------------
 
-  /// Set global constraint force mixing parameter
+  /// Set the default constraint force mixing parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::setServoMotorParameters() instead.
+  DART_DEPRECATED(6.10)
   static void setConstraintForceMixing(double cfm);
 
-  /// Get global constraint force mixing parameter
+  /// Get the default constraint force mixing parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::getServoMotorParameters() instead.
+  DART_DEPRECATED(6.10)
   static double getConstraintForceMixing();
 
+  /// Get the default parameters of the constraints that are created
+  /// afterwards
+  static const ConstraintParameters& getDefaultParameters();
+
   //----------------------------------------------------------------------------
   // Friendship
   //----------------------------------------------------------------------------
@@ -139,10 +151,8 @@ private:
   ///
   double mLowerBound[6];
 
-  /// Global constraint force mixing parameter in the range of [1e-9, 1]. The
-  /// default is 1e-5
-  /// \sa http://www.ode.org/ode-latest-userguide.html#sec_3_8_0
-  static double mConstraintForceMixing;
+  /// Default parameters of the constraints that are created afterwards
+  static ConstraintParameters mDefaultParameters;
 };
 
 } // namespace constraint
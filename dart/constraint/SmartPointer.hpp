@@ -54,6 +54,8 @@ DART_COMMON_DECLARE_SHARED_WEAK(JointCoulombFrictionConstraint)
 DART_COMMON_DECLARE_SHARED_WEAK(LCPSolver)
 DART_COMMON_DECLARE_SHARED_WEAK(BoxedLcpSolver)
 DART_COMMON_DECLARE_SHARED_WEAK(PgsBoxedLcpSolver)
+DART_COMMON_DECLARE_SHARED_WEAK(LemkeBoxedLcpSolver)
+DART_COMMON_DECLARE_SHARED_WEAK(ApgdBoxedLcpSolver)
 DART_COMMON_DECLARE_SHARED_WEAK(PsorBoxedLcpSolver)
 DART_COMMON_DECLARE_SHARED_WEAK(JacobiBoxedLcpSolver)
 
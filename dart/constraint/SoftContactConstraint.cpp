@@ -38,6 +38,7 @@
 
 #include "dart/collision/CollisionObject.hpp"
 #include "dart/common/Console.hpp"
+#include "dart/constraint/ImpulseResponseCache.hpp"
 #include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/PointMass.hpp"
 #include "dart/dynamics/Shape.hpp"
@@ -61,10 +62,8 @@
 namespace dart {
 namespace constraint {
 
-double SoftContactConstraint::mErrorAllowance = DART_ERROR_ALLOWANCE;
-double SoftContactConstraint::mErrorReductionParameter = DART_ERP;
-double SoftContactConstraint::mMaxErrorReductionVelocity = DART_MAX_ERV;
-double SoftContactConstraint::mConstraintForceMixing = DART_CFM;
+ConstraintParameters SoftContactConstraint::mDefaultParameters(
+    DART_ERROR_ALLOWANCE, DART_ERP, DART_MAX_ERV, DART_CFM);
 
 constexpr double DART_DEFAULT_FRICTION_COEFF = 1.0;
 constexpr double DART_DEFAULT_RESTITUTION_COEFF = 0.0;
@@ -72,7 +71,7 @@ constexpr double DART_DEFAULT_RESTITUTION_COEFF = 0.0;
 //==============================================================================
 SoftContactConstraint::SoftContactConstraint(
     collision::Contact& contact, double timeStep)
-  : ConstraintBase(),
+  : ConstraintBase(mDefaultParameters),
     mTimeStep(timeStep),
     mBodyNode1(const_cast<dynamics::ShapeFrame*>(
                    contact.collisionObject1->getShapeFrame())
@@ -342,16 +341,16 @@ void SoftContactConstraint::setErrorAllowance(double _allowance)
     dtwarn << "Error reduction parameter[" << _allowance
            << "] is lower than 0.0. "
            << "It is set to 0.0." << std::endl;
-    mErrorAllowance = 0.0;
+    mDefaultParameters.errorAllowance = 0.0;
   }
 
-  mErrorAllowance = _allowance;
+  mDefaultParameters.errorAllowance = _allowance;
 }
 
 //==============================================================================
 double SoftContactConstraint::getErrorAllowance()
 {
-  return mErrorAllowance;
+  return mDefaultParameters.errorAllowance;
 }
 
 //==============================================================================
@@ -362,22 +361,22 @@ void SoftContactConstraint::setErrorReductionParameter(double _erp)
   {
     dtwarn << "Error reduction parameter[" << _erp << "] is lower than 0.0. "
            << "It is set to 0.0." << std::endl;
-    mErrorReductionParameter = 0.0;
+    mDefaultParameters.errorReductionParameter = 0.0;
   }
   if (_erp > 1.0)
   {
     dtwarn << "Error reduction parameter[" << _erp << "] is greater than 1.0. "
            << "It is set to 1.0." << std::endl;
-    mErrorReductionParameter = 1.0;
+    mDefaultParameters.errorReductionParameter = 1.0;
   }
 
-  mErrorReductionParameter = _erp;
+  mDefaultParameters.errorReductionParameter = _erp;
 }
 
 //==============================================================================
 double SoftContactConstraint::getErrorReductionParameter()
 {
-  return mErrorReductionParameter;
+  return mDefaultParameters.errorReductionParameter;
 }
 
 //==============================================================================
@@ -389,16 +388,16 @@ void SoftContactConstraint::setMaxErrorReductionVelocity(double _erv)
     dtwarn << "Maximum error reduction velocity[" << _erv
            << "] is lower than 0.0. "
            << "It is set to 0.0." << std::endl;
-    mMaxErrorReductionVelocity = 0.0;
+    mDefaultParameters.maxErrorReductionVelocity = 0.0;
   }
 
-  mMaxErrorReductionVelocity = _erv;
+  mDefaultParameters.maxErrorReductionVelocity = _erv;
 }
 
 //==============================================================================
 double SoftContactConstraint::getMaxErrorReductionVelocity()
 {
-  return mMaxErrorReductionVelocity;
+  return mDefaultParameters.maxErrorReductionVelocity;
 }
 
 //==============================================================================
@@ -410,16 +409,22 @@ void SoftContactConstraint::setConstraintForceMixing(double _cfm)
     dtwarn << "Constraint force mixing parameter[" << _cfm
            << "] is lower than 1e-9. "
            << "It is set to 1e-9." << std::endl;
-    mConstraintForceMixing = 1e-9;
+    mDefaultParameters.constraintForceMixing = 1e-9;
   }
 
-  mConstraintForceMixing = _cfm;
+  mDefaultParameters.constraintForceMixing = _cfm;
 }
 
 //==============================================================================
 double SoftContactConstraint::getConstraintForceMixing()
 {
-  return mConstraintForceMixing;
+  return mDefaultParameters.constraintForceMixing;
+}
+
+//==============================================================================
+const ConstraintParameters& SoftContactConstraint::getDefaultParameters()
+{
+  return mDefaultParameters;
 }
 
 //==============================================================================
@@ -488,16 +493,17 @@ void SoftContactConstraint::getInformation(ConstraintInfo* _info)
       //------------------------------------------------------------------------
       // A. Penetration correction
       double bouncingVelocity
-          = mContacts[i]->penetrationDepth - mErrorAllowance;
+          = mContacts[i]->penetrationDepth - mParameters.errorAllowance;
       if (bouncingVelocity < 0.0)
       {
         bouncingVelocity = 0.0;
       }
       else
       {
-        bouncingVelocity *= mErrorReductionParameter * _info->invTimeStep;
-        if (bouncingVelocity > mMaxErrorReductionVelocity)
-          bouncingVelocity = mMaxErrorReductionVelocity;
+        bouncingVelocity
+            *= mParameters.errorReductionParameter * _info->invTimeStep;
+        if (bouncingVelocity > mParameters.maxErrorReductionVelocity)
+          bouncingVelocity = mParameters.maxErrorReductionVelocity;
       }
 
       // B. Restitution
@@ -563,7 +569,8 @@ void SoftContactConstraint::getInformation(ConstraintInfo* _info)
       }
       else
       {
-        bouncingVelocity *= mErrorReductionParameter * _info->invTimeStep;
+        bouncingVelocity
+            *= mParameters.errorReductionParameter * _info->invTimeStep;
         if (bouncingVelocity > DART_MAX_ERV)
           bouncingVelocity = DART_MAX_ERV;
       }
@@ -731,7 +738,128 @@ void SoftContactConstraint::getVelocityChange(double* _vel, bool _withCfm)
   if (_withCfm)
   {
     _vel[mAppliedImpulseIndex]
-        += _vel[mAppliedImpulseIndex] * mConstraintForceMixing;
+        += _vel[mAppliedImpulseIndex] * mParameters.constraintForceMixing;
+  }
+}
+
+//==============================================================================
+bool SoftContactConstraint::supportsImpulseResponseCache() const
+{
+  return true;
+}
+
+//==============================================================================
+void SoftContactConstraint::addBodyNodesTo(ImpulseResponseCache& cache) const
+{
+  // The point masses are added regardless of the reactivity of their
+  // SoftBodyNodes because getVelocityChanges() reads them whenever they have
+  // unit impulses, as getVelocityChange() does
+  if (mPointMass1)
+    cache.addPointMass(mPointMass1);
+  else if (mBodyNode1->isReactive())
+    cache.addBodyNode(mBodyNode1);
+
+  if (mPointMass2)
+    cache.addPointMass(mPointMass2);
+  else if (mBodyNode2->isReactive())
+    cache.addBodyNode(mBodyNode2);
+}
+
+//==============================================================================
+void SoftContactConstraint::applyUnitImpulses(
+    ImpulseResponseCache& cache) const
+{
+  assert(isActive());
+  assert(mBodyNode1->isReactive() || mBodyNode2->isReactive());
+
+  cache.clearUnitImpulses();
+
+  using Jacobians = Eigen::Map<const Eigen::Matrix<double, 6, Eigen::Dynamic>>;
+  const Jacobians jacobians1(mJacobians1.front().data(), 6, mDim);
+  const Jacobians jacobians2(mJacobians2.front().data(), 6, mDim);
+
+  // The impulses on a point mass only take effect when the Skeleton of the
+  // point mass is excited, which always holds for self collisions
+  const bool isSelfCollision
+      = mBodyNode1->getSkeleton() == mBodyNode2->getSkeleton();
+
+  if (mPointMass1)
+  {
+    if (isSelfCollision || mBodyNode1->isReactive())
+      cache.applyUnitImpulses(mPointMass1, jacobians1.bottomRows<3>());
+  }
+  else if (mBodyNode1->isReactive())
+  {
+    cache.applyUnitImpulses(mBodyNode1, jacobians1);
+  }
+
+  if (mPointMass2)
+  {
+    if (isSelfCollision || mBodyNode2->isReactive())
+      cache.applyUnitImpulses(mPointMass2, jacobians2.bottomRows<3>());
+  }
+  else if (mBodyNode2->isReactive())
+  {
+    cache.applyUnitImpulses(mBodyNode2, jacobians2);
+  }
+}
+
+//==============================================================================
+void SoftContactConstraint::getVelocityChanges(
+    const ImpulseResponseCache& cache,
+    double* vel,
+    int nSkip,
+    bool withCfm) const
+{
+  assert(vel != nullptr && "Null pointer is not allowed.");
+
+  using RowMajorMatrixXd
+      = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  Eigen::Map<RowMajorMatrixXd, 0, Eigen::OuterStride<>> velMap(
+      vel,
+      cache.getNumUnitImpulses(),
+      static_cast<int>(mDim),
+      Eigen::OuterStride<>(nSkip));
+  velMap.setZero();
+
+  using Jacobians = Eigen::Map<const Eigen::Matrix<double, 6, Eigen::Dynamic>>;
+  const Jacobians jacobians1(mJacobians1.front().data(), 6, mDim);
+  const Jacobians jacobians2(mJacobians2.front().data(), 6, mDim);
+
+  if (mPointMass1)
+  {
+    if (const auto* velocityChanges = cache.getVelocityChanges(mPointMass1))
+    {
+      velMap.noalias()
+          += velocityChanges->transpose() * jacobians1.bottomRows<3>();
+    }
+  }
+  else if (mBodyNode1->isReactive())
+  {
+    if (const auto* velocityChanges = cache.getVelocityChanges(mBodyNode1))
+      velMap.noalias() += velocityChanges->transpose() * jacobians1;
+  }
+
+  if (mPointMass2)
+  {
+    if (const auto* velocityChanges = cache.getVelocityChanges(mPointMass2))
+    {
+      velMap.noalias()
+          += velocityChanges->transpose() * jacobians2.bottomRows<3>();
+    }
+  }
+  else if (mBodyNode2->isReactive())
+  {
+    if (const auto* velocityChanges = cache.getVelocityChanges(mBodyNode2))
+      velMap.noalias() += velocityChanges->transpose() * jacobians2;
+  }
+
+  // Add small values to the diagnal to keep it away from singular, similar to
+  // cfm variable in ODE
+  if (withCfm)
+  {
+    assert(velMap.rows() == velMap.cols());
+    velMap.diagonal() += velMap.diagonal() * mParameters.constraintForceMixing;
   }
 }
 
@@ -33,7 +33,9 @@
 #ifndef DART_CONSTRAINT_SOFTCONTACTCONSTRAINT_HPP_
 #define DART_CONSTRAINT_SOFTCONTACTCONSTRAINT_HPP_
 
+#include "dart/common/Deprecated.hpp"
 #include "dart/constraint/ConstraintBase.hpp"
+#include "dart/constraint/ConstraintParameters.hpp"
 
 #include "dart/collision/CollisionDetector.hpp"
 #include "dart/math/MathTypes.hpp"
@@ -73,36 +75,84 @@ public:
   // Property settings
   //----------------------------------------------------------------------------
 
-  /// Set global error reduction parameter
+  /// Set the default constraint error allowance
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::setSoftContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static void setErrorAllowance(double _allowance);
 
-  /// Get global error reduction parameter
+  /// Get the default constraint error allowance
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::getSoftContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static double getErrorAllowance();
 
-  /// Set global error reduction parameter
+  /// Set the default error reduction parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::setSoftContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static void setErrorReductionParameter(double _erp);
 
-  /// Get global error reduction parameter
+  /// Get the default error reduction parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::getSoftContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static double getErrorReductionParameter();
 
-  /// Set global error reduction parameter
+  /// Set the default maximum error reduction velocity
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::setSoftContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static void setMaxErrorReductionVelocity(double _erv);
 
-  /// Get global error reduction parameter
+  /// Get the default maximum error reduction velocity
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::getSoftContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static double getMaxErrorReductionVelocity();
 
-  /// Set global constraint force mixing parameter
+  /// Set the default constraint force mixing parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::setSoftContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static void setConstraintForceMixing(double _cfm);
 
-  /// Get global constraint force mixing parameter
+  /// Get the default constraint force mixing parameter
+  /// \deprecated Deprecated in DART 6.10. Please use
+  /// ConstraintSolver::getSoftContactParameters() instead.
+  DART_DEPRECATED(6.10)
   static double getConstraintForceMixing();
 
+  /// Get the default parameters of the constraints that are created
+  /// afterwards
+  static const ConstraintParameters& getDefaultParameters();
+
   /// Set first frictional direction
   void setFrictionDirection(const Eigen::Vector3d& _dir);
 
   /// Get first frictional direction
   const Eigen::Vector3d& getFrictionDirection1() const;
 
+  //----------------------------------------------------------------------------
+  // Impulse tests with cached impulse responses
+  //----------------------------------------------------------------------------
+
+  // Documentation inherited
+  bool supportsImpulseResponseCache() const override;
+
+  // Documentation inherited
+  void addBodyNodesTo(ImpulseResponseCache& cache) const override;
+
+  // Documentation inherited
+  void applyUnitImpulses(ImpulseResponseCache& cache) const override;
+
+  // Documentation inherited
+  void getVelocityChanges(
+      const ImpulseResponseCache& cache,
+      double* vel,
+      int nSkip,
+      bool withCfm) const override;
+
   //----------------------------------------------------------------------------
   // Friendship
   //----------------------------------------------------------------------------
@@ -239,20 +289,8 @@ private:
   ///
   bool mActive;
 
-  /// Global constraint error allowance
-  static double mErrorAllowance;
-
-  /// Global constraint error redection parameter in the range of [0, 1]. The
-  /// default is 0.01.
-  static double mErrorReductionParameter;
-
-  /// Maximum error reduction velocity
-  static double mMaxErrorReductionVelocity;
-
-  /// Global constraint force mixing parameter in the range of [1e-9, 1]. The
-  /// default is 1e-5
-  /// \sa http://www.ode.org/ode-latest-userguide.html#sec_3_8_0
-  static double mConstraintForceMixing;
+  /// Default parameters of the constraints that are created afterwards
+  static ConstraintParameters mDefaultParameters;
 };
 
 } // namespace constraint
@@ -586,6 +586,9 @@ const Inertia& BodyNode::getInertia() const
 //==============================================================================
 const math::Inertia& BodyNode::getArticulatedInertia() const
 {
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   const ConstSkeletonPtr& skel = getSkeleton();
   if (skel && CHECK_FLAG(mArticulatedInertia))
     skel->updateArticulatedInertia(mTreeIndex);
@@ -596,6 +599,9 @@ const math::Inertia& BodyNode::getArticulatedInertia() const
 //==============================================================================
 const math::Inertia& BodyNode::getArticulatedInertiaImplicit() const
 {
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   const ConstSkeletonPtr& skel = getSkeleton();
   if (skel && CHECK_FLAG(mArticulatedInertia))
     skel->updateArticulatedInertia(mTreeIndex);
@@ -1146,6 +1152,9 @@ const Eigen::Vector6d& BodyNode::getPrimaryRelativeAcceleration() const
 //==============================================================================
 const Eigen::Vector6d& BodyNode::getPartialAcceleration() const
 {
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   if (mIsPartialAccelerationDirty)
     updatePartialAcceleration();
 
@@ -1155,6 +1164,9 @@ const Eigen::Vector6d& BodyNode::getPartialAcceleration() const
 //==============================================================================
 const math::Jacobian& BodyNode::getJacobian() const
 {
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   if (mIsBodyJacobianDirty)
     updateBodyJacobian();
 
@@ -1164,6 +1176,9 @@ const math::Jacobian& BodyNode::getJacobian() const
 //==============================================================================
 const math::Jacobian& BodyNode::getWorldJacobian() const
 {
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   if (mIsWorldJacobianDirty)
     updateWorldJacobian();
 
@@ -1173,6 +1188,9 @@ const math::Jacobian& BodyNode::getWorldJacobian() const
 //==============================================================================
 const math::Jacobian& BodyNode::getJacobianSpatialDeriv() const
 {
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   if (mIsBodyJacobianSpatialDerivDirty)
     updateBodyJacobianSpatialDeriv();
 
@@ -1182,6 +1200,9 @@ const math::Jacobian& BodyNode::getJacobianSpatialDeriv() const
 //==============================================================================
 const math::Jacobian& BodyNode::getJacobianClassicDeriv() const
 {
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   if (mIsWorldJacobianClassicDerivDirty)
     updateWorldJacobianClassicDeriv();
 
@@ -1381,6 +1402,10 @@ void BodyNode::init(const SkeletonPtr& _skeleton)
   mParentJoint->setVersionDependentObject(
       dynamic_cast<common::VersionCounter*>(mSkeleton.lock().get()));
 
+  // Point this BodyNode and its child Frames at the deferred updates flag of
+  // the new Skeleton
+  Frame::setDeferredUpdatesFlag(&_skeleton->mHasDeferredPositionUpdates);
+
   // Put the scope around this so that 'lock' releases the mutex immediately
   // after we're done with it
   {
@@ -1502,6 +1527,20 @@ void BodyNode::processRemovedEntity(Entity* _oldChildEntity)
     mNonBodyNodeEntities.erase(_oldChildEntity);
 }
 
+//==============================================================================
+void BodyNode::flushDeferredUpdates() const
+{
+  const ConstSkeletonPtr skel = getSkeleton();
+  if (skel)
+    skel->flushPositionUpdates();
+}
+
+//==============================================================================
+void BodyNode::setDeferredUpdatesFlag(const bool* /*flag*/)
+{
+  // Do nothing
+}
+
 //==============================================================================
 void BodyNode::dirtyTransform()
 {
@@ -2037,7 +2076,8 @@ Eigen::Vector3d BodyNode::getAngularMomentum(const Eigen::Vector3d& _pivot)
 bool BodyNode::isReactive() const
 {
   const ConstSkeletonPtr& skel = getSkeleton();
-  if (skel && skel->isMobile() && getNumDependentGenCoords() > 0)
+  if (skel && skel->isMobile() && !skel->isSleeping()
+      && getNumDependentGenCoords() > 0)
   {
     // Check if all the ancestor joints are motion prescribed.
     const BodyNode* body = this;
@@ -2084,14 +2124,7 @@ void BodyNode::aggregateGravityForceVector(
         (*it)->mParentJoint->getRelativeTransform(), (*it)->mG_F);
   }
 
-  std::size_t nGenCoords = mParentJoint->getNumDofs();
-  if (nGenCoords > 0)
-  {
-    Eigen::VectorXd g
-        = -(mParentJoint->getRelativeJacobian().transpose() * mG_F);
-    std::size_t iStart = mParentJoint->getIndexInTree(0);
-    _g.segment(iStart, nGenCoords) = g;
-  }
+  mParentJoint->getSpatialToGeneralizedSegment(_g, -mG_F);
 }
 
 //==============================================================================
@@ -2133,14 +2166,7 @@ void BodyNode::aggregateCombinedVector(
     mCg_F += math::dAdInvT((*it)->getParentJoint()->mT, (*it)->mCg_F);
   }
 
-  std::size_t nGenCoords = mParentJoint->getNumDofs();
-  if (nGenCoords > 0)
-  {
-    Eigen::VectorXd Cg
-        = mParentJoint->getRelativeJacobian().transpose() * mCg_F;
-    std::size_t iStart = mParentJoint->getIndexInTree(0);
-    _Cg.segment(iStart, nGenCoords) = Cg;
-  }
+  mParentJoint->getSpatialToGeneralizedSegment(_Cg, mCg_F);
 }
 
 //==============================================================================
@@ -2156,14 +2182,7 @@ void BodyNode::aggregateExternalForces(Eigen::VectorXd& _Fext)
         (*it)->mParentJoint->getRelativeTransform(), (*it)->mFext_F);
   }
 
-  std::size_t nGenCoords = mParentJoint->getNumDofs();
-  if (nGenCoords > 0)
-  {
-    Eigen::VectorXd Fext
-        = mParentJoint->getRelativeJacobian().transpose() * mFext_F;
-    std::size_t iStart = mParentJoint->getIndexInTree(0);
-    _Fext.segment(iStart, nGenCoords) = Fext;
-  }
+  mParentJoint->getSpatialToGeneralizedSegment(_Fext, mFext_F);
 }
 
 //==============================================================================
@@ -2183,26 +2202,14 @@ void BodyNode::aggregateSpatialToGeneralized(
   }
 
   // Project the spatial quantity to generalized coordinates
-  const auto numDofs = mParentJoint->getNumDofs();
-  if (numDofs > 0u)
-  {
-    const std::size_t iStart = mParentJoint->getIndexInTree(0);
-    _generalized.segment(iStart, numDofs)
-        = mParentJoint->getSpatialToGeneralized(mArbitrarySpatial);
-  }
+  mParentJoint->getSpatialToGeneralizedSegment(_generalized, mArbitrarySpatial);
 }
 
 //==============================================================================
 void BodyNode::updateMassMatrix()
 {
   mM_dV.setZero();
-  std::size_t dof = mParentJoint->getNumDofs();
-  if (dof > 0)
-  {
-    mM_dV.noalias() += mParentJoint->getRelativeJacobian()
-                       * mParentJoint->getAccelerations();
-    assert(!math::isNan(mM_dV));
-  }
+  mParentJoint->addAccelerationTo(mM_dV);
   if (mParentBodyNode)
     mM_dV += math::AdInvT(
         mParentJoint->getRelativeTransform(), mParentBodyNode->mM_dV);
@@ -2232,13 +2239,7 @@ void BodyNode::aggregateMassMatrix(Eigen::MatrixXd& _MCol, std::size_t _col)
   assert(!math::isNan(mM_F));
 
   //
-  std::size_t dof = mParentJoint->getNumDofs();
-  if (dof > 0)
-  {
-    std::size_t iStart = mParentJoint->getIndexInTree(0);
-    _MCol.block(iStart, _col, dof, 1).noalias()
-        = mParentJoint->getRelativeJacobian().transpose() * mM_F;
-  }
+  mParentJoint->getMassMatrixSegment(_MCol, _col, mM_F);
 }
 
 //==============================================================================
@@ -2267,24 +2268,7 @@ void BodyNode::aggregateAugMassMatrix(
   assert(!math::isNan(mM_F));
 
   //
-  std::size_t dof = mParentJoint->getNumDofs();
-  if (dof > 0)
-  {
-    Eigen::MatrixXd K = Eigen::MatrixXd::Zero(dof, dof);
-    Eigen::MatrixXd D = Eigen::MatrixXd::Zero(dof, dof);
-    for (std::size_t i = 0; i < dof; ++i)
-    {
-      K(i, i) = mParentJoint->getSpringStiffness(i);
-      D(i, i) = mParentJoint->getDampingCoefficient(i);
-    }
-
-    std::size_t iStart = mParentJoint->getIndexInTree(0);
-
-    _MCol.block(iStart, _col, dof, 1).noalias()
-        = mParentJoint->getRelativeJacobian().transpose() * mM_F
-          + D * (_timeStep * mParentJoint->getAccelerations())
-          + K * (_timeStep * _timeStep * mParentJoint->getAccelerations());
-  }
+  mParentJoint->getAugMassMatrixSegment(_MCol, _col, mM_F, _timeStep);
 }
 
 //==============================================================================
@@ -2424,12 +2408,14 @@ void BodyNode::updateBodyJacobian() const
         == static_cast<std::size_t>(mBodyJacobian.cols()));
 
     assert(mParentJoint);
-    mBodyJacobian.leftCols(ascendantDof) = math::AdInvTJac(
-        mParentJoint->getRelativeTransform(), mParentBodyNode->getJacobian());
+    const Eigen::Isometry3d& T = mParentJoint->getRelativeTransform();
+    const math::Jacobian& J_parent = mParentBodyNode->getJacobian();
+    for (std::size_t i = 0; i < ascendantDof; ++i)
+      mBodyJacobian.col(i) = math::AdInvT(T, J_parent.col(i));
   }
 
   // Local Jacobian
-  mBodyJacobian.rightCols(localDof) = mParentJoint->getRelativeJacobian();
+  mParentJoint->getRelativeJacobianSegment(mBodyJacobian, ascendantDof);
 
   mIsBodyJacobianDirty = false;
 }
@@ -2476,14 +2462,14 @@ void BodyNode::updateBodyJacobianSpatialDeriv() const
         static_cast<std::size_t>(dJ_parent.cols()) + mParentJoint->getNumDofs()
         == static_cast<std::size_t>(mBodyJacobianSpatialDeriv.cols()));
 
-    mBodyJacobianSpatialDeriv.leftCols(numParentDOFs)
-        = math::AdInvTJac(mParentJoint->getRelativeTransform(), dJ_parent);
+    const Eigen::Isometry3d& T = mParentJoint->getRelativeTransform();
+    for (std::size_t i = 0; i < numParentDOFs; ++i)
+      mBodyJacobianSpatialDeriv.col(i) = math::AdInvT(T, dJ_parent.col(i));
   }
 
   // Local Jacobian: ad(V(i), S(i)) + dS(i)
-  mBodyJacobianSpatialDeriv.rightCols(numLocalDOFs)
-      = math::adJac(getSpatialVelocity(), mParentJoint->getRelativeJacobian())
-        + mParentJoint->getRelativeJacobianTimeDeriv();
+  mParentJoint->getRelativeJacobianSpatialDerivSegment(
+      mBodyJacobianSpatialDeriv, numParentDOFs, getSpatialVelocity());
 
   mIsBodyJacobianSpatialDerivDirty = false;
 }
@@ -2544,18 +2530,11 @@ void BodyNode::updateWorldJacobianClassicDeriv() const
           + dJ_parent.topRows<3>().colwise().cross(p);
   }
 
-  const math::Jacobian& dJ_local = mParentJoint->getRelativeJacobianTimeDeriv();
-  const math::Jacobian& J_local = mParentJoint->getRelativeJacobian();
   const Eigen::Isometry3d& T = getWorldTransform();
   const Eigen::Vector3d& w = getAngularVelocity();
 
-  mWorldJacobianClassicDeriv.block(0, numParentDOFs, 3, numLocalDOFs)
-      = T.linear() * dJ_local.topRows<3>()
-        - (T.linear() * J_local.topRows<3>()).colwise().cross(w);
-
-  mWorldJacobianClassicDeriv.block(3, numParentDOFs, 3, numLocalDOFs)
-      = T.linear() * dJ_local.bottomRows<3>()
-        - (T.linear() * J_local.bottomRows<3>()).colwise().cross(w);
+  mParentJoint->getRelativeJacobianClassicDerivSegment(
+      mWorldJacobianClassicDeriv, numParentDOFs, T.linear(), w);
 
   mIsWorldJacobianClassicDerivDirty = false;
 }
@@ -730,8 +730,8 @@ public:
 
   /// Return true if the body can react to force or constraint impulse.
   ///
-  /// A body node is reactive if the skeleton is mobile and the number of
-  /// dependent generalized coordinates is non zero.
+  /// A body node is reactive if the skeleton is mobile and not sleeping, and
+  /// the number of dependent generalized coordinates is non zero.
   bool isReactive() const;
 
   /// Set constraint impulse
@@ -866,6 +866,13 @@ protected:
   /// Remove this Entity from mChildBodyNodes or mNonBodyNodeEntities
   void processRemovedEntity(Entity* _oldChildEntity) override;
 
+  /// Propagate the deferred position changes of the Skeleton of this BodyNode
+  void flushDeferredUpdates() const override;
+
+  /// Ignore the flag of the parent Frame. A BodyNode reads the deferred
+  /// updates flag of its own Skeleton, which is set by init().
+  void setDeferredUpdatesFlag(const bool* flag) override;
+
   /// Update transformation
   virtual void updateTransform();
 
@@ -117,6 +117,9 @@ const std::vector<const DegreeOfFreedom*> FixedJacobianNode::getChainDofs()
 //==============================================================================
 const math::Jacobian& FixedJacobianNode::getJacobian() const
 {
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   if (mIsBodyJacobianDirty)
     updateBodyJacobian();
 
@@ -126,6 +129,9 @@ const math::Jacobian& FixedJacobianNode::getJacobian() const
 //==============================================================================
 const math::Jacobian& FixedJacobianNode::getWorldJacobian() const
 {
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   if (mIsWorldJacobianDirty)
     updateWorldJacobian();
 
@@ -135,6 +141,9 @@ const math::Jacobian& FixedJacobianNode::getWorldJacobian() const
 //==============================================================================
 const math::Jacobian& FixedJacobianNode::getJacobianSpatialDeriv() const
 {
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   if (mIsBodyJacobianSpatialDerivDirty)
     updateBodyJacobianSpatialDeriv();
 
@@ -144,6 +153,9 @@ const math::Jacobian& FixedJacobianNode::getJacobianSpatialDeriv() const
 //==============================================================================
 const math::Jacobian& FixedJacobianNode::getJacobianClassicDeriv() const
 {
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   if (mIsWorldJacobianClassicDerivDirty)
     updateWorldJacobianClassicDeriv();
 
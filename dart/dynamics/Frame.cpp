@@ -95,6 +95,9 @@ const Eigen::Isometry3d& Frame::getWorldTransform() const
   if (mAmWorld)
     return mWorldTransform;
 
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   if (mNeedTransformUpdate)
   {
     mWorldTransform
@@ -142,6 +145,9 @@ const Eigen::Vector6d& Frame::getSpatialVelocity() const
   if (mAmWorld)
     return mVelocity;
 
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   if (mNeedVelocityUpdate)
   {
     mVelocity
@@ -252,6 +258,9 @@ const Eigen::Vector6d& Frame::getSpatialAcceleration() const
   if (mAmWorld)
     return mAcceleration;
 
+  if (mDeferredUpdatesFlag && *mDeferredUpdatesFlag)
+    flushDeferredUpdates();
+
   if (mNeedAccelerationUpdate)
   {
     mAcceleration = math::AdInvT(
@@ -594,6 +603,7 @@ void Frame::changeParentFrame(Frame* _newParentFrame)
   if (nullptr == _newParentFrame)
   {
     Entity::changeParentFrame(_newParentFrame);
+    setDeferredUpdatesFlag(nullptr);
     return;
   }
 
@@ -601,6 +611,7 @@ void Frame::changeParentFrame(Frame* _newParentFrame)
     _newParentFrame->mChildFrames.insert(this);
 
   Entity::changeParentFrame(_newParentFrame);
+  setDeferredUpdatesFlag(_newParentFrame->mDeferredUpdatesFlag);
 }
 
 //==============================================================================
@@ -615,6 +626,22 @@ void Frame::processRemovedEntity(Entity*)
   // Do nothing
 }
 
+//==============================================================================
+void Frame::flushDeferredUpdates() const
+{
+  if (!mAmWorld && mParentFrame)
+    mParentFrame->flushDeferredUpdates();
+}
+
+//==============================================================================
+void Frame::setDeferredUpdatesFlag(const bool* flag)
+{
+  mDeferredUpdatesFlag = flag;
+
+  for (Frame* child : mChildFrames)
+    child->setDeferredUpdatesFlag(flag);
+}
+
 //==============================================================================
 Frame::Frame(ConstructWorldTag)
   : Entity(this, true),
@@ -59,6 +59,7 @@ public:
   friend class Entity;
   friend class WorldFrame;
   friend class ShapeFrame;
+  friend class Skeleton;
 
   Frame(const Frame&) = delete;
 
@@ -290,6 +291,20 @@ protected:
   /// special post-processing to be performed for extensions of the Frame class.
   virtual void processRemovedEntity(Entity* _oldChildEntity);
 
+  /// Called before the transform, velocity, or acceleration of this Frame is
+  /// read while a Skeleton has position changes that are deferred by a
+  /// position update batch, so that they are propagated first. The default
+  /// implementation forwards the request to the parent Frame, and BodyNode
+  /// propagates the changes of its Skeleton. See
+  /// Skeleton::beginPositionUpdateBatch().
+  virtual void flushDeferredUpdates() const;
+
+  /// Make this Frame and its descendants read the given flag to find out
+  /// whether their Skeleton has deferred position updates. Frames inherit the
+  /// flag of their parent Frame, while BodyNode overrides this function to
+  /// keep reading the flag of its own Skeleton.
+  virtual void setDeferredUpdatesFlag(const bool* flag);
+
 private:
   /// Used when constructing the World
   enum ConstructWorldTag
@@ -323,6 +338,12 @@ protected:
   /// Container of this Frame's child Entities.
   std::set<Entity*> mChildEntities;
 
+  /// Flag that is set while the Skeleton that this Frame belongs to has
+  /// position changes deferred by a position update batch. Reading a Frame
+  /// only calls flushDeferredUpdates() while it is set. This is nullptr for
+  /// Frames that are not attached to a Skeleton.
+  const bool* mDeferredUpdatesFlag = nullptr;
+
 private:
   /// Contains whether or not this is the World Frame
   const bool mAmWorld;
@@ -141,6 +141,9 @@ public:
   // Documentation inherited
   double getCommand(std::size_t index) const override;
 
+  // Documentation inherited
+  void setCommandUnclipped(std::size_t index, double command) override;
+
   // Documentation inherited
   void setCommands(const Eigen::VectorXd& commands) override;
 
@@ -541,6 +544,23 @@ protected:
   // Documentation inherited
   void updateRelativePrimaryAcceleration() const override;
 
+  // Documentation inherited
+  void getRelativeJacobianSegment(
+      math::Jacobian& J, std::size_t col) const override;
+
+  // Documentation inherited
+  void getRelativeJacobianSpatialDerivSegment(
+      math::Jacobian& dJ,
+      std::size_t col,
+      const Eigen::Vector6d& V) const override;
+
+  // Documentation inherited
+  void getRelativeJacobianClassicDerivSegment(
+      math::Jacobian& dJ,
+      std::size_t col,
+      const Eigen::Matrix3d& R,
+      const Eigen::Vector3d& w) const override;
+
   // Documentation inherited
   void addVelocityTo(Eigen::Vector6d& vel) override;
 
@@ -671,6 +691,23 @@ protected:
   Eigen::VectorXd getSpatialToGeneralized(
       const Eigen::Vector6d& spatial) override;
 
+  // Documentation inherited
+  void getSpatialToGeneralizedSegment(
+      Eigen::VectorXd& generalized, const Eigen::Vector6d& spatial) override;
+
+  // Documentation inherited
+  void getMassMatrixSegment(
+      Eigen::MatrixXd& massMat,
+      const size_t col,
+      const Eigen::Vector6d& bodyForce) override;
+
+  // Documentation inherited
+  void getAugMassMatrixSegment(
+      Eigen::MatrixXd& augMassMat,
+      const size_t col,
+      const Eigen::Vector6d& bodyForce,
+      double timeStep) override;
+
   /// \}
 
 protected:
@@ -38,6 +38,7 @@
 #include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/DegreeOfFreedom.hpp"
 #include "dart/dynamics/Skeleton.hpp"
+#include "dart/math/Geometry.hpp"
 #include "dart/math/Helpers.hpp"
 
 namespace dart {
@@ -196,6 +197,9 @@ const std::string& Joint::getName() const
 void Joint::setActuatorType(Joint::ActuatorType _actuatorType)
 {
   mAspectProperties.mActuatorType = _actuatorType;
+
+  if (const SkeletonPtr& skel = getSkeleton())
+    skel->dirtyFreeRigidBody();
 }
 
 //==============================================================================
@@ -388,6 +392,12 @@ const Eigen::Vector6d& Joint::getRelativePrimaryAcceleration() const
   return mPrimaryAcceleration;
 }
 
+//==============================================================================
+void Joint::setCommandUnclipped(std::size_t index, double command)
+{
+  setCommand(index, command);
+}
+
 //==============================================================================
 void Joint::setPositionLimitEnforced(bool enforced)
 {
@@ -527,7 +537,8 @@ Joint::Joint()
     mNeedSpatialAccelerationUpdate(true),
     mNeedPrimaryAccelerationUpdate(true),
     mIsRelativeJacobianDirty(true),
-    mIsRelativeJacobianTimeDerivDirty(true)
+    mIsRelativeJacobianTimeDerivDirty(true),
+    mIsPositionUpdatePending(false)
 {
   // Do nothing. The Joint::Aspect must be created by a derived class.
 }
@@ -574,12 +585,104 @@ void Joint::updateLocalJacobianTimeDeriv() const
   updateRelativeJacobianTimeDeriv();
 }
 
+//==============================================================================
+void Joint::getRelativeJacobianSegment(math::Jacobian& _J, std::size_t _col) const
+{
+  const std::size_t dof = getNumDofs();
+  if (dof == 0u)
+    return;
+
+  _J.middleCols(_col, dof) = getRelativeJacobian();
+}
+
+//==============================================================================
+void Joint::getRelativeJacobianSpatialDerivSegment(
+    math::Jacobian& _dJ, std::size_t _col, const Eigen::Vector6d& _V) const
+{
+  const std::size_t dof = getNumDofs();
+  if (dof == 0u)
+    return;
+
+  _dJ.middleCols(_col, dof) = math::adJac(_V, getRelativeJacobian())
+                              + getRelativeJacobianTimeDeriv();
+}
+
+//==============================================================================
+void Joint::getRelativeJacobianClassicDerivSegment(
+    math::Jacobian& _dJ,
+    std::size_t _col,
+    const Eigen::Matrix3d& _R,
+    const Eigen::Vector3d& _w) const
+{
+  const std::size_t dof = getNumDofs();
+  if (dof == 0u)
+    return;
+
+  const math::Jacobian J = getRelativeJacobian();
+  const math::Jacobian dJ = getRelativeJacobianTimeDeriv();
+
+  _dJ.block(0, _col, 3, dof)
+      = _R * dJ.topRows<3>() - (_R * J.topRows<3>()).colwise().cross(_w);
+  _dJ.block(3, _col, 3, dof)
+      = _R * dJ.bottomRows<3>() - (_R * J.bottomRows<3>()).colwise().cross(_w);
+}
+
 //==============================================================================
 void Joint::updateArticulatedInertia() const
 {
   mChildBodyNode->getArticulatedInertia();
 }
 
+//==============================================================================
+void Joint::getSpatialToGeneralizedSegment(
+    Eigen::VectorXd& _generalized, const Eigen::Vector6d& _spatial)
+{
+  const std::size_t dof = getNumDofs();
+  if (dof == 0u)
+    return;
+
+  _generalized.segment(getIndexInTree(0), dof)
+      = getSpatialToGeneralized(_spatial);
+}
+
+//==============================================================================
+void Joint::getMassMatrixSegment(
+    Eigen::MatrixXd& _massMat,
+    const std::size_t _col,
+    const Eigen::Vector6d& _bodyForce)
+{
+  const std::size_t dof = getNumDofs();
+  if (dof == 0u)
+    return;
+
+  _massMat.block(getIndexInTree(0), _col, dof, 1).noalias()
+      = getRelativeJacobian().transpose() * _bodyForce;
+}
+
+//==============================================================================
+void Joint::getAugMassMatrixSegment(
+    Eigen::MatrixXd& _augMassMat,
+    const std::size_t _col,
+    const Eigen::Vector6d& _bodyForce,
+    double _timeStep)
+{
+  const std::size_t dof = getNumDofs();
+  if (dof == 0u)
+    return;
+
+  const std::size_t iStart = getIndexInTree(0);
+  _augMassMat.block(iStart, _col, dof, 1).noalias()
+      = getRelativeJacobian().transpose() * _bodyForce;
+
+  for (std::size_t i = 0; i < dof; ++i)
+  {
+    _augMassMat(iStart + i, _col)
+        += (_timeStep * getDampingCoefficient(i)
+            + _timeStep * _timeStep * getSpringStiffness(i))
+           * getAcceleration(i);
+  }
+}
+
 //==============================================================================
 // Eigen::VectorXd Joint::getDampingForces() const
 //{
@@ -617,13 +720,6 @@ void Joint::notifyPositionUpdate()
 //==============================================================================
 void Joint::notifyPositionUpdated()
 {
-  if (mChildBodyNode)
-  {
-    mChildBodyNode->dirtyTransform();
-    mChildBodyNode->dirtyJacobian();
-    mChildBodyNode->dirtyJacobianDeriv();
-  }
-
   mIsRelativeJacobianDirty = true;
   mIsRelativeJacobianTimeDerivDirty = true;
   mNeedPrimaryAccelerationUpdate = true;
@@ -633,6 +729,32 @@ void Joint::notifyPositionUpdated()
   mNeedSpatialAccelerationUpdate = true;
 
   SkeletonPtr skel = getSkeleton();
+
+  // A Skeleton that is moved is checked for collisions against the sleeping
+  // ones again
+  if (skel && skel->mIsSleeping)
+    skel->setSleeping(false);
+
+  if (skel && skel->mPositionUpdateBatchDepth > 0u)
+  {
+    // Defer the propagation until the batch ends or a quantity is read
+    skel->deferPositionUpdate(this);
+    return;
+  }
+
+  propagatePositionUpdate(skel.get());
+}
+
+//==============================================================================
+void Joint::propagatePositionUpdate(Skeleton* skel)
+{
+  if (mChildBodyNode)
+  {
+    mChildBodyNode->dirtyTransform();
+    mChildBodyNode->dirtyJacobian();
+    mChildBodyNode->dirtyJacobianDeriv();
+  }
+
   if (skel)
   {
     std::size_t tree = mChildBodyNode->mTreeIndex;
@@ -282,6 +282,11 @@ public:
   /// Get a single command
   virtual double getCommand(std::size_t _index) const = 0;
 
+  /// Set a single command as it is, without clipping it to the limits of the
+  /// actuator. Used to restore a command returned by getCommand(). The
+  /// default implementation calls setCommand().
+  virtual void setCommandUnclipped(std::size_t index, double command);
+
   /// Set all commands for this Joint
   virtual void setCommands(const Eigen::VectorXd& _commands) = 0;
 
@@ -732,7 +737,9 @@ public:
   DART_DEPRECATED(6.2)
   void notifyPositionUpdate();
 
-  /// Notify that a position has updated
+  /// Notify that a position has updated. If a position update batch of the
+  /// Skeleton is open, the notification of the child BodyNode is deferred
+  /// until the batch ends.
   void notifyPositionUpdated();
 
   /// Notify that a velocity has updated
@@ -783,6 +790,12 @@ protected:
   /// called with _renameDofs set to true.
   virtual void updateDegreeOfFreedomNames() = 0;
 
+  /// Dirty the child BodyNode subtree and the dynamics caches of \c skel that
+  /// depend on the position of this Joint. Called by notifyPositionUpdated()
+  /// or, when a position update batch is open, by
+  /// Skeleton::endPositionUpdateBatch().
+  void propagatePositionUpdate(Skeleton* skel);
+
   //----------------------------------------------------------------------------
   /// \{ \name Recursive dynamics routines
   //----------------------------------------------------------------------------
@@ -842,6 +855,29 @@ protected:
   /// function will be a no op.
   virtual void updateRelativeJacobianTimeDeriv() const = 0;
 
+  /// Assign the relative Jacobian of this Joint to the columns of _J starting
+  /// at _col. Unlike getRelativeJacobian(), this does not create a temporary
+  /// dynamic-size Jacobian.
+  virtual void getRelativeJacobianSegment(
+      math::Jacobian& _J, std::size_t _col) const;
+
+  /// Assign ad(_V, S) + dS, the local columns of the spatial Jacobian
+  /// derivative of the child BodyNode, to the columns of _dJ starting at _col
+  /// where S is the relative Jacobian of this Joint and _V is the spatial
+  /// velocity of the child BodyNode.
+  virtual void getRelativeJacobianSpatialDerivSegment(
+      math::Jacobian& _dJ, std::size_t _col, const Eigen::Vector6d& _V) const;
+
+  /// Assign the local columns of the classic Jacobian derivative of the child
+  /// BodyNode, (R * dS) - (R * S) x _w, to the columns of _dJ starting at _col
+  /// where _R is the world orientation and _w is the world angular velocity of
+  /// the child BodyNode.
+  virtual void getRelativeJacobianClassicDerivSegment(
+      math::Jacobian& _dJ,
+      std::size_t _col,
+      const Eigen::Matrix3d& _R,
+      const Eigen::Vector3d& _w) const;
+
   /// Tells the Skeleton to update the articulated inertia if it needs updating
   void updateArticulatedInertia() const;
 
@@ -1010,6 +1046,27 @@ protected:
       const Eigen::Vector6d& _spatial)
       = 0;
 
+  /// Assign J^T * _spatial, the projection of the spatial force _spatial
+  /// onto the generalized coordinates of this Joint, to the segment of
+  /// _generalized that corresponds to the DOFs of this Joint in its tree.
+  virtual void getSpatialToGeneralizedSegment(
+      Eigen::VectorXd& _generalized, const Eigen::Vector6d& _spatial);
+
+  /// Assign J^T * _bodyForce to the block of column _col of _massMat that
+  /// corresponds to the DOFs of this Joint in its tree.
+  virtual void getMassMatrixSegment(
+      Eigen::MatrixXd& _massMat,
+      const std::size_t _col,
+      const Eigen::Vector6d& _bodyForce);
+
+  /// Same as getMassMatrixSegment() but also adds the implicit damping and
+  /// spring terms of this Joint.
+  virtual void getAugMassMatrixSegment(
+      Eigen::MatrixXd& _augMassMat,
+      const std::size_t _col,
+      const Eigen::Vector6d& _bodyForce,
+      double _timeStep);
+
   /// \}
 
 protected:
@@ -1067,6 +1124,10 @@ protected:
   /// updated since the last position or velocity change
   mutable bool mIsRelativeJacobianTimeDerivDirty;
 
+  /// True iff this joint's position change is waiting for the position update
+  /// batch of its Skeleton to end. See Skeleton::beginPositionUpdateBatch().
+  bool mIsPositionUpdatePending;
+
 public:
   // To get byte-aligned Eigen vectors
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -397,6 +397,9 @@ double MetaSkeleton::getPosition(std::size_t _index) const
 //==============================================================================
 void MetaSkeleton::setPositions(const Eigen::VectorXd& _positions)
 {
+  // Notify the BodyNodes once per Joint rather than once per DegreeOfFreedom
+  PositionUpdateBatch batch(this);
+
   setAllValuesFromVector<&DegreeOfFreedom::setPosition>(
       this, _positions, "setPositions", "_positions");
 }
@@ -405,10 +408,40 @@ void MetaSkeleton::setPositions(const Eigen::VectorXd& _positions)
 void MetaSkeleton::setPositions(
     const std::vector<std::size_t>& _indices, const Eigen::VectorXd& _positions)
 {
+  PositionUpdateBatch batch(this);
+
   setValuesFromVector<&DegreeOfFreedom::setPosition>(
       this, _indices, _positions, "setPositions", "_positions");
 }
 
+//==============================================================================
+MetaSkeleton::PositionUpdateBatch::PositionUpdateBatch(
+    MetaSkeleton* metaSkeleton)
+  : mMetaSkeleton(metaSkeleton)
+{
+  if (mMetaSkeleton)
+    mMetaSkeleton->beginPositionUpdateBatch();
+}
+
+//==============================================================================
+MetaSkeleton::PositionUpdateBatch::~PositionUpdateBatch()
+{
+  if (mMetaSkeleton)
+    mMetaSkeleton->endPositionUpdateBatch();
+}
+
+//==============================================================================
+void MetaSkeleton::beginPositionUpdateBatch()
+{
+  // Do nothing
+}
+
+//==============================================================================
+void MetaSkeleton::endPositionUpdateBatch()
+{
+  // Do nothing
+}
+
 //==============================================================================
 Eigen::VectorXd MetaSkeleton::getPositions() const
 {
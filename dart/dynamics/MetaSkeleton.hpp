@@ -284,6 +284,42 @@ public:
   /// Set all positions to zero
   void resetPositions();
 
+  /// Scoped helper that calls beginPositionUpdateBatch() on construction and
+  /// endPositionUpdateBatch() on destruction.
+  ///
+  /// Example code:
+  /// \code
+  /// {
+  ///   Skeleton::PositionUpdateBatch batch(skel.get());
+  ///   for (std::size_t i = 0; i < skel->getNumDofs(); ++i)
+  ///     skel->getDof(i)->setPosition(q[i]);
+  /// } // The changed subtrees are dirtied once here, or at the first read
+  /// \endcode
+  class PositionUpdateBatch
+  {
+  public:
+    /// Constructor
+    explicit PositionUpdateBatch(MetaSkeleton* metaSkeleton);
+
+    /// Destructor
+    ~PositionUpdateBatch();
+
+    PositionUpdateBatch(const PositionUpdateBatch&) = delete;
+    PositionUpdateBatch& operator=(const PositionUpdateBatch&) = delete;
+
+  private:
+    MetaSkeleton* mMetaSkeleton;
+  };
+
+  /// Start deferring the update notifications that are caused by changing the
+  /// positions of this MetaSkeleton. The default implementation does nothing.
+  /// See Skeleton::beginPositionUpdateBatch().
+  virtual void beginPositionUpdateBatch();
+
+  /// End a batch that was started by beginPositionUpdateBatch(). The default
+  /// implementation does nothing.
+  virtual void endPositionUpdateBatch();
+
   /// Set the lower limit of a generalized coordinate's position
   void setPositionLowerLimit(std::size_t _index, double _position);
 
@@ -59,7 +59,9 @@ DynamicsAspectProperties::DynamicsAspectProperties(
     mRestitutionCoeff(restitutionCoeff),
     mSecondaryFrictionCoeff(frictionCoeff),
     mFirstFrictionDirection(Eigen::Vector3d::Zero()),
-    mFirstFrictionDirectionFrame(nullptr)
+    mFirstFrictionDirectionFrame(nullptr),
+    mContactStiffness(0.0),
+    mContactDamping(0.0)
 {
   // Do nothing
 }
@@ -75,7 +77,9 @@ DynamicsAspectProperties::DynamicsAspectProperties(
     mRestitutionCoeff(restitutionCoeff),
     mSecondaryFrictionCoeff(secondaryFrictionCoeff),
     mFirstFrictionDirection(firstFrictionDirection),
-    mFirstFrictionDirectionFrame(firstFrictionDirectionFrame)
+    mFirstFrictionDirectionFrame(firstFrictionDirectionFrame),
+    mContactStiffness(0.0),
+    mContactDamping(0.0)
 {
   // Do nothing
 }
@@ -170,6 +170,21 @@ public:
   DART_COMMON_SET_GET_ASPECT_PROPERTY(Eigen::Vector3d, FirstFrictionDirection)
   // void setFirstFrictionDirection(const Eigen::Vector3d& value);
   // const Eigen::Vector3d& getFirstFrictionDirection() const;
+
+  /// Set the stiffness of the compliant contact model of this shape. The
+  /// contacts of the shape are solved as implicit spring-dampers, separately
+  /// from the rigid contacts, when the stiffness is positive. The contact
+  /// points between two shapes share the stiffness, so it's the stiffness of
+  /// the whole contact regardless of the number of points. See
+  /// ContactConstraint::isCompliant().
+  DART_COMMON_SET_GET_ASPECT_PROPERTY(double, ContactStiffness)
+  // void setContactStiffness(const double& value);
+  // const double& getContactStiffness() const;
+
+  /// Set the damping of the compliant contact model of this shape
+  DART_COMMON_SET_GET_ASPECT_PROPERTY(double, ContactDamping)
+  // void setContactDamping(const double& value);
+  // const double& getContactDamping() const;
 };
 
 //==============================================================================
@@ -43,6 +43,7 @@
 #include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/DegreeOfFreedom.hpp"
 #include "dart/dynamics/EndEffector.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
 #include "dart/dynamics/InverseKinematics.hpp"
 #include "dart/dynamics/Joint.hpp"
 #include "dart/dynamics/Marker.hpp"
@@ -298,6 +299,23 @@ BodyNodePropertiesVector getAllJointProperties(const Skeleton* skel)
       &common::Composite::getCompositeProperties>(skel);
 }
 
+//==============================================================================
+/// Returns the spatial acceleration that the spatial force F causes on a rigid
+/// body with the given inertia, i.e., the inverse of the spatial inertia tensor
+/// applied to F, computed by shifting F to the center of mass.
+Eigen::Vector6d applyInverseSpatialInertia(
+    const Inertia& inertia, const Eigen::Vector6d& F)
+{
+  const Eigen::Vector3d& com = inertia.getLocalCOM();
+
+  Eigen::Vector6d A;
+  A.head<3>().noalias() = inertia.getMoment().inverse()
+                          * (F.head<3>() - com.cross(F.tail<3>()));
+  A.tail<3>() = F.tail<3>() / inertia.getMass() + com.cross(A.head<3>());
+
+  return A;
+}
+
 } // namespace detail
 
 //==============================================================================
@@ -514,6 +532,7 @@ SkeletonPtr Skeleton::cloneSkeleton(const std::string& cloneName) const
   skelClone->setProperties(getAspectProperties());
   skelClone->setName(cloneName);
   skelClone->setState(getState());
+  skelClone->mIsSleeping = mIsSleeping;
 
   // Fix mimic joint references
   for (std::size_t i = 0; i < getNumJoints(); ++i)
@@ -609,6 +628,66 @@ Skeleton::Configuration Skeleton::getConfiguration(
   return config;
 }
 
+//==============================================================================
+void Skeleton::beginPositionUpdateBatch()
+{
+  ++mPositionUpdateBatchDepth;
+}
+
+//==============================================================================
+void Skeleton::endPositionUpdateBatch()
+{
+  if (0u == mPositionUpdateBatchDepth)
+  {
+    dtwarn << "[Skeleton::endPositionUpdateBatch] Attempting to end a position "
+           << "update batch of Skeleton [" << getName() << "] (" << this
+           << "), but no batch is open. Ignoring this request.\n";
+    assert(false);
+    return;
+  }
+
+  --mPositionUpdateBatchDepth;
+  if (mPositionUpdateBatchDepth > 0u)
+    return;
+
+  flushPositionUpdates();
+}
+
+//==============================================================================
+bool Skeleton::isPositionUpdateBatchOpen() const
+{
+  return mPositionUpdateBatchDepth > 0u;
+}
+
+//==============================================================================
+void Skeleton::flushPositionUpdates() const
+{
+  if (mPendingPositionUpdates.empty())
+    return;
+
+  // Each Joint is listed at most once. Dirtying a subtree stops at any BodyNode
+  // that is already dirty, so overlapping subtrees are only visited once.
+  Skeleton* skel = const_cast<Skeleton*>(this);
+  for (Joint* joint : mPendingPositionUpdates)
+  {
+    joint->mIsPositionUpdatePending = false;
+    joint->propagatePositionUpdate(skel);
+  }
+  mPendingPositionUpdates.clear();
+  mHasDeferredPositionUpdates = false;
+}
+
+//==============================================================================
+void Skeleton::deferPositionUpdate(Joint* joint)
+{
+  if (joint->mIsPositionUpdatePending)
+    return;
+
+  joint->mIsPositionUpdatePending = true;
+  mHasDeferredPositionUpdates = true;
+  mPendingPositionUpdates.push_back(joint);
+}
+
 //==============================================================================
 void Skeleton::setState(const State& state)
 {
@@ -816,6 +895,27 @@ bool Skeleton::isMobile() const
   return mAspectProperties.mIsMobile;
 }
 
+//==============================================================================
+void Skeleton::setSleeping(bool _isSleeping)
+{
+  if (mIsSleeping == _isSleeping)
+    return;
+
+  mIsSleeping = _isSleeping;
+
+  if (mIsSleeping)
+  {
+    setVelocities(Eigen::VectorXd::Zero(getNumDofs()));
+    setAccelerations(Eigen::VectorXd::Zero(getNumDofs()));
+  }
+}
+
+//==============================================================================
+bool Skeleton::isSleeping() const
+{
+  return mIsSleeping;
+}
+
 //==============================================================================
 void Skeleton::setTimeStep(double _timeStep)
 {
@@ -1634,7 +1734,7 @@ Eigen::VectorXd Skeleton::getVelocityDifferences(
 static bool isValidBodyNode(
     const Skeleton* _skeleton,
     const JacobianNode* _node,
-    const std::string& _fname)
+    const char* _fname)
 {
   if (nullptr == _node)
   {
@@ -1679,39 +1779,47 @@ void assignJacobian(
 
 //==============================================================================
 template <typename... Args>
-math::Jacobian variadicGetJacobian(
-    const Skeleton* _skel, const JacobianNode* _node, Args... args)
+void variadicGetJacobian(
+    const Skeleton* _skel,
+    const JacobianNode* _node,
+    math::Jacobian& _J,
+    Args... args)
 {
-  math::Jacobian J = math::Jacobian::Zero(6, _skel->getNumDofs());
+  _J.setZero(6, _skel->getNumDofs());
 
   if (!isValidBodyNode(_skel, _node, "getJacobian"))
-    return J;
-
-  const math::Jacobian JBodyNode = _node->getJacobian(args...);
+    return;
 
-  assignJacobian<math::Jacobian>(J, _node, JBodyNode);
+  // Bind to a reference so that the Jacobian cached in the node is not copied
+  const math::Jacobian& JBodyNode = _node->getJacobian(args...);
 
-  return J;
+  assignJacobian<math::Jacobian>(_J, _node, JBodyNode);
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobian(const JacobianNode* _node) const
 {
-  return variadicGetJacobian(this, _node);
+  math::Jacobian J;
+  variadicGetJacobian(this, _node, J);
+  return J;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobian(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobian(this, _node, _inCoordinatesOf);
+  math::Jacobian J;
+  variadicGetJacobian(this, _node, J, _inCoordinatesOf);
+  return J;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobian(
     const JacobianNode* _node, const Eigen::Vector3d& _localOffset) const
 {
-  return variadicGetJacobian(this, _node, _localOffset);
+  math::Jacobian J;
+  variadicGetJacobian(this, _node, J, _localOffset);
+  return J;
 }
 
 //==============================================================================
@@ -1720,37 +1828,94 @@ math::Jacobian Skeleton::getJacobian(
     const Eigen::Vector3d& _localOffset,
     const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobian(this, _node, _localOffset, _inCoordinatesOf);
+  math::Jacobian J;
+  variadicGetJacobian(this, _node, J, _localOffset, _inCoordinatesOf);
+  return J;
+}
+
+//==============================================================================
+void Skeleton::getJacobian(const JacobianNode* _node, math::Jacobian& _J) const
+{
+  variadicGetJacobian(this, _node, _J);
+}
+
+//==============================================================================
+void Skeleton::getJacobian(
+    const JacobianNode* _node,
+    const Frame* _inCoordinatesOf,
+    math::Jacobian& _J) const
+{
+  variadicGetJacobian(this, _node, _J, _inCoordinatesOf);
+}
+
+//==============================================================================
+void Skeleton::getJacobian(
+    const JacobianNode* _node,
+    const Eigen::Vector3d& _localOffset,
+    math::Jacobian& _J) const
+{
+  variadicGetJacobian(this, _node, _J, _localOffset);
+}
+
+//==============================================================================
+void Skeleton::getJacobian(
+    const JacobianNode* _node,
+    const Eigen::Vector3d& _localOffset,
+    const Frame* _inCoordinatesOf,
+    math::Jacobian& _J) const
+{
+  variadicGetJacobian(this, _node, _J, _localOffset, _inCoordinatesOf);
 }
 
 //==============================================================================
 template <typename... Args>
-math::Jacobian variadicGetWorldJacobian(
-    const Skeleton* _skel, const JacobianNode* _node, Args... args)
+void variadicGetWorldJacobian(
+    const Skeleton* _skel,
+    const JacobianNode* _node,
+    math::Jacobian& _J,
+    Args... args)
 {
-  math::Jacobian J = math::Jacobian::Zero(6, _skel->getNumDofs());
+  _J.setZero(6, _skel->getNumDofs());
 
   if (!isValidBodyNode(_skel, _node, "getWorldJacobian"))
-    return J;
-
-  const math::Jacobian JBodyNode = _node->getWorldJacobian(args...);
+    return;
 
-  assignJacobian<math::Jacobian>(J, _node, JBodyNode);
+  const math::Jacobian& JBodyNode = _node->getWorldJacobian(args...);
 
-  return J;
+  assignJacobian<math::Jacobian>(_J, _node, JBodyNode);
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getWorldJacobian(const JacobianNode* _node) const
 {
-  return variadicGetWorldJacobian(this, _node);
+  math::Jacobian J;
+  variadicGetWorldJacobian(this, _node, J);
+  return J;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getWorldJacobian(
     const JacobianNode* _node, const Eigen::Vector3d& _localOffset) const
 {
-  return variadicGetWorldJacobian(this, _node, _localOffset);
+  math::Jacobian J;
+  variadicGetWorldJacobian(this, _node, J, _localOffset);
+  return J;
+}
+
+//==============================================================================
+void Skeleton::getWorldJacobian(
+    const JacobianNode* _node, math::Jacobian& _J) const
+{
+  variadicGetWorldJacobian(this, _node, _J);
+}
+
+//==============================================================================
+void Skeleton::getWorldJacobian(
+    const JacobianNode* _node,
+    const Eigen::Vector3d& _localOffset,
+    math::Jacobian& _J) const
+{
+  variadicGetWorldJacobian(this, _node, _J, _localOffset);
 }
 
 //==============================================================================
@@ -1763,7 +1928,7 @@ math::LinearJacobian variadicGetLinearJacobian(
   if (!isValidBodyNode(_skel, _node, "getLinearJacobian"))
     return J;
 
-  const math::LinearJacobian JBodyNode = _node->getLinearJacobian(args...);
+  const math::LinearJacobian& JBodyNode = _node->getLinearJacobian(args...);
 
   assignJacobian<math::LinearJacobian>(J, _node, JBodyNode);
 
@@ -1796,7 +1961,7 @@ math::AngularJacobian variadicGetAngularJacobian(
   if (!isValidBodyNode(_skel, _node, "getAngularJacobian"))
     return J;
 
-  const math::AngularJacobian JBodyNode = _node->getAngularJacobian(args...);
+  const math::AngularJacobian& JBodyNode = _node->getAngularJacobian(args...);
 
   assignJacobian<math::AngularJacobian>(J, _node, JBodyNode);
 
@@ -1812,40 +1977,47 @@ math::AngularJacobian Skeleton::getAngularJacobian(
 
 //==============================================================================
 template <typename... Args>
-math::Jacobian variadicGetJacobianSpatialDeriv(
-    const Skeleton* _skel, const JacobianNode* _node, Args... args)
+void variadicGetJacobianSpatialDeriv(
+    const Skeleton* _skel,
+    const JacobianNode* _node,
+    math::Jacobian& _dJ,
+    Args... args)
 {
-  math::Jacobian dJ = math::Jacobian::Zero(6, _skel->getNumDofs());
+  _dJ.setZero(6, _skel->getNumDofs());
 
   if (!isValidBodyNode(_skel, _node, "getJacobianSpatialDeriv"))
-    return dJ;
-
-  const math::Jacobian dJBodyNode = _node->getJacobianSpatialDeriv(args...);
+    return;
 
-  assignJacobian<math::Jacobian>(dJ, _node, dJBodyNode);
+  const math::Jacobian& dJBodyNode = _node->getJacobianSpatialDeriv(args...);
 
-  return dJ;
+  assignJacobian<math::Jacobian>(_dJ, _node, dJBodyNode);
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobianSpatialDeriv(
     const JacobianNode* _node) const
 {
-  return variadicGetJacobianSpatialDeriv(this, _node);
+  math::Jacobian dJ;
+  variadicGetJacobianSpatialDeriv(this, _node, dJ);
+  return dJ;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobianSpatialDeriv(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobianSpatialDeriv(this, _node, _inCoordinatesOf);
+  math::Jacobian dJ;
+  variadicGetJacobianSpatialDeriv(this, _node, dJ, _inCoordinatesOf);
+  return dJ;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobianSpatialDeriv(
     const JacobianNode* _node, const Eigen::Vector3d& _localOffset) const
 {
-  return variadicGetJacobianSpatialDeriv(this, _node, _localOffset);
+  math::Jacobian dJ;
+  variadicGetJacobianSpatialDeriv(this, _node, dJ, _localOffset);
+  return dJ;
 }
 
 //==============================================================================
@@ -1854,39 +2026,82 @@ math::Jacobian Skeleton::getJacobianSpatialDeriv(
     const Eigen::Vector3d& _localOffset,
     const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobianSpatialDeriv(
-      this, _node, _localOffset, _inCoordinatesOf);
+  math::Jacobian dJ;
+  variadicGetJacobianSpatialDeriv(
+      this, _node, dJ, _localOffset, _inCoordinatesOf);
+  return dJ;
+}
+
+//==============================================================================
+void Skeleton::getJacobianSpatialDeriv(
+    const JacobianNode* _node, math::Jacobian& _dJ) const
+{
+  variadicGetJacobianSpatialDeriv(this, _node, _dJ);
+}
+
+//==============================================================================
+void Skeleton::getJacobianSpatialDeriv(
+    const JacobianNode* _node,
+    const Frame* _inCoordinatesOf,
+    math::Jacobian& _dJ) const
+{
+  variadicGetJacobianSpatialDeriv(this, _node, _dJ, _inCoordinatesOf);
+}
+
+//==============================================================================
+void Skeleton::getJacobianSpatialDeriv(
+    const JacobianNode* _node,
+    const Eigen::Vector3d& _localOffset,
+    math::Jacobian& _dJ) const
+{
+  variadicGetJacobianSpatialDeriv(this, _node, _dJ, _localOffset);
+}
+
+//==============================================================================
+void Skeleton::getJacobianSpatialDeriv(
+    const JacobianNode* _node,
+    const Eigen::Vector3d& _localOffset,
+    const Frame* _inCoordinatesOf,
+    math::Jacobian& _dJ) const
+{
+  variadicGetJacobianSpatialDeriv(
+      this, _node, _dJ, _localOffset, _inCoordinatesOf);
 }
 
 //==============================================================================
 template <typename... Args>
-math::Jacobian variadicGetJacobianClassicDeriv(
-    const Skeleton* _skel, const JacobianNode* _node, Args... args)
+void variadicGetJacobianClassicDeriv(
+    const Skeleton* _skel,
+    const JacobianNode* _node,
+    math::Jacobian& _dJ,
+    Args... args)
 {
-  math::Jacobian dJ = math::Jacobian::Zero(6, _skel->getNumDofs());
+  _dJ.setZero(6, _skel->getNumDofs());
 
   if (!isValidBodyNode(_skel, _node, "getJacobianClassicDeriv"))
-    return dJ;
-
-  const math::Jacobian dJBodyNode = _node->getJacobianClassicDeriv(args...);
+    return;
 
-  assignJacobian<math::Jacobian>(dJ, _node, dJBodyNode);
+  const math::Jacobian& dJBodyNode = _node->getJacobianClassicDeriv(args...);
 
-  return dJ;
+  assignJacobian<math::Jacobian>(_dJ, _node, dJBodyNode);
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobianClassicDeriv(
     const JacobianNode* _node) const
 {
-  return variadicGetJacobianClassicDeriv(this, _node);
+  math::Jacobian dJ;
+  variadicGetJacobianClassicDeriv(this, _node, dJ);
+  return dJ;
 }
 
 //==============================================================================
 math::Jacobian Skeleton::getJacobianClassicDeriv(
     const JacobianNode* _node, const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobianClassicDeriv(this, _node, _inCoordinatesOf);
+  math::Jacobian dJ;
+  variadicGetJacobianClassicDeriv(this, _node, dJ, _inCoordinatesOf);
+  return dJ;
 }
 
 //==============================================================================
@@ -1895,8 +2110,37 @@ math::Jacobian Skeleton::getJacobianClassicDeriv(
     const Eigen::Vector3d& _localOffset,
     const Frame* _inCoordinatesOf) const
 {
-  return variadicGetJacobianClassicDeriv(
-      this, _node, _localOffset, _inCoordinatesOf);
+  math::Jacobian dJ;
+  variadicGetJacobianClassicDeriv(
+      this, _node, dJ, _localOffset, _inCoordinatesOf);
+  return dJ;
+}
+
+//==============================================================================
+void Skeleton::getJacobianClassicDeriv(
+    const JacobianNode* _node, math::Jacobian& _dJ) const
+{
+  variadicGetJacobianClassicDeriv(this, _node, _dJ);
+}
+
+//==============================================================================
+void Skeleton::getJacobianClassicDeriv(
+    const JacobianNode* _node,
+    const Frame* _inCoordinatesOf,
+    math::Jacobian& _dJ) const
+{
+  variadicGetJacobianClassicDeriv(this, _node, _dJ, _inCoordinatesOf);
+}
+
+//==============================================================================
+void Skeleton::getJacobianClassicDeriv(
+    const JacobianNode* _node,
+    const Eigen::Vector3d& _localOffset,
+    const Frame* _inCoordinatesOf,
+    math::Jacobian& _dJ) const
+{
+  variadicGetJacobianClassicDeriv(
+      this, _node, _dJ, _localOffset, _inCoordinatesOf);
 }
 
 //==============================================================================
@@ -1909,7 +2153,7 @@ math::LinearJacobian variadicGetLinearJacobianDeriv(
   if (!isValidBodyNode(_skel, _node, "getLinearJacobianDeriv"))
     return dJv;
 
-  const math::LinearJacobian dJvBodyNode
+  const math::LinearJacobian& dJvBodyNode
       = _node->getLinearJacobianDeriv(args...);
 
   assignJacobian<math::LinearJacobian>(dJv, _node, dJvBodyNode);
@@ -1945,7 +2189,7 @@ math::AngularJacobian variadicGetAngularJacobianDeriv(
   if (!isValidBodyNode(_skel, _node, "getAngularJacobianDeriv"))
     return dJw;
 
-  const math::AngularJacobian dJwBodyNode
+  const math::AngularJacobian& dJwBodyNode
       = _node->getAngularJacobianDeriv(args...);
 
   assignJacobian<math::AngularJacobian>(dJw, _node, dJwBodyNode);
@@ -1969,6 +2213,8 @@ double Skeleton::getMass() const
 //==============================================================================
 const Eigen::MatrixXd& Skeleton::getMassMatrix(std::size_t _treeIdx) const
 {
+  flushPositionUpdates();
+
   if (mTreeCache[_treeIdx].mDirty.mMassMatrix)
     updateMassMatrix(_treeIdx);
   return mTreeCache[_treeIdx].mM;
@@ -1977,6 +2223,8 @@ const Eigen::MatrixXd& Skeleton::getMassMatrix(std::size_t _treeIdx) const
 //==============================================================================
 const Eigen::MatrixXd& Skeleton::getMassMatrix() const
 {
+  flushPositionUpdates();
+
   if (mSkelCache.mDirty.mMassMatrix)
     updateMassMatrix();
   return mSkelCache.mM;
@@ -1985,6 +2233,8 @@ const Eigen::MatrixXd& Skeleton::getMassMatrix() const
 //==============================================================================
 const Eigen::MatrixXd& Skeleton::getAugMassMatrix(std::size_t _treeIdx) const
 {
+  flushPositionUpdates();
+
   if (mTreeCache[_treeIdx].mDirty.mAugMassMatrix)
     updateAugMassMatrix(_treeIdx);
 
@@ -1994,6 +2244,8 @@ const Eigen::MatrixXd& Skeleton::getAugMassMatrix(std::size_t _treeIdx) const
 //==============================================================================
 const Eigen::MatrixXd& Skeleton::getAugMassMatrix() const
 {
+  flushPositionUpdates();
+
   if (mSkelCache.mDirty.mAugMassMatrix)
     updateAugMassMatrix();
 
@@ -2003,6 +2255,8 @@ const Eigen::MatrixXd& Skeleton::getAugMassMatrix() const
 //==============================================================================
 const Eigen::MatrixXd& Skeleton::getInvMassMatrix(std::size_t _treeIdx) const
 {
+  flushPositionUpdates();
+
   if (mTreeCache[_treeIdx].mDirty.mInvMassMatrix)
     updateInvMassMatrix(_treeIdx);
 
@@ -2012,6 +2266,8 @@ const Eigen::MatrixXd& Skeleton::getInvMassMatrix(std::size_t _treeIdx) const
 //==============================================================================
 const Eigen::MatrixXd& Skeleton::getInvMassMatrix() const
 {
+  flushPositionUpdates();
+
   if (mSkelCache.mDirty.mInvMassMatrix)
     updateInvMassMatrix();
 
@@ -2021,6 +2277,8 @@ const Eigen::MatrixXd& Skeleton::getInvMassMatrix() const
 //==============================================================================
 const Eigen::MatrixXd& Skeleton::getInvAugMassMatrix(std::size_t _treeIdx) const
 {
+  flushPositionUpdates();
+
   if (mTreeCache[_treeIdx].mDirty.mInvAugMassMatrix)
     updateInvAugMassMatrix(_treeIdx);
 
@@ -2030,6 +2288,8 @@ const Eigen::MatrixXd& Skeleton::getInvAugMassMatrix(std::size_t _treeIdx) const
 //==============================================================================
 const Eigen::MatrixXd& Skeleton::getInvAugMassMatrix() const
 {
+  flushPositionUpdates();
+
   if (mSkelCache.mDirty.mInvAugMassMatrix)
     updateInvAugMassMatrix();
 
@@ -2039,6 +2299,8 @@ const Eigen::MatrixXd& Skeleton::getInvAugMassMatrix() const
 //==============================================================================
 const Eigen::VectorXd& Skeleton::getCoriolisForces(std::size_t _treeIdx) const
 {
+  flushPositionUpdates();
+
   if (mTreeCache[_treeIdx].mDirty.mCoriolisForces)
     updateCoriolisForces(_treeIdx);
 
@@ -2048,6 +2310,8 @@ const Eigen::VectorXd& Skeleton::getCoriolisForces(std::size_t _treeIdx) const
 //==============================================================================
 const Eigen::VectorXd& Skeleton::getCoriolisForces() const
 {
+  flushPositionUpdates();
+
   if (mSkelCache.mDirty.mCoriolisForces)
     updateCoriolisForces();
 
@@ -2057,6 +2321,8 @@ const Eigen::VectorXd& Skeleton::getCoriolisForces() const
 //==============================================================================
 const Eigen::VectorXd& Skeleton::getGravityForces(std::size_t _treeIdx) const
 {
+  flushPositionUpdates();
+
   if (mTreeCache[_treeIdx].mDirty.mGravityForces)
     updateGravityForces(_treeIdx);
 
@@ -2066,6 +2332,8 @@ const Eigen::VectorXd& Skeleton::getGravityForces(std::size_t _treeIdx) const
 //==============================================================================
 const Eigen::VectorXd& Skeleton::getGravityForces() const
 {
+  flushPositionUpdates();
+
   if (mSkelCache.mDirty.mGravityForces)
     updateGravityForces();
 
@@ -2076,6 +2344,8 @@ const Eigen::VectorXd& Skeleton::getGravityForces() const
 const Eigen::VectorXd& Skeleton::getCoriolisAndGravityForces(
     std::size_t _treeIdx) const
 {
+  flushPositionUpdates();
+
   if (mTreeCache[_treeIdx].mDirty.mCoriolisAndGravityForces)
     updateCoriolisAndGravityForces(_treeIdx);
 
@@ -2085,6 +2355,8 @@ const Eigen::VectorXd& Skeleton::getCoriolisAndGravityForces(
 //==============================================================================
 const Eigen::VectorXd& Skeleton::getCoriolisAndGravityForces() const
 {
+  flushPositionUpdates();
+
   if (mSkelCache.mDirty.mCoriolisAndGravityForces)
     updateCoriolisAndGravityForces();
 
@@ -2094,6 +2366,8 @@ const Eigen::VectorXd& Skeleton::getCoriolisAndGravityForces() const
 //==============================================================================
 const Eigen::VectorXd& Skeleton::getExternalForces(std::size_t _treeIdx) const
 {
+  flushPositionUpdates();
+
   if (mTreeCache[_treeIdx].mDirty.mExternalForces)
     updateExternalForces(_treeIdx);
 
@@ -2103,6 +2377,8 @@ const Eigen::VectorXd& Skeleton::getExternalForces(std::size_t _treeIdx) const
 //==============================================================================
 const Eigen::VectorXd& Skeleton::getExternalForces() const
 {
+  flushPositionUpdates();
+
   if (mSkelCache.mDirty.mExternalForces)
     updateExternalForces();
 
@@ -2130,7 +2406,12 @@ const Eigen::VectorXd& Skeleton::getConstraintForces() const
 
 //==============================================================================
 Skeleton::Skeleton(const AspectPropertiesData& properties)
-  : mTotalMass(0.0), mIsImpulseApplied(false), mUnionSize(1)
+  : mTotalMass(0.0),
+    mIsImpulseApplied(false),
+    mIsSleeping(false),
+    mPositionUpdateBatchDepth(0u),
+    mHasDeferredPositionUpdates(false),
+    mUnionSize(1)
 {
   createAspect<Aspect>(properties);
   createAspect<detail::BodyNodeVectorProxyAspect>();
@@ -2288,6 +2569,7 @@ void Skeleton::registerJoint(Joint* _newJoint)
 
   addEntryToJointNameMgr(_newJoint);
   _newJoint->registerDofs();
+  dirtyFreeRigidBody();
 
   std::size_t tree = _newJoint->getChildBodyNode()->getTreeIndex();
   std::vector<DegreeOfFreedom*>& treeDofs = mTreeCache[tree].mDofs;
@@ -2461,7 +2743,11 @@ void Skeleton::unregisterJoint(Joint* _oldJoint)
     return;
   }
 
+  // Don't keep deferred updates of a Joint that leaves this Skeleton
+  flushPositionUpdates();
+
   mNameMgrForJoints.removeName(_oldJoint->getName());
+  dirtyFreeRigidBody();
 
   std::size_t tree = _oldJoint->getChildBodyNode()->getTreeIndex();
   std::vector<DegreeOfFreedom*>& treeDofs = mTreeCache[tree].mDofs;
@@ -3581,6 +3867,8 @@ static void computeSupportPolygon(
 //==============================================================================
 const math::SupportPolygon& Skeleton::getSupportPolygon() const
 {
+  flushPositionUpdates();
+
   math::SupportPolygon& polygon = mSkelCache.mSupportPolygon;
 
   if (!mSkelCache.mDirty.mSupport)
@@ -3605,6 +3893,8 @@ const math::SupportPolygon& Skeleton::getSupportPolygon() const
 const math::SupportPolygon& Skeleton::getSupportPolygon(
     std::size_t _treeIdx) const
 {
+  flushPositionUpdates();
+
   math::SupportPolygon& polygon = mTreeCache[_treeIdx].mSupportPolygon;
 
   if (!mTreeCache[_treeIdx].mDirty.mSupport)
@@ -3673,6 +3963,8 @@ const Eigen::Vector2d& Skeleton::getSupportCentroid(std::size_t _treeIdx) const
 //==============================================================================
 std::size_t Skeleton::getSupportVersion() const
 {
+  flushPositionUpdates();
+
   if (mSkelCache.mDirty.mSupport)
     return mSkelCache.mDirty.mSupportVersion + 1;
 
@@ -3682,6 +3974,8 @@ std::size_t Skeleton::getSupportVersion() const
 //==============================================================================
 std::size_t Skeleton::getSupportVersion(std::size_t _treeIdx) const
 {
+  flushPositionUpdates();
+
   if (mTreeCache[_treeIdx].mDirty.mSupport)
     return mTreeCache[_treeIdx].mDirty.mSupportVersion + 1;
 
@@ -3727,6 +4021,12 @@ void Skeleton::computeForwardKinematics(
 //==============================================================================
 void Skeleton::computeForwardDynamics()
 {
+  if (FreeJoint* joint = getFreeRigidBodyJoint())
+  {
+    computeFreeRigidBodyForwardDynamics(joint);
+    return;
+  }
+
   // Note: Articulated Inertias will be updated automatically when
   // getArtInertiaImplicit() is called in BodyNode::updateBiasForce()
 
@@ -3745,6 +4045,94 @@ void Skeleton::computeForwardDynamics()
   }
 }
 
+//==============================================================================
+bool Skeleton::isFreeRigidBody() const
+{
+  return getFreeRigidBodyJoint() != nullptr;
+}
+
+//==============================================================================
+FreeJoint* Skeleton::getFreeRigidBodyJoint() const
+{
+  if (mSkelCache.mDirty.mFreeRigidBody)
+  {
+    mSkelCache.mFreeRigidBodyJoint = detectFreeRigidBodyJoint();
+    mSkelCache.mDirty.mFreeRigidBody = false;
+  }
+
+  return mSkelCache.mFreeRigidBodyJoint;
+}
+
+//==============================================================================
+FreeJoint* Skeleton::detectFreeRigidBodyJoint() const
+{
+  if (mSkelCache.mBodyNodes.size() != 1u || !mSoftBodyNodes.empty())
+    return nullptr;
+
+  auto* joint
+      = dynamic_cast<FreeJoint*>(mSkelCache.mBodyNodes[0]->getParentJoint());
+  if (!joint)
+    return nullptr;
+
+  const Joint::ActuatorType actuatorType = joint->getActuatorType();
+  if (actuatorType != Joint::FORCE && actuatorType != Joint::PASSIVE)
+    return nullptr;
+
+  // Implicit damping and spring forces are added to the articulated inertia
+  const auto& properties = joint->FreeJoint::Base::mAspectProperties;
+  if (!properties.mDampingCoefficients.isZero()
+      || !properties.mSpringStiffnesses.isZero())
+    return nullptr;
+
+  return joint;
+}
+
+//==============================================================================
+void Skeleton::computeFreeRigidBodyForwardDynamics(FreeJoint* joint)
+{
+  // This is the articulated body algorithm for a single body, where the
+  // articulated inertia is the spatial inertia of the body and the relative
+  // Jacobian of the joint, S = Ad(T), is constant and invertible:
+  //
+  //   ddq = S^-1 * I^-1 * S^-T * (tau - S^T * bias)
+  BodyNode* bodyNode = mSkelCache.mBodyNodes[0];
+  const Eigen::Isometry3d& T = joint->getTransformFromChildBodyNode();
+  const Inertia& inertia = bodyNode->getInertia();
+  const Eigen::Matrix6d& I = inertia.getSpatialTensor();
+
+  // Gravity force
+  if (bodyNode->getGravityMode())
+    bodyNode->mFgravity.noalias()
+        = I
+          * math::AdInvRLinear(
+              bodyNode->getWorldTransform(), mAspectProperties.mGravity);
+  else
+    bodyNode->mFgravity.setZero();
+
+  // Bias force
+  const Eigen::Vector6d& V = bodyNode->getSpatialVelocity();
+  bodyNode->mBiasForce = -math::dad(V, I * V)
+                         - bodyNode->getExternalForceLocal()
+                         - bodyNode->mFgravity;
+
+  // Joint force
+  auto& state = joint->FreeJoint::Base::mAspectState;
+  if (joint->getActuatorType() == Joint::FORCE)
+    state.mForces = state.mCommands;
+  else
+    state.mForces.setZero();
+
+  joint->mTotalForce = state.mForces - math::dAdT(T, bodyNode->mBiasForce);
+
+  // Joint acceleration and transmitted force
+  const Eigen::Vector6d totalForce = math::dAdInvT(T, joint->mTotalForce);
+  joint->setAccelerationsStatic(math::AdInvT(
+      T, detail::applyInverseSpatialInertia(inertia, totalForce)));
+  bodyNode->mF = bodyNode->mBiasForce + totalForce;
+
+  assert(!math::isNan(bodyNode->mF));
+}
+
 //==============================================================================
 void Skeleton::computeInverseDynamics(
     bool _withExternalForces, bool _withDampingForces, bool _withSpringForces)
@@ -3798,6 +4186,12 @@ void Skeleton::dirtyArticulatedInertia(std::size_t _treeIdx)
   SET_FLAG(_treeIdx, mCoriolisAndGravityForces);
 }
 
+//==============================================================================
+void Skeleton::dirtyFreeRigidBody()
+{
+  mSkelCache.mDirty.mFreeRigidBody = true;
+}
+
 //==============================================================================
 void Skeleton::notifySupportUpdate(std::size_t _treeIdx)
 {
@@ -3983,10 +4377,30 @@ void Skeleton::updateBiasImpulse(
 //==============================================================================
 void Skeleton::updateVelocityChange()
 {
+  if (FreeJoint* joint = getFreeRigidBodyJoint())
+  {
+    updateFreeRigidBodyVelocityChange(joint);
+    return;
+  }
+
   for (auto& bodyNode : mSkelCache.mBodyNodes)
     bodyNode->updateVelocityChangeFD();
 }
 
+//==============================================================================
+void Skeleton::updateFreeRigidBodyVelocityChange(FreeJoint* joint)
+{
+  // dq = S^-1 * I^-1 * S^-T * impulse, see computeFreeRigidBodyForwardDynamics
+  BodyNode* bodyNode = mSkelCache.mBodyNodes[0];
+  const Eigen::Isometry3d& T = joint->getTransformFromChildBodyNode();
+
+  bodyNode->mDelV = detail::applyInverseSpatialInertia(
+      bodyNode->getInertia(), math::dAdInvT(T, joint->mTotalImpulse));
+  joint->mVelocityChanges = math::AdInvT(T, bodyNode->mDelV);
+
+  assert(!math::isNan(bodyNode->mDelV));
+}
+
 //==============================================================================
 void Skeleton::setImpulseApplied(bool _val)
 {
@@ -4006,6 +4420,21 @@ void Skeleton::computeImpulseForwardDynamics()
   if (!isMobile() || getNumDofs() == 0)
     return;
 
+  if (FreeJoint* joint = getFreeRigidBodyJoint())
+  {
+    BodyNode* bodyNode = mSkelCache.mBodyNodes[0];
+    const Eigen::Isometry3d& T = joint->getTransformFromChildBodyNode();
+
+    bodyNode->mBiasImpulse = -bodyNode->mConstraintImpulse;
+    joint->mTotalImpulse = joint->mConstraintImpulses
+                           - math::dAdT(T, bodyNode->mBiasImpulse);
+    updateFreeRigidBodyVelocityChange(joint);
+    bodyNode->mImpF
+        = bodyNode->mBiasImpulse + math::dAdInvT(T, joint->mTotalImpulse);
+    bodyNode->updateConstrainedTerms(mAspectProperties.mTimeStep);
+    return;
+  }
+
   // Note: we do not need to update articulated inertias here, because they will
   // be updated when BodyNode::updateBiasImpulse() calls
   // BodyNode::getArticulatedInertia()
@@ -4240,7 +4669,8 @@ Skeleton::DirtyFlags::DirtyFlags()
     mExternalForces(true),
     mDampingForces(true),
     mSupport(true),
-    mSupportVersion(0)
+    mSupportVersion(0),
+    mFreeRigidBody(true)
 {
   // Do nothing
 }
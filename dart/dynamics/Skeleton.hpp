@@ -50,6 +50,8 @@
 namespace dart {
 namespace dynamics {
 
+class FreeJoint;
+
 /// class Skeleton
 class Skeleton : public virtual common::VersionCounter,
                  public MetaSkeleton,
@@ -214,6 +216,35 @@ public:
 
   /// \}
 
+  //----------------------------------------------------------------------------
+  /// \{ \name Batched position updates
+  //----------------------------------------------------------------------------
+
+  /// Start deferring the update notifications that are caused by changing the
+  /// positions of the Joints of this Skeleton. Until the matching
+  /// endPositionUpdateBatch() is called, setting a position only marks its
+  /// Joint as changed. The BodyNodes, Jacobians, and dynamics caches that
+  /// depend on the changed Joints are dirtied when the outermost batch ends,
+  /// or before the first read of a kinematic or dynamic quantity of this
+  /// Skeleton or of a Frame attached to it, whichever comes first. Batches
+  /// can be nested. See also PositionUpdateBatch.
+  void beginPositionUpdateBatch() override;
+
+  /// End a batch that was started by beginPositionUpdateBatch(). When the
+  /// outermost batch ends, all the deferred notifications are propagated.
+  void endPositionUpdateBatch() override;
+
+  /// Returns true if a position update batch is currently open
+  bool isPositionUpdateBatchOpen() const;
+
+  /// Propagate the position changes that are deferred by the open position
+  /// update batches. This is called automatically before reading quantities
+  /// that depend on the positions, so it's rarely needed to be called
+  /// directly.
+  void flushPositionUpdates() const;
+
+  /// \}
+
   //----------------------------------------------------------------------------
   /// \{ \name State
   //----------------------------------------------------------------------------
@@ -302,6 +333,20 @@ public:
   /// \return True if this skeleton is mobile.
   bool isMobile() const;
 
+  /// Put this Skeleton to sleep or wake it up. A sleeping Skeleton is treated
+  /// like an immobile one: World::step() skips its dynamics and integration,
+  /// and it is neither checked for collisions against other sleeping
+  /// Skeletons nor moved by constraint impulses. Putting a Skeleton to sleep
+  /// sets its velocities and accelerations to zero. Changing the positions of
+  /// a sleeping Skeleton wakes it up.
+  ///
+  /// World::step() puts resting Skeletons to sleep and wakes them up when
+  /// sleeping is enabled for the World. See World::setSleepingEnabled().
+  void setSleeping(bool _isSleeping);
+
+  /// Return true if this Skeleton is sleeping
+  bool isSleeping() const;
+
   /// Set time step. This timestep is used for implicit joint damping
   /// force.
   void setTimeStep(double _timeStep);
@@ -646,6 +691,12 @@ public:
   /// Compute forward dynamics
   void computeForwardDynamics();
 
+  /// Returns true if this Skeleton is a single rigid BodyNode attached to the
+  /// world by a force or passive FreeJoint without damping or springs. The
+  /// forward dynamics and the impulse response of such a Skeleton are
+  /// computed in closed form, skipping the articulated inertia updates.
+  bool isFreeRigidBody() const;
+
   /// Computes inverse dynamics.
   ///
   /// The inverse dynamics is computed according to the following equations of
@@ -823,6 +874,96 @@ public:
 
   /// \}
 
+  //----------------------------------------------------------------------------
+  /// \{ \name In-place Jacobians
+  //----------------------------------------------------------------------------
+
+  // The following functions are equivalent to the Jacobian functions above,
+  // but write the result into a caller-provided matrix instead of returning a
+  // newly allocated one. The matrix is resized to 6 x getNumDofs() and is only
+  // reallocated when its size changes, so it can be reused across calls.
+
+  /// In-place version of getJacobian(const JacobianNode*)
+  void getJacobian(const JacobianNode* _node, math::Jacobian& _J) const;
+
+  /// In-place version of getJacobian(const JacobianNode*, const Frame*)
+  void getJacobian(
+      const JacobianNode* _node,
+      const Frame* _inCoordinatesOf,
+      math::Jacobian& _J) const;
+
+  /// In-place version of
+  /// getJacobian(const JacobianNode*, const Eigen::Vector3d&)
+  void getJacobian(
+      const JacobianNode* _node,
+      const Eigen::Vector3d& _localOffset,
+      math::Jacobian& _J) const;
+
+  /// In-place version of
+  /// getJacobian(const JacobianNode*, const Eigen::Vector3d&, const Frame*)
+  void getJacobian(
+      const JacobianNode* _node,
+      const Eigen::Vector3d& _localOffset,
+      const Frame* _inCoordinatesOf,
+      math::Jacobian& _J) const;
+
+  /// In-place version of getWorldJacobian(const JacobianNode*)
+  void getWorldJacobian(const JacobianNode* _node, math::Jacobian& _J) const;
+
+  /// In-place version of
+  /// getWorldJacobian(const JacobianNode*, const Eigen::Vector3d&)
+  void getWorldJacobian(
+      const JacobianNode* _node,
+      const Eigen::Vector3d& _localOffset,
+      math::Jacobian& _J) const;
+
+  /// In-place version of getJacobianSpatialDeriv(const JacobianNode*)
+  void getJacobianSpatialDeriv(
+      const JacobianNode* _node, math::Jacobian& _dJ) const;
+
+  /// In-place version of
+  /// getJacobianSpatialDeriv(const JacobianNode*, const Frame*)
+  void getJacobianSpatialDeriv(
+      const JacobianNode* _node,
+      const Frame* _inCoordinatesOf,
+      math::Jacobian& _dJ) const;
+
+  /// In-place version of
+  /// getJacobianSpatialDeriv(const JacobianNode*, const Eigen::Vector3d&)
+  void getJacobianSpatialDeriv(
+      const JacobianNode* _node,
+      const Eigen::Vector3d& _localOffset,
+      math::Jacobian& _dJ) const;
+
+  /// In-place version of getJacobianSpatialDeriv(const JacobianNode*,
+  /// const Eigen::Vector3d&, const Frame*)
+  void getJacobianSpatialDeriv(
+      const JacobianNode* _node,
+      const Eigen::Vector3d& _localOffset,
+      const Frame* _inCoordinatesOf,
+      math::Jacobian& _dJ) const;
+
+  /// In-place version of getJacobianClassicDeriv(const JacobianNode*)
+  void getJacobianClassicDeriv(
+      const JacobianNode* _node, math::Jacobian& _dJ) const;
+
+  /// In-place version of
+  /// getJacobianClassicDeriv(const JacobianNode*, const Frame*)
+  void getJacobianClassicDeriv(
+      const JacobianNode* _node,
+      const Frame* _inCoordinatesOf,
+      math::Jacobian& _dJ) const;
+
+  /// In-place version of getJacobianClassicDeriv(const JacobianNode*,
+  /// const Eigen::Vector3d&, const Frame*)
+  void getJacobianClassicDeriv(
+      const JacobianNode* _node,
+      const Eigen::Vector3d& _localOffset,
+      const Frame* _inCoordinatesOf,
+      math::Jacobian& _dJ) const;
+
+  /// \}
+
   //----------------------------------------------------------------------------
   /// \{ \name Equations of Motion
   //----------------------------------------------------------------------------
@@ -912,6 +1053,11 @@ public:
   /// Notify that the support polygon of a tree needs to be updated
   void dirtySupportPolygon(std::size_t _treeIdx);
 
+  /// Notify that isFreeRigidBody() needs to be evaluated again, e.g., because
+  /// the structure of this Skeleton or the properties of its root Joint
+  /// changed
+  void dirtyFreeRigidBody();
+
   // Documentation inherited
   double computeKineticEnergy() const override;
 
@@ -1032,6 +1178,11 @@ protected:
   /// Remove a Joint from the Skeleton. Internal use only.
   void unregisterJoint(Joint* _oldJoint);
 
+  /// Defer the propagation of the position change of \c joint until the
+  /// open position update batch ends or a quantity is read. See
+  /// beginPositionUpdateBatch().
+  void deferPositionUpdate(Joint* joint);
+
   /// Remove a Node from the Skeleton. Internal use only.
   void unregisterNode(NodeMap& nodeMap, Node* _oldNode, std::size_t& _index);
 
@@ -1103,6 +1254,21 @@ protected:
   /// Update the articulated inertias of the skeleton
   void updateArticulatedInertia() const;
 
+  /// Return the FreeJoint of this Skeleton if isFreeRigidBody() is true, and
+  /// nullptr otherwise. The result is cached until dirtyFreeRigidBody() is
+  /// called.
+  FreeJoint* getFreeRigidBodyJoint() const;
+
+  /// Return the FreeJoint of this Skeleton if it's a free rigid body, and
+  /// nullptr otherwise, without using the cache
+  FreeJoint* detectFreeRigidBodyJoint() const;
+
+  /// Closed-form version of computeForwardDynamics() for free rigid bodies
+  void computeFreeRigidBodyForwardDynamics(FreeJoint* joint);
+
+  /// Closed-form version of updateVelocityChange() for free rigid bodies
+  void updateFreeRigidBodyVelocityChange(FreeJoint* joint);
+
   /// Update the mass matrix of a tree
   void updateMassMatrix(std::size_t _treeIdx) const;
 
@@ -1232,6 +1398,9 @@ protected:
     /// Increments each time a new support polygon is computed to help keep
     /// track of changes in the support polygon
     std::size_t mSupportVersion;
+
+    /// Dirty flag for the FreeJoint of a free rigid body
+    bool mFreeRigidBody;
   };
 
   struct DataCache
@@ -1295,6 +1464,10 @@ protected:
     /// Centroid of the support polygon
     Eigen::Vector2d mSupportCentroid;
 
+    /// FreeJoint of the Skeleton if it's a free rigid body, and nullptr
+    /// otherwise. See Skeleton::isFreeRigidBody().
+    FreeJoint* mFreeRigidBodyJoint = nullptr;
+
     // To get byte-aligned Eigen vectors
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
   };
@@ -1315,6 +1488,21 @@ protected:
   /// Flag for status of impulse testing.
   bool mIsImpulseApplied;
 
+  /// Whether this Skeleton is sleeping. See setSleeping().
+  bool mIsSleeping;
+
+  /// Depth of the currently open position update batches
+  std::size_t mPositionUpdateBatchDepth;
+
+  /// Joints whose position changes have not been propagated yet because a
+  /// position update batch is open
+  mutable std::vector<Joint*> mPendingPositionUpdates;
+
+  /// Whether mPendingPositionUpdates is not empty. The Frames of this Skeleton
+  /// point at this flag to find out whether they need to flush the deferred
+  /// position updates before they are read.
+  mutable bool mHasDeferredPositionUpdates;
+
   mutable std::mutex mMutex;
 
 public:
@@ -936,24 +936,7 @@ void SoftBodyNode::aggregateAugMassMatrix(
   }
   assert(!math::isNan(mM_F));
 
-  std::size_t dof = mParentJoint->getNumDofs();
-  if (dof > 0)
-  {
-    Eigen::MatrixXd K = Eigen::MatrixXd::Zero(dof, dof);
-    Eigen::MatrixXd D = Eigen::MatrixXd::Zero(dof, dof);
-    for (std::size_t i = 0; i < dof; ++i)
-    {
-      K(i, i) = mParentJoint->getSpringStiffness(i);
-      D(i, i) = mParentJoint->getDampingCoefficient(i);
-    }
-    int iStart = mParentJoint->getIndexInTree(0);
-
-    // TODO(JS): Not recommended to use Joint::getAccelerations
-    _MCol.block(iStart, _col, dof, 1).noalias()
-        = mParentJoint->getRelativeJacobian().transpose() * mM_F
-          + D * (_timeStep * mParentJoint->getAccelerations())
-          + K * (_timeStep * _timeStep * mParentJoint->getAccelerations());
-  }
+  mParentJoint->getAugMassMatrixSegment(_MCol, _col, mM_F, _timeStep);
 }
 
 //==============================================================================
@@ -1137,14 +1120,7 @@ void SoftBodyNode::aggregateGravityForceVector(
     mG_F.tail<3>() += (*it)->mG_F;
   }
 
-  int nGenCoords = mParentJoint->getNumDofs();
-  if (nGenCoords > 0)
-  {
-    Eigen::VectorXd g
-        = -(mParentJoint->getRelativeJacobian().transpose() * mG_F);
-    int iStart = mParentJoint->getIndexInTree(0);
-    _g.segment(iStart, nGenCoords) = g;
-  }
+  mParentJoint->getSpatialToGeneralizedSegment(_g, -mG_F);
 }
 
 //==============================================================================
@@ -1228,14 +1204,7 @@ void SoftBodyNode::aggregateExternalForces(Eigen::VectorXd& _Fext)
     mFext_F.tail<3>() += (*it)->mFext;
   }
 
-  int nGenCoords = mParentJoint->getNumDofs();
-  if (nGenCoords > 0)
-  {
-    Eigen::VectorXd Fext
-        = mParentJoint->getRelativeJacobian().transpose() * mFext_F;
-    int iStart = mParentJoint->getIndexInTree(0);
-    _Fext.segment(iStart, nGenCoords) = Fext;
-  }
+  mParentJoint->getSpatialToGeneralizedSegment(_Fext, mFext_F);
 }
 
 //==============================================================================
@@ -398,6 +398,20 @@ double GenericJoint<ConfigSpaceT>::getCommand(size_t index) const
   return this->mAspectState.mCommands[index];
 }
 
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::setCommandUnclipped(
+    size_t index, double command)
+{
+  if (index >= getNumDofs())
+  {
+    GenericJoint_REPORT_OUT_OF_RANGE(setCommandUnclipped, index);
+    return;
+  }
+
+  this->mAspectState.mCommands[index] = command;
+}
+
 //==============================================================================
 template <class ConfigSpaceT>
 void GenericJoint<ConfigSpaceT>::setCommands(const Eigen::VectorXd& commands)
@@ -1442,6 +1456,9 @@ void GenericJoint<ConfigSpaceT>::setSpringStiffness(size_t index, double k)
   assert(k >= 0.0);
 
   GenericJoint_SET_IF_DIFFERENT(mSpringStiffnesses[index], k);
+
+  if (const SkeletonPtr& skel = Joint::getSkeleton())
+    skel->dirtyFreeRigidBody();
 }
 
 //==============================================================================
@@ -1496,6 +1513,9 @@ void GenericJoint<ConfigSpaceT>::setDampingCoefficient(size_t index, double d)
   assert(d >= 0.0);
 
   GenericJoint_SET_IF_DIFFERENT(mDampingCoefficients[index], d);
+
+  if (const SkeletonPtr& skel = Joint::getSkeleton())
+    skel->dirtyFreeRigidBody();
 }
 
 //==============================================================================
@@ -1676,6 +1696,51 @@ void GenericJoint<ConfigSpaceT>::updateRelativePrimaryAcceleration() const
       = this->getRelativeJacobianStatic() * this->getAccelerationsStatic();
 }
 
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::getRelativeJacobianSegment(
+    math::Jacobian& J, std::size_t col) const
+{
+  J.template middleCols<NumDofs>(col) = getRelativeJacobianStatic();
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::getRelativeJacobianSpatialDerivSegment(
+    math::Jacobian& dJ, std::size_t col, const Eigen::Vector6d& V) const
+{
+  // ad(V, S) + dS
+  const JacobianMatrix& S = getRelativeJacobianStatic();
+  auto dJLocal = dJ.template middleCols<NumDofs>(col);
+
+  dJLocal.template topRows<3>().noalias()
+      = -S.template topRows<3>().colwise().cross(V.head<3>());
+  dJLocal.template bottomRows<3>().noalias()
+      = -S.template bottomRows<3>().colwise().cross(V.head<3>())
+        - S.template topRows<3>().colwise().cross(V.tail<3>());
+  dJLocal += getRelativeJacobianTimeDerivStatic();
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::getRelativeJacobianClassicDerivSegment(
+    math::Jacobian& dJ,
+    std::size_t col,
+    const Eigen::Matrix3d& R,
+    const Eigen::Vector3d& w) const
+{
+  const JacobianMatrix& S = getRelativeJacobianStatic();
+  const JacobianMatrix& dS = getRelativeJacobianTimeDerivStatic();
+  auto dJLocal = dJ.template middleCols<NumDofs>(col);
+
+  dJLocal.template topRows<3>().noalias()
+      = R * dS.template topRows<3>()
+        - (R * S.template topRows<3>()).colwise().cross(w);
+  dJLocal.template bottomRows<3>().noalias()
+      = R * dS.template bottomRows<3>()
+        - (R * S.template bottomRows<3>()).colwise().cross(w);
+}
+
 //==============================================================================
 template <class ConfigSpaceT>
 void GenericJoint<ConfigSpaceT>::addVelocityTo(Eigen::Vector6d& vel)
@@ -2564,6 +2629,42 @@ Eigen::VectorXd GenericJoint<ConfigSpaceT>::getSpatialToGeneralized(
   return getRelativeJacobianStatic().transpose() * spatial;
 }
 
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::getSpatialToGeneralizedSegment(
+    Eigen::VectorXd& generalized, const Eigen::Vector6d& spatial)
+{
+  generalized.template segment<NumDofs>(mDofs[0]->mIndexInTree).noalias()
+      = getRelativeJacobianStatic().transpose() * spatial;
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::getMassMatrixSegment(
+    Eigen::MatrixXd& massMat, const size_t col, const Eigen::Vector6d& bodyForce)
+{
+  massMat.template block<NumDofs, 1>(mDofs[0]->mIndexInTree, col).noalias()
+      = getRelativeJacobianStatic().transpose() * bodyForce;
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+void GenericJoint<ConfigSpaceT>::getAugMassMatrixSegment(
+    Eigen::MatrixXd& augMassMat,
+    const size_t col,
+    const Eigen::Vector6d& bodyForce,
+    double timeStep)
+{
+  // J^T * F + (h * D + h^2 * K) * ddq where D and K are diagonal
+  const Vector implicitCoeffs
+      = timeStep * Base::mAspectProperties.mDampingCoefficients
+        + (timeStep * timeStep) * Base::mAspectProperties.mSpringStiffnesses;
+
+  augMassMat.template block<NumDofs, 1>(mDofs[0]->mIndexInTree, col).noalias()
+      = getRelativeJacobianStatic().transpose() * bodyForce
+        + implicitCoeffs.cwiseProduct(getAccelerationsStatic());
+}
+
 } // namespace dynamics
 } // namespace dart
 
@@ -104,6 +104,14 @@ struct DynamicsAspectProperties
   /// The first friction direction unit vector is expressed in this frame
   const Frame* mFirstFrictionDirectionFrame;
 
+  /// Stiffness of the compliant contact model. Contacts of this shape are
+  /// rigid when it is zero, which is the default.
+  double mContactStiffness;
+
+  /// Damping of the compliant contact model. Ignored when mContactStiffness
+  /// is zero.
+  double mContactDamping;
+
   /// Constructors
   /// The frictionCoeff argument will be used for both primary and secondary
   /// friction
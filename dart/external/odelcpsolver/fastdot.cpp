@@ -28,7 +28,7 @@ namespace dart {
 namespace external {
 namespace ode {
 
-dReal _dDot (const dReal *a, const dReal *b, int n)
+dReal _dDotReference (const dReal *a, const dReal *b, int n)
 {  
   dReal p0,q0,m0,p1,q1,m1,sum;
   sum = 0;
@@ -36,7 +36,7 @@ namespace ode {
  * this processes blocks of 4.
  */
 
-void _dSolveL1T (const dReal *L, dReal *B, int n, int lskip1)
+void _dSolveL1TReference (const dReal *L, dReal *B, int n, int lskip1)
 {  
   /* declare variables - Z matrix, p and q vectors, etc */
   dReal Z11,m11,Z21,m21,Z31,m31,Z41,m41,p1,q1,p2,p3,p4,*ex;
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Eigen implementations of the dot product, LDLT factorization and unit lower
+ * triangular solves that the Dantzig LCP solver spends most of its time in.
+ * Eigen vectorizes them with the SIMD instructions enabled for the build, so
+ * the same code uses SSE2, AVX, AVX-512 or NEON depending on the target.
+ *
+ * the setup cost of the Eigen triangular solves outweighs the gain for small
+ * matrices, so those are still handled by the unrolled scalar kernels.
+ */
+
+#include <Eigen/Core>
+
+#include "dart/external/odelcpsolver/matrix.h"
+
+namespace dart {
+namespace external {
+namespace ode {
+
+namespace {
+
+using ConstMatrixMap = Eigen::Map<
+    const Eigen::Matrix<dReal, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>,
+    Eigen::Unaligned,
+    Eigen::OuterStride<>>;
+using VectorMap = Eigen::Map<Eigen::Matrix<dReal, Eigen::Dynamic, 1>>;
+using ConstVectorMap
+    = Eigen::Map<const Eigen::Matrix<dReal, Eigen::Dynamic, 1>>;
+
+// smallest dimension handled by the Eigen triangular kernels
+const int minVectorizedSize = 64;
+
+} // namespace
+
+dReal _dDot (const dReal *a, const dReal *b, int n)
+{
+  if (n <= 0)
+    return 0;
+
+  return ConstVectorMap(a, n).dot(ConstVectorMap(b, n));
+}
+
+/* the rows are factorized in order. with z = L(i,0:i-1) * D(0:i-1), row i of
+ * A satisfies A(i,0:i-1)' = L(0:i-1,0:i-1) * z, so z is found by a forward
+ * substitution with the rows factorized so far.
+ */
+
+void _dFactorLDLT (dReal *A, dReal *d, int n, int nskip1)
+{
+  if (n < minVectorizedSize)
+  {
+    _dFactorLDLTReference (A, d, n, nskip1);
+    return;
+  }
+
+  for (int i = 0; i < n; ++i)
+  {
+    dReal *row = A + i * nskip1;
+    VectorMap z(row, i);
+
+    if (i > 0)
+    {
+      const ConstMatrixMap L(A, i, i, Eigen::OuterStride<>(nskip1));
+      L.triangularView<Eigen::UnitLower>().solveInPlace(z);
+    }
+
+    const ConstVectorMap dee(d, i);
+    const dReal sum = z.cwiseAbs2().dot(dee);
+    z.array() *= dee.array();
+    d[i] = dRecip(row[i] - sum);
+  }
+}
+
+void _dSolveL1 (const dReal *L, dReal *B, int n, int lskip1)
+{
+  if (n < minVectorizedSize)
+  {
+    _dSolveL1Reference (L, B, n, lskip1);
+    return;
+  }
+
+  VectorMap b(B, n);
+  const ConstMatrixMap ell(L, n, n, Eigen::OuterStride<>(lskip1));
+  ell.triangularView<Eigen::UnitLower>().solveInPlace(b);
+}
+
+void _dSolveL1T (const dReal *L, dReal *B, int n, int lskip1)
+{
+  if (n < minVectorizedSize)
+  {
+    _dSolveL1TReference (L, B, n, lskip1);
+    return;
+  }
+
+  VectorMap b(B, n);
+  const ConstMatrixMap ell(L, n, n, Eigen::OuterStride<>(lskip1));
+  ell.transpose().triangularView<Eigen::UnitUpper>().solveInPlace(b);
+}
+
+} // namespace ode
+} // namespace external
+} // namespace dart
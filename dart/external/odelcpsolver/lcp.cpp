@@ -108,6 +108,8 @@ rows/columns and manipulate C.
 
 */
 
+#include <algorithm>
+
 #include "dart/external/odelcpsolver/odeconfig.h"
 #include "dart/external/odelcpsolver/lcp.h"
 #include "dart/external/odelcpsolver/matrix.h"
@@ -781,8 +783,35 @@ void dLCP::unpermute()
 //***************************************************************************
 // an optimized Dantzig LCP driver routine for the lo-hi LCP problem.
 
+void dLCPWorkspace::reserve (int n)
+{
+  if (n <= capacity) return;
+
+  const int nskip = dPAD(n);
+  const size_t tmpbuf_size = dEstimateLDLTRemoveTmpbufSize(n, nskip);
+
+  L.reset (new dReal[n*nskip]);
+  d.reset (new dReal[n]);
+  w.reset (new dReal[n]);
+  delta_w.reset (new dReal[n]);
+  delta_x.reset (new dReal[n]);
+  Dell.reset (new dReal[n]);
+  ell.reset (new dReal[n]);
+  tmpbuf.reset (new dReal[(tmpbuf_size + sizeof(dReal) - 1) / sizeof(dReal)]);
+#ifdef ROWPTRS
+  Arows.reset (new dReal*[n]);
+#endif
+  p.reset (new int[n]);
+  C.reset (new int[n]);
+  state.reset (new bool[n]);
+
+  capacity = n;
+}
+
+
 bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
-                dReal *outer_w/*=nullptr*/, int nub, dReal *lo, dReal *hi, int *findex, bool earlyTermination)
+                dReal *outer_w/*=nullptr*/, int nub, dReal *lo, dReal *hi, int *findex, bool earlyTermination,
+                dLCPWorkspace *workspace/*=nullptr*/)
 {
   dAASSERT (n>0 && A && x && b && lo && hi && nub >= 0 && nub <= n);
 # ifndef dNODEBUG
@@ -792,11 +821,15 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
   }
 # endif
 
+  // use a temporary workspace if the caller doesn't keep one
+  dLCPWorkspace local_workspace;
+  if (!workspace) workspace = &local_workspace;
+  workspace->reserve (n);
 
   // if all the variables are unbounded then we can just factor, solve,
   // and return
   if (nub >= n) {
-    dReal *d = new dReal[n];
+    dReal *d = workspace->d.get();
     dSetZero (d, n);
 
     int nskip = dPAD(n);
@@ -804,28 +837,28 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
     dSolveLDLT (A, d, b, n, nskip);
     memcpy (x, b, n*sizeof(dReal));
 
-    delete[] d;
     return true;
   }
 
   const int nskip = dPAD(n);
-  dReal *L = new dReal[ (n*nskip)];
-  dReal *d = new dReal[ (n)];
-  dReal *w = outer_w ? outer_w : (new dReal[n]);
-  dReal *delta_w = new dReal[ (n)];
-  dReal *delta_x = new dReal[ (n)];
-  dReal *Dell = new dReal[ (n)];
-  dReal *ell = new dReal[ (n)];
+  dReal *L = workspace->L.get();
+  dReal *d = workspace->d.get();
+  dReal *w = outer_w ? outer_w : workspace->w.get();
+  dReal *delta_w = workspace->delta_w.get();
+  dReal *delta_x = workspace->delta_x.get();
+  dReal *Dell = workspace->Dell.get();
+  dReal *ell = workspace->ell.get();
+  void *tmpbuf = workspace->tmpbuf.get();
 #ifdef ROWPTRS
-  dReal **Arows = new dReal* [n];
+  dReal **Arows = workspace->Arows.get();
 #else
   dReal **Arows = nullptr;
 #endif
-  int *p = new int[n];
-  int *C = new int[n];
+  int *p = workspace->p.get();
+  int *C = workspace->C.get();
 
   // for i in N, state[i] is 0 if x(i)==lo(i) or 1 if x(i)==hi(i)
-  bool *state = new bool[n];
+  bool *state = workspace->state.get();
 
   // create LCP object. note that tmp is set to delta_w to save space, this
   // optimization relies on knowledge of how tmp is used, so be careful!
@@ -1011,22 +1044,6 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
         if (s <= REAL(0.0)) {
 
           if (earlyTermination) {
-            if (!outer_w)
-              delete[] w;
-            delete[] L;
-            delete[] d;
-            delete[] delta_w;
-            delete[] delta_x;
-            delete[] Dell;
-            delete[] ell;
-          #ifdef ROWPTRS
-            delete[] Arows;
-          #endif
-            delete[] p;
-            delete[] C;
-
-            delete[] state;
-
             return false;
           }
 
@@ -1078,12 +1095,12 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
         case 5:		// keep going
           x[si] = lo[si];
           state[si] = false;
-          lcp.transfer_i_from_C_to_N (si, nullptr);
+          lcp.transfer_i_from_C_to_N (si, tmpbuf);
           break;
         case 6:		// keep going
           x[si] = hi[si];
           state[si] = true;
-          lcp.transfer_i_from_C_to_N (si, nullptr);
+          lcp.transfer_i_from_C_to_N (si, tmpbuf);
           break;
         }
 
@@ -1098,21 +1115,97 @@ bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b,
 
   lcp.unpermute();
 
-  if (!outer_w)
-	  delete[] w;
-  delete[] L;
-  delete[] d;
-  delete[] delta_w;
-  delete[] delta_x;
-  delete[] Dell;
-  delete[] ell;
-#ifdef ROWPTRS
-  delete[] Arows;
-#endif
-  delete[] p;
-  delete[] C;
+  return true;
+}
+
+bool dSolveLCPFromGuess (int n, const dReal *A, dReal *x, const dReal *b,
+                         const dReal *lo, const dReal *hi, const int *findex,
+                         dLCPWorkspace *workspace/*=nullptr*/)
+{
+  dAASSERT (n>0 && A && x && b && lo && hi);
+
+  dLCPWorkspace local_workspace;
+  if (!workspace) workspace = &local_workspace;
+  workspace->reserve (n);
 
-  delete[] state;
+  enum { IN_C, AT_LO, AT_HI, ZERO };
+
+  const int nskip = dPAD(n);
+  dReal *L = workspace->L.get();
+  dReal *d = workspace->d.get();
+  dReal *xC = workspace->Dell.get();
+  int *set = workspace->p.get();
+  int *C = workspace->C.get();
+
+  // sort the indexes into the sets guessed by x. the friction bounds depend on
+  // the initial normals, so all the sets are decided before x is changed.
+  int nC = 0;
+  for (int i=0; i<n; ++i) {
+    if (findex && findex[i] >= 0) {
+      const dReal bound = dFabs (hi[i] * x[findex[i]]);
+      if (x[findex[i]] == 0 || bound == 0) set[i] = ZERO;
+      else if (dFabs (x[i]) < bound) set[i] = IN_C;
+      else return false;
+    }
+    else if (x[i] <= lo[i] && lo[i] > -dInfinity) set[i] = AT_LO;
+    else if (x[i] >= hi[i] && hi[i] < dInfinity) set[i] = AT_HI;
+    else set[i] = IN_C;
+    if (set[i] == IN_C) C[nC++] = i;
+  }
+
+  dReal bmax = 0;
+  for (int i=0; i<n; ++i) {
+    bmax = std::max (bmax, dFabs (b[i]));
+    switch (set[i]) {
+    case IN_C: x[i] = 0; break;
+    case AT_LO: x[i] = lo[i]; break;
+    case AT_HI: x[i] = hi[i]; break;
+    default: x[i] = 0; break;
+    }
+  }
+
+  // solve A(C,C)*x(C) = b(C) - A(C,N)*x(N)
+  if (nC > 0) {
+    for (int r=0; r<nC; ++r) {
+      const dReal *Arow = A + C[r]*nskip;
+      dReal *Lrow = L + r*nskip;
+      for (int c=0; c<=r; ++c) Lrow[c] = Arow[C[c]];
+      xC[r] = b[C[r]] - dDot (Arow, x, n);
+    }
+    dFactorLDLT (L, d, nC, nskip);
+    for (int r=0; r<nC; ++r) {
+      // d holds the reciprocals of the pivots, which must be positive
+      if (!(d[r] > 0) || d[r] == dInfinity) return false;
+    }
+    dSolveLDLT (L, d, xC, nC, nskip);
+    for (int r=0; r<nC; ++r) x[C[r]] = xC[r];
+  }
+
+  // check the LCP conditions up to a tolerance relative to the problem size
+  dReal xmax = 0;
+  for (int i=0; i<n; ++i) xmax = std::max (xmax, dFabs (x[i]));
+  const dReal xtol = REAL(1e-9) * (1 + xmax);
+  const dReal wtol = REAL(1e-9) * (1 + bmax);
+
+  for (int i=0; i<n; ++i) {
+    if (set[i] == IN_C) {
+      dReal l = lo[i], h = hi[i];
+      if (findex && findex[i] >= 0) {
+        h = dFabs (hi[i] * x[findex[i]]);
+        l = -h;
+      }
+      if (x[i] < l - xtol || x[i] > h + xtol) return false;
+      x[i] = std::max (l, std::min (h, x[i]));
+    }
+    else if (set[i] == ZERO) {
+      // the friction bounds must still be zero for the solved normal
+      if (dFabs (hi[i] * x[findex[i]]) > xtol) return false;
+    }
+    else {
+      const dReal w = dDot (A + i*nskip, x, n) - b[i];
+      if (set[i] == AT_LO ? w < -wtol : w > wtol) return false;
+    }
+  }
 
   return true;
 }
@@ -53,6 +53,7 @@ to be implemented. the first `nub' variables are assumed to have findex < 0.
 #include <stdlib.h>
 #include <stdio.h>
 #include <cassert>
+#include <memory>
 
 #include "dart/external/odelcpsolver/odeconfig.h"
 #include "dart/external/odelcpsolver/common.h"
@@ -61,8 +62,49 @@ namespace dart {
 namespace external {
 namespace ode {
 
+/*
+
+scratch memory of dSolveLCP. the buffers only grow, so a workspace that is
+reused across calls stops allocating once it has seen the largest problem.
+a workspace must not be shared by concurrent calls.
+
+*/
+
+struct dLCPWorkspace {
+  // make sure that the buffers can hold a problem of dimension n
+  void reserve (int n);
+
+  int capacity = 0;
+  std::unique_ptr<dReal[]> L, d, w, delta_w, delta_x, Dell, ell, tmpbuf;
+  std::unique_ptr<dReal*[]> Arows;
+  std::unique_ptr<int[]> p, C;
+  std::unique_ptr<bool[]> state;
+};
+
+// if `workspace' is null, the scratch memory is allocated for this call only.
 bool dSolveLCP (int n, dReal *A, dReal *x, dReal *b, dReal *w,
-  int nub, dReal *lo, dReal *hi, int *findex, bool earlyTermination = false);
+  int nub, dReal *lo, dReal *hi, int *findex, bool earlyTermination = false,
+  dLCPWorkspace *workspace = nullptr);
+
+/*
+
+solve the lo-hi LCP from a guess of its index sets instead of pivoting. the
+guess is read from the initial x: x(i) in the open interval (lo(i),hi(i)) puts
+i into the clamped set C and x(i) at a bound puts i into the set N at that
+bound. the friction bounds of the guess are computed from the initial x of
+the corresponding normals. x(C) is then computed with a single factorization
+of A(C,C), and the result is accepted only if it satisfies the LCP conditions.
+
+returns false if the guess doesn't give a solution, in which case x is left in
+an undefined state and dSolveLCP() should be called instead. guesses that put
+a friction variable with a nonzero normal at its bound (i.e. sliding) are not
+supported and are always rejected. A, b, lo and hi are not modified.
+
+*/
+
+bool dSolveLCPFromGuess (int n, const dReal *A, dReal *x, const dReal *b,
+  const dReal *lo, const dReal *hi, const int *findex,
+  dLCPWorkspace *workspace = nullptr);
 
 size_t dEstimateSolveLCPMemoryReq(int n, bool outer_w_avail);
 
@@ -206,6 +206,16 @@ void _dLDLTAddTL (dReal *L, dReal *d, const dReal *a, int n, int nskip, void *tm
 void _dLDLTRemove (dReal **A, const int *p, dReal *L, dReal *d, int n1, int n2, int r, int nskip, void *tmpbuf);
 void _dRemoveRowCol (dReal *A, int n, int nskip, int r);
 
+/* dDot and, for large matrices, the LDLT factorization and triangular solves
+ * above are vectorized with Eigen, which uses the SIMD instructions that the
+ * library is compiled for. the original scalar implementations are kept as
+ * references to test them against.
+ */
+dReal _dDotReference (const dReal *a, const dReal *b, int n);
+void _dFactorLDLTReference (dReal *A, dReal *d, int n, int nskip);
+void _dSolveL1Reference (const dReal *L, dReal *b, int n, int nskip);
+void _dSolveL1TReference (const dReal *L, dReal *b, int n, int nskip);
+
 PURE_INLINE size_t _dEstimateFactorCholeskyTmpbufSize(int n)
 {
   return dPAD(n) * sizeof(dReal);
@@ -32,9 +32,10 @@
 
 #include "dart/lcpsolver/Lemke.hpp"
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
-#include <iostream>
-#include <vector>
+#include <limits>
 
 #include "dart/math/Helpers.hpp"
 
@@ -58,120 +59,219 @@ namespace lcpsolver {
 // }
 
 //==============================================================================
-int Lemke(
-    const Eigen::MatrixXd& _M, const Eigen::VectorXd& _q, Eigen::VectorXd* _z)
+/// Memory of LemkeSolver. With a fixed MaxSize, the matrices are stored inline
+/// and the problems must have at most MaxSize variables.
+template <int MaxSize>
+struct LemkeSolver::Workspace
 {
-  int n = _q.size();
+  using Matrix = Eigen::
+      Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, MaxSize, MaxSize>;
+  using Vector = Eigen::Matrix<double, Eigen::Dynamic, 1, 0, MaxSize, 1>;
+  using IndexVector = Eigen::Matrix<int, Eigen::Dynamic, 1, 0, MaxSize, 1>;
 
-  const double zer_tol = 1e-5;
-  const double piv_tol = 1e-8;
-  int maxiter = 1000;
-  int err = 0;
+  /// Grows the memory to hold problems of n variables
+  void reserve(int n);
+
+  /// Computes the LU factorization of the basis and clears the eta updates.
+  /// Returns false if the basis is singular.
+  bool factorize(int n);
+
+  /// Overwrites v with the solution of B*v = v
+  void solveBasis(int n, Vector& v);
+
+  /// Replaces column r of the basis by mBe, where mD = B^-1 * mBe. Returns
+  /// false if the basis is singular.
+  bool replaceColumn(int n, int r);
+
+  /// Solves the LCP. See LemkeSolver::solve().
+  int solve(
+      const Eigen::Ref<const Eigen::MatrixXd>& M,
+      const Eigen::Ref<const Eigen::VectorXd>& q,
+      Eigen::Ref<Eigen::VectorXd> z,
+      int maxIterations);
+
+  /// Columns of the basis
+  Matrix mB;
+
+  /// LU factorization of the basis when it was last factorized
+  Matrix mLU;
+
+  /// Eta updates of the basis since it was last factorized, one per column
+  Matrix mEtas;
+
+  /// Values of the basic variables
+  Vector mX;
+
+  /// Direction of the pivot
+  Vector mD;
+
+  /// Column of the entering variable
+  Vector mBe;
+
+  /// Row transpositions of the LU factorization
+  IndexVector mPerm;
+
+  /// Basic variables. Index i < n is z[i], n <= i < 2n is w[i - n], and 2n is
+  /// the artificial variable.
+  IndexVector mBasis;
+
+  /// Replaced columns of the eta updates
+  IndexVector mEtaRows;
 
-  if (_q.minCoeff() >= 0)
+  /// Number of eta updates
+  int mNumEtas = 0;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+//==============================================================================
+template <int MaxSize>
+void LemkeSolver::Workspace<MaxSize>::reserve(int n)
+{
+  if (mB.rows() >= n)
+    return;
+
+  mB.resize(n, n);
+  mLU.resize(n, n);
+  mEtas.resize(n, n);
+  mX.resize(n);
+  mD.resize(n);
+  mBe.resize(n);
+  mPerm.resize(n);
+  mBasis.resize(n);
+  mEtaRows.resize(n);
+}
+
+//==============================================================================
+template <int MaxSize>
+bool LemkeSolver::Workspace<MaxSize>::factorize(int n)
+{
+  // LU factorization with partial pivoting, in place so that only the first n
+  // rows and columns of the memory are used
+  auto LU = mLU.topLeftCorner(n, n);
+  LU = mB.topLeftCorner(n, n);
+  for (int k = 0; k < n; ++k)
   {
-    // LOG(INFO) << "Trivial solution exists.";
-    *_z = Eigen::VectorXd::Zero(n);
-    return err;
+    int p;
+    if (LU.col(k).tail(n - k).cwiseAbs().maxCoeff(&p) == 0.0)
+      return false;
+
+    p += k;
+    mPerm[k] = p;
+    if (p != k)
+      LU.row(k).swap(LU.row(p));
+
+    const int r = n - k - 1;
+    LU.col(k).tail(r) /= LU(k, k);
+    LU.bottomRightCorner(r, r).noalias()
+        -= LU.col(k).tail(r) * LU.row(k).tail(r);
   }
 
-  // solve trivial case for n=1
-  //   if (n==1){
-  //     if (_M(0)>0){
-  //         *_z = (- _q(0)/_M(0) )*Eigen::VectorXd::Ones(n);
-  //         return err;
-  //     } else {
-  //         *_z = Eigen::VectorXd::Zero(n);
-  //         err = 4; // no solution
-  //         return err;
-  //     }
-  //   }
-
-  *_z = Eigen::VectorXd::Zero(2 * n);
-  int iter = 0;
-  // double theta = 0;
-  double ratio = 0;
-  int leaving = 0;
-  Eigen::VectorXd Be = Eigen::VectorXd::Constant(n, 1);
-  Eigen::VectorXd x = _q;
-  std::vector<int> bas;
-  std::vector<int> nonbas;
-
-  int t = 2 * n;
-  int entering = t;
+  mNumEtas = 0;
 
-  bas.clear();
-  nonbas.clear();
+  return true;
+}
 
-  // TODO: here suppose initial guess z0 is [0,0,0,...], this contradicts to
-  // ODE's w always initilized as 0
-  for (int i = 0; i < n; ++i)
+//==============================================================================
+template <int MaxSize>
+void LemkeSolver::Workspace<MaxSize>::solveBasis(int n, Vector& v)
+{
+  auto x = v.head(n);
+  for (int k = 0; k < n; ++k)
   {
-    nonbas.push_back(i);
+    if (mPerm[k] != k)
+      std::swap(x[k], x[mPerm[k]]);
   }
 
-  Eigen::MatrixXd B = -Eigen::MatrixXd::Identity(n, n);
+  const auto LU = mLU.topLeftCorner(n, n);
+  LU.template triangularView<Eigen::UnitLower>().solveInPlace(x);
+  LU.template triangularView<Eigen::Upper>().solveInPlace(x);
 
-  if (!bas.empty())
+  // Each eta update replaced column r of the basis B by B*eta, so its inverse
+  // is applied by eliminating row r
+  for (int e = 0; e < mNumEtas; ++e)
   {
-    Eigen::MatrixXd B_copy = B;
-    for (std::size_t i = 0; i < bas.size(); ++i)
-    {
-      B.col(i) = _M.col(bas[i]);
-    }
-    for (std::size_t i = 0; i < nonbas.size(); ++i)
-    {
-      B.col(bas.size() + i) = B_copy.col(nonbas[i]);
-    }
-    // TODO: check the condition number to return err = 3
-    Eigen::JacobiSVD<Eigen::MatrixXd> svd(B);
-    double cond = svd.singularValues()(0)
-                  / svd.singularValues()(svd.singularValues().size() - 1);
-    if (cond > 1e16)
-    {
-      (*_z) = Eigen::VectorXd::Zero(n);
-      err = 3;
-      return err;
-    }
-    x = -B.householderQr().solve(_q);
+    const int r = mEtaRows[e];
+    const double xr = x[r] / mEtas(r, e);
+    x.noalias() -= xr * mEtas.col(e).head(n);
+    x[r] = xr;
   }
+}
+
+//==============================================================================
+template <int MaxSize>
+bool LemkeSolver::Workspace<MaxSize>::replaceColumn(int n, int r)
+{
+  mB.col(r).head(n) = mBe.head(n);
+
+  // Factorize again once the eta updates cost as much as the factorization
+  if (mNumEtas == n)
+    return factorize(n);
+
+  mEtas.col(mNumEtas).head(n) = mD.head(n);
+  mEtaRows[mNumEtas] = r;
+  ++mNumEtas;
+
+  return true;
+}
+
+//==============================================================================
+template <int MaxSize>
+int LemkeSolver::Workspace<MaxSize>::solve(
+    const Eigen::Ref<const Eigen::MatrixXd>& M,
+    const Eigen::Ref<const Eigen::VectorXd>& q,
+    Eigen::Ref<Eigen::VectorXd> z,
+    int maxIterations)
+{
+  const int n = static_cast<int>(q.size());
+
+  const double zer_tol = 1e-5;
+  const double piv_tol = 1e-8;
+  int err = 0;
 
-  // Check if initial basis provides solution
-  if (x.minCoeff() >= 0)
+  if (q.minCoeff() >= 0)
   {
-    Eigen::VectorXd __z = Eigen::VectorXd::Zero(2 * n);
-    for (std::size_t i = 0; i < bas.size(); ++i)
-    {
-      (__z).row(bas[i]) = x.row(i);
-    }
-    (*_z) = __z.head(n);
+    // LOG(INFO) << "Trivial solution exists.";
+    z.setZero();
     return err;
   }
 
+  reserve(n);
+  auto x = mX.head(n);
+  auto d = mD.head(n);
+  auto Be = mBe.head(n);
+  auto bas = mBasis.head(n);
+
+  // The initial basis is -I, where all the w variables are basic
+  x = q;
+  mB.topLeftCorner(n, n) = -Eigen::MatrixXd::Identity(n, n);
+  for (int i = 0; i < n; ++i)
+    bas[i] = n + i;
+
+  const int t = 2 * n;
+  int entering = t;
+
   // Determine initial leaving variable
-  Eigen::VectorXd minuxX = -x;
   int lvindex;
-  double tval = minuxX.maxCoeff(&lvindex);
-  for (std::size_t i = 0; i < nonbas.size(); ++i)
-  {
-    bas.push_back(nonbas[i] + n);
-  }
-  leaving = bas[lvindex];
-
+  const double tval = (-x).maxCoeff(&lvindex);
+  int leaving = bas[lvindex];
   bas[lvindex] = t; // pivoting in the artificial variable
 
-  Eigen::VectorXd U = Eigen::VectorXd::Zero(n);
+  // The column of the artificial variable is -B*U = U, where U[i] = 1 for the
+  // negative x[i]
   for (int i = 0; i < n; ++i)
+    Be[i] = (x[i] < 0) ? 1.0 : 0.0;
+  x += tval * Be;
+  x[lvindex] = tval;
+  mB.col(lvindex).head(n) = Be;
+  if (!factorize(n))
   {
-    if (x[i] < 0)
-      U[i] = 1;
+    z.setZero();
+    return 4;
   }
-  Be = -(B * U);
-  x += tval * U;
-  x[lvindex] = tval;
-  B.col(lvindex) = Be;
 
-  for (iter = 0; iter < maxiter; ++iter)
+  int iter;
+  for (iter = 0; iter < maxIterations; ++iter)
   {
     if (leaving == t)
     {
@@ -180,146 +280,104 @@ int Lemke(
     else if (leaving < n)
     {
       entering = n + leaving;
-      Be = Eigen::VectorXd::Zero(n);
+      Be.setZero();
       Be[leaving] = -1;
     }
     else
     {
       entering = leaving - n;
-      Be = _M.col(entering);
+      Be = M.col(entering);
     }
 
-    Eigen::VectorXd d = B.householderQr().solve(Be);
+    d = Be;
+    solveBasis(n, mD);
 
     // Find new leaving variable
-    std::vector<int> j;
+    double theta = std::numeric_limits<double>::infinity();
+    bool hasPivot = false;
     for (int i = 0; i < n; ++i)
     {
       if (d[i] > piv_tol)
-        j.push_back(i);
-    }
-    if (j.empty()) // no new pivots - ray termination
-    {
-      err = 2;
-      break;
-    }
-
-    std::size_t jSize = j.size();
-    Eigen::VectorXd minRatio(jSize);
-    for (std::size_t i = 0; i < jSize; ++i)
-    {
-      minRatio[i] = (x[j[i]] + zer_tol) / d[j[i]];
-    }
-    double theta = minRatio.minCoeff();
-
-    std::vector<int> tmpJ;
-    std::vector<double> tmpd;
-    for (std::size_t i = 0; i < jSize; ++i)
-    {
-      if (x[j[i]] / d[j[i]] <= theta)
       {
-        tmpJ.push_back(j[i]);
-        tmpd.push_back(d[j[i]]);
+        theta = std::min(theta, (x[i] + zer_tol) / d[i]);
+        hasPivot = true;
       }
     }
-
-    //    if (tmpJ.empty())
-    //    {
-    //      LOG(WARNING) << "tmpJ should never be empty!!!";
-    //      LOG(WARNING) << "dumping data:";
-    //      LOG(WARNING) << "theta:" << theta;
-    //      for (int i = 0; i < jSize; ++i)
-    //      {
-    //        LOG(WARNING) << "x(" << j[i] << "): " << x[j[i]] << "d: " <<
-    //        d[j[i]];
-    //      }
-    //    }
-
-    j = tmpJ;
-    jSize = j.size();
-    if (jSize == 0)
+    if (!hasPivot) // no new pivots - ray termination
     {
-      err = 4;
+      err = 2;
       break;
     }
-    lvindex = -1;
 
-    // Check if artificial among these
-    for (std::size_t i = 0; i < jSize; ++i)
+    // Among the candidates of the ratio test, always use the artificial
+    // variable if possible, and otherwise the first of the largest pivots
+    lvindex = -1;
+    int largestPivotIndex = -1;
+    for (int i = 0; i < n; ++i)
     {
-      if (bas[j[i]] == t)
+      if (d[i] <= piv_tol || x[i] / d[i] > theta)
+        continue;
+
+      if (bas[i] == t)
         lvindex = i;
-    }
 
-    if (lvindex != -1)
-    {
-      lvindex = j[lvindex]; // Always use artificial if possible
+      if (largestPivotIndex == -1 || d[i] - d[largestPivotIndex] > piv_tol)
+        largestPivotIndex = i;
     }
-    else
+    if (largestPivotIndex == -1)
     {
-      theta = tmpd[0];
-      lvindex = 0;
-      for (std::size_t i = 0; i < jSize; ++i)
-      {
-        if (tmpd[i] - theta > piv_tol)
-        { // Bubble sorting
-          theta = tmpd[i];
-          lvindex = i;
-        }
-      }
-      lvindex = j[lvindex]; // choose the first if there are multiple
+      err = 4;
+      break;
     }
+    if (lvindex == -1)
+      lvindex = largestPivotIndex;
 
     leaving = bas[lvindex];
 
-    ratio = x[lvindex] / d[lvindex];
-
-    //    bool bDiverged = false;
-    //    for (int i = 0; i < n; ++i) {
-    //      if (isnan(x[i]) || isinf(x[i])) {
-    //        bDiverged = true;
-    //        break;
-    //      }
-    //    }
-    //    if (bDiverged) {
-    //      err = 4;
-    //      break;
-    //    }
+    const double ratio = x[lvindex] / d[lvindex];
 
     // Perform pivot
-    x = x - ratio * d;
+    x -= ratio * d;
     x[lvindex] = ratio;
-    B.col(lvindex) = Be;
     bas[lvindex] = entering;
+    if (!replaceColumn(n, lvindex))
+    {
+      err = 4;
+      break;
+    }
   }
 
-  if (iter >= maxiter && leaving != t)
+  if (iter >= maxIterations && leaving != t)
   {
     err = 1;
   }
 
   if (err == 0)
   {
-    for (std::size_t i = 0; i < bas.size(); ++i)
+    z.setZero();
+    for (int i = 0; i < n; ++i)
     {
-      if (bas[i] < _z->size())
-      {
-        (*_z)[bas[i]] = x[i];
-      }
+      if (bas[i] < n)
+        z[bas[i]] = x[i];
     }
 
-    Eigen::VectorXd __z = _z->head(n);
-    *_z = __z;
-
-    if (!validate(_M, *_z, _q))
+    // Same as validate(), without allocating w
+    const double threshold = 1e-4;
+    d.noalias() = M * z;
+    d += q;
+    for (int i = 0; i < n; ++i)
     {
-      // _z = VectorXd::Zero(n);
-      err = 3;
+      if (d[i] < -threshold || z[i] < -threshold
+          || std::abs(d[i] * z[i]) > threshold)
+      {
+        err = 3;
+        break;
+      }
     }
   }
   else
   {
-    *_z = Eigen::VectorXd::Zero(n); // solve failed, return a 0 vector
+    z.setZero(); // solve failed, return a 0 vector
   }
 
   //  if (err == 1)
@@ -335,6 +393,72 @@ int Lemke(
   return err;
 }
 
+//==============================================================================
+LemkeSolver::LemkeSolver() : mMaxIterations(1000)
+{
+  // Do nothing
+}
+
+//==============================================================================
+LemkeSolver::~LemkeSolver() = default;
+
+//==============================================================================
+int LemkeSolver::solve(
+    const Eigen::Ref<const Eigen::MatrixXd>& M,
+    const Eigen::Ref<const Eigen::VectorXd>& q,
+    Eigen::Ref<Eigen::VectorXd> z)
+{
+  assert(M.rows() == q.size() && M.cols() == q.size());
+  assert(z.size() == q.size());
+
+  const int n = static_cast<int>(q.size());
+  reserve(n);
+
+  if (n <= MaxFixedSize)
+    return mFixedWorkspace->solve(M, q, z, mMaxIterations);
+  else
+    return mDynamicWorkspace->solve(M, q, z, mMaxIterations);
+}
+
+//==============================================================================
+void LemkeSolver::reserve(int n)
+{
+  if (!mFixedWorkspace)
+  {
+    mFixedWorkspace = std::make_unique<Workspace<MaxFixedSize>>();
+    mFixedWorkspace->reserve(MaxFixedSize);
+  }
+
+  if (n <= MaxFixedSize)
+    return;
+
+  if (!mDynamicWorkspace)
+    mDynamicWorkspace = std::make_unique<Workspace<Eigen::Dynamic>>();
+  mDynamicWorkspace->reserve(n);
+}
+
+//==============================================================================
+void LemkeSolver::setMaxIterations(int maxIterations)
+{
+  mMaxIterations = maxIterations;
+}
+
+//==============================================================================
+int LemkeSolver::getMaxIterations() const
+{
+  return mMaxIterations;
+}
+
+//==============================================================================
+int Lemke(
+    const Eigen::MatrixXd& _M, const Eigen::VectorXd& _q, Eigen::VectorXd* _z)
+{
+  _z->resize(_q.size());
+
+  LemkeSolver solver;
+  return solver.solve(_M, _q, *_z);
+}
+
 //==============================================================================
 bool validate(
     const Eigen::MatrixXd& _M,
@@ -33,12 +33,75 @@
 #ifndef DART_LCPSOLVER_LEMKE_HPP_
 #define DART_LCPSOLVER_LEMKE_HPP_
 
+#include <memory>
+
 #include <Eigen/Dense>
 
 namespace dart {
 namespace lcpsolver {
 
-/// \brief
+/// LemkeSolver solves the standard LCP, which is to find z such that
+/// w = M*z + q, w >= 0, z >= 0, and w^T*z = 0, with Lemke's complementary
+/// pivoting algorithm.
+///
+/// The solver keeps its memory across solves: it only allocates memory when a
+/// problem is larger than all the previous ones. The basis of the pivoting is
+/// kept as an LU factorization that each pivot updates with a rank-1 (eta)
+/// modification instead of factorizing the basis again, and the factorization
+/// is only recomputed after as many pivots as the problem has variables.
+/// Problems of up to MaxFixedSize variables, such as a single contact with
+/// friction, are solved with fixed-size matrices.
+class LemkeSolver
+{
+public:
+  /// Largest problem that is solved with fixed-size matrices
+  static constexpr int MaxFixedSize = 12;
+
+  /// Constructor
+  LemkeSolver();
+
+  /// Destructor
+  ~LemkeSolver();
+
+  /// Solves the LCP of M and q.
+  ///
+  /// \param[in] M M term of the LCP, which is square.
+  /// \param[in] q q term of the LCP.
+  /// \param[out] z The solution, which must have the size of q. Set to zero
+  /// when the pivoting fails.
+  /// \return Error code, which is 0 on success, 1 if the iteration limit was
+  /// reached, 2 on ray termination, 3 if the solution failed validate(), and 4
+  /// if the pivoting broke down.
+  int solve(
+      const Eigen::Ref<const Eigen::MatrixXd>& M,
+      const Eigen::Ref<const Eigen::VectorXd>& q,
+      Eigen::Ref<Eigen::VectorXd> z);
+
+  /// Allocates the memory for problems of up to \c n variables
+  void reserve(int n);
+
+  /// Sets the maximum number of pivots of a solve
+  void setMaxIterations(int maxIterations);
+
+  /// Returns the maximum number of pivots of a solve
+  int getMaxIterations() const;
+
+private:
+  template <int MaxSize>
+  struct Workspace;
+
+  /// Maximum number of pivots of a solve
+  int mMaxIterations;
+
+  /// Memory of the problems of up to MaxFixedSize variables
+  std::unique_ptr<Workspace<MaxFixedSize>> mFixedWorkspace;
+
+  /// Memory of the larger problems, which only grows
+  std::unique_ptr<Workspace<Eigen::Dynamic>> mDynamicWorkspace;
+};
+
+/// Solves the LCP of M and q with a temporary LemkeSolver. See
+/// LemkeSolver::solve() for the error codes.
 int Lemke(
     const Eigen::MatrixXd& _M, const Eigen::VectorXd& _q, Eigen::VectorXd* _z);
 
@@ -40,13 +40,16 @@
 
 #include <iostream>
 
+#include "dart/common/Console.hpp"
 #include "dart/dynamics/Skeleton.hpp"
+#include "dart/simulation/RecordingWriter.hpp"
 
 namespace dart {
 namespace simulation {
 
 //==============================================================================
 Recording::Recording(const std::vector<dynamics::SkeletonPtr>& _skeletons)
+  : mKeepsStatesInMemory(true)
 {
   for (std::size_t i = 0; i < _skeletons.size(); i++)
     mNumGenCoordsForSkeletons.push_back(_skeletons[i]->getNumDofs());
@@ -54,6 +57,7 @@ Recording::Recording(const std::vector<dynamics::SkeletonPtr>& _skeletons)
 
 //==============================================================================
 Recording::Recording(const std::vector<int>& _skelDofs)
+  : mKeepsStatesInMemory(true)
 {
   for (std::size_t i = 0; i < _skelDofs.size(); i++)
     mNumGenCoordsForSkeletons.push_back(_skelDofs[i]);
@@ -62,6 +66,7 @@ Recording::Recording(const std::vector<int>& _skelDofs)
 //==============================================================================
 Recording::~Recording()
 {
+  stopStreaming();
 }
 
 //==============================================================================
@@ -136,16 +141,61 @@ void Recording::clear()
 //==============================================================================
 void Recording::addState(const Eigen::VectorXd& _state)
 {
-  mBakedStates.push_back(_state);
+  if (mWriter)
+    mWriter->write(_state);
+
+  if (mKeepsStatesInMemory)
+    mBakedStates.push_back(_state);
 }
 
 //==============================================================================
 void Recording::updateNumGenCoords(
     const std::vector<dynamics::SkeletonPtr>& _skeletons)
 {
-  mNumGenCoordsForSkeletons.clear();
+  std::vector<int> numGenCoords;
   for (std::size_t i = 0; i < _skeletons.size(); ++i)
-    mNumGenCoordsForSkeletons.push_back(_skeletons[i]->getNumDofs());
+    numGenCoords.push_back(_skeletons[i]->getNumDofs());
+
+  if (mWriter && numGenCoords != mNumGenCoordsForSkeletons)
+  {
+    dtwarn << "[Recording::updateNumGenCoords] The number of generalized "
+           << "coordinates changed while streaming. The states that are "
+           << "streamed from now on won't match the layout stored in the "
+           << "recording file. Restart streaming to a new file instead.\n";
+  }
+
+  mNumGenCoordsForSkeletons = numGenCoords;
+}
+
+//==============================================================================
+bool Recording::startStreaming(
+    const std::string& _path, bool _compress, bool _keepInMemory)
+{
+  stopStreaming();
+
+  mWriter.reset(new RecordingWriter());
+  if (!mWriter->open(_path, mNumGenCoordsForSkeletons, _compress))
+  {
+    mWriter.reset();
+    return false;
+  }
+
+  mKeepsStatesInMemory = _keepInMemory;
+
+  return true;
+}
+
+//==============================================================================
+void Recording::stopStreaming()
+{
+  mWriter.reset();
+  mKeepsStatesInMemory = true;
+}
+
+//==============================================================================
+bool Recording::isStreaming() const
+{
+  return mWriter != nullptr;
 }
 
 } // namespace simulation
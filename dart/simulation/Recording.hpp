@@ -39,6 +39,8 @@
 #ifndef DART_SIMULATION_RECORDING_HPP_
 #define DART_SIMULATION_RECORDING_HPP_
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -53,6 +55,8 @@ class Skeleton;
 
 namespace simulation {
 
+class RecordingWriter;
+
 /// \brief class Recording
 class Recording
 {
@@ -104,12 +108,36 @@ public:
   /// \brief Update list for number of generalized coordinates
   void updateNumGenCoords(const std::vector<dynamics::SkeletonPtr>& _skeletons);
 
+  /// \brief Stream the states that are added from now on to a file instead of
+  /// keeping them in memory. The file can be read back with RecordingReader.
+  /// Returns false if the file can't be opened.
+  /// \param[in] _path Path of the recording file
+  /// \param[in] _compress Whether the states should be compressed
+  /// \param[in] _keepInMemory Whether the states should also be kept in memory
+  /// so that the getters of this Recording keep working
+  bool startStreaming(
+      const std::string& _path,
+      bool _compress = true,
+      bool _keepInMemory = false);
+
+  /// \brief Stop streaming and close the recording file
+  void stopStreaming();
+
+  /// \brief Return true if the states are being streamed to a file
+  bool isStreaming() const;
+
 private:
   /// \brief Baked states
   std::vector<Eigen::VectorXd> mBakedStates;
 
   /// \brief Number of generalized coordinates for skeletons
   std::vector<int> mNumGenCoordsForSkeletons;
+
+  /// \brief Writer of the recording file while streaming
+  std::unique_ptr<RecordingWriter> mWriter;
+
+  /// \brief Whether states are kept in memory while streaming
+  bool mKeepsStatesInMemory;
 };
 
 } // namespace simulation
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/simulation/RecordingReader.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cassert>
+
+#include "dart/common/Console.hpp"
+#include "dart/simulation/detail/RecordingFormat.hpp"
+
+namespace dart {
+namespace simulation {
+
+namespace {
+
+//==============================================================================
+const char* mapFile(const std::string& path, std::size_t& size)
+{
+  size = 0u;
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(
+      path.c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ | FILE_SHARE_WRITE,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return nullptr;
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+  {
+    CloseHandle(file);
+    return nullptr;
+  }
+
+  HANDLE mapping
+      = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping)
+    return nullptr;
+
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!data)
+    return nullptr;
+
+  size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0)
+  {
+    ::close(fd);
+    return nullptr;
+  }
+
+  void* data = mmap(
+      nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE,
+      fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED)
+    return nullptr;
+
+  size = static_cast<std::size_t>(info.st_size);
+#endif
+
+  return static_cast<const char*>(data);
+}
+
+//==============================================================================
+void unmapFile(const char* data, std::size_t size)
+{
+#ifdef _WIN32
+  (void)size;
+  UnmapViewOfFile(data);
+#else
+  munmap(const_cast<char*>(data), size);
+#endif
+}
+
+} // namespace
+
+//==============================================================================
+RecordingReader::RecordingReader()
+  : mData(nullptr),
+    mSize(0u),
+    mCompressed(false),
+    mFramesPerChunk(1u),
+    mCachedFrame(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+RecordingReader::RecordingReader(const std::string& path) : RecordingReader()
+{
+  open(path);
+}
+
+//==============================================================================
+RecordingReader::~RecordingReader()
+{
+  close();
+}
+
+//==============================================================================
+bool RecordingReader::open(const std::string& path)
+{
+  close();
+
+  mData = mapFile(path, mSize);
+  if (!mData)
+  {
+    dtwarn << "[RecordingReader::open] Failed to open '" << path << "'.\n";
+    return false;
+  }
+
+  detail::RecordingHeader header;
+  const std::size_t headerSize
+      = detail::readRecordingHeader(mData, mSize, header);
+  if (0u == headerSize)
+  {
+    dtwarn << "[RecordingReader::open] '" << path
+           << "' is not a valid recording file.\n";
+    close();
+    return false;
+  }
+
+  mCompressed = (header.mFlags & detail::RECORDING_COMPRESSED) != 0u;
+  mFramesPerChunk = header.mFramesPerChunk;
+  mNumDofs = header.mNumDofs;
+
+  if (!detail::readRecordingFooter(mData, mSize, headerSize, mFrameOffsets))
+  {
+    dtwarn << "[RecordingReader::open] '" << path << "' has no frame index. "
+           << "It was probably not closed properly. Recovering the frames by "
+           << "scanning the file.\n";
+    scanFrames(headerSize);
+  }
+
+  mCachedFrame = mFrameOffsets.size();
+
+  return true;
+}
+
+//==============================================================================
+void RecordingReader::close()
+{
+  if (mData)
+    unmapFile(mData, mSize);
+
+  mData = nullptr;
+  mSize = 0u;
+  mNumDofs.clear();
+  mFrameOffsets.clear();
+  mCachedFrame = 0u;
+  mCachedState.resize(0);
+}
+
+//==============================================================================
+bool RecordingReader::isOpen() const
+{
+  return mData != nullptr;
+}
+
+//==============================================================================
+std::size_t RecordingReader::getNumFrames() const
+{
+  return mFrameOffsets.size();
+}
+
+//==============================================================================
+std::size_t RecordingReader::getNumSkeletons() const
+{
+  return mNumDofs.size();
+}
+
+//==============================================================================
+int RecordingReader::getNumDofs(std::size_t skelIdx) const
+{
+  assert(skelIdx < mNumDofs.size());
+  return mNumDofs[skelIdx];
+}
+
+//==============================================================================
+bool RecordingReader::getState(
+    std::size_t frameIdx, Eigen::VectorXd& state) const
+{
+  if (frameIdx >= mFrameOffsets.size())
+  {
+    dtwarn << "[RecordingReader::getState] Requested frame #" << frameIdx
+           << " is out of range. The recording has " << mFrameOffsets.size()
+           << " frames.\n";
+    return false;
+  }
+
+  if (!decodeFrame(frameIdx))
+  {
+    dtwarn << "[RecordingReader::getState] Frame #" << frameIdx
+           << " is corrupted.\n";
+    return false;
+  }
+
+  state = mCachedState;
+
+  return true;
+}
+
+//==============================================================================
+Eigen::VectorXd RecordingReader::getState(std::size_t frameIdx) const
+{
+  Eigen::VectorXd state;
+  if (!getState(frameIdx, state))
+    state.resize(0);
+
+  return state;
+}
+
+//==============================================================================
+Eigen::VectorXd RecordingReader::getConfig(
+    std::size_t frameIdx, std::size_t skelIdx) const
+{
+  assert(skelIdx < mNumDofs.size());
+
+  int index = 0;
+  for (std::size_t i = 0u; i < skelIdx; ++i)
+    index += mNumDofs[i];
+
+  if (frameIdx >= mFrameOffsets.size() || !decodeFrame(frameIdx)
+      || mCachedState.size() < index + mNumDofs[skelIdx])
+    return Eigen::VectorXd();
+
+  return mCachedState.segment(index, mNumDofs[skelIdx]);
+}
+
+//==============================================================================
+bool RecordingReader::decodeFrame(std::size_t frameIdx) const
+{
+  if (frameIdx == mCachedFrame)
+    return true;
+
+  // Decode from the key frame at the beginning of the chunk unless the cached
+  // frame is an earlier frame of the same chunk
+  std::size_t first = frameIdx - frameIdx % mFramesPerChunk;
+  if (mCachedFrame < frameIdx && mCachedFrame >= first)
+    first = mCachedFrame + 1u;
+
+  for (std::size_t i = first; i <= frameIdx; ++i)
+  {
+    const std::size_t offset = static_cast<std::size_t>(mFrameOffsets[i]);
+    if (!detail::decodeRecordingFrame(
+            mData + offset,
+            mSize - offset,
+            mCachedState,
+            mCompressed,
+            mCachedState,
+            mBuffer))
+    {
+      mCachedFrame = mFrameOffsets.size();
+      return false;
+    }
+
+    mCachedFrame = i;
+  }
+
+  return true;
+}
+
+//==============================================================================
+void RecordingReader::scanFrames(std::size_t headerSize)
+{
+  mFrameOffsets.clear();
+
+  std::size_t offset = headerSize;
+  while (offset < mSize)
+  {
+    const std::size_t frameSize
+        = detail::getRecordingFrameSize(mData + offset, mSize - offset);
+    if (0u == frameSize)
+      break;
+
+    mFrameOffsets.push_back(offset);
+    offset += frameSize;
+  }
+}
+
+} // namespace simulation
+} // namespace dart
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_SIMULATION_RECORDINGREADER_HPP_
+#define DART_SIMULATION_RECORDINGREADER_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace dart {
+namespace simulation {
+
+/// RecordingReader provides random access to the frames of a file written by
+/// RecordingWriter.
+///
+/// The file is memory mapped, so only the frames that are accessed are read
+/// from disk. Reading a frame decodes it from the key frame at the beginning
+/// of its chunk; reading the frames in order only decodes each frame once. If
+/// the file was not closed properly (e.g., the simulation crashed), the frame
+/// index is rebuilt by scanning the frames that were completely written.
+///
+/// A RecordingReader caches the last decoded frame, so it must not be shared
+/// between threads without synchronization.
+class RecordingReader
+{
+public:
+  /// Default constructor
+  RecordingReader();
+
+  /// Constructor that opens a recording file
+  explicit RecordingReader(const std::string& path);
+
+  /// Destructor
+  ~RecordingReader();
+
+  RecordingReader(const RecordingReader&) = delete;
+  RecordingReader& operator=(const RecordingReader&) = delete;
+
+  /// Open a recording file. Returns false if the file can't be opened or is
+  /// not a recording file.
+  bool open(const std::string& path);
+
+  /// Close the file
+  void close();
+
+  /// Return true if a recording file is open
+  bool isOpen() const;
+
+  /// Get number of frames
+  std::size_t getNumFrames() const;
+
+  /// Get number of skeletons
+  std::size_t getNumSkeletons() const;
+
+  /// Get number of generalized coordinates of the skeleton whose index is
+  /// skelIdx
+  int getNumDofs(std::size_t skelIdx) const;
+
+  /// Decode the state at frame number frameIdx into state. Returns false if
+  /// the frame doesn't exist or is corrupted.
+  bool getState(std::size_t frameIdx, Eigen::VectorXd& state) const;
+
+  /// Get the state at frame number frameIdx. Returns an empty vector on
+  /// failure.
+  Eigen::VectorXd getState(std::size_t frameIdx) const;
+
+  /// Get configurations of the skeleton whose index is skelIdx at frame number
+  /// frameIdx
+  Eigen::VectorXd getConfig(std::size_t frameIdx, std::size_t skelIdx) const;
+
+private:
+  /// Decode frame number frameIdx into the cache
+  bool decodeFrame(std::size_t frameIdx) const;
+
+  /// Rebuild the frame index by scanning the frames
+  void scanFrames(std::size_t headerSize);
+
+  /// Mapped file content
+  const char* mData;
+
+  /// Size of the mapped file content
+  std::size_t mSize;
+
+  /// Whether frames are compressed
+  bool mCompressed;
+
+  /// Number of frames between two key frames
+  std::size_t mFramesPerChunk;
+
+  /// Number of DOFs of each Skeleton
+  std::vector<int> mNumDofs;
+
+  /// File offset of each frame
+  std::vector<std::uint64_t> mFrameOffsets;
+
+  /// Index of the cached frame, or the number of frames if nothing is cached
+  mutable std::size_t mCachedFrame;
+
+  /// Cached state
+  mutable Eigen::VectorXd mCachedState;
+
+  /// Scratch buffer for decompression
+  mutable std::vector<char> mBuffer;
+};
+
+} // namespace simulation
+} // namespace dart
+
+#endif // DART_SIMULATION_RECORDINGREADER_HPP_
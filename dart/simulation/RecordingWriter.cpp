@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/simulation/RecordingWriter.hpp"
+
+#include "dart/common/Console.hpp"
+#include "dart/simulation/detail/RecordingFormat.hpp"
+
+namespace dart {
+namespace simulation {
+
+//==============================================================================
+RecordingWriter::RecordingWriter() : mCompress(true), mFramesPerChunk(64u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+RecordingWriter::~RecordingWriter()
+{
+  close();
+}
+
+//==============================================================================
+bool RecordingWriter::open(
+    const std::string& path,
+    const std::vector<int>& numDofs,
+    bool compress,
+    std::size_t framesPerChunk)
+{
+  close();
+
+  mStream.open(path, std::ios::binary | std::ios::trunc);
+  if (!mStream.is_open())
+  {
+    dtwarn << "[RecordingWriter::open] Failed to open '" << path
+           << "' for writing.\n";
+    return false;
+  }
+
+  if (0u == framesPerChunk)
+  {
+    dtwarn << "[RecordingWriter::open] Attempting to use zero frames per "
+           << "chunk. Using one instead, which stores every frame as a key "
+           << "frame.\n";
+    framesPerChunk = 1u;
+  }
+
+  mCompress = compress;
+  mFramesPerChunk = framesPerChunk;
+  mFrameOffsets.clear();
+  mPreviousState.resize(0);
+
+  detail::RecordingHeader header;
+  header.mFlags = compress ? detail::RECORDING_COMPRESSED : 0u;
+  header.mFramesPerChunk = static_cast<std::uint32_t>(framesPerChunk);
+  header.mNumDofs = numDofs;
+  detail::writeRecordingHeader(mStream, header);
+
+  return mStream.good();
+}
+
+//==============================================================================
+void RecordingWriter::write(const Eigen::VectorXd& state)
+{
+  if (!mStream.is_open())
+  {
+    dtwarn << "[RecordingWriter::write] Attempting to write a state while no "
+           << "file is open. Ignoring this request.\n";
+    return;
+  }
+
+  const bool isKeyFrame = mFrameOffsets.size() % mFramesPerChunk == 0u;
+
+  mFrameOffsets.push_back(static_cast<std::uint64_t>(mStream.tellp()));
+  detail::encodeRecordingFrame(
+      state, isKeyFrame ? nullptr : &mPreviousState, mCompress, mBuffer);
+  mStream.write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+
+  mPreviousState = state;
+}
+
+//==============================================================================
+void RecordingWriter::close()
+{
+  if (!mStream.is_open())
+    return;
+
+  detail::writeRecordingFooter(mStream, mFrameOffsets);
+  mStream.close();
+}
+
+//==============================================================================
+bool RecordingWriter::isOpen() const
+{
+  return mStream.is_open();
+}
+
+//==============================================================================
+std::size_t RecordingWriter::getNumFrames() const
+{
+  return mFrameOffsets.size();
+}
+
+} // namespace simulation
+} // namespace dart
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_SIMULATION_RECORDINGWRITER_HPP_
+#define DART_SIMULATION_RECORDINGWRITER_HPP_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace dart {
+namespace simulation {
+
+/// RecordingWriter streams the states of a Recording to a file as they are
+/// added, so long simulations don't need to keep every frame in memory.
+///
+/// Frames are delta encoded against the previous frame, with a key frame at
+/// the beginning of every chunk, and are optionally compressed. A frame index
+/// is appended when the writer is closed so that RecordingReader can seek to
+/// any frame in constant time.
+class RecordingWriter
+{
+public:
+  /// Default constructor
+  RecordingWriter();
+
+  /// Destructor. Closes the file if it is still open.
+  ~RecordingWriter();
+
+  /// Open a recording file for writing, discarding its previous content.
+  /// Returns false if the file can't be opened.
+  ///
+  /// \param[in] path Path of the recording file
+  /// \param[in] numDofs Number of DOFs of each Skeleton in the World
+  /// \param[in] compress Whether the frames should be compressed
+  /// \param[in] framesPerChunk Number of frames between two key frames. Larger
+  /// chunks compress better but make random access slower.
+  bool open(
+      const std::string& path,
+      const std::vector<int>& numDofs,
+      bool compress = true,
+      std::size_t framesPerChunk = 64u);
+
+  /// Append a state to the recording
+  void write(const Eigen::VectorXd& state);
+
+  /// Write the frame index and close the file
+  void close();
+
+  /// Return true if a file is open for writing
+  bool isOpen() const;
+
+  /// Return the number of frames written since the file was opened
+  std::size_t getNumFrames() const;
+
+private:
+  /// Output file
+  std::ofstream mStream;
+
+  /// Whether frames are compressed
+  bool mCompress;
+
+  /// Number of frames between two key frames
+  std::size_t mFramesPerChunk;
+
+  /// File offset of each frame
+  std::vector<std::uint64_t> mFrameOffsets;
+
+  /// Previously written state
+  Eigen::VectorXd mPreviousState;
+
+  /// Reusable buffer for encoded frames
+  std::vector<char> mBuffer;
+};
+
+} // namespace simulation
+} // namespace dart
+
+#endif // DART_SIMULATION_RECORDINGWRITER_HPP_
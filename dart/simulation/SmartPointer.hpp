@@ -39,6 +39,7 @@ namespace dart {
 namespace simulation {
 
 DART_COMMON_DECLARE_SHARED_WEAK(World)
+DART_COMMON_DECLARE_SHARED_WEAK(WorldBatch)
 
 } // namespace simulation
 } // namespace dart
@@ -38,20 +38,58 @@
 
 #include "dart/simulation/World.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <vector>
 
 #include "dart/collision/CollisionGroup.hpp"
+#include "dart/collision/CollisionObject.hpp"
 #include "dart/common/Console.hpp"
+#include "dart/common/Profiler.hpp"
 #include "dart/constraint/BoxedLcpConstraintSolver.hpp"
 #include "dart/constraint/ConstrainedGroup.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/DegreeOfFreedom.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/integration/SemiImplicitEulerIntegrator.hpp"
 
 namespace dart {
 namespace simulation {
 
+namespace {
+
+//==============================================================================
+/// Find the indices of the Skeleton and of the BodyNode of a collision object,
+/// given the Skeletons of the World sorted by address along with their indices
+void findBodyNodeIndices(
+    const collision::CollisionObject* object,
+    const std::vector<std::pair<const dynamics::Skeleton*, std::size_t>>&
+        skeletonIndices,
+    std::size_t& skeletonIndex,
+    std::size_t& bodyNodeIndex)
+{
+  const dynamics::BodyNode* bodyNode
+      = object->getShapeFrame()->asShapeNode()->getBodyNodePtr().get();
+  const dynamics::Skeleton* skel = bodyNode->getSkeleton().get();
+
+  const auto it = std::lower_bound(
+      skeletonIndices.begin(),
+      skeletonIndices.end(),
+      skel,
+      [](const std::pair<const dynamics::Skeleton*, std::size_t>& entry,
+         const dynamics::Skeleton* key) { return entry.first < key; });
+  assert(it != skeletonIndices.end() && it->first == skel);
+
+  skeletonIndex = it->second;
+  bodyNodeIndex = bodyNode->getIndexInSkeleton();
+}
+
+} // namespace
+
 //==============================================================================
 std::shared_ptr<World> World::create(const std::string& name)
 {
@@ -68,6 +106,16 @@ World::World(const std::string& _name)
     mTime(0.0),
     mFrame(0),
     mRecording(new Recording(mSkeletons)),
+    mIsSleepingEnabled(false),
+    mSleepVelocityThreshold(1e-2),
+    mSleepTimeThreshold(0.5),
+    mNumSubSteps(1u),
+    mIsAdaptiveSubSteppingEnabled(false),
+    mMaxNumSubSteps(16u),
+    mPenetrationTolerance(1e-2),
+    mIsDeterministic(false),
+    mIsSnapshotPublishingEnabled(false),
+    mPublishedSnapshot(-1),
     onNameChanged(mNameChangedSignal)
 {
   mIndices.push_back(0);
@@ -95,6 +143,19 @@ WorldPtr World::clone() const
 
   worldClone->setGravity(mGravity);
   worldClone->setTimeStep(mTimeStep);
+  worldClone->setSleepingEnabled(mIsSleepingEnabled);
+  worldClone->setSleepVelocityThreshold(mSleepVelocityThreshold);
+  worldClone->setSleepTimeThreshold(mSleepTimeThreshold);
+  worldClone->setNumSubSteps(mNumSubSteps);
+  worldClone->setAdaptiveSubSteppingEnabled(mIsAdaptiveSubSteppingEnabled);
+  worldClone->setMaxNumSubSteps(mMaxNumSubSteps);
+  worldClone->setPenetrationTolerance(mPenetrationTolerance);
+  worldClone->setDeterministic(mIsDeterministic);
+  worldClone->setSnapshotPublishingEnabled(mIsSnapshotPublishingEnabled);
+  worldClone->setRealTime(
+      isRealTime(),
+      mConstraintSolver->getCollisionOption().maxNumContacts,
+      mConstraintSolver->getMaxNumConstraintRows());
 
   auto cd = getConstraintSolver()->getCollisionDetector();
   worldClone->getConstraintSolver()->setCollisionDetector(
@@ -105,6 +166,7 @@ WorldPtr World::clone() const
   {
     worldClone->addSkeleton(mSkeletons[i]->cloneSkeleton());
   }
+  worldClone->mRestTimes = mRestTimes;
 
   // Clone and add each SimpleFrame
   for (std::size_t i = 0; i < mSimpleFrames.size(); ++i)
@@ -142,10 +204,7 @@ void World::setTimeStep(double _timeStep)
   }
 
   mTimeStep = _timeStep;
-  assert(mConstraintSolver);
-  mConstraintSolver->setTimeStep(_timeStep);
-  for (auto& skel : mSkeletons)
-    skel->setTimeStep(_timeStep);
+  updateSubTimeStep();
 }
 
 //==============================================================================
@@ -161,48 +220,78 @@ void World::reset()
   mFrame = 0;
   mRecording->clear();
   mConstraintSolver->clearLastCollisionResult();
+  std::fill(mRestTimes.begin(), mRestTimes.end(), 0.0);
 }
 
 //==============================================================================
-void World::step(bool _resetCommand)
+static bool isAtRest(const dynamics::Skeleton* skel, double velocityThreshold)
 {
-  // Integrate velocity for unconstrained skeletons
-  for (auto& skel : mSkeletons)
+  for (std::size_t i = 0u; i < skel->getNumDofs(); ++i)
   {
-    if (!skel->isMobile())
-      continue;
+    const dynamics::DegreeOfFreedom* dof = skel->getDof(i);
 
-    skel->computeForwardDynamics();
-    skel->integrateVelocities(mTimeStep);
-  }
+    if (std::abs(dof->getVelocity()) > velocityThreshold)
+      return false;
 
-  // Detect activated constraints and compute constraint impulses
-  mConstraintSolver->solve();
+    if (dof->getCommand() != 0.0 || dof->getForce() != 0.0)
+      return false;
+  }
 
-  // Compute velocity changes given constraint impulses
-  for (auto& skel : mSkeletons)
+  for (std::size_t i = 0u; i < skel->getNumBodyNodes(); ++i)
   {
-    if (!skel->isMobile())
-      continue;
+    if (!skel->getBodyNode(i)->getExternalForceLocal().isZero(0.0))
+      return false;
+  }
 
-    if (skel->isImpulseApplied())
-    {
-      skel->computeImpulseForwardDynamics();
-      skel->setImpulseApplied(false);
-    }
+  return true;
+}
+
+//==============================================================================
+void World::step(bool _resetCommand)
+{
+  DART_PROFILE_SCOPE("World::step");
 
-    skel->integratePositions(mTimeStep);
+  const double subTimeStep = getSubTimeStep();
 
-    if (_resetCommand)
+  // Collision detection is performed only on the first substep. The following
+  // substeps reuse its contacts, updated to the motion of the bodies.
+  for (std::size_t i = 0u; i < mNumSubSteps; ++i)
+    integrateSubStep(subTimeStep, 0u == i);
+
+  if (_resetCommand)
+  {
+    for (auto& skel : mSkeletons)
     {
+      if (!skel->isMobile() || skel->isSleeping())
+        continue;
+
       skel->clearInternalForces();
       skel->clearExternalForces();
       skel->resetCommands();
     }
   }
 
+  if (mIsSleepingEnabled)
+  {
+    // Immobile Skeletons are only moved by the user, which wakes them up
+    for (auto& skel : mSkeletons)
+    {
+      if (!skel->isMobile() && !skel->isSleeping()
+          && isAtRest(skel.get(), 0.0))
+      {
+        skel->setSleeping(true);
+      }
+    }
+  }
+
+  if (mIsAdaptiveSubSteppingEnabled)
+    adaptNumSubSteps();
+
   mTime += mTimeStep;
   mFrame++;
+
+  if (mIsSnapshotPublishingEnabled)
+    publishSnapshot();
 }
 
 //==============================================================================
@@ -223,6 +312,142 @@ int World::getSimFrames() const
   return mFrame;
 }
 
+//==============================================================================
+void World::setNumSubSteps(std::size_t numSubSteps)
+{
+  if (0u == numSubSteps)
+  {
+    dtwarn << "[World::setNumSubSteps] Attempting to set zero substeps. "
+           << "Ignoring this request.\n";
+    return;
+  }
+
+  if (mNumSubSteps == numSubSteps)
+    return;
+
+  mNumSubSteps = numSubSteps;
+  updateSubTimeStep();
+}
+
+//==============================================================================
+std::size_t World::getNumSubSteps() const
+{
+  return mNumSubSteps;
+}
+
+//==============================================================================
+double World::getSubTimeStep() const
+{
+  return mTimeStep / static_cast<double>(mNumSubSteps);
+}
+
+//==============================================================================
+void World::setAdaptiveSubSteppingEnabled(bool enabled)
+{
+  mIsAdaptiveSubSteppingEnabled = enabled;
+}
+
+//==============================================================================
+bool World::isAdaptiveSubSteppingEnabled() const
+{
+  return mIsAdaptiveSubSteppingEnabled;
+}
+
+//==============================================================================
+void World::setMaxNumSubSteps(std::size_t maxNumSubSteps)
+{
+  if (0u == maxNumSubSteps)
+  {
+    dtwarn << "[World::setMaxNumSubSteps] Attempting to set zero substeps. "
+           << "Ignoring this request.\n";
+    return;
+  }
+
+  mMaxNumSubSteps = maxNumSubSteps;
+}
+
+//==============================================================================
+std::size_t World::getMaxNumSubSteps() const
+{
+  return mMaxNumSubSteps;
+}
+
+//==============================================================================
+void World::setPenetrationTolerance(double tolerance)
+{
+  if (tolerance <= 0.0)
+  {
+    dtwarn << "[World::setPenetrationTolerance] Attempting to set non-positive "
+           << "tolerance (" << tolerance << "). Ignoring this request.\n";
+    return;
+  }
+
+  mPenetrationTolerance = tolerance;
+}
+
+//==============================================================================
+double World::getPenetrationTolerance() const
+{
+  return mPenetrationTolerance;
+}
+
+//==============================================================================
+void World::setSleepingEnabled(bool enabled)
+{
+  mIsSleepingEnabled = enabled;
+
+  if (mIsSleepingEnabled)
+    return;
+
+  std::fill(mRestTimes.begin(), mRestTimes.end(), 0.0);
+  for (auto& skel : mSkeletons)
+    skel->setSleeping(false);
+}
+
+//==============================================================================
+bool World::isSleepingEnabled() const
+{
+  return mIsSleepingEnabled;
+}
+
+//==============================================================================
+void World::setSleepVelocityThreshold(double threshold)
+{
+  if (threshold < 0.0)
+  {
+    dtwarn << "[World::setSleepVelocityThreshold] Attempting to set negative "
+           << "threshold (" << threshold << "). Ignoring this request.\n";
+    return;
+  }
+
+  mSleepVelocityThreshold = threshold;
+}
+
+//==============================================================================
+double World::getSleepVelocityThreshold() const
+{
+  return mSleepVelocityThreshold;
+}
+
+//==============================================================================
+void World::setSleepTimeThreshold(double threshold)
+{
+  if (threshold < 0.0)
+  {
+    dtwarn << "[World::setSleepTimeThreshold] Attempting to set negative "
+           << "threshold (" << threshold << "). Ignoring this request.\n";
+    return;
+  }
+
+  mSleepTimeThreshold = threshold;
+}
+
+//==============================================================================
+double World::getSleepTimeThreshold() const
+{
+  return mSleepTimeThreshold;
+}
+
 //==============================================================================
 const std::string& World::setName(const std::string& _newName)
 {
@@ -306,6 +531,8 @@ std::string World::addSkeleton(const dynamics::SkeletonPtr& _skeleton)
   mSkeletons.push_back(_skeleton);
   mMapForSkeletons[_skeleton] = _skeleton;
 
+  mRestTimes.push_back(0.0);
+
   mNameConnectionsForSkeletons.push_back(_skeleton->onNameChanged.connect(
       [=](dynamics::ConstMetaSkeletonPtr skel,
           const std::string&,
@@ -314,7 +541,7 @@ std::string World::addSkeleton(const dynamics::SkeletonPtr& _skeleton)
   _skeleton->setName(
       mNameMgrForSkeletons.issueNewNameAndAdd(_skeleton->getName(), _skeleton));
 
-  _skeleton->setTimeStep(mTimeStep);
+  _skeleton->setTimeStep(getSubTimeStep());
   _skeleton->setGravity(mGravity);
 
   mIndices.push_back(mIndices.back() + _skeleton->getNumDofs());
@@ -375,6 +602,8 @@ void World::removeSkeleton(const dynamics::SkeletonPtr& _skeleton)
   mNameConnectionsForSkeletons.erase(
       mNameConnectionsForSkeletons.begin() + index);
 
+  mRestTimes.erase(mRestTimes.begin() + index);
+
   // Update recording
   mRecording->updateNumGenCoords(mSkeletons);
 
@@ -553,6 +782,352 @@ const collision::CollisionResult& World::getLastCollisionResult() const
   return mConstraintSolver->getLastCollisionResult();
 }
 
+//==============================================================================
+void World::setDeterministic(bool deterministic)
+{
+  mIsDeterministic = deterministic;
+  mConstraintSolver->setDeterministic(deterministic);
+}
+
+//==============================================================================
+bool World::isDeterministic() const
+{
+  return mIsDeterministic;
+}
+
+//==============================================================================
+std::uint64_t World::computeStateHash() const
+{
+  // 64-bit FNV-1a over the bit patterns of the values
+  std::uint64_t hash = 14695981039346656037ull;
+  const auto combine = [&hash](double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (std::size_t i = 0u; i < sizeof(bits); ++i)
+    {
+      hash ^= (bits >> (8u * i)) & 0xffu;
+      hash *= 1099511628211ull;
+    }
+  };
+
+  combine(mTime);
+  for (const auto& skel : mSkeletons)
+  {
+    for (std::size_t i = 0u; i < skel->getNumDofs(); ++i)
+    {
+      const auto* dof = skel->getDof(i);
+      combine(dof->getPosition());
+      combine(dof->getVelocity());
+    }
+  }
+
+  return hash;
+}
+
+//==============================================================================
+void World::setRealTime(
+    bool realTime, std::size_t maxNumContacts, std::size_t maxNumConstraintRows)
+{
+  mConstraintSolver->setRealTime(
+      realTime, maxNumContacts, maxNumConstraintRows);
+
+  if (mIsSnapshotPublishingEnabled)
+    reserveSnapshotBuffers();
+}
+
+//==============================================================================
+bool World::isRealTime() const
+{
+  return mConstraintSolver->isRealTime();
+}
+
+//==============================================================================
+std::size_t World::getNumRealTimeOverflows() const
+{
+  return mConstraintSolver->getNumRealTimeOverflows();
+}
+
+//==============================================================================
+void World::saveState(State& state) const
+{
+  std::size_t numDofs = 0u;
+  std::size_t numBodyNodes = 0u;
+  for (const auto& skel : mSkeletons)
+  {
+    numDofs += skel->getNumDofs();
+    numBodyNodes += skel->getNumBodyNodes();
+  }
+
+  state.mTime = mTime;
+  state.mFrame = mFrame;
+  state.mNumSubSteps = mNumSubSteps;
+
+  state.mPositions.resize(static_cast<int>(numDofs));
+  state.mVelocities.resize(static_cast<int>(numDofs));
+  state.mAccelerations.resize(static_cast<int>(numDofs));
+  state.mForces.resize(static_cast<int>(numDofs));
+  state.mCommands.resize(static_cast<int>(numDofs));
+  state.mExternalForces.resize(6 * static_cast<int>(numBodyNodes));
+  state.mSleeping.resize(mSkeletons.size());
+  state.mRestTimes = mRestTimes;
+
+  int dofIndex = 0;
+  int bodyIndex = 0;
+  for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+  {
+    const dynamics::Skeleton* skel = mSkeletons[i].get();
+
+    for (std::size_t j = 0u; j < skel->getNumDofs(); ++j)
+    {
+      const dynamics::DegreeOfFreedom* dof = skel->getDof(j);
+      state.mPositions[dofIndex] = dof->getPosition();
+      state.mVelocities[dofIndex] = dof->getVelocity();
+      state.mAccelerations[dofIndex] = dof->getAcceleration();
+      state.mForces[dofIndex] = dof->getForce();
+      state.mCommands[dofIndex] = dof->getCommand();
+      ++dofIndex;
+    }
+
+    for (std::size_t j = 0u; j < skel->getNumBodyNodes(); ++j)
+    {
+      state.mExternalForces.segment<6>(6 * bodyIndex)
+          = skel->getBodyNode(j)->getExternalForceLocal();
+      ++bodyIndex;
+    }
+
+    state.mSleeping[i] = skel->isSleeping();
+  }
+
+  state.mCollisionResult = mConstraintSolver->getLastCollisionResult();
+  state.mContactImpulses = mConstraintSolver->getContactImpulses();
+}
+
+//==============================================================================
+World::State World::saveState() const
+{
+  State state;
+  saveState(state);
+
+  return state;
+}
+
+//==============================================================================
+bool World::restoreState(const State& state)
+{
+  std::size_t numDofs = 0u;
+  std::size_t numBodyNodes = 0u;
+  for (const auto& skel : mSkeletons)
+  {
+    numDofs += skel->getNumDofs();
+    numBodyNodes += skel->getNumBodyNodes();
+  }
+
+  if (static_cast<std::size_t>(state.mPositions.size()) != numDofs
+      || static_cast<std::size_t>(state.mVelocities.size()) != numDofs
+      || static_cast<std::size_t>(state.mAccelerations.size()) != numDofs
+      || static_cast<std::size_t>(state.mForces.size()) != numDofs
+      || static_cast<std::size_t>(state.mCommands.size()) != numDofs
+      || static_cast<std::size_t>(state.mExternalForces.size())
+             != 6u * numBodyNodes
+      || state.mSleeping.size() != mSkeletons.size()
+      || state.mRestTimes.size() != mSkeletons.size())
+  {
+    dtwarn << "[World::restoreState] The given state does not match the "
+           << "structure of World [" << getName() << "]. Ignoring this "
+           << "request.\n";
+    return false;
+  }
+
+  mTime = state.mTime;
+  mFrame = state.mFrame;
+  setNumSubSteps(state.mNumSubSteps);
+  mRestTimes = state.mRestTimes;
+
+  int dofIndex = 0;
+  int bodyIndex = 0;
+  for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+  {
+    dynamics::Skeleton* skel = mSkeletons[i].get();
+
+    {
+      dynamics::Skeleton::PositionUpdateBatch batch(skel);
+      for (std::size_t j = 0u; j < skel->getNumDofs(); ++j)
+      {
+        dynamics::DegreeOfFreedom* dof = skel->getDof(j);
+        dof->setPosition(state.mPositions[dofIndex]);
+        dof->setVelocity(state.mVelocities[dofIndex]);
+        dof->setAcceleration(state.mAccelerations[dofIndex]);
+        dof->setForce(state.mForces[dofIndex]);
+        // The commands are restored as they were saved, without clipping them
+        // to the limits of the actuators again
+        dof->getJoint()->setCommandUnclipped(
+            dof->getIndexInJoint(), state.mCommands[dofIndex]);
+        ++dofIndex;
+      }
+    }
+
+    // Restore the sleeping flag after the positions because changing them
+    // wakes up the Skeleton. The velocities of a sleeping Skeleton are zero,
+    // so putting it to sleep doesn't change them.
+    skel->setSleeping(state.mSleeping[i]);
+
+    for (std::size_t j = 0u; j < skel->getNumBodyNodes(); ++j)
+    {
+      skel->getBodyNode(j)->setAspectState(dynamics::BodyNode::AspectState(
+          state.mExternalForces.segment<6>(6 * bodyIndex)));
+      ++bodyIndex;
+    }
+  }
+
+  mConstraintSolver->getLastCollisionResult() = state.mCollisionResult;
+  mConstraintSolver->setContactImpulses(state.mContactImpulses);
+
+  return true;
+}
+
+//==============================================================================
+void World::setSnapshotPublishingEnabled(bool enabled)
+{
+  mIsSnapshotPublishingEnabled = enabled;
+
+  if (enabled)
+    reserveSnapshotBuffers();
+}
+
+//==============================================================================
+bool World::isSnapshotPublishingEnabled() const
+{
+  return mIsSnapshotPublishingEnabled;
+}
+
+//==============================================================================
+bool World::publishSnapshot()
+{
+  DART_PROFILE_SCOPE("World::publishSnapshot");
+
+  // Only this function changes the published buffer. Refill a buffer that is
+  // neither published nor held by a reader.
+  const int published = mPublishedSnapshot.load();
+  for (int i = 0; i < static_cast<int>(mSnapshotBuffers.size()); ++i)
+  {
+    SnapshotBuffer& buffer = mSnapshotBuffers[i];
+    if (i == published || buffer.mNumReaders.load() > 0)
+      continue;
+
+    // Make sure that the reads of the last reader of this buffer happen
+    // before it is refilled
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    fillSnapshot(buffer.mSnapshot);
+    mPublishedSnapshot.store(i);
+
+    return true;
+  }
+
+  return false;
+}
+
+//==============================================================================
+WorldSnapshotPtr World::getSnapshot() const
+{
+  while (true)
+  {
+    const int index = mPublishedSnapshot.load();
+    if (index < 0)
+      return WorldSnapshotPtr();
+
+    // The buffer may have stopped being published, and started being refilled,
+    // right after it was looked up. publishSnapshot() checks the number of
+    // readers after it changes the published buffer, so the buffer is safe to
+    // read if it is still published after the reader is counted.
+    const SnapshotBuffer& buffer = mSnapshotBuffers[index];
+    ++buffer.mNumReaders;
+    if (mPublishedSnapshot.load() == index)
+      return WorldSnapshotPtr(&buffer.mSnapshot, &buffer.mNumReaders);
+
+    --buffer.mNumReaders;
+  }
+}
+
+//==============================================================================
+void World::reserveSnapshotBuffers()
+{
+  const int published = mPublishedSnapshot.load();
+  for (int i = 0; i < static_cast<int>(mSnapshotBuffers.size()); ++i)
+  {
+    SnapshotBuffer& buffer = mSnapshotBuffers[i];
+    if (i == published || buffer.mNumReaders.load() > 0)
+      continue;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    fillSnapshot(buffer.mSnapshot);
+    if (isRealTime())
+    {
+      buffer.mSnapshot.mContacts.reserve(
+          mConstraintSolver->getCollisionOption().maxNumContacts);
+    }
+  }
+
+  mSnapshotSkeletonIndices.reserve(mSkeletons.size());
+}
+
+//==============================================================================
+void World::fillSnapshot(WorldSnapshot& snapshot)
+{
+  snapshot.mTime = mTime;
+  snapshot.mFrame = mFrame;
+
+  mSnapshotSkeletonIndices.clear();
+  snapshot.mSkeletons.resize(mSkeletons.size());
+  for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+  {
+    const dynamics::Skeleton* skel = mSkeletons[i].get();
+    WorldSnapshot::SkeletonState& state = snapshot.mSkeletons[i];
+
+    // Copy into the existing storage of the buffer
+    const std::size_t numDofs = skel->getNumDofs();
+    state.mName = skel->getName();
+    state.mPositions.resize(numDofs);
+    state.mVelocities.resize(numDofs);
+    for (std::size_t j = 0u; j < numDofs; ++j)
+    {
+      state.mPositions[j] = skel->getPosition(j);
+      state.mVelocities[j] = skel->getVelocity(j);
+    }
+    state.mBodyTransforms.resize(skel->getNumBodyNodes());
+    for (std::size_t j = 0u; j < skel->getNumBodyNodes(); ++j)
+      state.mBodyTransforms[j] = skel->getBodyNode(j)->getWorldTransform();
+    state.mIsSleeping = skel->isSleeping();
+
+    mSnapshotSkeletonIndices.emplace_back(skel, i);
+  }
+  std::sort(mSnapshotSkeletonIndices.begin(), mSnapshotSkeletonIndices.end());
+
+  const collision::CollisionResult& result = getLastCollisionResult();
+  snapshot.mContacts.resize(result.getNumContacts());
+  for (std::size_t i = 0u; i < result.getNumContacts(); ++i)
+  {
+    const collision::Contact& contact = result.getContact(i);
+    WorldSnapshot::ContactState& state = snapshot.mContacts[i];
+
+    findBodyNodeIndices(
+        contact.collisionObject1,
+        mSnapshotSkeletonIndices,
+        state.mSkeleton1,
+        state.mBodyNode1);
+    findBodyNodeIndices(
+        contact.collisionObject2,
+        mSnapshotSkeletonIndices,
+        state.mSkeleton2,
+        state.mBodyNode2);
+    state.mPoint = contact.point;
+    state.mNormal = contact.normal;
+    state.mForce = contact.force;
+    state.mPenetrationDepth = contact.penetrationDepth;
+  }
+}
+
 //==============================================================================
 void World::setConstraintSolver(constraint::UniqueConstraintSolverPtr solver)
 {
@@ -567,7 +1142,8 @@ void World::setConstraintSolver(constraint::UniqueConstraintSolverPtr solver)
     solver->setFromOtherConstraintSolver(*mConstraintSolver);
 
   mConstraintSolver = std::move(solver);
-  mConstraintSolver->setTimeStep(mTimeStep);
+  mConstraintSolver->setTimeStep(getSubTimeStep());
+  mConstraintSolver->setDeterministic(mIsDeterministic);
 }
 
 //==============================================================================
@@ -612,6 +1188,104 @@ Recording* World::getRecording()
   return mRecording;
 }
 
+//==============================================================================
+void World::integrateSubStep(double timeStep, bool detectCollision)
+{
+  // Integrate velocity for unconstrained skeletons
+  {
+    DART_PROFILE_SCOPE("World::computeForwardDynamics");
+
+    for (auto& skel : mSkeletons)
+    {
+      if (!skel->isMobile())
+        continue;
+
+      if (skel->isSleeping())
+      {
+        if (mIsSleepingEnabled
+            && isAtRest(skel.get(), mSleepVelocityThreshold))
+          continue;
+
+        skel->setSleeping(false);
+      }
+
+      skel->computeForwardDynamics();
+      skel->integrateVelocities(timeStep);
+    }
+  }
+
+  // Detect activated constraints and compute constraint impulses
+  mConstraintSolver->solve(detectCollision);
+
+  // Compute velocity changes given constraint impulses
+  DART_PROFILE_SCOPE("World::integratePositions");
+
+  for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+  {
+    const auto& skel = mSkeletons[i];
+
+    if (!skel->isMobile() || skel->isSleeping())
+      continue;
+
+    if (skel->isImpulseApplied())
+    {
+      skel->computeImpulseForwardDynamics();
+      skel->setImpulseApplied(false);
+    }
+
+    skel->integratePositions(timeStep);
+
+    if (mIsSleepingEnabled)
+    {
+      // Commands and forces are checked before they are reset so that an
+      // actuated Skeleton holding still is not put to sleep
+      if (isAtRest(skel.get(), mSleepVelocityThreshold))
+        mRestTimes[i] += timeStep;
+      else
+        mRestTimes[i] = 0.0;
+
+      if (mRestTimes[i] >= mSleepTimeThreshold)
+      {
+        skel->setSleeping(true);
+        mRestTimes[i] = 0.0;
+      }
+    }
+  }
+}
+
+//==============================================================================
+void World::adaptNumSubSteps()
+{
+  double maxPenetration = 0.0;
+  const auto& result = mConstraintSolver->getLastCollisionResult();
+  for (auto i = 0u; i < result.getNumContacts(); ++i)
+  {
+    maxPenetration
+        = std::max(maxPenetration, result.getContact(i).penetrationDepth);
+  }
+
+  // Halve the substeps only well below the tolerance to avoid switching back
+  // and forth every step
+  std::size_t numSubSteps = mNumSubSteps;
+  if (maxPenetration > mPenetrationTolerance)
+    numSubSteps = std::min(2u * mNumSubSteps, mMaxNumSubSteps);
+  else if (maxPenetration < 0.25 * mPenetrationTolerance)
+    numSubSteps = std::max<std::size_t>(mNumSubSteps / 2u, 1u);
+
+  setNumSubSteps(numSubSteps);
+}
+
+//==============================================================================
+void World::updateSubTimeStep()
+{
+  const double subTimeStep = getSubTimeStep();
+
+  assert(mConstraintSolver);
+  mConstraintSolver->setTimeStep(subTimeStep);
+  for (auto& skel : mSkeletons)
+    skel->setTimeStep(subTimeStep);
+}
+
 //==============================================================================
 void World::handleSkeletonNameChange(
     const dynamics::ConstMetaSkeletonPtr& _skeleton)
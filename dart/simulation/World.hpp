@@ -39,6 +39,10 @@
 #ifndef DART_SIMULATION_WORLD_HPP_
 #define DART_SIMULATION_WORLD_HPP_
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -46,15 +50,18 @@
 #include <Eigen/Dense>
 
 #include "dart/collision/CollisionOption.hpp"
+#include "dart/collision/CollisionResult.hpp"
 #include "dart/common/NameManager.hpp"
 #include "dart/common/SmartPointer.hpp"
 #include "dart/common/Subject.hpp"
 #include "dart/common/Timer.hpp"
+#include "dart/constraint/ConstraintSolver.hpp"
 #include "dart/constraint/SmartPointer.hpp"
 #include "dart/dynamics/SimpleFrame.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/simulation/Recording.hpp"
 #include "dart/simulation/SmartPointer.hpp"
+#include "dart/simulation/WorldSnapshot.hpp"
 
 namespace dart {
 
@@ -85,6 +92,52 @@ public:
   using NameChangedSignal = common::Signal<void(
       const std::string& _oldName, const std::string& _newName)>;
 
+  /// Snapshot of the mutable simulation state of a World. See saveState().
+  struct State
+  {
+    /// Simulation time
+    double mTime;
+
+    /// Simulation frame number
+    int mFrame;
+
+    /// Number of substeps, which may be changed by adaptive sub-stepping
+    std::size_t mNumSubSteps;
+
+    /// Generalized positions of all the Skeletons, in the order of the
+    /// Skeletons and of their DegreesOfFreedom
+    Eigen::VectorXd mPositions;
+
+    /// Generalized velocities, ordered like mPositions
+    Eigen::VectorXd mVelocities;
+
+    /// Generalized accelerations, ordered like mPositions
+    Eigen::VectorXd mAccelerations;
+
+    /// Generalized forces, ordered like mPositions
+    Eigen::VectorXd mForces;
+
+    /// Commands, ordered like mPositions
+    Eigen::VectorXd mCommands;
+
+    /// External forces of all the BodyNodes, six entries per BodyNode in the
+    /// order of the Skeletons and of their BodyNodes
+    Eigen::VectorXd mExternalForces;
+
+    /// Whether each Skeleton is sleeping
+    std::vector<bool> mSleeping;
+
+    /// Time each Skeleton has been at rest
+    std::vector<double> mRestTimes;
+
+    /// Last collision result of the constraint solver
+    collision::CollisionResult mCollisionResult;
+
+    /// Contact impulses that the next step starts from when warm starting is
+    /// enabled. See ConstraintSolver::setWarmStarting().
+    std::vector<constraint::ConstraintSolver::ContactImpulse> mContactImpulses;
+  };
+
   /// Creates World as shared_ptr
   template <typename... Args>
   static WorldPtr create(Args&&... args);
@@ -103,7 +156,9 @@ public:
   virtual ~World();
 
   /// Create a clone of this World. All Skeletons and SimpleFrames that are held
-  /// by this World will be copied over.
+  /// by this World will be copied over. The clone has new collision objects,
+  /// so its first step does not start from the contact impulses of this World
+  /// when warm starting is enabled.
   std::shared_ptr<World> clone() const;
 
   //--------------------------------------------------------------------------
@@ -229,6 +284,198 @@ public:
   /// getSimpleFrame()
   int getSimFrames() const;
 
+  //--------------------------------------------------------------------------
+  // Sub-stepping
+  //--------------------------------------------------------------------------
+
+  /// Set the number of substeps that step() divides the time step into. The
+  /// dynamics, the constraints, and the integration are computed on every
+  /// substep of getSubTimeStep() seconds, while collision detection is only
+  /// performed on the first substep and its contacts are reused by the
+  /// following ones. The points and penetration depths of the reused contacts
+  /// follow the bodies as they move, so the penetration correction isn't
+  /// applied again for the depth that was already corrected. This allows a
+  /// stiff system to be simulated stably with a larger time step without
+  /// paying for collision detection on every substep.
+  void setNumSubSteps(std::size_t numSubSteps);
+
+  /// Get the number of substeps per step()
+  std::size_t getNumSubSteps() const;
+
+  /// Get the time step of each substep, which is getTimeStep() divided by
+  /// getNumSubSteps()
+  double getSubTimeStep() const;
+
+  /// Set whether the number of substeps is adapted after every step(). When
+  /// enabled, the number of substeps is doubled (up to getMaxNumSubSteps())
+  /// when the deepest contact penetration exceeds getPenetrationTolerance(),
+  /// and halved (down to one) when it falls below a quarter of it.
+  void setAdaptiveSubSteppingEnabled(bool enabled);
+
+  /// Return true if the number of substeps is adapted after every step()
+  bool isAdaptiveSubSteppingEnabled() const;
+
+  /// Set the largest number of substeps used by adaptive sub-stepping
+  void setMaxNumSubSteps(std::size_t maxNumSubSteps);
+
+  /// Get the largest number of substeps used by adaptive sub-stepping
+  std::size_t getMaxNumSubSteps() const;
+
+  /// Set the contact penetration depth that adaptive sub-stepping tolerates
+  void setPenetrationTolerance(double tolerance);
+
+  /// Get the contact penetration depth that adaptive sub-stepping tolerates
+  double getPenetrationTolerance() const;
+
+  //--------------------------------------------------------------------------
+  // Sleeping
+  //--------------------------------------------------------------------------
+
+  /// Set whether resting Skeletons are put to sleep. When enabled, step()
+  /// puts a mobile Skeleton to sleep once it has been at rest for
+  /// getSleepTimeThreshold() seconds. A Skeleton is at rest when none of its
+  /// generalized velocities exceeds getSleepVelocityThreshold() and it has no
+  /// commands, joint forces, or external forces applied.
+  ///
+  /// Sleeping Skeletons are skipped by the dynamics, the integration, and the
+  /// collision checks against other sleeping Skeletons. A sleeping Skeleton
+  /// is woken up when it stops being at rest (for example, because a command,
+  /// force, or velocity was set), when its positions are changed, or when it
+  /// comes in contact with an awake Skeleton.
+  ///
+  /// Immobile Skeletons are put to sleep at the end of every step in which
+  /// they have no velocities. Moving one wakes it up, so that it wakes up the
+  /// sleeping Skeletons that it pushes.
+  ///
+  /// Disabling sleeping wakes up all the sleeping Skeletons.
+  void setSleepingEnabled(bool enabled);
+
+  /// Return true if resting Skeletons are put to sleep
+  bool isSleepingEnabled() const;
+
+  /// Set the largest absolute generalized velocity of a resting Skeleton
+  void setSleepVelocityThreshold(double threshold);
+
+  /// Get the largest absolute generalized velocity of a resting Skeleton
+  double getSleepVelocityThreshold() const;
+
+  /// Set the time in seconds a Skeleton should be at rest before it is put to
+  /// sleep
+  void setSleepTimeThreshold(double threshold);
+
+  /// Get the time in seconds a Skeleton should be at rest before it is put to
+  /// sleep
+  double getSleepTimeThreshold() const;
+
+  //--------------------------------------------------------------------------
+  // Determinism
+  //--------------------------------------------------------------------------
+
+  /// Set whether step() produces bit-identical trajectories across runs. When
+  /// enabled, the constraint solver creates the contact constraints in an
+  /// order that depends only on the indices of the colliding Skeletons,
+  /// BodyNodes, and ShapeNodes in this World and on the contact geometry,
+  /// rather than on the internal ordering of the collision detector or on
+  /// memory addresses. Stepping the same World from the same state with the
+  /// same commands then yields the same bits, regardless of how many other
+  /// Worlds are stepped concurrently (e.g., by a WorldBatch).
+  ///
+  /// Determinism still requires the same binary on the same platform, and the
+  /// Skeletons have to be added in the same order. It is disabled by default
+  /// because sorting the contacts adds a small cost to every step.
+  void setDeterministic(bool deterministic);
+
+  /// Return true if step() produces bit-identical trajectories across runs
+  bool isDeterministic() const;
+
+  /// Return a hash of the time and of the generalized positions and
+  /// velocities of all the Skeletons. Two Worlds with the same structure have
+  /// the same hash if and only if (barring collisions) these values are
+  /// bitwise identical, which makes it suitable for logging a compact
+  /// fingerprint of every step and checking that a replay reproduces it.
+  std::uint64_t computeStateHash() const;
+
+  //--------------------------------------------------------------------------
+  // Real-time mode
+  //--------------------------------------------------------------------------
+
+  /// Set whether step() runs without allocating memory, for hard real-time
+  /// loops. Enabling it allocates up front the memory for up to
+  /// \c maxNumContacts contacts and for constrained groups of up to
+  /// \c maxNumConstraintRows constraint rows. Exceeding these maxima drops
+  /// contacts or constraints instead of allocating memory, and is counted by
+  /// getNumRealTimeOverflows(). See ConstraintSolver::setRealTime().
+  ///
+  /// The collision detector must be a DARTCollisionDetector, which reports
+  /// its contacts into the reserved memory. The other collision detectors,
+  /// including the default FCLCollisionDetector, allocate memory when they
+  /// post-process their contacts.
+  ///
+  /// The steps that follow adding Skeletons or changing the structure of a
+  /// Skeleton may still allocate memory. Recording the states and publishing
+  /// snapshots also allocate memory, and so do the LCP solvers that don't
+  /// implement BoxedLcpSolver::reserve().
+  void setRealTime(
+      bool realTime,
+      std::size_t maxNumContacts = 1000u,
+      std::size_t maxNumConstraintRows = 3000u);
+
+  /// Return true if step() runs without allocating memory
+  bool isRealTime() const;
+
+  /// Return the number of times a maximum of the real-time mode was exceeded
+  /// since the mode was last set
+  std::size_t getNumRealTimeOverflows() const;
+
+  //--------------------------------------------------------------------------
+  // State snapshots
+  //--------------------------------------------------------------------------
+
+  /// Write the mutable simulation state of this World into \c state. Unlike
+  /// clone(), this only copies numbers: the Skeletons, their shapes, and the
+  /// collision objects are not copied. The buffers of \c state are reused, so
+  /// saving into the same State repeatedly does not allocate memory once the
+  /// buffers are large enough.
+  void saveState(State& state) const;
+
+  /// Return the mutable simulation state of this World. See saveState(State&).
+  State saveState() const;
+
+  /// Restore a state saved by saveState() in place. The structure of this
+  /// World (its Skeletons, DegreesOfFreedom, and BodyNodes) must not have
+  /// changed since the state was saved. The commands are restored as they
+  /// were saved, without clipping them to the limits of the actuators.
+  /// Returns false, leaving this World untouched, if the sizes of \c state
+  /// do not match this World.
+  bool restoreState(const State& state);
+
+  //--------------------------------------------------------------------------
+  // Published snapshots
+  //--------------------------------------------------------------------------
+
+  /// Set whether step() publishes a WorldSnapshot at its end, so that other
+  /// threads can read the state of this World with getSnapshot() while it
+  /// keeps stepping. Disabled by default.
+  void setSnapshotPublishingEnabled(bool enabled);
+
+  /// Return true if step() publishes a WorldSnapshot at its end
+  bool isSnapshotPublishingEnabled() const;
+
+  /// Publish a WorldSnapshot of the current state of this World. step() calls
+  /// this when snapshot publishing is enabled. Like step(), this must not be
+  /// called concurrently with anything that modifies this World.
+  ///
+  /// Snapshots are written into a fixed set of buffers. If readers still hold
+  /// every buffer other than the published one, nothing is published and this
+  /// returns false.
+  bool publishSnapshot();
+
+  /// Return the last published WorldSnapshot, or an empty handle if none has
+  /// been published. This can be called from any thread at any time; it never
+  /// waits for step() and never allocates memory. The returned snapshot is
+  /// not modified while the handle exists.
+  WorldSnapshotPtr getSnapshot() const;
+
   //--------------------------------------------------------------------------
   // Constraint
   //--------------------------------------------------------------------------
@@ -259,6 +506,25 @@ protected:
   /// Register when a SimpleFrame's name is changed
   void handleSimpleFrameNameChange(const dynamics::Entity* _entity);
 
+  /// Advance the Skeletons by one substep of \c timeStep seconds. If
+  /// \c detectCollision is false, collision detection is skipped and the
+  /// contacts of the last collision check are reused.
+  void integrateSubStep(double timeStep, bool detectCollision);
+
+  /// Update the number of substeps from the last collision result. Used by
+  /// adaptive sub-stepping.
+  void adaptNumSubSteps();
+
+  /// Pass the substep size to the constraint solver and the Skeletons
+  void updateSubTimeStep();
+
+  /// Size the snapshot buffers that aren't in use for the current Skeletons,
+  /// and for the maximum number of contacts in real-time mode
+  void reserveSnapshotBuffers();
+
+  /// Fill a snapshot with the current state of this World
+  void fillSnapshot(WorldSnapshot& snapshot);
+
   /// Name of this World
   std::string mName;
 
@@ -272,6 +538,9 @@ protected:
   /// TODO(MXG): Consider putting this functionality into NameManager
   std::vector<common::Connection> mNameConnectionsForSkeletons;
 
+  /// Time in seconds each Skeleton has been at rest. Indexed like mSkeletons.
+  std::vector<double> mRestTimes;
+
   /// NameManager for keeping track of Skeletons
   dart::common::NameManager<dynamics::SkeletonPtr> mNameMgrForSkeletons;
 
@@ -313,6 +582,56 @@ protected:
   ///
   Recording* mRecording;
 
+  /// Whether resting Skeletons are put to sleep
+  bool mIsSleepingEnabled;
+
+  /// Largest absolute generalized velocity of a resting Skeleton
+  double mSleepVelocityThreshold;
+
+  /// Time in seconds a Skeleton should be at rest before it is put to sleep
+  double mSleepTimeThreshold;
+
+  /// Number of substeps per step
+  std::size_t mNumSubSteps;
+
+  /// Whether the number of substeps is adapted after every step
+  bool mIsAdaptiveSubSteppingEnabled;
+
+  /// Largest number of substeps used by adaptive sub-stepping
+  std::size_t mMaxNumSubSteps;
+
+  /// Contact penetration depth that adaptive sub-stepping tolerates
+  double mPenetrationTolerance;
+
+  /// Whether step() produces bit-identical trajectories across runs
+  bool mIsDeterministic;
+
+  /// Whether step() publishes a WorldSnapshot at its end
+  bool mIsSnapshotPublishingEnabled;
+
+  /// Buffer of a published snapshot
+  struct SnapshotBuffer
+  {
+    /// The snapshot
+    WorldSnapshot mSnapshot;
+
+    /// Number of WorldSnapshotPtr handles to the snapshot
+    mutable std::atomic<int> mNumReaders{0};
+  };
+
+  /// Snapshot buffers. A buffer is only refilled while it is neither
+  /// published nor held by a reader.
+  std::array<SnapshotBuffer, 3> mSnapshotBuffers;
+
+  /// Index of the published buffer in mSnapshotBuffers, or -1 if no snapshot
+  /// has been published
+  std::atomic<int> mPublishedSnapshot;
+
+  /// Skeletons sorted by address with their indices, to find the Skeletons
+  /// of the contacts when publishing snapshots
+  std::vector<std::pair<const dynamics::Skeleton*, std::size_t>>
+      mSnapshotSkeletonIndices;
+
   //--------------------------------------------------------------------------
   // Signals
   //--------------------------------------------------------------------------
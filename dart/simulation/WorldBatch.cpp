@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/simulation/WorldBatch.hpp"
+
+#include <algorithm>
+
+#include "dart/common/Console.hpp"
+#include "dart/dynamics/DegreeOfFreedom.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/simulation/World.hpp"
+
+namespace dart {
+namespace simulation {
+
+//==============================================================================
+WorldBatch::WorldBatch(
+    const ConstWorldPtr& world, std::size_t numWorlds, std::size_t numThreads)
+  : mNumDofs(0u), mTaskGeneration(0u), mNumBusyThreads(0u), mIsStopping(false)
+{
+  if (!world)
+  {
+    dterr << "[WorldBatch::WorldBatch] Attempting to create a batch from a "
+          << "nullptr World. The batch will be empty.\n";
+    numWorlds = 0u;
+  }
+
+  mWorlds.reserve(numWorlds);
+  for (std::size_t i = 0u; i < numWorlds; ++i)
+    mWorlds.push_back(world->clone());
+
+  if (world)
+  {
+    for (std::size_t i = 0u; i < world->getNumSkeletons(); ++i)
+      mNumDofs += world->getSkeleton(i)->getNumDofs();
+  }
+
+  const int rows = static_cast<int>(mNumDofs);
+  const int cols = static_cast<int>(numWorlds);
+  mCommands = Eigen::MatrixXd::Zero(rows, cols);
+  mPositions = Eigen::MatrixXd::Zero(rows, cols);
+  mVelocities = Eigen::MatrixXd::Zero(rows, cols);
+
+  if (0u == numThreads)
+    numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  mNumThreads = std::max<std::size_t>(std::min(numThreads, numWorlds), 1u);
+
+  // With a single thread, the Worlds are stepped by the calling thread
+  if (mNumThreads > 1u)
+  {
+    mThreads.reserve(mNumThreads);
+    for (std::size_t i = 0u; i < mNumThreads; ++i)
+      mThreads.emplace_back(&WorldBatch::runWorker, this, i);
+  }
+
+  updateStates();
+}
+
+//==============================================================================
+WorldBatch::~WorldBatch()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIsStopping = true;
+  }
+  mTaskCondition.notify_all();
+
+  for (auto& thread : mThreads)
+    thread.join();
+}
+
+//==============================================================================
+std::size_t WorldBatch::getNumWorlds() const
+{
+  return mWorlds.size();
+}
+
+//==============================================================================
+WorldPtr WorldBatch::getWorld(std::size_t index) const
+{
+  if (index >= mWorlds.size())
+  {
+    dtwarn << "[WorldBatch::getWorld] Index (" << index << ") is out of range "
+           << "(" << mWorlds.size() << "). Returning nullptr.\n";
+    return nullptr;
+  }
+
+  return mWorlds[index];
+}
+
+//==============================================================================
+std::size_t WorldBatch::getNumThreads() const
+{
+  return mNumThreads;
+}
+
+//==============================================================================
+std::size_t WorldBatch::getNumDofs() const
+{
+  return mNumDofs;
+}
+
+//==============================================================================
+void WorldBatch::step(std::size_t numSteps, bool resetCommand)
+{
+  runInParallel([&](std::size_t index) {
+    World* world = mWorlds[index].get();
+
+    for (std::size_t i = 0u; i < numSteps; ++i)
+    {
+      int dofIndex = 0;
+      for (std::size_t j = 0u; j < world->getNumSkeletons(); ++j)
+      {
+        dynamics::Skeleton* skel = world->getSkeleton(j).get();
+        for (std::size_t k = 0u; k < skel->getNumDofs(); ++k)
+          skel->getDof(k)->setCommand(mCommands(dofIndex++, index));
+      }
+
+      world->step(resetCommand);
+    }
+
+    updateState(index);
+  });
+}
+
+//==============================================================================
+Eigen::MatrixXd& WorldBatch::getCommands()
+{
+  return mCommands;
+}
+
+//==============================================================================
+const Eigen::MatrixXd& WorldBatch::getCommands() const
+{
+  return mCommands;
+}
+
+//==============================================================================
+const Eigen::MatrixXd& WorldBatch::getPositions() const
+{
+  return mPositions;
+}
+
+//==============================================================================
+const Eigen::MatrixXd& WorldBatch::getVelocities() const
+{
+  return mVelocities;
+}
+
+//==============================================================================
+void WorldBatch::updateStates()
+{
+  runInParallel([&](std::size_t index) { updateState(index); });
+}
+
+//==============================================================================
+void WorldBatch::runInParallel(const std::function<void(std::size_t)>& task)
+{
+  if (mThreads.empty())
+  {
+    for (std::size_t i = 0u; i < mWorlds.size(); ++i)
+      task(i);
+
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mMutex);
+  mTask = task;
+  mNumBusyThreads = mThreads.size();
+  ++mTaskGeneration;
+  mTaskCondition.notify_all();
+
+  mDoneCondition.wait(lock, [this]() { return 0u == mNumBusyThreads; });
+  mTask = nullptr;
+}
+
+//==============================================================================
+void WorldBatch::runWorker(std::size_t threadIndex)
+{
+  std::size_t lastGeneration = 0u;
+
+  while (true)
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mTaskCondition.wait(lock, [&]() {
+      return mIsStopping || mTaskGeneration != lastGeneration;
+    });
+
+    if (mIsStopping)
+      return;
+
+    lastGeneration = mTaskGeneration;
+    lock.unlock();
+
+    // The Worlds are interleaved over the threads, so each World is always
+    // stepped by the same thread and stays in that thread's cache
+    for (std::size_t i = threadIndex; i < mWorlds.size(); i += mNumThreads)
+      mTask(i);
+
+    lock.lock();
+    if (0u == --mNumBusyThreads)
+      mDoneCondition.notify_one();
+  }
+}
+
+//==============================================================================
+void WorldBatch::updateState(std::size_t index)
+{
+  const World* world = mWorlds[index].get();
+
+  int dofIndex = 0;
+  for (std::size_t i = 0u; i < world->getNumSkeletons(); ++i)
+  {
+    const dynamics::Skeleton* skel = world->getSkeleton(i).get();
+    for (std::size_t j = 0u; j < skel->getNumDofs(); ++j)
+    {
+      const dynamics::DegreeOfFreedom* dof = skel->getDof(j);
+      mPositions(dofIndex, index) = dof->getPosition();
+      mVelocities(dofIndex, index) = dof->getVelocity();
+      ++dofIndex;
+    }
+  }
+}
+
+} // namespace simulation
+} // namespace dart
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_SIMULATION_WORLDBATCH_HPP_
+#define DART_SIMULATION_WORLDBATCH_HPP_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/simulation/SmartPointer.hpp"
+
+namespace dart {
+namespace simulation {
+
+/// WorldBatch owns a number of structurally identical Worlds and steps all of
+/// them across a pool of threads with a single call. The generalized
+/// positions and velocities of the Worlds, and the commands applied to them,
+/// are stored in column-major matrices with one column per World, so they
+/// can be exchanged with learning frameworks as contiguous arrays.
+///
+/// Each World is only ever touched by one thread at a time, but the Worlds
+/// share the Shapes of the prototype World they were cloned from, so Shapes
+/// must not be modified while step() is running.
+class WorldBatch
+{
+public:
+  /// Constructor
+  /// \param[in] world Prototype World. It is cloned \c numWorlds times, and
+  /// is not stepped by this WorldBatch.
+  /// \param[in] numWorlds Number of Worlds in this batch.
+  /// \param[in] numThreads Number of threads used by step(). Zero means the
+  /// number of hardware threads. It is never larger than \c numWorlds.
+  WorldBatch(
+      const ConstWorldPtr& world,
+      std::size_t numWorlds,
+      std::size_t numThreads = 0u);
+
+  /// Destructor
+  ~WorldBatch();
+
+  WorldBatch(const WorldBatch&) = delete;
+  WorldBatch& operator=(const WorldBatch&) = delete;
+
+  /// Get the number of Worlds in this batch
+  std::size_t getNumWorlds() const;
+
+  /// Get the indexed World
+  WorldPtr getWorld(std::size_t index) const;
+
+  /// Get the number of threads used by step()
+  std::size_t getNumThreads() const;
+
+  /// Get the number of generalized coordinates of each World
+  std::size_t getNumDofs() const;
+
+  /// Step all the Worlds \c numSteps times. Before every step, the commands
+  /// in getCommands() are applied to the Worlds. After the last step, the
+  /// state matrices are updated.
+  /// \param[in] numSteps Number of steps of each World.
+  /// \param[in] resetCommand Passed on to World::step().
+  void step(std::size_t numSteps = 1u, bool resetCommand = true);
+
+  /// Get the commands applied to the Worlds before every step. The matrix is
+  /// getNumDofs() x getNumWorlds(), and its i-th column holds the commands of
+  /// the i-th World in the order of its Skeletons and their DegreesOfFreedom.
+  Eigen::MatrixXd& getCommands();
+
+  /// Get the commands applied to the Worlds before every step
+  const Eigen::MatrixXd& getCommands() const;
+
+  /// Get the generalized positions of all the Worlds, laid out like
+  /// getCommands()
+  const Eigen::MatrixXd& getPositions() const;
+
+  /// Get the generalized velocities of all the Worlds, laid out like
+  /// getCommands()
+  const Eigen::MatrixXd& getVelocities() const;
+
+  /// Copy the positions and velocities of all the Worlds into the state
+  /// matrices. This is done by step(); call this function after changing the
+  /// Worlds directly, e.g., by World::restoreState().
+  void updateStates();
+
+protected:
+  /// Run \c task for the index of every World, distributing the Worlds over
+  /// the threads
+  void runInParallel(const std::function<void(std::size_t)>& task);
+
+  /// Loop of the worker thread with index \c threadIndex
+  void runWorker(std::size_t threadIndex);
+
+  /// Copy the state of the indexed World into the state matrices
+  void updateState(std::size_t index);
+
+  /// Worlds of this batch
+  std::vector<WorldPtr> mWorlds;
+
+  /// Number of generalized coordinates of each World
+  std::size_t mNumDofs;
+
+  /// Commands applied before every step, one column per World
+  Eigen::MatrixXd mCommands;
+
+  /// Generalized positions, one column per World
+  Eigen::MatrixXd mPositions;
+
+  /// Generalized velocities, one column per World
+  Eigen::MatrixXd mVelocities;
+
+  /// Worker threads. The thread that calls step() only waits for them.
+  std::vector<std::thread> mThreads;
+
+  /// Number of threads that share the Worlds
+  std::size_t mNumThreads;
+
+  /// Protects the members below
+  std::mutex mMutex;
+
+  /// Signals the workers that a new task is available or that they should
+  /// stop
+  std::condition_variable mTaskCondition;
+
+  /// Signals the calling thread that all the workers have finished the task
+  std::condition_variable mDoneCondition;
+
+  /// Task that the workers run for each of their Worlds
+  std::function<void(std::size_t)> mTask;
+
+  /// Incremented whenever a new task is posted
+  std::size_t mTaskGeneration;
+
+  /// Number of workers that have not finished the current task
+  std::size_t mNumBusyThreads;
+
+  /// Whether the workers should exit
+  bool mIsStopping;
+};
+
+} // namespace simulation
+} // namespace dart
+
+#endif // DART_SIMULATION_WORLDBATCH_HPP_
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/simulation/WorldSnapshot.hpp"
+
+#include <cassert>
+#include <utility>
+
+namespace dart {
+namespace simulation {
+
+//==============================================================================
+WorldSnapshotPtr::WorldSnapshotPtr(const WorldSnapshotPtr& other)
+  : mSnapshot(other.mSnapshot), mNumReaders(other.mNumReaders)
+{
+  if (mNumReaders)
+    ++(*mNumReaders);
+}
+
+//==============================================================================
+WorldSnapshotPtr::WorldSnapshotPtr(WorldSnapshotPtr&& other)
+  : mSnapshot(other.mSnapshot), mNumReaders(other.mNumReaders)
+{
+  other.mSnapshot = nullptr;
+  other.mNumReaders = nullptr;
+}
+
+//==============================================================================
+WorldSnapshotPtr::~WorldSnapshotPtr()
+{
+  reset();
+}
+
+//==============================================================================
+WorldSnapshotPtr& WorldSnapshotPtr::operator=(const WorldSnapshotPtr& other)
+{
+  WorldSnapshotPtr copy(other);
+  *this = std::move(copy);
+
+  return *this;
+}
+
+//==============================================================================
+WorldSnapshotPtr& WorldSnapshotPtr::operator=(WorldSnapshotPtr&& other)
+{
+  if (this == &other)
+    return *this;
+
+  reset();
+  std::swap(mSnapshot, other.mSnapshot);
+  std::swap(mNumReaders, other.mNumReaders);
+
+  return *this;
+}
+
+//==============================================================================
+const WorldSnapshot* WorldSnapshotPtr::get() const
+{
+  return mSnapshot;
+}
+
+//==============================================================================
+const WorldSnapshot& WorldSnapshotPtr::operator*() const
+{
+  assert(mSnapshot);
+
+  return *mSnapshot;
+}
+
+//==============================================================================
+const WorldSnapshot* WorldSnapshotPtr::operator->() const
+{
+  assert(mSnapshot);
+
+  return mSnapshot;
+}
+
+//==============================================================================
+WorldSnapshotPtr::operator bool() const
+{
+  return mSnapshot != nullptr;
+}
+
+//==============================================================================
+void WorldSnapshotPtr::reset()
+{
+  if (!mNumReaders)
+    return;
+
+  // Make sure that the reads of this reader happen before the World refills
+  // the buffer
+  mNumReaders->fetch_sub(1, std::memory_order_release);
+  mSnapshot = nullptr;
+  mNumReaders = nullptr;
+}
+
+//==============================================================================
+WorldSnapshotPtr::WorldSnapshotPtr(
+    const WorldSnapshot* snapshot, std::atomic<int>* numReaders)
+  : mSnapshot(snapshot), mNumReaders(numReaders)
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool operator==(const WorldSnapshotPtr& lhs, const WorldSnapshotPtr& rhs)
+{
+  return lhs.get() == rhs.get();
+}
+
+//==============================================================================
+bool operator!=(const WorldSnapshotPtr& lhs, const WorldSnapshotPtr& rhs)
+{
+  return lhs.get() != rhs.get();
+}
+
+//==============================================================================
+bool operator==(const WorldSnapshotPtr& ptr, std::nullptr_t)
+{
+  return ptr.get() == nullptr;
+}
+
+//==============================================================================
+bool operator!=(const WorldSnapshotPtr& ptr, std::nullptr_t)
+{
+  return ptr.get() != nullptr;
+}
+
+} // namespace simulation
+} // namespace dart
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_SIMULATION_WORLDSNAPSHOT_HPP_
+#define DART_SIMULATION_WORLDSNAPSHOT_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/common/Memory.hpp"
+
+namespace dart {
+namespace simulation {
+
+/// WorldSnapshot is an immutable copy of the state of a World at the end of a
+/// step, published by World so that other threads (visualization, logging,
+/// bridges to other middleware) can read the state without locking the World
+/// while it steps. See World::getSnapshot().
+struct WorldSnapshot
+{
+  /// State of a Skeleton
+  struct SkeletonState
+  {
+    /// Name of the Skeleton
+    std::string mName;
+
+    /// Generalized positions
+    Eigen::VectorXd mPositions;
+
+    /// Generalized velocities
+    Eigen::VectorXd mVelocities;
+
+    /// World transforms of the BodyNodes, in the order of the BodyNodes
+    common::aligned_vector<Eigen::Isometry3d> mBodyTransforms;
+
+    /// Whether the Skeleton is sleeping
+    bool mIsSleeping;
+  };
+
+  /// Contact found by the last collision check of the World
+  struct ContactState
+  {
+    /// Index of the first Skeleton in WorldSnapshot::mSkeletons
+    std::size_t mSkeleton1;
+
+    /// Index of the first BodyNode in its Skeleton
+    std::size_t mBodyNode1;
+
+    /// Index of the second Skeleton in WorldSnapshot::mSkeletons
+    std::size_t mSkeleton2;
+
+    /// Index of the second BodyNode in its Skeleton
+    std::size_t mBodyNode2;
+
+    /// Contact point in the world frame
+    Eigen::Vector3d mPoint;
+
+    /// Contact normal in the world frame
+    Eigen::Vector3d mNormal;
+
+    /// Contact force in the world frame
+    Eigen::Vector3d mForce;
+
+    /// Penetration depth
+    double mPenetrationDepth;
+  };
+
+  /// Simulation time
+  double mTime;
+
+  /// Simulation frame number
+  int mFrame;
+
+  /// States of the Skeletons, in the order of the Skeletons in the World
+  std::vector<SkeletonState> mSkeletons;
+
+  /// Contacts of the last collision check
+  std::vector<ContactState> mContacts;
+};
+
+class World;
+
+/// WorldSnapshotPtr is a handle to a WorldSnapshot published by a World,
+/// returned by World::getSnapshot(). The World does not overwrite a snapshot
+/// while any handle to it exists. Handles are cheap to copy: a copy only
+/// increments the number of readers of the snapshot.
+class WorldSnapshotPtr
+{
+public:
+  /// Default constructor. The handle refers to no snapshot.
+  WorldSnapshotPtr() = default;
+
+  /// Copy constructor
+  WorldSnapshotPtr(const WorldSnapshotPtr& other);
+
+  /// Move constructor
+  WorldSnapshotPtr(WorldSnapshotPtr&& other);
+
+  /// Destructor. Releases the snapshot.
+  ~WorldSnapshotPtr();
+
+  /// Copy assignment operator
+  WorldSnapshotPtr& operator=(const WorldSnapshotPtr& other);
+
+  /// Move assignment operator
+  WorldSnapshotPtr& operator=(WorldSnapshotPtr&& other);
+
+  /// Return the snapshot, or nullptr if this handle refers to no snapshot
+  const WorldSnapshot* get() const;
+
+  /// Return the snapshot
+  const WorldSnapshot& operator*() const;
+
+  /// Return the snapshot
+  const WorldSnapshot* operator->() const;
+
+  /// Return true if this handle refers to a snapshot
+  explicit operator bool() const;
+
+  /// Release the snapshot, so that this handle refers to no snapshot
+  void reset();
+
+private:
+  friend class World;
+
+  /// Constructor used by World. Takes over a reader that World::getSnapshot()
+  /// already added to \c numReaders.
+  WorldSnapshotPtr(
+      const WorldSnapshot* snapshot, std::atomic<int>* numReaders);
+
+  /// The snapshot
+  const WorldSnapshot* mSnapshot = nullptr;
+
+  /// Number of readers of the buffer of the snapshot
+  std::atomic<int>* mNumReaders = nullptr;
+};
+
+/// Return true if both handles refer to the same snapshot
+bool operator==(const WorldSnapshotPtr& lhs, const WorldSnapshotPtr& rhs);
+
+/// Return true if the handles refer to different snapshots
+bool operator!=(const WorldSnapshotPtr& lhs, const WorldSnapshotPtr& rhs);
+
+/// Return true if the handle refers to no snapshot
+bool operator==(const WorldSnapshotPtr& ptr, std::nullptr_t);
+
+/// Return true if the handle refers to a snapshot
+bool operator!=(const WorldSnapshotPtr& ptr, std::nullptr_t);
+
+} // namespace simulation
+} // namespace dart
+
+#endif // DART_SIMULATION_WORLDSNAPSHOT_HPP_
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/simulation/detail/RecordingFormat.hpp"
+
+#include <cstring>
+
+namespace dart {
+namespace simulation {
+namespace detail {
+
+namespace {
+
+const char HEADER_MAGIC[8] = {'D', 'A', 'R', 'T', 'R', 'E', 'C', '\0'};
+const char FOOTER_MAGIC[8] = {'D', 'A', 'R', 'T', 'I', 'D', 'X', '\0'};
+const std::uint32_t VERSION = 1u;
+
+// Number of values (uint32), key frame flag (uint8), and payload size (uint32)
+const std::size_t FRAME_HEADER_SIZE = 9u;
+
+//==============================================================================
+template <typename T>
+void append(std::vector<char>& buffer, const T& value)
+{
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+//==============================================================================
+template <typename T>
+void write(std::ostream& stream, const T& value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//==============================================================================
+template <typename T>
+T read(const char* data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+//==============================================================================
+std::uint64_t toBits(double value)
+{
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+//==============================================================================
+double fromBits(std::uint64_t bits)
+{
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+} // namespace
+
+//==============================================================================
+void writeRecordingHeader(std::ostream& stream, const RecordingHeader& header)
+{
+  stream.write(HEADER_MAGIC, sizeof(HEADER_MAGIC));
+  write(stream, VERSION);
+  write(stream, header.mFlags);
+  write(stream, header.mFramesPerChunk);
+  write(stream, static_cast<std::uint32_t>(header.mNumDofs.size()));
+  for (const int numDofs : header.mNumDofs)
+    write(stream, static_cast<std::int32_t>(numDofs));
+}
+
+//==============================================================================
+std::size_t readRecordingHeader(
+    const char* data, std::size_t size, RecordingHeader& header)
+{
+  const std::size_t fixedSize
+      = sizeof(HEADER_MAGIC) + 4u * sizeof(std::uint32_t);
+  if (size < fixedSize
+      || std::memcmp(data, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0)
+    return 0u;
+
+  std::size_t offset = sizeof(HEADER_MAGIC);
+  const auto version = read<std::uint32_t>(data + offset);
+  offset += sizeof(std::uint32_t);
+  if (version != VERSION)
+    return 0u;
+
+  header.mFlags = read<std::uint32_t>(data + offset);
+  offset += sizeof(std::uint32_t);
+  header.mFramesPerChunk = read<std::uint32_t>(data + offset);
+  offset += sizeof(std::uint32_t);
+  const auto numSkeletons = read<std::uint32_t>(data + offset);
+  offset += sizeof(std::uint32_t);
+
+  if (0u == header.mFramesPerChunk
+      || size < offset + numSkeletons * sizeof(std::int32_t))
+    return 0u;
+
+  header.mNumDofs.resize(numSkeletons);
+  for (auto& numDofs : header.mNumDofs)
+  {
+    numDofs = read<std::int32_t>(data + offset);
+    offset += sizeof(std::int32_t);
+  }
+
+  return offset;
+}
+
+//==============================================================================
+void encodeRecordingFrame(
+    const Eigen::VectorXd& state,
+    const Eigen::VectorXd* previous,
+    bool compress,
+    std::vector<char>& record)
+{
+  const auto numValues = static_cast<std::uint32_t>(state.size());
+  const auto numPrevious = previous ? static_cast<int>(previous->size()) : 0;
+
+  record.clear();
+  append(record, numValues);
+  append(record, static_cast<std::uint8_t>(previous ? 0u : 1u));
+  append(record, std::uint32_t(0u)); // Payload size, filled in below
+
+  for (int i = 0; i < state.size(); ++i)
+  {
+    std::uint64_t bits = toBits(state[i]);
+    if (i < numPrevious)
+      bits ^= toBits((*previous)[i]);
+
+    if (!compress)
+    {
+      append(record, bits);
+      continue;
+    }
+
+    // Zero bytes are written as a zero followed by the length of the run
+    const char* bytes = reinterpret_cast<const char*>(&bits);
+    for (std::size_t j = 0u; j < sizeof(bits); ++j)
+    {
+      if (bytes[j] != 0)
+      {
+        record.push_back(bytes[j]);
+      }
+      else if (
+          record.size() >= FRAME_HEADER_SIZE + 2u
+          && record[record.size() - 2] == 0
+          && static_cast<unsigned char>(record.back()) < 255u)
+      {
+        // Literal bytes are never zero and run lengths are never zero, so a
+        // trailing zero is always the start of the current run
+        record.back() = static_cast<char>(
+            static_cast<unsigned char>(record.back()) + 1u);
+      }
+      else
+      {
+        record.push_back(0);
+        record.push_back(1);
+      }
+    }
+  }
+
+  const auto payloadSize
+      = static_cast<std::uint32_t>(record.size() - FRAME_HEADER_SIZE);
+  std::memcpy(
+      record.data() + FRAME_HEADER_SIZE - sizeof(payloadSize),
+      &payloadSize,
+      sizeof(payloadSize));
+}
+
+//==============================================================================
+std::size_t getRecordingFrameSize(const char* data, std::size_t size)
+{
+  if (size < FRAME_HEADER_SIZE)
+    return 0u;
+
+  const auto payloadSize = read<std::uint32_t>(data + 5u);
+  if (size < FRAME_HEADER_SIZE + payloadSize)
+    return 0u;
+
+  return FRAME_HEADER_SIZE + payloadSize;
+}
+
+//==============================================================================
+bool decodeRecordingFrame(
+    const char* data,
+    std::size_t size,
+    const Eigen::VectorXd& previous,
+    bool compressed,
+    Eigen::VectorXd& state,
+    std::vector<char>& buffer)
+{
+  const std::size_t recordSize = getRecordingFrameSize(data, size);
+  if (0u == recordSize)
+    return false;
+
+  const auto numValues = read<std::uint32_t>(data);
+  const bool isKeyFrame = read<std::uint8_t>(data + 4u) != 0u;
+  const char* payload = data + FRAME_HEADER_SIZE;
+  const std::size_t payloadSize = recordSize - FRAME_HEADER_SIZE;
+  const std::size_t numBytes = numValues * sizeof(std::uint64_t);
+
+  const char* bytes = payload;
+  if (compressed)
+  {
+    buffer.clear();
+    buffer.reserve(numBytes);
+    for (std::size_t i = 0u; i < payloadSize; ++i)
+    {
+      if (payload[i] != 0)
+      {
+        buffer.push_back(payload[i]);
+        continue;
+      }
+
+      if (++i == payloadSize)
+        return false;
+
+      buffer.insert(
+          buffer.end(), static_cast<unsigned char>(payload[i]), char(0));
+    }
+
+    if (buffer.size() != numBytes)
+      return false;
+
+    bytes = buffer.data();
+  }
+  else if (payloadSize != numBytes)
+  {
+    return false;
+  }
+
+  const int numPrevious = isKeyFrame ? 0 : static_cast<int>(previous.size());
+  Eigen::VectorXd decoded(static_cast<int>(numValues));
+  for (int i = 0; i < decoded.size(); ++i)
+  {
+    std::uint64_t bits = read<std::uint64_t>(bytes + i * sizeof(bits));
+    if (i < numPrevious)
+      bits ^= toBits(previous[i]);
+
+    decoded[i] = fromBits(bits);
+  }
+
+  state.swap(decoded);
+
+  return true;
+}
+
+//==============================================================================
+void writeRecordingFooter(
+    std::ostream& stream, const std::vector<std::uint64_t>& frameOffsets)
+{
+  for (const auto offset : frameOffsets)
+    write(stream, offset);
+
+  write(stream, static_cast<std::uint64_t>(frameOffsets.size()));
+  stream.write(FOOTER_MAGIC, sizeof(FOOTER_MAGIC));
+}
+
+//==============================================================================
+bool readRecordingFooter(
+    const char* data,
+    std::size_t size,
+    std::size_t headerSize,
+    std::vector<std::uint64_t>& frameOffsets)
+{
+  const std::size_t tailSize = sizeof(std::uint64_t) + sizeof(FOOTER_MAGIC);
+  if (size < headerSize + tailSize)
+    return false;
+
+  const char* tail = data + size - tailSize;
+  if (std::memcmp(
+          tail + sizeof(std::uint64_t), FOOTER_MAGIC, sizeof(FOOTER_MAGIC))
+      != 0)
+    return false;
+
+  const auto numFrames = read<std::uint64_t>(tail);
+  if (numFrames > (size - headerSize - tailSize) / sizeof(std::uint64_t))
+    return false;
+
+  const char* index = tail - numFrames * sizeof(std::uint64_t);
+  frameOffsets.resize(numFrames);
+  for (std::size_t i = 0u; i < numFrames; ++i)
+  {
+    frameOffsets[i] = read<std::uint64_t>(index + i * sizeof(std::uint64_t));
+    if (frameOffsets[i] < headerSize
+        || frameOffsets[i] >= static_cast<std::size_t>(index - data))
+      return false;
+  }
+
+  return true;
+}
+
+} // namespace detail
+} // namespace simulation
+} // namespace dart
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * This code incorporates portions of Open Dynamics Engine
+ *     (Copyright (c) 2001-2004, Russell L. Smith. All rights
+ *     reserved.) and portions of FCL (Copyright (c) 2011, Willow
+ *     Garage, Inc. All rights reserved.), which were released under
+ *     the same BSD license as below
+ *
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_SIMULATION_DETAIL_RECORDINGFORMAT_HPP_
+#define DART_SIMULATION_DETAIL_RECORDINGFORMAT_HPP_
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace dart {
+namespace simulation {
+namespace detail {
+
+// Binary layout of a recording file. All integers and doubles are stored in
+// the native byte order.
+//
+//   Header: "DARTREC" magic (8 bytes), version (uint32), flags (uint32),
+//           frames per chunk (uint32), number of Skeletons (uint32), and the
+//           number of DOFs of each Skeleton (int32 each)
+//   Frames: number of values (uint32), key frame flag (uint8), payload size
+//           (uint32), and the payload
+//   Footer: offset of each frame (uint64 each), number of frames (uint64),
+//           and "DARTIDX" magic (8 bytes)
+//
+// The first frame of every chunk is a key frame that stores its values as is.
+// The other frames store the bitwise XOR of their values with the values of
+// the previous frame, so values that don't change are encoded as zeros. When
+// the file is compressed, the payloads are run-length encoded runs of zero
+// bytes.
+
+/// Flags of a recording file
+enum RecordingFlag : std::uint32_t
+{
+  RECORDING_COMPRESSED = 1u << 0
+};
+
+/// Header of a recording file
+struct RecordingHeader
+{
+  /// Combination of RecordingFlag values
+  std::uint32_t mFlags;
+
+  /// Number of frames between two key frames
+  std::uint32_t mFramesPerChunk;
+
+  /// Number of DOFs of each Skeleton
+  std::vector<int> mNumDofs;
+};
+
+/// Write the header of a recording file
+void writeRecordingHeader(std::ostream& stream, const RecordingHeader& header);
+
+/// Parse the header at the beginning of \c data. Returns the size of the
+/// header, or zero if \c data doesn't start with a valid header.
+std::size_t readRecordingHeader(
+    const char* data, std::size_t size, RecordingHeader& header);
+
+/// Encode \c state as a frame record. If \c previous is nullptr, the frame is
+/// a key frame.
+void encodeRecordingFrame(
+    const Eigen::VectorXd& state,
+    const Eigen::VectorXd* previous,
+    bool compress,
+    std::vector<char>& record);
+
+/// Return the size of the frame record at the beginning of \c data, or zero if
+/// \c data doesn't hold a complete record.
+std::size_t getRecordingFrameSize(const char* data, std::size_t size);
+
+/// Decode the frame record at the beginning of \c data into \c state. Delta
+/// frames are applied on top of \c previous, which is ignored for key frames.
+/// \c buffer is a scratch buffer. Returns false if the record is invalid.
+bool decodeRecordingFrame(
+    const char* data,
+    std::size_t size,
+    const Eigen::VectorXd& previous,
+    bool compressed,
+    Eigen::VectorXd& state,
+    std::vector<char>& buffer);
+
+/// Write the frame index at the end of a recording file
+void writeRecordingFooter(
+    std::ostream& stream, const std::vector<std::uint64_t>& frameOffsets);
+
+/// Read the frame index at the end of \c data. Returns false if there is no
+/// valid index, e.g., because the file was not closed properly.
+bool readRecordingFooter(
+    const char* data,
+    std::size_t size,
+    std::size_t headerSize,
+    std::vector<std::uint64_t>& frameOffsets);
+
+} // namespace detail
+} // namespace simulation
+} // namespace dart
+
+#endif // DART_SIMULATION_DETAIL_RECORDINGFORMAT_HPP_
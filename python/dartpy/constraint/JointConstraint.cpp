@@ -41,6 +41,7 @@ namespace python {
 
 void JointConstraint(py::module& m)
 {
+  DART_SUPPRESS_DEPRECATED_BEGIN
   ::py::class_<
       dart::constraint::JointConstraint,
       dart::constraint::ConstraintBase,
@@ -90,6 +91,7 @@ void JointConstraint(py::module& m)
       .def_static("getConstraintForceMixing", +[]() -> double {
         return dart::constraint::JointConstraint::getConstraintForceMixing();
       });
+  DART_SUPPRESS_DEPRECATED_END
 
   ::py::class_<
       dart::constraint::BallJointConstraint,
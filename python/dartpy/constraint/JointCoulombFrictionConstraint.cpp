@@ -40,6 +40,7 @@ namespace python {
 
 void JointCoulombFrictionConstraint(py::module& m)
 {
+  DART_SUPPRESS_DEPRECATED_BEGIN
   ::py::class_<
       dart::constraint::JointCoulombFrictionConstraint,
       dart::constraint::ConstraintBase,
@@ -57,6 +58,7 @@ void JointCoulombFrictionConstraint(py::module& m)
         return dart::constraint::JointCoulombFrictionConstraint::
             getConstraintForceMixing();
       });
+  DART_SUPPRESS_DEPRECATED_END
 }
 
 } // namespace python
@@ -40,6 +40,7 @@ namespace python {
 
 void JointLimitConstraint(py::module& m)
 {
+  DART_SUPPRESS_DEPRECATED_BEGIN
   ::py::class_<
       dart::constraint::JointLimitConstraint,
       dart::constraint::ConstraintBase,
@@ -95,6 +96,7 @@ void JointLimitConstraint(py::module& m)
         return dart::constraint::JointLimitConstraint::
             getConstraintForceMixing();
       });
+  DART_SUPPRESS_DEPRECATED_END
 }
 
 } // namespace python
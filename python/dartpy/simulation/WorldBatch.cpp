@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dart/dart.hpp>
+#include <dart/simulation/WorldBatch.hpp>
+
+#include <pybind11/eigen.h>
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+namespace dart {
+namespace python {
+
+void WorldBatch(py::module& m)
+{
+  ::py::class_<
+      dart::simulation::WorldBatch,
+      std::shared_ptr<dart::simulation::WorldBatch>>(m, "WorldBatch")
+      .def(
+          ::py::init<const dart::simulation::ConstWorldPtr&, std::size_t>(),
+          ::py::arg("world"),
+          ::py::arg("numWorlds"))
+      .def(
+          ::py::init<
+              const dart::simulation::ConstWorldPtr&,
+              std::size_t,
+              std::size_t>(),
+          ::py::arg("world"),
+          ::py::arg("numWorlds"),
+          ::py::arg("numThreads"))
+      .def(
+          "getNumWorlds",
+          +[](const dart::simulation::WorldBatch* self) -> std::size_t {
+            return self->getNumWorlds();
+          })
+      .def(
+          "getWorld",
+          +[](const dart::simulation::WorldBatch* self,
+              std::size_t index) -> dart::simulation::WorldPtr {
+            return self->getWorld(index);
+          },
+          ::py::arg("index"))
+      .def(
+          "getNumThreads",
+          +[](const dart::simulation::WorldBatch* self) -> std::size_t {
+            return self->getNumThreads();
+          })
+      .def(
+          "getNumDofs",
+          +[](const dart::simulation::WorldBatch* self) -> std::size_t {
+            return self->getNumDofs();
+          })
+      .def(
+          "step",
+          +[](dart::simulation::WorldBatch* self,
+              std::size_t numSteps,
+              bool resetCommand) -> void {
+            return self->step(numSteps, resetCommand);
+          },
+          ::py::arg("numSteps") = 1u,
+          ::py::arg("resetCommand") = true,
+          ::py::call_guard<::py::gil_scoped_release>())
+      .def(
+          "getCommands",
+          +[](dart::simulation::WorldBatch* self) -> Eigen::MatrixXd& {
+            return self->getCommands();
+          },
+          ::py::return_value_policy::reference_internal)
+      .def(
+          "getPositions",
+          +[](const dart::simulation::WorldBatch* self)
+              -> const Eigen::MatrixXd& { return self->getPositions(); },
+          ::py::return_value_policy::reference_internal)
+      .def(
+          "getVelocities",
+          +[](const dart::simulation::WorldBatch* self)
+              -> const Eigen::MatrixXd& { return self->getVelocities(); },
+          ::py::return_value_policy::reference_internal)
+      .def(
+          "updateStates",
+          +[](dart::simulation::WorldBatch* self) -> void {
+            return self->updateStates();
+          },
+          ::py::call_guard<::py::gil_scoped_release>());
+}
+
+} // namespace python
+} // namespace dart
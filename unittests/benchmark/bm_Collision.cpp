@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "dart/collision/collision.hpp"
+#include "dart/collision/dart/dart.hpp"
+#include "dart/collision/fcl/fcl.hpp"
+#include "dart/config.hpp"
+#include "dart/dynamics/dynamics.hpp"
+#if HAVE_BULLET
+#  include "dart/collision/bullet/bullet.hpp"
+#endif
+#if HAVE_ODE
+#  include "dart/collision/ode/ode.hpp"
+#endif
+
+using namespace dart;
+
+namespace {
+
+enum DetectorType
+{
+  DETECTOR_DART = 0,
+  DETECTOR_FCL_PRIMITIVE,
+  DETECTOR_FCL_MESH,
+  DETECTOR_BULLET,
+  DETECTOR_ODE
+};
+
+enum SceneType
+{
+  SCENE_SPHERES = 0,
+  SCENE_BOXES
+};
+
+//==============================================================================
+std::shared_ptr<collision::CollisionDetector> createDetector(int type)
+{
+  switch (type)
+  {
+    case DETECTOR_DART:
+      return collision::DARTCollisionDetector::create();
+    case DETECTOR_FCL_PRIMITIVE:
+    {
+      auto detector = collision::FCLCollisionDetector::create();
+      detector->setPrimitiveShapeType(
+          collision::FCLCollisionDetector::PRIMITIVE);
+      return detector;
+    }
+    case DETECTOR_FCL_MESH:
+    {
+      auto detector = collision::FCLCollisionDetector::create();
+      detector->setPrimitiveShapeType(collision::FCLCollisionDetector::MESH);
+      return detector;
+    }
+#if HAVE_BULLET
+    case DETECTOR_BULLET:
+      return collision::BulletCollisionDetector::create();
+#endif
+#if HAVE_ODE
+    case DETECTOR_ODE:
+      return collision::OdeCollisionDetector::create();
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+//==============================================================================
+const char* getDetectorName(int type)
+{
+  switch (type)
+  {
+    case DETECTOR_DART:
+      return "dart";
+    case DETECTOR_FCL_PRIMITIVE:
+      return "fcl-primitive";
+    case DETECTOR_FCL_MESH:
+      return "fcl-mesh";
+    case DETECTOR_BULLET:
+      return "bullet";
+    case DETECTOR_ODE:
+      return "ode";
+    default:
+      return "unknown";
+  }
+}
+
+//==============================================================================
+/// Create a cubic grid of numObjects shapes whose neighbors slightly overlap,
+/// so that every shape is in contact with up to six others
+std::vector<dynamics::SimpleFramePtr> createScene(
+    int sceneType, std::size_t numObjects)
+{
+  const double size = 0.1;
+  const double spacing = 0.95 * size;
+  const auto numPerSide = static_cast<std::size_t>(
+      std::ceil(std::cbrt(static_cast<double>(numObjects))));
+
+  std::vector<dynamics::SimpleFramePtr> frames;
+  for (std::size_t i = 0u; i < numObjects; ++i)
+  {
+    Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+    tf.translation() << spacing * (i % numPerSide),
+        spacing * ((i / numPerSide) % numPerSide),
+        spacing * (i / (numPerSide * numPerSide));
+
+    auto frame = std::make_shared<dynamics::SimpleFrame>(
+        dynamics::Frame::World(), "object" + std::to_string(i), tf);
+    if (SCENE_SPHERES == sceneType)
+      frame->setShape(std::make_shared<dynamics::SphereShape>(0.5 * size));
+    else
+      frame->setShape(std::make_shared<dynamics::BoxShape>(
+          Eigen::Vector3d::Constant(size)));
+
+    frames.push_back(frame);
+  }
+
+  return frames;
+}
+
+//==============================================================================
+void addArguments(benchmark::internal::Benchmark* benchmark)
+{
+  for (const int detector : {DETECTOR_DART,
+                             DETECTOR_FCL_PRIMITIVE,
+                             DETECTOR_FCL_MESH,
+                             DETECTOR_BULLET,
+                             DETECTOR_ODE})
+  {
+    if (!createDetector(detector))
+      continue;
+
+    for (const int scene : {SCENE_SPHERES, SCENE_BOXES})
+    {
+      for (const int numObjects : {8, 64, 512})
+        benchmark->Args({detector, scene, numObjects});
+    }
+  }
+}
+
+} // namespace
+
+//==============================================================================
+static void BM_Collide(benchmark::State& state)
+{
+  const int detectorType = static_cast<int>(state.range(0));
+  const int sceneType = static_cast<int>(state.range(1));
+  const auto numObjects = static_cast<std::size_t>(state.range(2));
+
+  auto detector = createDetector(detectorType);
+  const auto frames = createScene(sceneType, numObjects);
+  auto group = detector->createCollisionGroup();
+  for (const auto& frame : frames)
+    group->addShapeFrame(frame.get());
+
+  collision::CollisionOption option(true, 1000u);
+  collision::CollisionResult result;
+  for (auto _ : state)
+  {
+    result.clear();
+    group->collide(option, &result);
+  }
+
+  state.counters["contacts"] = static_cast<double>(result.getNumContacts());
+  state.SetLabel(
+      std::string(getDetectorName(detectorType)) + "/"
+      + (SCENE_SPHERES == sceneType ? "spheres" : "boxes"));
+}
+BENCHMARK(BM_Collide)->Apply(addArguments);
+
+//==============================================================================
+static void BM_CollideBinary(benchmark::State& state)
+{
+  const int detectorType = static_cast<int>(state.range(0));
+  const int sceneType = static_cast<int>(state.range(1));
+  const auto numObjects = static_cast<std::size_t>(state.range(2));
+
+  auto detector = createDetector(detectorType);
+  const auto frames = createScene(sceneType, numObjects);
+  auto group = detector->createCollisionGroup();
+  for (const auto& frame : frames)
+    group->addShapeFrame(frame.get());
+
+  // Only report whether there is any collision, which lets the detectors
+  // stop at the first contact
+  collision::CollisionOption option(false, 1u);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(group->collide(option, nullptr));
+
+  state.SetLabel(
+      std::string(getDetectorName(detectorType)) + "/"
+      + (SCENE_SPHERES == sceneType ? "spheres" : "boxes"));
+}
+BENCHMARK(BM_CollideBinary)->Apply(addArguments);
+
+BENCHMARK_MAIN();
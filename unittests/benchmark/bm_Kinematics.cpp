@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "dart/dart.hpp"
+#include "dart/utils/SkelParser.hpp"
+
+using namespace dart;
+
+namespace {
+
+const char* const SCENES[] = {"dart://sample/skel/test/chainwhipa.skel",
+                              "dart://sample/skel/fullbody1.skel",
+                              "dart://sample/skel/biped.skel"};
+
+const std::size_t NUM_CONFIGURATIONS = 64u;
+
+//==============================================================================
+/// Load the Skeleton with the most DOFs in scene \c index and generate random
+/// configurations for it. Each iteration sets another configuration so that
+/// the cached kinematics are invalidated as they are in a simulation.
+struct Fixture
+{
+  explicit Fixture(int index)
+  {
+    auto world = utils::SkelParser::readWorld(SCENES[index]);
+    for (std::size_t i = 0u; i < world->getNumSkeletons(); ++i)
+    {
+      auto candidate = world->getSkeleton(i);
+      if (!skel || candidate->getNumDofs() > skel->getNumDofs())
+        skel = candidate;
+    }
+
+    const int numDofs = static_cast<int>(skel->getNumDofs());
+    for (std::size_t i = 0u; i < NUM_CONFIGURATIONS; ++i)
+    {
+      positions.push_back(Eigen::VectorXd::Random(numDofs));
+      velocities.push_back(Eigen::VectorXd::Random(numDofs));
+    }
+  }
+
+  void setState(std::size_t i)
+  {
+    skel->setPositions(positions[i % NUM_CONFIGURATIONS]);
+    skel->setVelocities(velocities[i % NUM_CONFIGURATIONS]);
+  }
+
+  dynamics::SkeletonPtr skel;
+  std::vector<Eigen::VectorXd> positions;
+  std::vector<Eigen::VectorXd> velocities;
+};
+
+//==============================================================================
+void setLabel(benchmark::State& state, const Fixture& fixture)
+{
+  state.SetLabel(
+      std::string(SCENES[state.range(0)]) + " ("
+      + std::to_string(fixture.skel->getNumDofs()) + " DOFs)");
+}
+
+} // namespace
+
+//==============================================================================
+static void BM_ForwardKinematicsPosition(benchmark::State& state)
+{
+  Fixture fixture(static_cast<int>(state.range(0)));
+  std::size_t i = 0u;
+  for (auto _ : state)
+  {
+    fixture.setState(i++);
+    for (auto* bodyNode : fixture.skel->getBodyNodes())
+      benchmark::DoNotOptimize(bodyNode->getWorldTransform());
+  }
+  setLabel(state, fixture);
+}
+BENCHMARK(BM_ForwardKinematicsPosition)->DenseRange(0, 2);
+
+//==============================================================================
+static void BM_ForwardKinematicsAcceleration(benchmark::State& state)
+{
+  Fixture fixture(static_cast<int>(state.range(0)));
+  std::size_t i = 0u;
+  for (auto _ : state)
+  {
+    fixture.setState(i++);
+    for (auto* bodyNode : fixture.skel->getBodyNodes())
+      benchmark::DoNotOptimize(bodyNode->getSpatialAcceleration());
+  }
+  setLabel(state, fixture);
+}
+BENCHMARK(BM_ForwardKinematicsAcceleration)->DenseRange(0, 2);
+
+//==============================================================================
+static void BM_MassMatrix(benchmark::State& state)
+{
+  Fixture fixture(static_cast<int>(state.range(0)));
+  std::size_t i = 0u;
+  for (auto _ : state)
+  {
+    fixture.setState(i++);
+    benchmark::DoNotOptimize(fixture.skel->getMassMatrix());
+  }
+  setLabel(state, fixture);
+}
+BENCHMARK(BM_MassMatrix)->DenseRange(0, 2);
+
+//==============================================================================
+static void BM_ForwardDynamics(benchmark::State& state)
+{
+  Fixture fixture(static_cast<int>(state.range(0)));
+  std::size_t i = 0u;
+  for (auto _ : state)
+  {
+    fixture.setState(i++);
+    fixture.skel->computeForwardDynamics();
+    benchmark::DoNotOptimize(fixture.skel->getAccelerations());
+  }
+  setLabel(state, fixture);
+}
+BENCHMARK(BM_ForwardDynamics)->DenseRange(0, 2);
+
+//==============================================================================
+static void BM_InverseDynamics(benchmark::State& state)
+{
+  Fixture fixture(static_cast<int>(state.range(0)));
+  std::size_t i = 0u;
+  for (auto _ : state)
+  {
+    fixture.setState(i++);
+    fixture.skel->computeInverseDynamics();
+    benchmark::DoNotOptimize(fixture.skel->getForces());
+  }
+  setLabel(state, fixture);
+}
+BENCHMARK(BM_InverseDynamics)->DenseRange(0, 2);
+
+//==============================================================================
+static void BM_WorldJacobians(benchmark::State& state)
+{
+  Fixture fixture(static_cast<int>(state.range(0)));
+  math::Jacobian J;
+  std::size_t i = 0u;
+  for (auto _ : state)
+  {
+    fixture.setState(i++);
+    for (auto* bodyNode : fixture.skel->getBodyNodes())
+    {
+      fixture.skel->getWorldJacobian(bodyNode, J);
+      benchmark::DoNotOptimize(J.data());
+    }
+  }
+  setLabel(state, fixture);
+}
+BENCHMARK(BM_WorldJacobians)->DenseRange(0, 2);
+
+//==============================================================================
+static void BM_JacobianClassicDerivs(benchmark::State& state)
+{
+  Fixture fixture(static_cast<int>(state.range(0)));
+  math::Jacobian dJ;
+  std::size_t i = 0u;
+  for (auto _ : state)
+  {
+    fixture.setState(i++);
+    for (auto* bodyNode : fixture.skel->getBodyNodes())
+    {
+      fixture.skel->getJacobianClassicDeriv(bodyNode, dJ);
+      benchmark::DoNotOptimize(dJ.data());
+    }
+  }
+  setLabel(state, fixture);
+}
+BENCHMARK(BM_JacobianClassicDerivs)->DenseRange(0, 2);
+
+BENCHMARK_MAIN();
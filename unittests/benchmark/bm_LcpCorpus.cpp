@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Replays a corpus of LCPs captured with
+// BoxedLcpConstraintSolver::startLcpCapture() against every boxed LCP solver:
+//
+//   bm_LcpCorpus --corpus=<path> [benchmark options]
+//
+// The corpus can also be given by the DART_LCP_CORPUS environment variable.
+// Besides the time, each benchmark reports the number of problems the solver
+// failed on, the mean number of iterations of the iterative solvers, and the
+// largest and mean residuals of its solutions.
+
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "dart/constraint/ApgdBoxedLcpSolver.hpp"
+#include "dart/constraint/BoxedLcpProblem.hpp"
+#include "dart/constraint/DantzigBoxedLcpSolver.hpp"
+#include "dart/constraint/LemkeBoxedLcpSolver.hpp"
+#include "dart/constraint/PgsBoxedLcpSolver.hpp"
+
+using namespace dart;
+
+namespace {
+
+//==============================================================================
+void replayCorpus(
+    benchmark::State& state,
+    const std::vector<constraint::BoxedLcpProblem>& problems,
+    const std::function<std::unique_ptr<constraint::BoxedLcpSolver>()>&
+        createSolver)
+{
+  auto solver = createSolver();
+
+  Eigen::VectorXd solution;
+  for (auto _ : state)
+  {
+    for (const auto& problem : problems)
+      benchmark::DoNotOptimize(problem.solve(*solver, solution));
+  }
+
+  // Check the solutions once outside of the timed loop
+  std::size_t numFailures = 0u;
+  std::size_t sumIterations = 0u;
+  double maxResidual = 0.0;
+  double sumResidual = 0.0;
+  for (const auto& problem : problems)
+  {
+    if (!problem.solve(*solver, solution))
+      ++numFailures;
+    sumIterations += static_cast<std::size_t>(solver->getNumIterations());
+
+    const double residual = problem.computeResidual(solution);
+    maxResidual = std::max(maxResidual, residual);
+    sumResidual += residual;
+  }
+
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations() * problems.size()));
+  state.counters["problems"] = static_cast<double>(problems.size());
+  state.counters["failures"] = static_cast<double>(numFailures);
+  state.counters["iterations"] = static_cast<double>(sumIterations)
+                                 / static_cast<double>(problems.size());
+  state.counters["max_residual"] = maxResidual;
+  state.counters["mean_residual"]
+      = sumResidual / static_cast<double>(problems.size());
+}
+
+//==============================================================================
+std::string getCorpusPath(int& argc, char** argv)
+{
+  // Remove --corpus from the arguments so that Google Benchmark doesn't
+  // complain about it
+  std::string path;
+  const char* prefix = "--corpus=";
+  int numArgs = 1;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::strncmp(argv[i], prefix, std::strlen(prefix)) == 0)
+      path = argv[i] + std::strlen(prefix);
+    else
+      argv[numArgs++] = argv[i];
+  }
+  argc = numArgs;
+
+  if (path.empty())
+  {
+    const char* env = std::getenv("DART_LCP_CORPUS");
+    if (env)
+      path = env;
+  }
+
+  return path;
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char** argv)
+{
+  const std::string path = getCorpusPath(argc, argv);
+  if (path.empty())
+  {
+    std::cout << "No LCP corpus given. Pass --corpus=<path> or set "
+              << "DART_LCP_CORPUS to replay one.\n";
+    return EXIT_SUCCESS;
+  }
+
+  const auto problems = constraint::readBoxedLcpCorpus(path);
+  if (problems.empty())
+  {
+    std::cerr << "No LCP could be read from '" << path << "'.\n";
+    return EXIT_FAILURE;
+  }
+
+  std::size_t numFallbacks = 0u;
+  double captureTime = 0.0;
+  for (const auto& problem : problems)
+  {
+    if (problem.isFallback)
+      ++numFallbacks;
+    captureTime += problem.solveTime;
+  }
+  std::cout << "Replaying " << problems.size() << " LCPs from '" << path
+            << "' (" << numFallbacks << " fell back to the secondary solver, "
+            << captureTime << " s to solve when captured).\n";
+
+  benchmark::RegisterBenchmark(
+      "BM_DantzigBoxedLcp", replayCorpus, problems, [] {
+        return std::unique_ptr<constraint::BoxedLcpSolver>(
+            new constraint::DantzigBoxedLcpSolver());
+      });
+  benchmark::RegisterBenchmark("BM_PgsBoxedLcp", replayCorpus, problems, [] {
+    return std::unique_ptr<constraint::BoxedLcpSolver>(
+        new constraint::PgsBoxedLcpSolver());
+  });
+  benchmark::RegisterBenchmark(
+      "BM_LemkeBoxedLcp", replayCorpus, problems, [] {
+        return std::unique_ptr<constraint::BoxedLcpSolver>(
+            new constraint::LemkeBoxedLcpSolver());
+      });
+  benchmark::RegisterBenchmark(
+      "BM_ApgdBoxedLcp", replayCorpus, problems, [] {
+        return std::unique_ptr<constraint::BoxedLcpSolver>(
+            new constraint::ApgdBoxedLcpSolver());
+      });
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return EXIT_FAILURE;
+  benchmark::RunSpecifiedBenchmarks();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "dart/external/odelcpsolver/common.h"
+
+#include "dart/constraint/ApgdBoxedLcpSolver.hpp"
+#include "dart/constraint/DantzigBoxedLcpSolver.hpp"
+#include "dart/constraint/LemkeBoxedLcpSolver.hpp"
+#include "dart/constraint/PgsBoxedLcpSolver.hpp"
+#include "dart/lcpsolver/Lemke.hpp"
+#include "dart/math/MathTypes.hpp"
+#include "dart/math/Random.hpp"
+
+using namespace dart;
+
+namespace {
+
+using RowMajorMatrixXd
+    = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+//==============================================================================
+/// Boxed LCP with friction in the form BoxedLcpConstraintSolver passes to the
+/// solvers: A is padded to dPAD(n) columns and each contact has a normal row
+/// followed by two friction rows bounded by mu times the normal impulse.
+struct ContactLcp
+{
+  /// Generate the LCP of numContacts contacts between random pairs of
+  /// numBodies free bodies
+  ContactLcp(std::size_t numContacts, std::size_t numBodies)
+  {
+    math::Random::setSeed(0u);
+
+    const int n = static_cast<int>(3u * numContacts);
+    const int numDofs = static_cast<int>(6u * numBodies);
+
+    // Block diagonal inverse mass matrix
+    Eigen::MatrixXd invM = Eigen::MatrixXd::Zero(numDofs, numDofs);
+    for (std::size_t i = 0u; i < numBodies; ++i)
+    {
+      const Eigen::Matrix6d R = Eigen::Matrix6d::Random();
+      invM.block<6, 6>(6 * i, 6 * i)
+          = R * R.transpose() + Eigen::Matrix6d::Identity();
+    }
+
+    // Each contact couples one or two bodies
+    Eigen::MatrixXd J = Eigen::MatrixXd::Zero(n, numDofs);
+    for (std::size_t i = 0u; i < numContacts; ++i)
+    {
+      const auto body1 = static_cast<int>(
+          math::Random::uniform<int>(0, static_cast<int>(numBodies) - 1));
+      const auto body2 = static_cast<int>(
+          math::Random::uniform<int>(-1, static_cast<int>(numBodies) - 1));
+      J.block<3, 6>(3 * i, 6 * body1).setRandom();
+      if (body2 >= 0 && body2 != body1)
+        J.block<3, 6>(3 * i, 6 * body2).setRandom();
+    }
+
+    mN = n;
+    mA = RowMajorMatrixXd::Zero(n, dPAD(n));
+    mA.leftCols(n) = J * invM * J.transpose();
+    mA.leftCols(n).diagonal().array() += 1e-6;
+
+    mB.resize(n);
+    mLo.resize(n);
+    mHi.resize(n);
+    mFIndex.resize(n);
+    for (std::size_t i = 0u; i < numContacts; ++i)
+    {
+      const int row = static_cast<int>(3u * i);
+      mB[row] = math::Random::uniform(0.0, 1.0);
+      mLo[row] = 0.0;
+      mHi[row] = static_cast<double>(dInfinity);
+      mFIndex[row] = -1;
+
+      for (int j = 1; j < 3; ++j)
+      {
+        mB[row + j] = math::Random::uniform(-0.5, 0.5);
+        mLo[row + j] = -0.5;
+        mHi[row + j] = 0.5;
+        mFIndex[row + j] = row;
+      }
+    }
+  }
+
+  int mN;
+  RowMajorMatrixXd mA;
+  Eigen::VectorXd mB;
+  Eigen::VectorXd mLo;
+  Eigen::VectorXd mHi;
+  Eigen::VectorXi mFIndex;
+};
+
+//==============================================================================
+template <typename Solver>
+void solveBoxedLcp(benchmark::State& state)
+{
+  const auto numContacts = static_cast<std::size_t>(state.range(0));
+  const ContactLcp lcp(numContacts, std::max<std::size_t>(numContacts, 2u));
+  Solver solver;
+
+  // The solvers overwrite their inputs, so they work on copies
+  RowMajorMatrixXd A;
+  Eigen::VectorXd x;
+  Eigen::VectorXd b;
+  Eigen::VectorXd lo;
+  Eigen::VectorXd hi;
+  Eigen::VectorXi findex;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    A = lcp.mA;
+    x.setZero(lcp.mN);
+    b = lcp.mB;
+    lo = lcp.mLo;
+    hi = lcp.mHi;
+    findex = lcp.mFIndex;
+    state.ResumeTiming();
+
+    benchmark::DoNotOptimize(solver.solve(
+        lcp.mN,
+        A.data(),
+        x.data(),
+        b.data(),
+        0,
+        lo.data(),
+        hi.data(),
+        findex.data(),
+        false));
+  }
+
+  state.counters["rows"] = lcp.mN;
+}
+
+} // namespace
+
+//==============================================================================
+static void BM_DantzigBoxedLcp(benchmark::State& state)
+{
+  solveBoxedLcp<constraint::DantzigBoxedLcpSolver>(state);
+}
+BENCHMARK(BM_DantzigBoxedLcp)->Arg(4)->Arg(16)->Arg(64);
+
+//==============================================================================
+static void BM_PgsBoxedLcp(benchmark::State& state)
+{
+  solveBoxedLcp<constraint::PgsBoxedLcpSolver>(state);
+}
+BENCHMARK(BM_PgsBoxedLcp)->Arg(4)->Arg(16)->Arg(64);
+
+//==============================================================================
+static void BM_LemkeBoxedLcp(benchmark::State& state)
+{
+  solveBoxedLcp<constraint::LemkeBoxedLcpSolver>(state);
+}
+BENCHMARK(BM_LemkeBoxedLcp)->Arg(4)->Arg(16)->Arg(64);
+
+//==============================================================================
+static void BM_ApgdBoxedLcp(benchmark::State& state)
+{
+  solveBoxedLcp<constraint::ApgdBoxedLcpSolver>(state);
+}
+BENCHMARK(BM_ApgdBoxedLcp)->Arg(4)->Arg(16)->Arg(64);
+
+//==============================================================================
+static void BM_Lemke(benchmark::State& state)
+{
+  // Lemke solves standard LCPs, so only the normal rows are used
+  const auto numContacts = static_cast<std::size_t>(state.range(0));
+  const ContactLcp lcp(numContacts, std::max<std::size_t>(numContacts, 2u));
+
+  Eigen::MatrixXd M(numContacts, numContacts);
+  Eigen::VectorXd q(numContacts);
+  for (std::size_t i = 0u; i < numContacts; ++i)
+  {
+    for (std::size_t j = 0u; j < numContacts; ++j)
+      M(i, j) = lcp.mA(3 * i, 3 * j);
+    q[i] = -lcp.mB[3 * i];
+  }
+
+  Eigen::VectorXd z(numContacts);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(lcpsolver::Lemke(M, q, &z));
+
+  state.counters["rows"] = static_cast<double>(numContacts);
+}
+BENCHMARK(BM_Lemke)->Arg(4)->Arg(16)->Arg(64);
+
+BENCHMARK_MAIN();
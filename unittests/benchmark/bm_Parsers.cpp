@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "dart/utils/SkelParser.hpp"
+#include "dart/utils/mjcf/MjcfParser.hpp"
+#include "dart/utils/sdf/SdfParser.hpp"
+
+using namespace dart;
+
+//==============================================================================
+static void BM_SkelParser(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        utils::SkelParser::readWorld("dart://sample/skel/fullbody1.skel"));
+}
+BENCHMARK(BM_SkelParser)->Unit(benchmark::kMillisecond);
+
+//==============================================================================
+static void BM_SdfParser(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(utils::SdfParser::readSkeleton(
+        "dart://sample/sdf/atlas/atlas_v3_no_head.sdf"));
+}
+BENCHMARK(BM_SdfParser)->Unit(benchmark::kMillisecond);
+
+//==============================================================================
+static void BM_MjcfParser(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(utils::MjcfParser::readWorld(
+        "dart://sample/mjcf/openai/humanoid.xml"));
+}
+BENCHMARK(BM_MjcfParser)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "dart/constraint/constraint.hpp"
+#include "dart/dart.hpp"
+#include "dart/utils/SkelParser.hpp"
+
+using namespace dart;
+
+namespace {
+
+const char* const SCENES[] = {"dart://sample/skel/test/chainwhipa.skel",
+                              "dart://sample/skel/fullbody1.skel",
+                              "dart://sample/skel/cubes.skel",
+                              "dart://sample/skel/softBodies.skel"};
+
+//==============================================================================
+/// Create a World with a ground and a pyramid of boxes stacked in layers,
+/// which keeps many contacts active in every step
+simulation::WorldPtr createBoxStack(std::size_t numLayers)
+{
+  auto world = simulation::World::create();
+
+  auto ground = dynamics::Skeleton::create("ground");
+  auto groundBody
+      = ground->createJointAndBodyNodePair<dynamics::WeldJoint>().second;
+  groundBody->createShapeNodeWith<
+      dynamics::CollisionAspect,
+      dynamics::DynamicsAspect>(
+      std::make_shared<dynamics::BoxShape>(Eigen::Vector3d(10.0, 10.0, 0.1)));
+  world->addSkeleton(ground);
+
+  const double size = 0.1;
+  for (std::size_t layer = 0u; layer < numLayers; ++layer)
+  {
+    const std::size_t numPerSide = numLayers - layer;
+    for (std::size_t i = 0u; i < numPerSide * numPerSide; ++i)
+    {
+      auto box = dynamics::Skeleton::create("box");
+      auto pair = box->createJointAndBodyNodePair<dynamics::FreeJoint>();
+      auto shape = std::make_shared<dynamics::BoxShape>(
+          Eigen::Vector3d::Constant(size));
+      pair.second->createShapeNodeWith<
+          dynamics::CollisionAspect,
+          dynamics::DynamicsAspect>(shape);
+      pair.second->setInertia(dynamics::Inertia(
+          1.0, Eigen::Vector3d::Zero(), shape->computeInertia(1.0)));
+
+      Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+      tf.translation() << size * ((i % numPerSide) + 0.5 * layer),
+          size * ((i / numPerSide) + 0.5 * layer), 0.05 + size * (layer + 0.5);
+      dynamics::FreeJoint::setTransformOf(pair.first, tf);
+
+      world->addSkeleton(box);
+    }
+  }
+
+  return world;
+}
+
+//==============================================================================
+void setLcpSolver(
+    const simulation::WorldPtr& world, std::int64_t solverType)
+{
+  if (0 == solverType)
+    return;
+
+  world->setConstraintSolver(
+      std::make_unique<constraint::BoxedLcpConstraintSolver>(
+          std::make_shared<constraint::PgsBoxedLcpSolver>()));
+}
+
+//==============================================================================
+const char* getLcpSolverName(std::int64_t solverType)
+{
+  return 0 == solverType ? "dantzig" : "pgs";
+}
+
+} // namespace
+
+//==============================================================================
+static void BM_StepScene(benchmark::State& state)
+{
+  auto world = utils::SkelParser::readWorld(SCENES[state.range(0)]);
+  setLcpSolver(world, state.range(1));
+
+  for (auto _ : state)
+    world->step();
+
+  state.SetLabel(
+      std::string(SCENES[state.range(0)]) + "/"
+      + getLcpSolverName(state.range(1)));
+}
+BENCHMARK(BM_StepScene)
+    ->ArgPair(0, 0)
+    ->ArgPair(1, 0)
+    ->ArgPair(2, 0)
+    ->ArgPair(2, 1)
+    ->ArgPair(3, 0);
+
+//==============================================================================
+static void BM_StepBoxStack(benchmark::State& state)
+{
+  auto world = createBoxStack(static_cast<std::size_t>(state.range(0)));
+  setLcpSolver(world, state.range(1));
+
+  // Let the stack settle so that the contacts are representative
+  for (std::size_t i = 0u; i < 100u; ++i)
+    world->step();
+
+  const auto initialState = world->saveState();
+  std::size_t numSteps = 0u;
+  for (auto _ : state)
+  {
+    // Restart from the settled state periodically so that long runs measure
+    // the same configuration instead of a collapsed stack
+    if (++numSteps % 1000u == 0u)
+    {
+      state.PauseTiming();
+      world->restoreState(initialState);
+      state.ResumeTiming();
+    }
+
+    world->step();
+  }
+
+  state.counters["skeletons"]
+      = static_cast<double>(world->getNumSkeletons());
+  state.counters["contacts"] = static_cast<double>(
+      world->getLastCollisionResult().getNumContacts());
+  state.SetLabel(getLcpSolverName(state.range(1)));
+}
+BENCHMARK(BM_StepBoxStack)
+    ->ArgPair(2, 0)
+    ->ArgPair(4, 0)
+    ->ArgPair(4, 1)
+    ->ArgPair(6, 0)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -36,6 +36,7 @@
 #include <gtest/gtest.h>
 
 #include "dart/simulation/World.hpp"
+#include "dart/simulation/WorldBatch.hpp"
 
 #include "TestHelpers.hpp"
 
@@ -78,3 +79,52 @@ TEST(Concurrency, FrameDeletion)
   EXPECT_EQ(Frame::World()->getNumChildEntities(), 0);
   EXPECT_EQ(Frame::World()->getNumChildFrames(), 0);
 }
+
+//==============================================================================
+TEST(Concurrency, WorldBatch)
+{
+  auto world = simulation::World::create();
+  auto pendulum = createNLinkRobot(3, Eigen::Vector3d::Ones(), DOF_ROLL);
+  pendulum->setPositions(Eigen::VectorXd::Constant(3, 0.1));
+  world->addSkeleton(pendulum);
+
+  const std::size_t numWorlds = 5u;
+  simulation::WorldBatch batch(world, numWorlds, 2u);
+  EXPECT_EQ(batch.getNumWorlds(), numWorlds);
+  EXPECT_EQ(batch.getNumThreads(), 2u);
+  EXPECT_EQ(batch.getNumDofs(), 3u);
+
+  for (std::size_t i = 0u; i < numWorlds; ++i)
+  {
+    EXPECT_TRUE(equals(
+        Eigen::VectorXd(batch.getPositions().col(i)),
+        pendulum->getPositions()));
+  }
+
+  // Give each World different commands, and step serial copies with the same
+  // commands to compare against
+  std::vector<simulation::WorldPtr> references;
+  for (std::size_t i = 0u; i < numWorlds; ++i)
+  {
+    batch.getCommands().col(i).setConstant(0.1 * i);
+    references.push_back(world->clone());
+  }
+
+  const std::size_t numSteps = 20u;
+  batch.step(numSteps);
+
+  for (std::size_t i = 0u; i < numWorlds; ++i)
+  {
+    auto skel = references[i]->getSkeleton(0);
+    for (std::size_t j = 0u; j < numSteps; ++j)
+    {
+      skel->setCommands(Eigen::VectorXd::Constant(3, 0.1 * i));
+      references[i]->step();
+    }
+
+    EXPECT_TRUE(equals(
+        Eigen::VectorXd(batch.getPositions().col(i)), skel->getPositions()));
+    EXPECT_TRUE(equals(
+        Eigen::VectorXd(batch.getVelocities().col(i)), skel->getVelocities()));
+  }
+}
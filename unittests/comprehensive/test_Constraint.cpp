@@ -30,17 +30,29 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <thread>
 
 #include <Eigen/Dense>
 #include <gtest/gtest.h>
 
 #include "TestHelpers.hpp"
 
+#include "dart/collision/CollisionObject.hpp"
 #include "dart/collision/dart/DARTCollisionDetector.hpp"
 #include "dart/common/Console.hpp"
+#include "dart/constraint/BoxedLcpConstraintSolver.hpp"
+#include "dart/constraint/ContactConstraint.hpp"
+#include "dart/constraint/DantzigBoxedLcpSolver.hpp"
+#include "dart/constraint/ImpulseResponseCache.hpp"
+#include "dart/constraint/PgsBoxedLcpSolver.hpp"
+#include "dart/constraint/SoftContactConstraint.hpp"
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/PointMass.hpp"
 #include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/SoftBodyNode.hpp"
 #include "dart/math/Geometry.hpp"
 #include "dart/math/Helpers.hpp"
 #include "dart/math/Random.hpp"
@@ -234,3 +246,466 @@ TEST_F(ConstraintTest, SingleContactTest)
 
   SingleContactTest(getList()[0]);
 }
+
+//==============================================================================
+dart::simulation::WorldPtr createBoxStack(bool warmStarting)
+{
+  auto world = dart::simulation::World::create();
+  world->addSkeleton(createGround(Eigen::Vector3d(10.0, 10.0, 0.1)));
+  for (auto i = 0u; i < 3u; ++i)
+  {
+    world->addSkeleton(createBox(
+        Eigen::Vector3d::Constant(0.2),
+        Eigen::Vector3d(0.0, 0.0, 0.15 + 0.2 * i)));
+  }
+
+  auto lcpSolver = std::make_shared<dart::constraint::DantzigBoxedLcpSolver>();
+  lcpSolver->setWarmStarting(warmStarting);
+  auto* solver = static_cast<dart::constraint::BoxedLcpConstraintSolver*>(
+      world->getConstraintSolver());
+  solver->setBoxedLcpSolver(lcpSolver);
+  solver->setWarmStarting(warmStarting);
+
+  return world;
+}
+
+//==============================================================================
+TEST(ConstraintSolver, WarmStartRestingContacts)
+{
+  auto cold = createBoxStack(false);
+  auto warm = createBoxStack(true);
+  EXPECT_TRUE(warm->getConstraintSolver()->isWarmStarting());
+
+  const auto numSteps = 500u;
+  for (auto i = 0u; i < numSteps; ++i)
+  {
+    cold->step();
+    warm->step();
+  }
+
+  // Nearly every LCP of the resting stack is solved from the impulses of the
+  // previous step, and the motion is the same as with cold starts
+  const auto* solver
+      = static_cast<const dart::constraint::BoxedLcpConstraintSolver*>(
+          warm->getConstraintSolver());
+  const auto lcpSolver
+      = std::static_pointer_cast<const dart::constraint::DantzigBoxedLcpSolver>(
+          solver->getBoxedLcpSolver());
+  EXPECT_GT(lcpSolver->getNumWarmStarts(), numSteps - 10u);
+
+  for (auto i = 0u; i < cold->getNumSkeletons(); ++i)
+  {
+    EXPECT_TRUE(cold->getSkeleton(i)->getPositions().isApprox(
+        warm->getSkeleton(i)->getPositions(), 1e-9));
+  }
+
+  // A restored state starts from the impulses of the step it was saved at,
+  // not from those of the last step, so the motion is replayed exactly
+  auto replayed = createBoxStack(true);
+  for (auto i = 0u; i < 10u; ++i)
+    replayed->step();
+  const auto state = replayed->saveState();
+  EXPECT_FALSE(state.mContactImpulses.empty());
+
+  std::vector<Eigen::VectorXd> positions;
+  for (auto i = 0u; i < 20u; ++i)
+  {
+    replayed->step();
+    positions.push_back(replayed->getSkeleton(3)->getPositions());
+  }
+
+  ASSERT_TRUE(replayed->restoreState(state));
+  for (auto i = 0u; i < 20u; ++i)
+  {
+    replayed->step();
+    EXPECT_TRUE(replayed->getSkeleton(3)->getPositions() == positions[i]);
+  }
+}
+
+//==============================================================================
+TEST(ConstraintSolver, CachedImpulseResponses)
+{
+  auto uncached = createBoxStack(false);
+  auto cached = createBoxStack(false);
+  auto* solver = static_cast<dart::constraint::BoxedLcpConstraintSolver*>(
+      uncached->getConstraintSolver());
+  solver->setCachingImpulseResponses(false);
+  EXPECT_FALSE(solver->isCachingImpulseResponses());
+  EXPECT_TRUE(static_cast<dart::constraint::BoxedLcpConstraintSolver*>(
+                  cached->getConstraintSolver())
+                  ->isCachingImpulseResponses());
+
+  // The contact rows assembled from the cached responses give the same motion
+  // as the impulse tests
+  for (auto i = 0u; i < 300u; ++i)
+  {
+    uncached->step();
+    cached->step();
+  }
+
+  for (auto i = 0u; i < uncached->getNumSkeletons(); ++i)
+  {
+    EXPECT_TRUE(uncached->getSkeleton(i)->getPositions().isApprox(
+        cached->getSkeleton(i)->getPositions(), 1e-9));
+  }
+}
+
+//==============================================================================
+/// Returns a World with a sphere of unit mass resting on a ground whose shape
+/// has the given contact stiffness and damping
+dart::simulation::WorldPtr createSphereOnGround(
+    double stiffness, double damping)
+{
+  auto world = dart::simulation::World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+      dart::collision::DARTCollisionDetector::create());
+
+  auto ground = createGround(Eigen::Vector3d(10.0, 10.0, 0.1));
+  auto* dynamicsAspect
+      = ground->getBodyNode(0)->getShapeNode(0)->getDynamicsAspect();
+  dynamicsAspect->setContactStiffness(stiffness);
+  dynamicsAspect->setContactDamping(damping);
+  world->addSkeleton(ground);
+
+  auto sphere = createObject(Eigen::Vector3d(0.0, 0.0, 0.15));
+  sphere->getBodyNode(0)->createShapeNodeWith<
+      dart::dynamics::VisualAspect,
+      dart::dynamics::CollisionAspect,
+      dart::dynamics::DynamicsAspect>(
+      std::make_shared<dart::dynamics::SphereShape>(0.1));
+  world->addSkeleton(sphere);
+
+  return world;
+}
+
+//==============================================================================
+TEST(ConstraintSolver, CompliantContacts)
+{
+  const double gravity = 9.81;
+
+  // The sphere sinks into the compliant ground until the spring-damper of the
+  // contact carries its weight. The stiffest ground would make an explicit
+  // penalty force unstable at this time step.
+  for (const double stiffness : {1e3, 1e5, 1e7})
+  {
+    const double damping = 2.0 * std::sqrt(stiffness);
+    auto world = createSphereOnGround(stiffness, damping);
+    for (auto i = 0u; i < 1000u; ++i)
+      world->step();
+
+    const auto* sphere = world->getSkeleton(1)->getBodyNode(0);
+    const double depth = 0.15 - sphere->getTransform().translation()[2];
+    EXPECT_NEAR(depth, gravity / stiffness, 0.01 * gravity / stiffness);
+    EXPECT_NEAR(sphere->getLinearVelocity()[2], 0.0, 1e-6);
+  }
+
+  // Contacts are rigid by default
+  auto world = createSphereOnGround(0.0, 0.0);
+  for (auto i = 0u; i < 1000u; ++i)
+    world->step();
+
+  const auto* sphere = world->getSkeleton(1)->getBodyNode(0);
+  EXPECT_LT(0.15 - sphere->getTransform().translation()[2], 1e-3);
+}
+
+//==============================================================================
+TEST(ConstraintSolver, CompliantContactPoints)
+{
+  const double gravity = 9.81;
+  const double stiffness = 1e5;
+
+  auto world = dart::simulation::World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+      dart::collision::DARTCollisionDetector::create());
+
+  auto ground = createGround(Eigen::Vector3d(10.0, 10.0, 0.1));
+  world->addSkeleton(ground);
+
+  auto box = createBox(
+      Eigen::Vector3d::Constant(0.2), Eigen::Vector3d(0.0, 0.0, 0.15));
+  const double mass = box->getMass();
+  auto* dynamicsAspect
+      = ground->getBodyNode(0)->getShapeNode(0)->getDynamicsAspect();
+  dynamicsAspect->setContactStiffness(stiffness);
+  dynamicsAspect->setContactDamping(2.0 * std::sqrt(stiffness * mass));
+  world->addSkeleton(box);
+
+  for (auto i = 0u; i < 1000u; ++i)
+    world->step();
+
+  // The box rests on several contact points, which share the stiffness of the
+  // ground, so it sinks as deep as on a single spring
+  EXPECT_GT(world->getLastCollisionResult().getNumContacts(), 1u);
+  const auto* body = box->getBodyNode(0);
+  const double depth = 0.15 - body->getTransform().translation()[2];
+  EXPECT_NEAR(
+      depth, mass * gravity / stiffness, 0.01 * mass * gravity / stiffness);
+  EXPECT_NEAR(body->getLinearVelocity()[2], 0.0, 1e-6);
+}
+
+//==============================================================================
+TEST(ConstraintSolver, PerSolverParameters)
+{
+  using dart::constraint::ConstraintParameters;
+  using dart::constraint::ContactConstraint;
+
+  // Returns the depth of a sphere that starts 2 cm deep in the ground after
+  // 100 steps with the given contact parameters
+  const auto simulate = [](const ConstraintParameters& parameters,
+                           bool frictionless = false) {
+    auto world = createSphereOnGround(0.0, 0.0);
+    world->getConstraintSolver()->setContactParameters(parameters);
+    if (frictionless)
+    {
+      world->getSkeleton(0)
+          ->getBodyNode(0)
+          ->getShapeNode(0)
+          ->getDynamicsAspect()
+          ->setFrictionCoeff(0.0);
+    }
+    world->getSkeleton(1)->getJoint(0)->setPosition(5, 0.13);
+    for (auto i = 0u; i < 100u; ++i)
+      world->step();
+
+    const auto* sphere = world->getSkeleton(1)->getBodyNode(0);
+    return 0.15 - sphere->getTransform().translation()[2];
+  };
+
+  // The default maximum error reduction velocity of 1 mm/s barely moves the
+  // sphere in 0.1 s
+  const ConstraintParameters defaults
+      = ContactConstraint::getDefaultParameters();
+  const ConstraintParameters stiff(0.0, 0.2, 1.0, 1e-5);
+  const double defaultDepth = simulate(defaults);
+  const double stiffDepth = simulate(stiff);
+  EXPECT_GT(defaultDepth, 0.019);
+  EXPECT_LT(stiffDepth, 1e-3);
+
+  // The error allowance applies to frictionless contacts as well
+  const ConstraintParameters tolerant(0.05, 0.2, 1.0, 1e-5);
+  EXPECT_LT(simulate(stiff, true), 1e-3);
+  EXPECT_GT(simulate(tolerant, true), 0.019);
+  EXPECT_GT(simulate(tolerant), 0.019);
+
+  // Differently tuned worlds don't affect each other when they are simulated
+  // concurrently
+  std::vector<double> depths(8u);
+  std::vector<std::thread> threads;
+  for (auto i = 0u; i < depths.size(); ++i)
+  {
+    threads.emplace_back([&, i]() {
+      depths[i] = simulate(i % 2u == 0u ? defaults : stiff);
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  for (auto i = 0u; i < depths.size(); ++i)
+    EXPECT_EQ(depths[i], i % 2u == 0u ? defaultDepth : stiffDepth);
+
+  EXPECT_EQ(
+      ContactConstraint::getDefaultParameters().errorReductionParameter,
+      defaults.errorReductionParameter);
+
+  // Parameters out of their ranges are clamped
+  auto world = dart::simulation::World::create();
+  auto* solver = world->getConstraintSolver();
+  solver->setContactParameters(ConstraintParameters(-1.0, 2.0, -1.0, 0.0));
+  const ConstraintParameters& clamped = solver->getContactParameters();
+  EXPECT_EQ(clamped.errorAllowance, 0.0);
+  EXPECT_EQ(clamped.errorReductionParameter, 1.0);
+  EXPECT_EQ(clamped.maxErrorReductionVelocity, 0.0);
+  EXPECT_EQ(clamped.constraintForceMixing, 1e-9);
+  EXPECT_TRUE(clamped.isValid());
+}
+
+//==============================================================================
+TEST(ConstraintSolver, SolveBudget)
+{
+  using dart::constraint::BoxedLcpConstraintSolver;
+
+  // Box stack solved by PGS, which runs to its tolerances unless the budget
+  // stops it first
+  const auto createPgsBoxStack = []() {
+    auto world = createBoxStack(false);
+    auto lcpSolver = std::make_shared<dart::constraint::PgsBoxedLcpSolver>();
+    lcpSolver->setOption(
+        dart::constraint::PgsBoxedLcpSolver::Option(1000, 1e-12, 1e-12));
+    auto* solver
+        = static_cast<BoxedLcpConstraintSolver*>(world->getConstraintSolver());
+    solver->setBoxedLcpSolver(lcpSolver);
+    return std::make_pair(world, solver);
+  };
+
+  auto unlimited = createPgsBoxStack();
+  auto limited = createPgsBoxStack();
+  auto expired = createPgsBoxStack();
+  EXPECT_FALSE(unlimited.second->hasSolveBudget());
+
+  const double inf = std::numeric_limits<double>::infinity();
+  unlimited.second->setSolveBudget(inf);
+  limited.second->setSolveBudget(inf, 3u);
+  expired.second->setSolveBudget(0.0);
+  EXPECT_TRUE(limited.second->hasSolveBudget());
+  EXPECT_EQ(limited.second->getMaxNumSolveIterations(), 3u);
+
+  for (auto i = 0u; i < 10u; ++i)
+  {
+    unlimited.first->step();
+    limited.first->step();
+    expired.first->step();
+
+    const auto& unlimitedReport = unlimited.second->getLastSolveReport();
+    const auto& limitedReport = limited.second->getLastSolveReport();
+    const auto& expiredReport = expired.second->getLastSolveReport();
+    ASSERT_GT(unlimitedReport.numLcps, 0u);
+    ASSERT_GT(limitedReport.numLcps, 0u);
+    ASSERT_GT(expiredReport.numLcps, 0u);
+
+    EXPECT_EQ(unlimitedReport.numInterruptedLcps, 0u);
+    EXPECT_GT(unlimitedReport.numIterations, 3u);
+    EXPECT_LT(unlimitedReport.maxResidual, 1e-6);
+
+    // Each LCP gets at least one iteration, and the best iterates are used
+    EXPECT_EQ(limitedReport.numInterruptedLcps, limitedReport.numLcps);
+    EXPECT_LE(
+        limitedReport.numIterations,
+        std::max<std::size_t>(3u, limitedReport.numLcps));
+    EXPECT_GT(limitedReport.maxResidual, unlimitedReport.maxResidual);
+    EXPECT_TRUE(std::isfinite(limitedReport.maxResidual));
+
+    EXPECT_EQ(expiredReport.numIterations, expiredReport.numLcps);
+    EXPECT_GE(expiredReport.elapsedTime, 0.0);
+  }
+
+  // The stacks stay upright within the budget
+  for (auto i = 0u; i < 200u; ++i)
+    limited.first->step();
+  for (auto i = 1u; i < limited.first->getNumSkeletons(); ++i)
+  {
+    const auto* box = limited.first->getSkeleton(i)->getBodyNode(0);
+    EXPECT_NEAR(box->getTransform().translation()[0], 0.0, 1e-2);
+    EXPECT_NEAR(box->getTransform().translation()[1], 0.0, 1e-2);
+  }
+
+  limited.second->clearSolveBudget();
+  EXPECT_FALSE(limited.second->hasSolveBudget());
+  limited.first->step();
+  EXPECT_EQ(limited.second->getLastSolveReport().numInterruptedLcps, 0u);
+}
+
+//==============================================================================
+/// CollisionObject of the contacts that are made without collision detection
+class ContactObject : public dart::collision::CollisionObject
+{
+public:
+  ContactObject(
+      dart::collision::CollisionDetector* collisionDetector,
+      const dart::dynamics::ShapeFrame* shapeFrame)
+    : dart::collision::CollisionObject(collisionDetector, shapeFrame)
+  {
+    // Do nothing
+  }
+
+protected:
+  void updateEngineData() override
+  {
+    // Do nothing
+  }
+};
+
+//==============================================================================
+TEST(ConstraintSolver, CachedSoftContactResponses)
+{
+  using namespace dart::dynamics;
+
+  auto soft = Skeleton::create("soft");
+  auto* softBodyNode
+      = soft->createJointAndBodyNodePair<FreeJoint, SoftBodyNode>().second;
+  SoftBodyNodeHelper::setBox(
+      softBodyNode,
+      Eigen::Vector3d::Constant(0.2),
+      Eigen::Isometry3d::Identity(),
+      Eigen::Vector3i::Constant(3),
+      1.0);
+  soft->setPositions(0.1 * Eigen::VectorXd::Random(soft->getNumDofs()));
+  auto rigid = createBox(Eigen::Vector3d::Constant(0.4));
+
+  auto detector = dart::collision::DARTCollisionDetector::create();
+  ContactObject softObject(detector.get(), softBodyNode->getShapeNode(0));
+  ContactObject rigidObject(
+      detector.get(), rigid->getBodyNode(0)->getShapeNode(0));
+
+  // Contacts on the point masses of several faces, where some faces share a
+  // point mass, and one contact with the soft body as the second body
+  std::vector<dart::collision::Contact> contacts;
+  for (const int face : {0, 1, 2, 7, 12})
+  {
+    dart::collision::Contact contact;
+    const int index = softBodyNode->getFace(face)[0];
+    contact.point = softBodyNode->getPointMass(index)->getWorldPosition();
+    contact.normal = Eigen::Vector3d::UnitZ();
+    contact.penetrationDepth = 0.01;
+    contact.collisionObject1 = &softObject;
+    contact.collisionObject2 = &rigidObject;
+    contact.triID1 = face;
+    contacts.push_back(contact);
+  }
+  std::swap(contacts.back().collisionObject1, contacts.back().collisionObject2);
+  std::swap(contacts.back().triID1, contacts.back().triID2);
+
+  std::vector<std::shared_ptr<dart::constraint::ConstraintBase>> constraints;
+  std::vector<int> offsets;
+  int n = 0;
+  for (auto& contact : contacts)
+  {
+    constraints.push_back(
+        std::make_shared<dart::constraint::SoftContactConstraint>(
+            contact, 0.001));
+    constraints.back()->update();
+    ASSERT_TRUE(constraints.back()->isActive());
+    ASSERT_TRUE(constraints.back()->supportsImpulseResponseCache());
+
+    offsets.push_back(n);
+    n += static_cast<int>(constraints.back()->getDimension());
+  }
+
+  // Matrix of the LCP by the impulse tests on the Skeletons
+  using RowMajorMatrixXd
+      = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  RowMajorMatrixXd expected(n, n);
+  for (std::size_t i = 0u; i < constraints.size(); ++i)
+  {
+    constraints[i]->excite();
+    for (std::size_t j = 0u; j < constraints[i]->getDimension(); ++j)
+    {
+      constraints[i]->applyUnitImpulse(j);
+      for (std::size_t k = 0u; k < constraints.size(); ++k)
+      {
+        constraints[k]->getVelocityChange(
+            &expected(offsets[i] + j, offsets[k]), k == i);
+      }
+    }
+    constraints[i]->unexcite();
+  }
+
+  // Matrix of the LCP by the cached impulse responses
+  dart::constraint::ImpulseResponseCache cache;
+  for (const auto& constraint : constraints)
+    constraint->addBodyNodesTo(cache);
+  cache.update();
+  EXPECT_EQ(cache.getNumBodyNodes(), 1u);
+
+  RowMajorMatrixXd cached(n, n);
+  for (std::size_t i = 0u; i < constraints.size(); ++i)
+  {
+    constraints[i]->applyUnitImpulses(cache);
+    for (std::size_t k = 0u; k < constraints.size(); ++k)
+    {
+      constraints[k]->getVelocityChanges(
+          cache, &cached(offsets[i], offsets[k]), n, k == i);
+    }
+  }
+
+  EXPECT_TRUE(cached.isApprox(expected, 1e-12));
+}
@@ -39,6 +39,8 @@
 
 #include "dart/common/Console.hpp"
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
 #include "dart/dynamics/SimpleFrame.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/math/Geometry.hpp"
@@ -2605,3 +2607,96 @@ TEST_F(DynamicsTest, HybridDynamics)
     EXPECT_NEAR(command(i, 4), output(i, 4), tol);
   }
 }
+
+//==============================================================================
+TEST_F(DynamicsTest, FreeRigidBody)
+{
+  using namespace dynamics;
+
+  const double tol = 1e-9;
+
+  auto skel = Skeleton::create();
+  auto pair = skel->createJointAndBodyNodePair<FreeJoint>();
+  FreeJoint* joint = pair.first;
+  BodyNode* body = pair.second;
+
+  // Inertia with an offset center of mass and products of inertia, and a
+  // joint frame that is not at the body origin
+  const Eigen::Matrix3d R = math::expMapRot(Eigen::Vector3d(0.2, 0.1, -0.3));
+  body->setInertia(dynamics::Inertia(
+      2.5,
+      Eigen::Vector3d(0.1, -0.2, 0.3),
+      R * BoxShape::computeInertia(Eigen::Vector3d(0.3, 0.5, 0.7), 2.5)
+          * R.transpose()));
+  Eigen::Isometry3d childToJoint = Eigen::Isometry3d::Identity();
+  childToJoint.linear() = math::expMapRot(Eigen::Vector3d(0.3, -0.4, 0.5));
+  childToJoint.translation() = Eigen::Vector3d(-0.1, 0.2, 0.05);
+  joint->setTransformFromChildBodyNode(childToJoint);
+  EXPECT_TRUE(skel->isFreeRigidBody());
+
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    skel->setPositions(Eigen::Vector6d::Random());
+    skel->setVelocities(Eigen::Vector6d::Random());
+    skel->setCommands(Eigen::Vector6d::Random());
+    body->setExtForce(Eigen::Vector3d::Random(), Eigen::Vector3d::Random());
+
+    // Forward dynamics
+    skel->computeForwardDynamics();
+    const Eigen::VectorXd expectedAccelerations
+        = skel->getInvMassMatrix()
+          * (skel->getForces() + skel->getExternalForces()
+             - skel->getCoriolisAndGravityForces());
+    EXPECT_TRUE(equals(skel->getAccelerations(), expectedAccelerations, tol));
+
+    // Impulse response of a constraint impulse on the body, as computed for
+    // contact constraints
+    const Eigen::Vector6d impulse = Eigen::Vector6d::Random();
+    const math::Jacobian J = body->getJacobian();
+    skel->clearConstraintImpulses();
+    skel->updateBiasImpulse(body, impulse);
+    skel->updateVelocityChange();
+    EXPECT_TRUE(equals(
+        Eigen::VectorXd(body->getBodyVelocityChange()),
+        Eigen::VectorXd(J * skel->getInvMassMatrix() * J.transpose() * impulse),
+        tol));
+
+    // Impulse-based forward dynamics
+    const Eigen::VectorXd velocities = skel->getVelocities();
+    const Eigen::VectorXd jointImpulses = Eigen::Vector6d::Random();
+    skel->clearConstraintImpulses();
+    skel->setJointConstraintImpulses(jointImpulses);
+    skel->computeImpulseForwardDynamics();
+    EXPECT_TRUE(equals(
+        skel->getVelocityChanges(),
+        Eigen::VectorXd(skel->getInvMassMatrix() * jointImpulses),
+        tol));
+    EXPECT_TRUE(equals(
+        skel->getVelocities(),
+        Eigen::VectorXd(velocities + skel->getVelocityChanges()),
+        tol));
+  }
+
+  // Implicit joint damping and springs, other actuator types and other
+  // BodyNodes fall back to the articulated body algorithm. The cached
+  // detection follows each of these changes.
+  joint->setDampingCoefficient(0, 0.1);
+  EXPECT_FALSE(skel->isFreeRigidBody());
+  joint->setDampingCoefficient(0, 0.0);
+  EXPECT_TRUE(skel->isFreeRigidBody());
+
+  joint->setSpringStiffness(1, 10.0);
+  EXPECT_FALSE(skel->isFreeRigidBody());
+  joint->setSpringStiffness(1, 0.0);
+  EXPECT_TRUE(skel->isFreeRigidBody());
+
+  joint->setActuatorType(Joint::VELOCITY);
+  EXPECT_FALSE(skel->isFreeRigidBody());
+  joint->setActuatorType(Joint::PASSIVE);
+  EXPECT_TRUE(skel->isFreeRigidBody());
+
+  auto child = body->createChildJointAndBodyNodePair<RevoluteJoint>();
+  EXPECT_FALSE(skel->isFreeRigidBody());
+  child.second->remove();
+  EXPECT_TRUE(skel->isFreeRigidBody());
+}
@@ -32,6 +32,8 @@
 
 #include <gtest/gtest.h>
 
+#include "dart/constraint/ApgdBoxedLcpSolver.hpp"
+#include "dart/constraint/BoxedLcpConstraintSolver.hpp"
 #include "dart/dynamics/SimpleFrame.hpp"
 #include "dart/math/Helpers.hpp"
 #include "dart/math/Random.hpp"
@@ -286,3 +288,58 @@ TEST(Friction, FrictionPerShapeNode)
     }
   }
 }
+
+//==============================================================================
+TEST(Friction, ConeFriction)
+{
+  // Slide boxes on the floor at 30 degrees from the friction directions, with
+  // the friction bounded by the box of the boxed LCP and by the cone
+  std::vector<Eigen::Vector3d> displacements;
+  for (const bool cone : {false, true})
+  {
+    auto world = simulation::World::create();
+    world->addSkeleton(createFloor());
+    auto box = createBox(
+        Eigen::Vector3d::Constant(0.2), Eigen::Vector3d(0.0, 0.0, -0.4));
+    world->addSkeleton(box);
+
+    if (cone)
+    {
+      auto* solver = static_cast<constraint::BoxedLcpConstraintSolver*>(
+          world->getConstraintSolver());
+      solver->setBoxedLcpSolver(
+          std::make_shared<constraint::ApgdBoxedLcpSolver>());
+      solver->setSecondaryBoxedLcpSolver(nullptr);
+    }
+
+    for (auto i = 0u; i < 200u; ++i)
+      world->step();
+
+    const Eigen::Vector3d start = box->getPositions().tail<3>();
+    Eigen::Vector6d velocity = Eigen::Vector6d::Zero();
+    velocity.tail<3>() << std::sqrt(3.0), 1.0, 0.0;
+    box->setVelocities(velocity);
+
+    for (auto i = 0u; i < 1000u; ++i)
+    {
+      world->step();
+      EXPECT_NEAR(box->getPositions()[5], start[2], 1e-4);
+    }
+
+    displacements.push_back(box->getPositions().tail<3>() - start);
+  }
+
+  // The box friction pushes against both friction directions equally, which
+  // stops the box early and turns it away from its initial direction
+  const double angle = math::constants<double>::pi() / 6.0;
+  EXPECT_LT(std::atan2(displacements[0][1], displacements[0][0]), angle - 0.1);
+
+  // The cone friction opposes the velocity, so the box slides straight for
+  // v^2/(2*mu*g) with the default friction coefficient of one
+  const double distance = 4.0 / (2.0 * 9.81);
+  EXPECT_NEAR(
+      std::atan2(displacements[1][1], displacements[1][0]), angle, 1e-3);
+  EXPECT_NEAR(displacements[1].head<2>().norm(), distance, 0.01 * distance);
+  EXPECT_LT(
+      displacements[0].head<2>().norm(), displacements[1].head<2>().norm());
+}
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+#include "TestHelpers.hpp"
+
+#include "dart/collision/CollisionObject.hpp"
+#include "dart/collision/dart/DARTCollisionDetector.hpp"
+#include "dart/common/StlHelpers.hpp"
+#include "dart/simulation/World.hpp"
+
+using namespace dart;
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#define DART_TEST_SANITIZED
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define DART_TEST_SANITIZED
+#endif
+
+// Count the heap allocations by interposing the C allocation functions, which
+// operator new also goes through with glibc.
+#if defined(__GLIBC__) && !defined(DART_TEST_SANITIZED)
+#define DART_TEST_COUNT_ALLOCATIONS
+
+extern "C" void* __libc_malloc(std::size_t);
+extern "C" void* __libc_calloc(std::size_t, std::size_t);
+extern "C" void* __libc_realloc(void*, std::size_t);
+
+namespace {
+bool gIsCountingAllocations = false;
+std::size_t gNumAllocations = 0u;
+} // namespace
+
+extern "C" void* malloc(std::size_t size)
+{
+  if (gIsCountingAllocations)
+    ++gNumAllocations;
+  return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t num, std::size_t size)
+{
+  if (gIsCountingAllocations)
+    ++gNumAllocations;
+  return __libc_calloc(num, size);
+}
+
+extern "C" void* realloc(void* ptr, std::size_t size)
+{
+  if (gIsCountingAllocations)
+    ++gNumAllocations;
+  return __libc_realloc(ptr, size);
+}
+#endif
+
+//==============================================================================
+simulation::WorldPtr createRealTimeWorld()
+{
+  auto world = simulation::World::create();
+  world->getConstraintSolver()->setCollisionDetector(
+      collision::DARTCollisionDetector::create());
+
+  world->addSkeleton(createGround(Eigen::Vector3d(10.0, 10.0, 0.1)));
+  for (auto i = 0u; i < 3u; ++i)
+  {
+    world->addSkeleton(createBox(
+        Eigen::Vector3d::Constant(0.2),
+        Eigen::Vector3d(0.05 * i, 0.0, 0.15 + 0.25 * i)));
+  }
+
+  auto chain = createNLinkRobot(4, Eigen::Vector3d(0.1, 0.1, 0.3), DOF_ROLL);
+  for (auto* joint : chain->getJoints())
+  {
+    joint->setLimitEnforcement(true);
+    joint->setPositionLowerLimit(0, -0.3);
+    joint->setPositionUpperLimit(0, 0.3);
+  }
+  chain->setPositions(Eigen::VectorXd::Constant(chain->getNumDofs(), 0.5));
+  world->addSkeleton(chain);
+
+  return world;
+}
+
+//==============================================================================
+std::size_t stepAndCountAllocations(
+    const simulation::WorldPtr& world, std::size_t numSteps)
+{
+#ifdef DART_TEST_COUNT_ALLOCATIONS
+  gNumAllocations = 0u;
+  gIsCountingAllocations = true;
+#endif
+
+  for (auto i = 0u; i < numSteps; ++i)
+    world->step();
+
+#ifdef DART_TEST_COUNT_ALLOCATIONS
+  gIsCountingAllocations = false;
+  return gNumAllocations;
+#else
+  return 0u;
+#endif
+}
+
+//==============================================================================
+std::size_t saveStateAndCountAllocations(
+    const simulation::WorldPtr& world,
+    simulation::World::State& state,
+    std::size_t numSteps)
+{
+#ifdef DART_TEST_COUNT_ALLOCATIONS
+  gNumAllocations = 0u;
+  gIsCountingAllocations = true;
+#endif
+
+  for (auto i = 0u; i < numSteps; ++i)
+  {
+    world->step();
+    world->saveState(state);
+  }
+
+#ifdef DART_TEST_COUNT_ALLOCATIONS
+  gIsCountingAllocations = false;
+  return gNumAllocations;
+#else
+  return 0u;
+#endif
+}
+
+//==============================================================================
+TEST(RealTime, StepWithoutAllocations)
+{
+  auto world = createRealTimeWorld();
+  world->setRealTime(true, 100u, 300u);
+  EXPECT_TRUE(world->isRealTime());
+
+  const auto numAllocations = stepAndCountAllocations(world, 300u);
+  EXPECT_GT(world->getLastCollisionResult().getNumContacts(), 0u);
+  EXPECT_EQ(world->getNumRealTimeOverflows(), 0u);
+
+  // Assertions allocate temporaries in debug builds
+#ifdef NDEBUG
+  EXPECT_EQ(numAllocations, 0u);
+#else
+  DART_UNUSED(numAllocations);
+#endif
+
+  // The colliding objects are not recorded, but they can still be queried
+  const auto& result = world->getLastCollisionResult();
+  const auto* frame = result.getContact(0u).collisionObject1->getShapeFrame();
+  EXPECT_TRUE(result.getCollidingShapeFrames().empty());
+  EXPECT_TRUE(result.inCollision(frame));
+  EXPECT_TRUE(result.inCollision(frame->asShapeNode()->getBodyNodePtr()));
+
+  // The setting survives cloning
+  EXPECT_TRUE(world->clone()->isRealTime());
+
+  world->setRealTime(false);
+  EXPECT_FALSE(world->isRealTime());
+  EXPECT_EQ(result.getCollidingShapeFrames().count(frame), 1u);
+}
+
+//==============================================================================
+TEST(RealTime, CountOverflows)
+{
+  auto world = createRealTimeWorld();
+  world->setRealTime(true, 2u, 3u);
+
+  const auto numAllocations = stepAndCountAllocations(world, 300u);
+  EXPECT_LE(world->getLastCollisionResult().getNumContacts(), 2u);
+  EXPECT_GT(world->getNumRealTimeOverflows(), 0u);
+
+  // Exceeding the limits drops work instead of allocating
+#ifdef NDEBUG
+  EXPECT_EQ(numAllocations, 0u);
+#else
+  DART_UNUSED(numAllocations);
+#endif
+
+  for (auto i = 0u; i < world->getNumSkeletons(); ++i)
+    EXPECT_FALSE(world->getSkeleton(i)->getPositions().hasNaN());
+}
+
+//==============================================================================
+TEST(RealTime, PublishSnapshotsWithoutAllocations)
+{
+  auto world = createRealTimeWorld();
+  world->setRealTime(true, 100u, 300u);
+  world->setSnapshotPublishingEnabled(true);
+
+  // A reader holds a snapshot while the World keeps publishing
+  world->step();
+  const auto held = world->getSnapshot();
+
+  const auto numAllocations = stepAndCountAllocations(world, 300u);
+  const auto snapshot = world->getSnapshot();
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->mFrame, world->getSimFrames());
+  EXPECT_EQ(held->mFrame, 1);
+  EXPECT_GT(snapshot->mContacts.size(), 0u);
+
+#ifdef NDEBUG
+  EXPECT_EQ(numAllocations, 0u);
+#else
+  DART_UNUSED(numAllocations);
+#endif
+}
+
+//==============================================================================
+TEST(RealTime, SaveStateWithoutAllocations)
+{
+  auto world = createRealTimeWorld();
+  world->setRealTime(true, 100u, 300u);
+
+  // Saving into the same State reuses its buffers once they are large enough
+  simulation::World::State state;
+  stepAndCountAllocations(world, 100u);
+  world->saveState(state);
+  state.mCollisionResult.reserve(100u);
+
+  const auto numAllocations = saveStateAndCountAllocations(world, state, 100u);
+  EXPECT_GT(state.mCollisionResult.getNumContacts(), 0u);
+
+#ifdef NDEBUG
+  EXPECT_EQ(numAllocations, 0u);
+#else
+  DART_UNUSED(numAllocations);
+#endif
+}
@@ -37,6 +37,7 @@
 #include "dart/common/sub_ptr.hpp"
 #include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/SimpleFrame.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/math/Geometry.hpp"
 #include "dart/simulation/World.hpp"
@@ -874,6 +875,63 @@ TEST(Skeleton, LinearJacobianDerivOverload)
   linkage->getLinearJacobianDeriv(linkage->getBodyNode(0));
 }
 
+TEST(Skeleton, InPlaceJacobians)
+{
+  SkeletonPtr skeleton = createThreeLinkRobot(
+      Vector3d::Ones(),
+      DOF_PITCH,
+      Vector3d::Ones(),
+      DOF_ROLL,
+      Vector3d::Ones(),
+      DOF_YAW);
+  skeleton->setPositions(Eigen::VectorXd::Random(skeleton->getNumDofs()));
+  skeleton->setVelocities(Eigen::VectorXd::Random(skeleton->getNumDofs()));
+
+  const BodyNode* bn = skeleton->getBodyNode(1);
+  const Frame* frame = skeleton->getBodyNode(2);
+  const Eigen::Vector3d offset = Eigen::Vector3d::Random();
+
+  // The same buffer is reused for every call
+  math::Jacobian J;
+
+  skeleton->getJacobian(bn, J);
+  EXPECT_TRUE(equals(skeleton->getJacobian(bn), J));
+  skeleton->getJacobian(bn, frame, J);
+  EXPECT_TRUE(equals(skeleton->getJacobian(bn, frame), J));
+  skeleton->getJacobian(bn, offset, J);
+  EXPECT_TRUE(equals(skeleton->getJacobian(bn, offset), J));
+  skeleton->getJacobian(bn, offset, frame, J);
+  EXPECT_TRUE(equals(skeleton->getJacobian(bn, offset, frame), J));
+
+  skeleton->getWorldJacobian(bn, J);
+  EXPECT_TRUE(equals(skeleton->getWorldJacobian(bn), J));
+  skeleton->getWorldJacobian(bn, offset, J);
+  EXPECT_TRUE(equals(skeleton->getWorldJacobian(bn, offset), J));
+
+  skeleton->getJacobianSpatialDeriv(bn, J);
+  EXPECT_TRUE(equals(skeleton->getJacobianSpatialDeriv(bn), J));
+  skeleton->getJacobianSpatialDeriv(bn, frame, J);
+  EXPECT_TRUE(equals(skeleton->getJacobianSpatialDeriv(bn, frame), J));
+  skeleton->getJacobianSpatialDeriv(bn, offset, J);
+  EXPECT_TRUE(equals(skeleton->getJacobianSpatialDeriv(bn, offset), J));
+  skeleton->getJacobianSpatialDeriv(bn, offset, frame, J);
+  EXPECT_TRUE(
+      equals(skeleton->getJacobianSpatialDeriv(bn, offset, frame), J));
+
+  skeleton->getJacobianClassicDeriv(bn, J);
+  EXPECT_TRUE(equals(skeleton->getJacobianClassicDeriv(bn), J));
+  skeleton->getJacobianClassicDeriv(bn, frame, J);
+  EXPECT_TRUE(equals(skeleton->getJacobianClassicDeriv(bn, frame), J));
+  skeleton->getJacobianClassicDeriv(bn, offset, frame, J);
+  EXPECT_TRUE(
+      equals(skeleton->getJacobianClassicDeriv(bn, offset, frame), J));
+
+  // Columns of DOFs that the node does not depend on must be cleared
+  J.setOnes();
+  skeleton->getJacobian(skeleton->getBodyNode(0), J);
+  EXPECT_TRUE(equals(skeleton->getJacobian(skeleton->getBodyNode(0)), J));
+}
+
 TEST(Skeleton, Updating)
 {
   // Make sure that structural properties get automatically updated correctly
@@ -930,3 +988,90 @@ TEST(Skeleton, Updating)
   EXPECT_FALSE(originalMass == newMass);
   EXPECT_TRUE(newMass == originalMass - removedMass);
 }
+
+TEST(Skeleton, PositionUpdateBatch)
+{
+  SkeletonPtr skeleton = createThreeLinkRobot(
+      Vector3d::Ones(),
+      DOF_PITCH,
+      Vector3d::Ones(),
+      DOF_ROLL,
+      Vector3d::Ones(),
+      DOF_YAW);
+  SkeletonPtr reference = skeleton->cloneSkeleton();
+
+  const Eigen::VectorXd q = Eigen::VectorXd::Random(skeleton->getNumDofs());
+  reference->setPositions(q);
+
+  // Make sure that all the transforms are cached before the batch
+  for (std::size_t i = 0; i < skeleton->getNumBodyNodes(); ++i)
+    skeleton->getBodyNode(i)->getWorldTransform();
+
+  {
+    Skeleton::PositionUpdateBatch outer(skeleton.get());
+    EXPECT_TRUE(skeleton->isPositionUpdateBatchOpen());
+    for (std::size_t i = 0; i < skeleton->getNumDofs(); ++i)
+    {
+      Skeleton::PositionUpdateBatch inner(skeleton.get());
+      skeleton->getDof(i)->setPosition(0.5 * q[i]);
+      skeleton->getDof(i)->setPosition(q[i]);
+    }
+    EXPECT_TRUE(skeleton->isPositionUpdateBatchOpen());
+  }
+  EXPECT_FALSE(skeleton->isPositionUpdateBatchOpen());
+
+  for (std::size_t i = 0; i < skeleton->getNumBodyNodes(); ++i)
+  {
+    const BodyNode* bn = skeleton->getBodyNode(i);
+    const BodyNode* refBn = reference->getBodyNode(i);
+    EXPECT_TRUE(equals(
+        bn->getWorldTransform().matrix(), refBn->getWorldTransform().matrix()));
+    EXPECT_TRUE(equals(bn->getWorldJacobian(), refBn->getWorldJacobian()));
+  }
+
+  EXPECT_TRUE(equals(skeleton->getMassMatrix(), reference->getMassMatrix()));
+
+  // Reads inside a batch propagate the changes that are deferred so far
+  const std::size_t tipIndex = skeleton->getNumBodyNodes() - 1u;
+  const BodyNode* tip = skeleton->getBodyNode(tipIndex);
+  const BodyNode* refTip = reference->getBodyNode(tipIndex);
+  const Eigen::VectorXd q2 = Eigen::VectorXd::Random(skeleton->getNumDofs());
+  {
+    Skeleton::PositionUpdateBatch batch(skeleton.get());
+    skeleton->setPositions(q2);
+    reference->setPositions(q2);
+    EXPECT_TRUE(equals(
+        tip->getWorldTransform().matrix(),
+        refTip->getWorldTransform().matrix()));
+
+    skeleton->getDof(0)->setPosition(q[0]);
+    reference->getDof(0)->setPosition(q[0]);
+    EXPECT_TRUE(equals(tip->getWorldJacobian(), refTip->getWorldJacobian()));
+    EXPECT_TRUE(equals(skeleton->getMassMatrix(), reference->getMassMatrix()));
+
+    // So do the articulated inertia and the Frames attached to a BodyNode
+    SimpleFrame tipFrame(skeleton->getBodyNode(tipIndex));
+    skeleton->getDof(1)->setPosition(q[1]);
+    reference->getDof(1)->setPosition(q[1]);
+    EXPECT_TRUE(equals(
+        tipFrame.getWorldTransform().matrix(),
+        refTip->getWorldTransform().matrix()));
+    skeleton->getRootBodyNode()->getArticulatedInertia();
+    skeleton->getDof(1)->setPosition(q2[1]);
+    reference->getDof(1)->setPosition(q2[1]);
+    EXPECT_TRUE(equals(
+        skeleton->getRootBodyNode()->getArticulatedInertia(),
+        reference->getRootBodyNode()->getArticulatedInertia()));
+    EXPECT_TRUE(equals(
+        skeleton->getRootBodyNode()->getArticulatedInertiaImplicit(),
+        reference->getRootBodyNode()->getArticulatedInertiaImplicit()));
+
+    // Removing a Joint with a deferred change drops it from the batch
+    skeleton->getDof(skeleton->getNumDofs() - 1u)->setPosition(0.0);
+    skeleton->getBodyNode(tipIndex)->remove();
+  }
+  EXPECT_FALSE(skeleton->isPositionUpdateBatchOpen());
+  EXPECT_TRUE(equals(
+      skeleton->getBodyNode(tipIndex - 1u)->getWorldTransform().matrix(),
+      reference->getBodyNode(tipIndex - 1u)->getWorldTransform().matrix()));
+}
@@ -30,7 +30,9 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <atomic>
 #include <iostream>
+#include <thread>
 #include <gtest/gtest.h>
 #include "TestHelpers.hpp"
 
@@ -48,6 +50,7 @@
 #include "dart/constraint/DantzigBoxedLcpSolver.hpp"
 #include "dart/constraint/PgsBoxedLcpSolver.hpp"
 #include "dart/simulation/World.hpp"
+#include "dart/simulation/WorldBatch.hpp"
 
 using namespace dart;
 using namespace math;
@@ -396,3 +399,522 @@ TEST(World, SetNewConstraintSolver)
   EXPECT_TRUE(world->getConstraintSolver()->getSkeletons().size() == 1);
   EXPECT_TRUE(world->getConstraintSolver()->getConstraints().size() == 1);
 }
+
+//==============================================================================
+TEST(World, Sleeping)
+{
+  auto world = World::create();
+  world->setGravity(Eigen::Vector3d::Zero());
+  world->setSleepingEnabled(true);
+  world->setSleepTimeThreshold(10.0 * world->getTimeStep());
+
+  auto resting = createBox(Eigen::Vector3d::Ones());
+  auto moving = createBox(Eigen::Vector3d::Ones(), Eigen::Vector3d(3, 0, 0));
+  moving->setVelocities(
+      (Eigen::Vector6d() << 0.0, 0.0, 0.0, -5.0, 0.0, 0.0).finished());
+  world->addSkeleton(resting);
+  world->addSkeleton(moving);
+
+  for (auto i = 0u; i < 20u; ++i)
+    world->step();
+
+  EXPECT_TRUE(resting->isSleeping());
+  EXPECT_FALSE(moving->isSleeping());
+
+  // The moving box wakes up the resting box when they come into contact
+  bool woken = false;
+  for (auto i = 0u; i < 1000u && !woken; ++i)
+  {
+    world->step();
+    woken = !resting->isSleeping();
+  }
+
+  EXPECT_TRUE(woken);
+
+  // Separate the boxes and let them fall asleep again
+  resting->setPositions(Eigen::VectorXd::Zero(6));
+  resting->setVelocities(Eigen::VectorXd::Zero(6));
+  moving->setPositions(
+      (Eigen::Vector6d() << 0.0, 0.0, 0.0, 3.0, 0.0, 0.0).finished());
+  moving->setVelocities(Eigen::VectorXd::Zero(6));
+  for (auto i = 0u; i < 20u; ++i)
+    world->step();
+
+  EXPECT_TRUE(resting->isSleeping());
+  EXPECT_TRUE(moving->isSleeping());
+
+  // An external force wakes up a sleeping Skeleton
+  const Eigen::VectorXd sleepingPositions = moving->getPositions();
+  moving->getBodyNode(0)->addExtForce(Eigen::Vector3d(0, 0, 10));
+  world->step();
+  EXPECT_FALSE(moving->isSleeping());
+  EXPECT_GT(moving->getVelocities()[5], 0.0);
+  EXPECT_GT(moving->getPositions()[5], sleepingPositions[5]);
+  EXPECT_TRUE(resting->isSleeping());
+
+  // Disabling sleeping wakes up all the Skeletons
+  world->setSleepingEnabled(false);
+  world->step();
+  EXPECT_FALSE(resting->isSleeping());
+}
+
+//==============================================================================
+TEST(World, SleepingWokenByImmobileSkeleton)
+{
+  auto world = World::create();
+  world->setGravity(Eigen::Vector3d::Zero());
+  world->setSleepingEnabled(true);
+  world->setSleepTimeThreshold(10.0 * world->getTimeStep());
+
+  auto resting = createBox(Eigen::Vector3d::Ones());
+  auto pusher = createBox(Eigen::Vector3d::Ones(), Eigen::Vector3d(3, 0, 0));
+  pusher->setMobile(false);
+  world->addSkeleton(resting);
+  world->addSkeleton(pusher);
+
+  // This box rests against the other side of the resting box, since their
+  // penetration is within the error allowance of the contacts
+  auto behind
+      = createBox(Eigen::Vector3d::Ones(), Eigen::Vector3d(-0.999, 0, 0));
+  world->addSkeleton(behind);
+  world->getConstraintSolver()->setContactParameters(
+      constraint::ConstraintParameters(0.01));
+
+  for (auto i = 0u; i < 20u; ++i)
+    world->step();
+
+  // Immobile Skeletons sleep while they hold still
+  EXPECT_TRUE(resting->isSleeping());
+  EXPECT_TRUE(pusher->isSleeping());
+  EXPECT_TRUE(behind->isSleeping());
+  EXPECT_TRUE(resting->clone()->isSleeping());
+
+  // Moving the immobile Skeleton wakes it up, and pushing it into the sleeping
+  // Skeleton wakes that one up as well
+  Eigen::VectorXd positions = pusher->getPositions();
+  bool woken = false;
+  for (auto i = 0u; i < 300u && !woken; ++i)
+  {
+    positions[3] -= 0.01;
+    pusher->setPositions(positions);
+    EXPECT_FALSE(pusher->isSleeping());
+
+    world->step();
+    woken = !resting->isSleeping();
+  }
+
+  // The contact of the two sleeping boxes is detected in the same step, so the
+  // whole island is woken up at once
+  EXPECT_TRUE(woken);
+  EXPECT_FALSE(behind->isSleeping());
+
+  for (auto i = 0u; i < 10u; ++i)
+  {
+    positions[3] -= 0.01;
+    pusher->setPositions(positions);
+    world->step();
+  }
+
+  EXPECT_FALSE(resting->isSleeping());
+  EXPECT_LT(resting->getPositions()[3], 0.0);
+}
+
+//==============================================================================
+TEST(World, SubStepping)
+{
+  const double timeStep = 1e-3;
+  const std::size_t numSubSteps = 4u;
+
+  auto fineWorld = World::create();
+  fineWorld->setTimeStep(timeStep);
+  fineWorld->addSkeleton(createBox(Eigen::Vector3d::Ones()));
+
+  auto subSteppedWorld = World::create();
+  subSteppedWorld->setTimeStep(numSubSteps * timeStep);
+  subSteppedWorld->setNumSubSteps(numSubSteps);
+  subSteppedWorld->addSkeleton(createBox(Eigen::Vector3d::Ones()));
+
+  EXPECT_EQ(subSteppedWorld->getNumSubSteps(), numSubSteps);
+  EXPECT_DOUBLE_EQ(subSteppedWorld->getSubTimeStep(), timeStep);
+  EXPECT_DOUBLE_EQ(
+      subSteppedWorld->getConstraintSolver()->getTimeStep(), timeStep);
+  EXPECT_DOUBLE_EQ(subSteppedWorld->getSkeleton(0)->getTimeStep(), timeStep);
+
+  // Zero substeps is not allowed
+  subSteppedWorld->setNumSubSteps(0u);
+  EXPECT_EQ(subSteppedWorld->getNumSubSteps(), numSubSteps);
+
+  for (std::size_t i = 0u; i < 10u; ++i)
+  {
+    for (std::size_t j = 0u; j < numSubSteps; ++j)
+      fineWorld->step();
+
+    subSteppedWorld->step();
+  }
+
+  EXPECT_NEAR(fineWorld->getTime(), subSteppedWorld->getTime(), 1e-12);
+  EXPECT_EQ(subSteppedWorld->getSimFrames(), 10);
+  EXPECT_TRUE(equals(
+      fineWorld->getSkeleton(0)->getPositions(),
+      subSteppedWorld->getSkeleton(0)->getPositions()));
+  EXPECT_TRUE(equals(
+      fineWorld->getSkeleton(0)->getVelocities(),
+      subSteppedWorld->getSkeleton(0)->getVelocities()));
+}
+
+//==============================================================================
+WorldPtr createBoxStackWorld(std::size_t numSubSteps)
+{
+  auto world = World::create();
+  world->setTimeStep(4e-3);
+  world->setNumSubSteps(numSubSteps);
+  world->addSkeleton(createGround(Eigen::Vector3d(10.0, 10.0, 0.1)));
+
+  // The boxes start penetrating each other and the ground by 1 cm
+  for (auto i = 0u; i < 3u; ++i)
+  {
+    world->addSkeleton(createBox(
+        Eigen::Vector3d::Constant(0.2),
+        Eigen::Vector3d(0.0, 0.0, 0.14 + 0.19 * i)));
+  }
+
+  auto solver = world->getConstraintSolver();
+  auto parameters = solver->getContactParameters();
+  parameters.errorReductionParameter = 0.2;
+  parameters.maxErrorReductionVelocity = 10.0;
+  solver->setContactParameters(parameters);
+
+  return world;
+}
+
+//==============================================================================
+TEST(World, SubSteppingRestingContacts)
+{
+  // The substeps that reuse the contacts of the first one only correct the
+  // penetration that is left, so the stack comes to rest like without
+  // substeps instead of being pushed apart
+  auto world = createBoxStackWorld(1u);
+  auto subSteppedWorld = createBoxStackWorld(4u);
+
+  for (auto i = 0u; i < 500u; ++i)
+  {
+    world->step();
+    subSteppedWorld->step();
+  }
+
+  for (auto i = 1u; i < world->getNumSkeletons(); ++i)
+  {
+    const auto skel = world->getSkeleton(i);
+    const auto subSteppedSkel = subSteppedWorld->getSkeleton(i);
+
+    EXPECT_TRUE(equals(skel->getPositions(), subSteppedSkel->getPositions()));
+    EXPECT_TRUE(subSteppedSkel->getVelocities().isZero(1e-6));
+  }
+}
+
+//==============================================================================
+TEST(World, AdaptiveSubStepping)
+{
+  auto world = World::create();
+  world->setTimeStep(4e-3);
+  world->setPenetrationTolerance(1e-3);
+  world->setMaxNumSubSteps(8u);
+  world->addSkeleton(createGround(Eigen::Vector3d(10.0, 10.0, 0.1)));
+  auto box = createBox(
+      Eigen::Vector3d::Constant(0.2), Eigen::Vector3d(0.0, 0.0, 0.5));
+  box->setVelocities(
+      (Eigen::Vector6d() << 0.0, 0.0, 0.0, 0.0, 0.0, -5.0).finished());
+  world->addSkeleton(box);
+
+  EXPECT_FALSE(world->isAdaptiveSubSteppingEnabled());
+  world->setAdaptiveSubSteppingEnabled(true);
+  EXPECT_TRUE(world->isAdaptiveSubSteppingEnabled());
+
+  // The number of substeps doubles up to the maximum while the box penetrates
+  // the ground deeper than the tolerance
+  std::size_t maxNumSubSteps = 1u;
+  for (auto i = 0u; i < 100u; ++i)
+  {
+    world->step();
+    maxNumSubSteps = std::max(maxNumSubSteps, world->getNumSubSteps());
+  }
+
+  EXPECT_EQ(maxNumSubSteps, 8u);
+  EXPECT_EQ(world->getNumSubSteps(), 8u);
+
+  // Without contacts, it is halved down to one
+  box->setPositions(
+      (Eigen::Vector6d() << 0.0, 0.0, 0.0, 0.0, 0.0, 1.0).finished());
+  box->setVelocities(Eigen::VectorXd::Zero(6));
+  for (const std::size_t numSubSteps : {4u, 2u, 1u, 1u})
+  {
+    world->step();
+    EXPECT_EQ(world->getNumSubSteps(), numSubSteps);
+  }
+
+  // Disabling adaptive sub-stepping keeps the number of substeps
+  world->setAdaptiveSubSteppingEnabled(false);
+  world->setNumSubSteps(2u);
+  box->setPositions(Eigen::VectorXd::Zero(6));
+  for (auto i = 0u; i < 10u; ++i)
+    world->step();
+  EXPECT_EQ(world->getNumSubSteps(), 2u);
+}
+
+//==============================================================================
+TEST(World, SaveAndRestoreState)
+{
+  auto world = World::create();
+  world->addSkeleton(createGround(Eigen::Vector3d(10.0, 10.0, 0.1)));
+  world->addSkeleton(createBox(
+      Eigen::Vector3d::Constant(0.2),
+      Eigen::Vector3d(0.0, 0.0, 0.3),
+      Eigen::Vector3d(0.1, 0.2, 0.3)));
+
+  for (auto i = 0u; i < 100u; ++i)
+    world->step();
+
+  World::State state;
+  world->saveState(state);
+  const double savedTime = world->getTime();
+  const int savedFrame = world->getSimFrames();
+
+  for (auto i = 0u; i < 200u; ++i)
+    world->step();
+  const Eigen::VectorXd positions = world->getSkeleton(1)->getPositions();
+  const Eigen::VectorXd velocities = world->getSkeleton(1)->getVelocities();
+
+  EXPECT_TRUE(world->restoreState(state));
+  EXPECT_DOUBLE_EQ(world->getTime(), savedTime);
+  EXPECT_EQ(world->getSimFrames(), savedFrame);
+  EXPECT_TRUE(equals(
+      world->getSkeleton(1)->getPositions(),
+      Eigen::VectorXd(state.mPositions.tail(6))));
+
+  // Rolling out again from the restored state reproduces the same result
+  for (auto i = 0u; i < 200u; ++i)
+    world->step();
+  EXPECT_TRUE(equals(world->getSkeleton(1)->getPositions(), positions));
+  EXPECT_TRUE(equals(world->getSkeleton(1)->getVelocities(), velocities));
+
+  // Commands are restored as they were saved, without clipping them to the
+  // current limits of the actuators
+  auto* dof = world->getSkeleton(1)->getDof(0);
+  dof->setCommand(5.0);
+  world->saveState(state);
+  dof->setForceLimits(-1.0, 1.0);
+  dof->setCommand(0.0);
+  EXPECT_TRUE(world->restoreState(state));
+  EXPECT_DOUBLE_EQ(dof->getCommand(), 5.0);
+
+  // A state that doesn't match the structure of the World is rejected
+  world->addSkeleton(createBox(Eigen::Vector3d::Constant(0.2)));
+  EXPECT_FALSE(world->restoreState(state));
+}
+
+//==============================================================================
+TEST(World, DeterministicReplay)
+{
+  auto world = World::create();
+  world->setDeterministic(true);
+  world->addSkeleton(createGround(Eigen::Vector3d(10.0, 10.0, 0.1)));
+  for (auto i = 0u; i < 4u; ++i)
+  {
+    world->addSkeleton(createBox(
+        Eigen::Vector3d::Constant(0.2),
+        Eigen::Vector3d(0.05 * i, -0.03 * i, 0.2 + 0.25 * i),
+        Eigen::Vector3d(0.1 * i, 0.2, 0.3 * i)));
+  }
+
+  EXPECT_TRUE(world->isDeterministic());
+  EXPECT_TRUE(world->getConstraintSolver()->isDeterministic());
+
+  const std::size_t numSteps = 300u;
+  const auto initialState = world->saveState();
+  auto replayWorld = world->clone();
+  EXPECT_TRUE(replayWorld->isDeterministic());
+  EXPECT_EQ(world->computeStateHash(), replayWorld->computeStateHash());
+
+  // Log the state hash of every step of a reference run
+  std::vector<std::uint64_t> hashes;
+  for (auto i = 0u; i < numSteps; ++i)
+  {
+    world->step();
+    hashes.push_back(world->computeStateHash());
+  }
+
+  // The contacts make the trajectory nontrivial
+  EXPECT_FALSE(world->getLastCollisionResult().getContacts().empty());
+
+  // Replaying from the same initial state reproduces every step bitwise, both
+  // in a clone and in the original World
+  world->restoreState(initialState);
+  for (auto i = 0u; i < numSteps; ++i)
+  {
+    replayWorld->step();
+    world->step();
+    ASSERT_EQ(replayWorld->computeStateHash(), hashes[i]) << "step " << i;
+    ASSERT_EQ(world->computeStateHash(), hashes[i]) << "step " << i;
+  }
+
+  // Stepping the Worlds concurrently doesn't change the trajectories
+  world->restoreState(initialState);
+  for (const std::size_t numThreads : {1u, 4u})
+  {
+    WorldBatch batch(world, 4u, numThreads);
+    for (auto i = 0u; i < numSteps; ++i)
+    {
+      batch.step();
+      for (auto j = 0u; j < batch.getNumWorlds(); ++j)
+      {
+        ASSERT_EQ(batch.getWorld(j)->computeStateHash(), hashes[i])
+            << "step " << i << ", world " << j << ", " << numThreads
+            << " threads";
+      }
+    }
+  }
+}
+
+//==============================================================================
+TEST(World, DeterministicReplayWithRandomizedPgs)
+{
+  auto createWorld = []() {
+    auto world = World::create();
+    world->setDeterministic(true);
+    world->addSkeleton(createGround(Eigen::Vector3d(10.0, 10.0, 0.1)));
+    for (auto i = 0u; i < 4u; ++i)
+    {
+      world->addSkeleton(createBox(
+          Eigen::Vector3d::Constant(0.2),
+          Eigen::Vector3d(0.05 * i, -0.03 * i, 0.2 + 0.25 * i),
+          Eigen::Vector3d(0.1 * i, 0.2, 0.3 * i)));
+    }
+
+    // PGS shuffles the order of the constraints with its own random number
+    // generator
+    auto pgs = std::make_shared<constraint::PgsBoxedLcpSolver>();
+    auto option = pgs->getOption();
+    option.mRandomizeConstraintOrder = true;
+    pgs->setOption(option);
+    world->setConstraintSolver(
+        std::make_unique<constraint::BoxedLcpConstraintSolver>(pgs));
+
+    return world;
+  };
+
+  auto world = createWorld();
+  auto otherWorld = createWorld();
+
+  const std::size_t numSteps = 300u;
+  const auto initialState = world->saveState();
+
+  std::vector<std::uint64_t> hashes;
+  for (auto i = 0u; i < numSteps; ++i)
+  {
+    world->step();
+    hashes.push_back(world->computeStateHash());
+  }
+
+  EXPECT_FALSE(world->getLastCollisionResult().getContacts().empty());
+
+  // Replaying from the initial state reproduces every step bitwise, both in
+  // the World that already ran and in a new one
+  world->restoreState(initialState);
+  for (auto i = 0u; i < numSteps; ++i)
+  {
+    world->step();
+    otherWorld->step();
+    ASSERT_EQ(world->computeStateHash(), hashes[i]) << "step " << i;
+    ASSERT_EQ(otherWorld->computeStateHash(), hashes[i]) << "step " << i;
+  }
+}
+
+//==============================================================================
+TEST(World, PublishSnapshot)
+{
+  auto world = World::create();
+  world->addSkeleton(createGround(Eigen::Vector3d(10.0, 10.0, 0.1)));
+  world->addSkeleton(createBox(
+      Eigen::Vector3d::Constant(0.2), Eigen::Vector3d(0.0, 0.0, 0.15)));
+
+  EXPECT_FALSE(world->isSnapshotPublishingEnabled());
+  world->step();
+  EXPECT_EQ(world->getSnapshot(), nullptr);
+
+  world->setSnapshotPublishingEnabled(true);
+  EXPECT_TRUE(world->isSnapshotPublishingEnabled());
+  for (auto i = 0u; i < 10u; ++i)
+    world->step();
+
+  // The snapshot matches the World at the end of the last step
+  auto snapshot = world->getSnapshot();
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->mTime, world->getTime());
+  EXPECT_EQ(snapshot->mFrame, world->getSimFrames());
+  ASSERT_EQ(snapshot->mSkeletons.size(), world->getNumSkeletons());
+  for (auto i = 0u; i < world->getNumSkeletons(); ++i)
+  {
+    const auto skel = world->getSkeleton(i);
+    const auto& state = snapshot->mSkeletons[i];
+    EXPECT_EQ(state.mName, skel->getName());
+    EXPECT_TRUE(equals(state.mPositions, skel->getPositions()));
+    EXPECT_TRUE(equals(state.mVelocities, skel->getVelocities()));
+    ASSERT_EQ(state.mBodyTransforms.size(), skel->getNumBodyNodes());
+    for (auto j = 0u; j < skel->getNumBodyNodes(); ++j)
+    {
+      EXPECT_TRUE(equals(
+          state.mBodyTransforms[j].matrix(),
+          skel->getBodyNode(j)->getWorldTransform().matrix()));
+    }
+  }
+
+  // The box rests on the ground, so the contacts are published too
+  const auto& contacts = world->getLastCollisionResult().getContacts();
+  ASSERT_FALSE(contacts.empty());
+  ASSERT_EQ(snapshot->mContacts.size(), contacts.size());
+  for (const auto& contact : snapshot->mContacts)
+  {
+    EXPECT_LT(contact.mSkeleton1, snapshot->mSkeletons.size());
+    EXPECT_LT(contact.mSkeleton2, snapshot->mSkeletons.size());
+    EXPECT_NE(contact.mSkeleton1, contact.mSkeleton2);
+  }
+
+  // A snapshot held by a reader is never modified by later steps
+  const auto heldTime = snapshot->mTime;
+  const Eigen::VectorXd heldPositions = snapshot->mSkeletons[1].mPositions;
+  world->getSkeleton(1)->setVelocities(Eigen::VectorXd::Ones(6));
+  for (auto i = 0u; i < 10u; ++i)
+    world->step();
+  EXPECT_EQ(snapshot->mTime, heldTime);
+  EXPECT_TRUE(equals(snapshot->mSkeletons[1].mPositions, heldPositions));
+  EXPECT_NE(world->getSnapshot(), snapshot);
+  EXPECT_EQ(world->getSnapshot()->mFrame, world->getSimFrames());
+
+  // Nothing is published while readers hold all the other buffers
+  auto newer = world->getSnapshot();
+  world->step();
+  EXPECT_FALSE(world->publishSnapshot());
+  EXPECT_EQ(world->getSnapshot()->mFrame, world->getSimFrames());
+  newer.reset();
+  EXPECT_TRUE(world->publishSnapshot());
+
+  // Readers on other threads always see consistent snapshots while the World
+  // keeps stepping
+  std::atomic<bool> done(false);
+  std::atomic<bool> consistent(true);
+  std::thread reader([&]() {
+    int lastFrame = 0;
+    while (!done.load())
+    {
+      const auto s = world->getSnapshot();
+      if (s->mFrame < lastFrame || s->mSkeletons.size() != 2u)
+        consistent.store(false);
+      lastFrame = s->mFrame;
+    }
+  });
+  for (auto i = 0u; i < 200u; ++i)
+    world->step();
+  done.store(true);
+  reader.join();
+  EXPECT_TRUE(consistent.load());
+}
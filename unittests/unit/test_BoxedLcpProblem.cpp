@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <gtest/gtest.h>
+
+#include "dart/external/odelcpsolver/common.h"
+
+#include "dart/constraint/ApgdBoxedLcpSolver.hpp"
+#include "dart/constraint/BoxedLcpProblem.hpp"
+#include "dart/constraint/DantzigBoxedLcpSolver.hpp"
+#include "dart/constraint/LemkeBoxedLcpSolver.hpp"
+#include "dart/constraint/PgsBoxedLcpSolver.hpp"
+
+using namespace dart;
+using namespace constraint;
+
+//==============================================================================
+/// Contacts, each with a normal row followed by two friction rows
+BoxedLcpProblem makeContactProblem(int numContacts = 2)
+{
+  const int n = 3 * numContacts;
+  const Eigen::MatrixXd J = Eigen::MatrixXd::Random(n, 2 * n);
+
+  BoxedLcpProblem problem;
+  problem.A = J * J.transpose() + 0.1 * Eigen::MatrixXd::Identity(n, n);
+  problem.x = Eigen::VectorXd::Zero(n);
+  problem.b = Eigen::VectorXd::Random(n);
+  problem.lo.resize(n);
+  problem.hi.resize(n);
+  problem.findex.resize(n);
+  for (int i = 0; i < n; i += 3)
+  {
+    problem.b[i] = std::abs(problem.b[i]);
+    problem.lo[i] = 0.0;
+    problem.hi[i] = static_cast<double>(dInfinity);
+    problem.findex[i] = -1;
+    for (int j = 1; j < 3; ++j)
+    {
+      problem.lo[i + j] = -0.5;
+      problem.hi[i + j] = 0.5;
+      problem.findex[i + j] = i;
+    }
+  }
+
+  return problem;
+}
+
+//==============================================================================
+TEST(BoxedLcpProblem, Residual)
+{
+  // Boxed LCP without friction coupling, which Dantzig solves exactly
+  BoxedLcpProblem problem = makeContactProblem();
+  problem.lo.setConstant(-0.5);
+  problem.hi.setConstant(0.5);
+  problem.findex.setConstant(-1);
+
+  DantzigBoxedLcpSolver dantzig;
+  Eigen::VectorXd solution;
+  EXPECT_TRUE(problem.solve(dantzig, solution));
+  EXPECT_LT(problem.computeResidual(solution), 1e-9);
+
+  // The problem itself is left untouched by the solver
+  EXPECT_TRUE(problem.x.isZero());
+
+  Eigen::VectorXd perturbed = solution;
+  perturbed[0] += 0.1;
+  EXPECT_GT(problem.computeResidual(perturbed), 1e-3);
+
+  // Friction bounds are scaled by the normal impulse
+  BoxedLcpProblem friction;
+  friction.A = Eigen::Matrix2d::Identity();
+  friction.x = Eigen::Vector2d::Zero();
+  friction.b = Eigen::Vector2d(1.0, 1.0);
+  friction.lo = Eigen::Vector2d(0.0, -0.5);
+  friction.hi = Eigen::Vector2d(static_cast<double>(dInfinity), 0.5);
+  friction.findex = Eigen::Vector2i(-1, 0);
+  EXPECT_DOUBLE_EQ(friction.computeResidual(Eigen::Vector2d(1.0, 0.5)), 0.0);
+  EXPECT_DOUBLE_EQ(friction.computeResidual(Eigen::Vector2d(1.0, 1.0)), 0.5);
+  EXPECT_DOUBLE_EQ(friction.computeResidual(Eigen::Vector2d(2.0, 1.0)), 1.0);
+}
+
+//==============================================================================
+TEST(BoxedLcpProblem, DantzigWorkspaceReuse)
+{
+  // A solver reusing its workspace across problems of different sizes gives
+  // the same solutions as fresh solvers
+  DantzigBoxedLcpSolver reused;
+  reused.reserve(6);
+  for (const int numContacts : {1, 4, 2, 5})
+  {
+    const BoxedLcpProblem problem = makeContactProblem(numContacts);
+
+    Eigen::VectorXd reusedSolution;
+    Eigen::VectorXd freshSolution;
+    DantzigBoxedLcpSolver fresh;
+    EXPECT_EQ(
+        problem.solve(reused, reusedSolution),
+        problem.solve(fresh, freshSolution));
+    EXPECT_EQ(reusedSolution, freshSolution);
+  }
+}
+
+//==============================================================================
+TEST(BoxedLcpProblem, DantzigWarmStart)
+{
+  // Sticking contacts, so that the solution is reachable from a guess
+  BoxedLcpProblem problem = makeContactProblem(4);
+  for (int i = 0; i < problem.findex.size(); ++i)
+  {
+    if (problem.findex[i] >= 0)
+    {
+      problem.lo[i] = -10.0;
+      problem.hi[i] = 10.0;
+    }
+  }
+
+  DantzigBoxedLcpSolver cold;
+  Eigen::VectorXd coldSolution;
+  ASSERT_TRUE(problem.solve(cold, coldSolution));
+
+  DantzigBoxedLcpSolver warm;
+  warm.setWarmStarting(true);
+  EXPECT_TRUE(warm.isWarmStarting());
+
+  // The solution of the same problem is accepted as a guess
+  problem.x = coldSolution;
+  Eigen::VectorXd warmSolution;
+  EXPECT_TRUE(problem.solve(warm, warmSolution));
+  EXPECT_EQ(warm.getNumWarmStarts(), 1u);
+  EXPECT_TRUE(warmSolution.isApprox(coldSolution, 1e-9));
+  EXPECT_LT(problem.computeResidual(warmSolution), 1e-9);
+
+  // A wrong guess falls back to a cold start
+  problem.x.setZero();
+  EXPECT_TRUE(problem.solve(warm, warmSolution));
+  EXPECT_EQ(warm.getNumWarmStarts(), 1u);
+  EXPECT_EQ(warmSolution, coldSolution);
+}
+
+//==============================================================================
+TEST(BoxedLcpProblem, LemkeSolver)
+{
+  LemkeBoxedLcpSolver lemke;
+  Eigen::VectorXd solution;
+
+  // Boxed rows only
+  BoxedLcpProblem boxed = makeContactProblem(3);
+  boxed.lo.setConstant(-0.5);
+  boxed.hi.setConstant(0.5);
+  boxed.findex.setConstant(-1);
+  EXPECT_TRUE(boxed.solve(lemke, solution));
+  EXPECT_LT(boxed.computeResidual(solution), 1e-6);
+
+  // Rows with one or no bounds
+  BoxedLcpProblem unbounded = boxed;
+  unbounded.lo[0] = -static_cast<double>(dInfinity);
+  unbounded.hi[1] = static_cast<double>(dInfinity);
+  unbounded.lo[2] = -static_cast<double>(dInfinity);
+  unbounded.hi[2] = static_cast<double>(dInfinity);
+  EXPECT_TRUE(unbounded.solve(lemke, solution));
+  EXPECT_LT(unbounded.computeResidual(solution), 1e-6);
+
+  // Contacts with friction, solved by the same solver
+  for (const int numContacts : {1, 4, 8})
+  {
+    const BoxedLcpProblem contact = makeContactProblem(numContacts);
+    EXPECT_TRUE(contact.solve(lemke, solution));
+    EXPECT_LT(contact.computeResidual(solution), 1e-6);
+  }
+
+  // Friction rows need a nonnegative normal
+  BoxedLcpProblem invalid = makeContactProblem(1);
+  invalid.lo[0] = -1.0;
+  EXPECT_FALSE(invalid.solve(lemke, solution));
+}
+
+//==============================================================================
+TEST(BoxedLcpProblem, ApgdSolver)
+{
+  ApgdBoxedLcpSolver apgd;
+  apgd.setOption(ApgdBoxedLcpSolver::Option(10000, 1e-9));
+  Eigen::VectorXd solution;
+
+  // Boxed rows only
+  BoxedLcpProblem boxed = makeContactProblem(3);
+  boxed.lo.setConstant(-0.5);
+  boxed.hi.setConstant(0.5);
+  boxed.findex.setConstant(-1);
+  EXPECT_TRUE(boxed.solve(apgd, solution));
+  EXPECT_LT(boxed.computeResidual(solution), 1e-6);
+
+  // A single friction row per normal is bounded as in the boxed LCP
+  BoxedLcpProblem planar = makeContactProblem(4);
+  for (int i = 2; i < planar.getDimension(); i += 3)
+  {
+    planar.lo[i] = 0.0;
+    planar.hi[i] = 0.0;
+    planar.findex[i] = -1;
+  }
+  EXPECT_TRUE(planar.solve(apgd, solution));
+  EXPECT_LT(planar.computeResidual(solution), 1e-6);
+
+  // Two friction rows per normal are bounded by the friction cone
+  for (const int numContacts : {1, 4, 8})
+  {
+    const BoxedLcpProblem contact = makeContactProblem(numContacts);
+    ASSERT_TRUE(contact.solve(apgd, solution));
+    EXPECT_LT(apgd.getResidual(), 1e-9);
+
+    for (int i = 0; i < contact.getDimension(); i += 3)
+    {
+      EXPECT_GE(solution[i], 0.0);
+      EXPECT_LE(solution.segment<2>(i + 1).norm(), 0.5 * solution[i] + 1e-9);
+    }
+
+    // Coulomb friction is the cone complementarity between x and the
+    // velocities w = A*x - b, where the normal velocities are raised by mu
+    // times the sliding velocities (De Saxce). So no other point of the cones
+    // is in a descent direction of the raised velocities.
+    Eigen::VectorXd w = contact.A * solution - contact.b;
+    for (int i = 0; i < contact.getDimension(); i += 3)
+    {
+      EXPECT_GE(w[i], -1e-6);
+      w[i] += 0.5 * w.segment<2>(i + 1).norm();
+    }
+
+    for (int sample = 0; sample < 20; ++sample)
+    {
+      Eigen::VectorXd other = Eigen::VectorXd::Random(contact.getDimension());
+      for (int i = 0; i < contact.getDimension(); i += 3)
+      {
+        other[i] = std::abs(other[i]);
+        other.segment<2>(i + 1) *= 0.5 * other[i] / std::sqrt(2.0);
+      }
+      EXPECT_GE(w.dot(other - solution), -1e-6);
+    }
+    EXPECT_NEAR(w.dot(solution), 0.0, 1e-6);
+  }
+
+  // Friction rows need a normal that is bounded by zero from below only
+  BoxedLcpProblem invalid = makeContactProblem(1);
+  invalid.lo[0] = -1.0;
+  EXPECT_FALSE(invalid.solve(apgd, solution));
+
+  // Problems that are not finite, or whose steps overflow, fail rather than
+  // backtrack forever
+  BoxedLcpProblem diverging = makeContactProblem(2);
+  diverging.b[0] = 1e300;
+  EXPECT_FALSE(diverging.solve(apgd, solution));
+  diverging.b[0] = std::numeric_limits<double>::infinity();
+  EXPECT_FALSE(diverging.solve(apgd, solution));
+  diverging.b[0] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(diverging.solve(apgd, solution));
+}
+
+//==============================================================================
+TEST(BoxedLcpProblem, SolveBudget)
+{
+  const BoxedLcpProblem problem = makeContactProblem(8);
+  const auto past = std::chrono::steady_clock::now();
+  const auto future = std::chrono::steady_clock::time_point::max();
+
+  PgsBoxedLcpSolver pgs;
+  pgs.setOption(PgsBoxedLcpSolver::Option(1000, 1e-12, 1e-12));
+  ApgdBoxedLcpSolver apgd;
+  apgd.setOption(ApgdBoxedLcpSolver::Option(10000, 1e-9));
+
+  for (BoxedLcpSolver* solver : {static_cast<BoxedLcpSolver*>(&pgs),
+                                 static_cast<BoxedLcpSolver*>(&apgd)})
+  {
+    EXPECT_TRUE(solver->isInterruptible());
+
+    Eigen::VectorXd converged;
+    problem.solve(*solver, converged);
+    EXPECT_FALSE(solver->isInterrupted());
+    EXPECT_GT(solver->getNumIterations(), 5);
+
+    // The iterate of an interrupted solve is usable but less accurate
+    Eigen::VectorXd interrupted;
+    solver->setBudget(5, future);
+    EXPECT_FALSE(problem.solve(*solver, interrupted));
+    EXPECT_TRUE(solver->isInterrupted());
+    EXPECT_EQ(solver->getNumIterations(), 5);
+    EXPECT_FALSE(interrupted.hasNaN());
+    EXPECT_GT(
+        problem.computeResidual(interrupted),
+        problem.computeResidual(converged));
+
+    // A deadline that has passed still leaves a single iteration
+    solver->setBudget(1000, past);
+    EXPECT_FALSE(problem.solve(*solver, interrupted));
+    EXPECT_TRUE(solver->isInterrupted());
+    EXPECT_EQ(solver->getNumIterations(), 1);
+
+    solver->clearBudget();
+    problem.solve(*solver, interrupted);
+    EXPECT_FALSE(solver->isInterrupted());
+    EXPECT_TRUE(interrupted.isApprox(converged));
+  }
+
+  // Pivoting solvers run to completion
+  DantzigBoxedLcpSolver dantzig;
+  EXPECT_FALSE(dantzig.isInterruptible());
+}
+
+//==============================================================================
+TEST(BoxedLcpProblem, CorpusRoundTrip)
+{
+  const std::string path = "test_BoxedLcpProblem.lcp";
+
+  std::vector<BoxedLcpProblem> problems;
+  for (int i = 0; i < 3; ++i)
+  {
+    problems.push_back(makeContactProblem());
+    problems.back().solveTime = 0.5 * i;
+    problems.back().isFallback = (i == 1);
+  }
+
+  BoxedLcpCorpusWriter writer;
+  ASSERT_TRUE(writer.open(path));
+  for (const auto& problem : problems)
+    writer.write(problem);
+  EXPECT_EQ(writer.getNumProblems(), problems.size());
+  writer.close();
+  EXPECT_FALSE(writer.isOpen());
+
+  const auto corpus = readBoxedLcpCorpus(path);
+  ASSERT_EQ(corpus.size(), problems.size());
+  for (std::size_t i = 0u; i < corpus.size(); ++i)
+  {
+    EXPECT_EQ(corpus[i].A, problems[i].A);
+    EXPECT_EQ(corpus[i].x, problems[i].x);
+    EXPECT_EQ(corpus[i].b, problems[i].b);
+    EXPECT_EQ(corpus[i].lo, problems[i].lo);
+    EXPECT_EQ(corpus[i].hi, problems[i].hi);
+    EXPECT_EQ(corpus[i].findex, problems[i].findex);
+    EXPECT_EQ(corpus[i].solveTime, problems[i].solveTime);
+    EXPECT_EQ(corpus[i].isFallback, problems[i].isFallback);
+  }
+
+  // A corpus cut in the middle of a problem keeps the complete ones
+  std::ifstream in(path, std::ios::binary);
+  const std::string content(
+      (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(content.data(), static_cast<std::streamsize>(content.size() - 8u));
+  out.close();
+  EXPECT_EQ(readBoxedLcpCorpus(path).size(), problems.size() - 1u);
+
+  std::remove(path.c_str());
+}
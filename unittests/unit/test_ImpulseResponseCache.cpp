@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "TestHelpers.hpp"
+
+#include "dart/constraint/ImpulseResponseCache.hpp"
+#include "dart/dynamics/dynamics.hpp"
+
+using namespace dart;
+
+//==============================================================================
+/// Returns the velocity change of \c bodyNode by an impulse test on \c source
+Eigen::Vector6d computeVelocityChange(
+    dynamics::BodyNode* bodyNode,
+    dynamics::BodyNode* source,
+    const Eigen::Vector6d& impulse)
+{
+  auto skeleton = source->getSkeleton();
+  skeleton->clearConstraintImpulses();
+  skeleton->updateBiasImpulse(source, impulse);
+  skeleton->updateVelocityChange();
+
+  return bodyNode->getBodyVelocityChange();
+}
+
+//==============================================================================
+TEST(ImpulseResponseCache, Responses)
+{
+  auto robot = createNLinkRobot(4, Eigen::Vector3d(0.1, 0.1, 0.3), DOF_ROLL);
+  robot->setPositions(Eigen::VectorXd::Random(robot->getNumDofs()));
+  auto box = createBox(Eigen::Vector3d::Constant(0.2));
+
+  dynamics::BodyNode* link1 = robot->getBodyNode(1);
+  dynamics::BodyNode* link3 = robot->getBodyNode(3);
+  dynamics::BodyNode* boxBody = box->getBodyNode(0);
+
+  constraint::ImpulseResponseCache cache;
+  cache.addBodyNode(link3);
+  cache.addBodyNode(boxBody);
+  cache.addBodyNode(link1);
+  cache.addBodyNode(link3);
+  cache.update();
+  EXPECT_EQ(cache.getNumBodyNodes(), 3u);
+
+  // The responses are the velocity changes of the impulse tests
+  const Eigen::Vector6d impulse = Eigen::Vector6d::Random();
+  for (auto* bodyNode : {link1, link3})
+  {
+    for (auto* source : {link1, link3})
+    {
+      EXPECT_TRUE(equals(
+          Eigen::Vector6d(cache.getResponse(bodyNode, source) * impulse),
+          computeVelocityChange(bodyNode, source, impulse)));
+    }
+  }
+  EXPECT_TRUE(equals(
+      Eigen::Vector6d(cache.getResponse(boxBody, boxBody) * impulse),
+      computeVelocityChange(boxBody, boxBody, impulse)));
+
+  // Responses between two BodyNodes are reciprocal
+  EXPECT_TRUE(equals(
+      cache.getResponse(link1, link3),
+      Eigen::Matrix6d(cache.getResponse(link3, link1).transpose())));
+
+  // Unit impulses on the rows of a constraint add up in the Skeleton they are
+  // applied to
+  constraint::ImpulseResponseCache::RowImpulses impulses1
+      = Eigen::Matrix<double, 6, 3>::Random();
+  constraint::ImpulseResponseCache::RowImpulses impulses3
+      = Eigen::Matrix<double, 6, 3>::Random();
+  cache.clearUnitImpulses();
+  cache.applyUnitImpulses(link1, impulses1);
+  cache.applyUnitImpulses(link3, impulses3);
+  EXPECT_EQ(cache.getNumUnitImpulses(), 3);
+  EXPECT_EQ(cache.getVelocityChanges(boxBody), nullptr);
+
+  const auto* velocityChanges = cache.getVelocityChanges(link3);
+  ASSERT_NE(velocityChanges, nullptr);
+  const Eigen::MatrixXd expected
+      = cache.getResponse(link3, link1) * impulses1
+        + cache.getResponse(link3, link3) * impulses3;
+  EXPECT_TRUE(equals(Eigen::MatrixXd(*velocityChanges), expected));
+
+  cache.clearUnitImpulses();
+  EXPECT_EQ(cache.getVelocityChanges(link3), nullptr);
+}
+
+//==============================================================================
+TEST(ImpulseResponseCache, PointMasses)
+{
+  auto skeleton = dynamics::Skeleton::create();
+  auto* softBodyNode
+      = skeleton
+            ->createJointAndBodyNodePair<
+                dynamics::FreeJoint,
+                dynamics::SoftBodyNode>()
+            .second;
+  dynamics::SoftBodyNodeHelper::setBox(
+      softBodyNode,
+      Eigen::Vector3d::Constant(0.2),
+      Eigen::Isometry3d::Identity(),
+      1.0);
+  auto* link = skeleton
+                   ->createJointAndBodyNodePair<dynamics::RevoluteJoint>(
+                       softBodyNode)
+                   .second;
+  skeleton->setPositions(Eigen::VectorXd::Random(skeleton->getNumDofs()));
+
+  dynamics::PointMass* pointMass0 = softBodyNode->getPointMass(0);
+  dynamics::PointMass* pointMass1 = softBodyNode->getPointMass(1);
+
+  constraint::ImpulseResponseCache cache;
+  cache.addPointMass(pointMass1);
+  cache.addPointMass(pointMass0);
+  cache.addPointMass(pointMass1);
+  cache.addBodyNode(link);
+  cache.update();
+  EXPECT_EQ(cache.getNumBodyNodes(), 1u);
+  EXPECT_EQ(cache.getNumPointMasses(), 2u);
+
+  const constraint::ImpulseResponseCache::PointMassImpulses impulses
+      = Eigen::Matrix<double, 3, 2>::Random();
+  cache.clearUnitImpulses();
+  cache.applyUnitImpulses(pointMass0, impulses);
+  EXPECT_EQ(cache.getNumUnitImpulses(), 2);
+  EXPECT_EQ(cache.getVelocityChanges(pointMass1), nullptr);
+  EXPECT_EQ(cache.getVelocityChanges(link), nullptr);
+
+  const auto* velocityChanges = cache.getVelocityChanges(pointMass0);
+  ASSERT_NE(velocityChanges, nullptr);
+
+  // The velocity changes are the ones of the impulse tests, which change
+  // neither the other point masses nor the BodyNodes
+  for (int i = 0; i < impulses.cols(); ++i)
+  {
+    skeleton->clearConstraintImpulses();
+    skeleton->updateBiasImpulse(
+        softBodyNode, pointMass0, Eigen::Vector3d(impulses.col(i)));
+    skeleton->updateVelocityChange();
+
+    EXPECT_TRUE(equals(
+        Eigen::Vector3d(velocityChanges->col(i)),
+        pointMass0->getBodyVelocityChange()));
+    EXPECT_TRUE(pointMass1->getBodyVelocityChange().isZero());
+    EXPECT_TRUE(softBodyNode->getBodyVelocityChange().isZero());
+    EXPECT_TRUE(link->getBodyVelocityChange().isZero());
+  }
+
+  cache.clearUnitImpulses();
+  EXPECT_EQ(cache.getVelocityChanges(pointMass0), nullptr);
+}
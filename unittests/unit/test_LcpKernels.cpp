@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+#include <gtest/gtest.h>
+#include <Eigen/Dense>
+
+#include "dart/external/odelcpsolver/matrix.h"
+
+using namespace dart::external::ode;
+
+namespace {
+
+//==============================================================================
+/// Returns a random symmetric positive definite matrix stored by rows with the
+/// padded leading dimension that the Dantzig solver uses
+std::vector<dReal> makeSpdMatrix(int n)
+{
+  const int nskip = dPAD(n);
+  const Eigen::MatrixXd J = Eigen::MatrixXd::Random(n, n + 3);
+  const Eigen::MatrixXd A
+      = J * J.transpose() + 0.1 * Eigen::MatrixXd::Identity(n, n);
+
+  std::vector<dReal> data(static_cast<std::size_t>(n * nskip), 0.0);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      data[static_cast<std::size_t>(i * nskip + j)] = A(i, j);
+
+  return data;
+}
+
+//==============================================================================
+void expectNear(
+    const std::vector<dReal>& expected, const std::vector<dReal>& actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (std::size_t i = 0u; i < expected.size(); ++i)
+    EXPECT_NEAR(expected[i], actual[i], 1e-10 * (1.0 + std::abs(expected[i])));
+}
+
+} // namespace
+
+//==============================================================================
+TEST(LcpKernels, MatchReference)
+{
+  for (const int n : {1, 2, 3, 7, 16, 33, 64, 65, 150})
+  {
+    const int nskip = dPAD(n);
+
+    std::vector<dReal> a(static_cast<std::size_t>(n));
+    std::vector<dReal> b(static_cast<std::size_t>(n));
+    Eigen::Map<Eigen::VectorXd>(a.data(), n).setRandom();
+    Eigen::Map<Eigen::VectorXd>(b.data(), n).setRandom();
+    EXPECT_NEAR(
+        _dDotReference(a.data(), b.data(), n),
+        _dDot(a.data(), b.data(), n),
+        1e-12 * n);
+
+    // Factorization
+    std::vector<dReal> L = makeSpdMatrix(n);
+    std::vector<dReal> LReference = L;
+    std::vector<dReal> d(static_cast<std::size_t>(n));
+    std::vector<dReal> dReference(static_cast<std::size_t>(n));
+    _dFactorLDLT(L.data(), d.data(), n, nskip);
+    _dFactorLDLTReference(LReference.data(), dReference.data(), n, nskip);
+
+    // Only the strict lower triangle holds the factor
+    for (int i = 0; i < n; ++i)
+    {
+      for (int j = i; j < nskip; ++j)
+      {
+        L[static_cast<std::size_t>(i * nskip + j)] = 0.0;
+        LReference[static_cast<std::size_t>(i * nskip + j)] = 0.0;
+      }
+    }
+    expectNear(LReference, L);
+    expectNear(dReference, d);
+
+    // Triangular solves with the factor
+    std::vector<dReal> x = b;
+    std::vector<dReal> xReference = b;
+    _dSolveL1(L.data(), x.data(), n, nskip);
+    _dSolveL1Reference(L.data(), xReference.data(), n, nskip);
+    expectNear(xReference, x);
+
+    x = b;
+    xReference = b;
+    _dSolveL1T(L.data(), x.data(), n, nskip);
+    _dSolveL1TReference(L.data(), xReference.data(), n, nskip);
+    expectNear(xReference, x);
+  }
+
+  EXPECT_EQ(_dDot(nullptr, nullptr, 0), 0.0);
+}
+
+//==============================================================================
+TEST(LcpKernels, SolveLdlt)
+{
+  const int n = 100;
+  const int nskip = dPAD(n);
+  const std::vector<dReal> A = makeSpdMatrix(n);
+  std::vector<dReal> L = A;
+  std::vector<dReal> d(static_cast<std::size_t>(n));
+  _dFactorLDLT(L.data(), d.data(), n, nskip);
+
+  const Eigen::VectorXd b = Eigen::VectorXd::Random(n);
+  std::vector<dReal> x(b.data(), b.data() + n);
+  _dSolveLDLT(L.data(), d.data(), x.data(), n, nskip);
+
+  const Eigen::Map<
+      const Eigen::Matrix<dReal, -1, -1, Eigen::RowMajor>,
+      0,
+      Eigen::OuterStride<>>
+      AMap(A.data(), n, n, Eigen::OuterStride<>(nskip));
+  const Eigen::Map<const Eigen::VectorXd> xMap(x.data(), n);
+  EXPECT_LT((AMap * xMap - b).norm(), 1e-9);
+}
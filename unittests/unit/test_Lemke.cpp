@@ -156,6 +156,30 @@ TEST(Lemke, Lemke_12D)
   EXPECT_TRUE(dart::lcpsolver::validate(A, (*f), b));
 }
 
+//==============================================================================
+TEST(Lemke, SolverReuse)
+{
+  // A solver reused across sizes, including both sides of the fixed-size
+  // limit, gives the same solutions as temporary solvers
+  dart::lcpsolver::LemkeSolver solver;
+  solver.reserve(4);
+  for (const int n : {3, 12, 13, 40, 6})
+  {
+    const Eigen::MatrixXd J = Eigen::MatrixXd::Random(n, n);
+    const Eigen::MatrixXd M
+        = J * J.transpose() + 0.1 * Eigen::MatrixXd::Identity(n, n);
+    const Eigen::VectorXd q = Eigen::VectorXd::Random(n);
+
+    Eigen::VectorXd z(n);
+    EXPECT_EQ(solver.solve(M, q, z), 0);
+    EXPECT_TRUE(dart::lcpsolver::validate(M, z, q));
+
+    Eigen::VectorXd expected;
+    EXPECT_EQ(dart::lcpsolver::Lemke(M, q, &expected), 0);
+    EXPECT_TRUE(z.isApprox(expected, 1e-9));
+  }
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "dart/common/MemoryPool.hpp"
+
+using namespace dart;
+using namespace common;
+
+namespace {
+
+struct alignas(32) Payload
+{
+  double mValues[8];
+};
+
+} // namespace
+
+//==============================================================================
+TEST(MemoryPool, ReusesBlocks)
+{
+  MemoryPool pool(100u);
+  EXPECT_EQ(pool.getBlockSize() % MemoryPool::Alignment, 0u);
+  EXPECT_GE(pool.getBlockSize(), 100u);
+
+  pool.reserve(4u);
+  EXPECT_EQ(pool.getNumBlocks(), 4u);
+
+  void* first = pool.allocate(100u);
+  void* second = pool.allocate(50u);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(pool.getNumUsedBlocks(), 2u);
+  EXPECT_EQ(
+      reinterpret_cast<std::uintptr_t>(first) % MemoryPool::Alignment, 0u);
+
+  // A returned block is handed out again
+  pool.deallocate(first, 100u);
+  EXPECT_EQ(pool.allocate(100u), first);
+
+  pool.deallocate(first, 100u);
+  pool.deallocate(second, 50u);
+  EXPECT_EQ(pool.getNumUsedBlocks(), 0u);
+  EXPECT_EQ(pool.getNumOverflows(), 0u);
+}
+
+//==============================================================================
+TEST(MemoryPool, Overflows)
+{
+  MemoryPool pool(64u);
+  pool.reserve(2u);
+
+  // Requests larger than a block always fall back to the heap
+  void* large = pool.allocate(1000u);
+  EXPECT_EQ(pool.getNumOverflows(), 1u);
+  EXPECT_EQ(pool.getNumUsedBlocks(), 0u);
+  pool.deallocate(large, 1000u);
+
+  // A growable pool allocates more blocks when it runs out of them
+  void* blocks[3];
+  for (auto& block : blocks)
+    block = pool.allocate(64u);
+  EXPECT_GT(pool.getNumBlocks(), 2u);
+  EXPECT_EQ(pool.getNumOverflows(), 1u);
+  for (auto& block : blocks)
+    pool.deallocate(block, 64u);
+
+  // Otherwise the requests beyond the reserved blocks fall back to the heap
+  pool.resetNumOverflows();
+  pool.setGrowable(false);
+  const auto numBlocks = pool.getNumBlocks();
+  std::vector<void*> pointers;
+  for (auto i = 0u; i < numBlocks + 2u; ++i)
+    pointers.push_back(pool.allocate(64u));
+  EXPECT_EQ(pool.getNumBlocks(), numBlocks);
+  EXPECT_EQ(pool.getNumOverflows(), 2u);
+  for (auto* pointer : pointers)
+  {
+    EXPECT_EQ(
+        reinterpret_cast<std::uintptr_t>(pointer) % MemoryPool::Alignment, 0u);
+    pool.deallocate(pointer, 64u);
+  }
+  EXPECT_EQ(pool.getNumUsedBlocks(), 0u);
+}
+
+//==============================================================================
+TEST(MemoryPool, AllocateShared)
+{
+  auto pool = std::make_shared<MemoryPool>(256u);
+  pool->reserve(2u);
+
+  std::weak_ptr<MemoryPool> weakPool = pool;
+  auto payload = std::allocate_shared<Payload>(PoolAllocator<Payload>(pool));
+  EXPECT_EQ(pool->getNumUsedBlocks(), 1u);
+  EXPECT_EQ(pool->getNumOverflows(), 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(payload.get()) % 32u, 0u);
+
+  // The pool lives as long as the objects allocated from it
+  pool.reset();
+  EXPECT_FALSE(weakPool.expired());
+  payload.reset();
+  EXPECT_TRUE(weakPool.expired());
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sstream>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "dart/common/Profiler.hpp"
+
+using namespace dart;
+using namespace common;
+
+//==============================================================================
+TEST(Profiler, RecordsZones)
+{
+  auto& profiler = Profiler::getSingleton();
+  profiler.clear();
+
+  // Nothing is recorded while the profiler is disabled
+  profiler.setEnabled(false);
+  {
+    ProfileZone zone("disabled");
+  }
+  EXPECT_TRUE(profiler.getEvents().empty());
+  EXPECT_TRUE(profiler.getStatistics().empty());
+
+  profiler.setEnabled(true);
+  for (int i = 0; i < 3; ++i)
+  {
+    ProfileZone outer("outer");
+    ProfileZone inner("inner");
+  }
+
+  std::thread worker([]() { ProfileZone zone("worker"); });
+  worker.join();
+
+  profiler.setEnabled(false);
+
+  const auto statistics = profiler.getStatistics();
+  ASSERT_EQ(statistics.size(), 3u);
+  EXPECT_EQ(statistics.at("outer").mCount, 3u);
+  EXPECT_EQ(statistics.at("inner").mCount, 3u);
+  EXPECT_EQ(statistics.at("worker").mCount, 1u);
+  EXPECT_GE(
+      statistics.at("outer").mTotalTime, statistics.at("inner").mTotalTime);
+  EXPECT_LE(statistics.at("inner").mMinTime, statistics.at("inner").mMaxTime);
+
+  const auto events = profiler.getEvents();
+  ASSERT_EQ(events.size(), 7u);
+  EXPECT_EQ(events.front().mThreadIndex, 0u);
+  EXPECT_EQ(events.back().mThreadIndex, 1u);
+
+  std::ostringstream trace;
+  profiler.writeChromeTrace(trace);
+  EXPECT_NE(trace.str().find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(trace.str().find("\"name\":\"worker\""), std::string::npos);
+
+  // Only statistics are kept beyond the event limit
+  profiler.clear();
+  profiler.setMaxNumEvents(1u);
+  profiler.setEnabled(true);
+  for (int i = 0; i < 5; ++i)
+  {
+    ProfileZone zone("limited");
+  }
+  profiler.setEnabled(false);
+  EXPECT_EQ(profiler.getEvents().size(), 1u);
+  EXPECT_EQ(profiler.getStatistics().at("limited").mCount, 5u);
+
+  profiler.setMaxNumEvents(1000000u);
+  profiler.clear();
+}
+
+//==============================================================================
+TEST(Profiler, MergesThreads)
+{
+  auto& profiler = Profiler::getSingleton();
+  profiler.clear();
+  profiler.setEnabled(true);
+
+  std::vector<std::thread> workers;
+  for (int i = 0; i < 4; ++i)
+  {
+    workers.emplace_back([]() {
+      for (int j = 0; j < 100; ++j)
+      {
+        ProfileZone zone("threaded");
+      }
+    });
+  }
+  for (auto& worker : workers)
+    worker.join();
+
+  // Zones are merged by name even if the names have different addresses
+  const std::string name = "threaded";
+  {
+    ProfileZone zone(name.c_str());
+  }
+
+  // A stopped zone isn't recorded again at the end of its scope
+  {
+    ProfileZone zone("stopped");
+    zone.stop();
+  }
+
+  profiler.setEnabled(false);
+
+  const auto statistics = profiler.getStatistics();
+  EXPECT_EQ(statistics.at("threaded").mCount, 401u);
+  EXPECT_EQ(statistics.at("stopped").mCount, 1u);
+
+  const auto events = profiler.getEvents();
+  ASSERT_EQ(events.size(), 402u);
+  for (std::size_t i = 1u; i < events.size(); ++i)
+    EXPECT_LE(events[i - 1u].mStartTime, events[i].mStartTime);
+
+  profiler.clear();
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "dart/simulation/Recording.hpp"
+#include "dart/simulation/RecordingReader.hpp"
+#include "dart/simulation/RecordingWriter.hpp"
+
+using namespace dart;
+using namespace simulation;
+
+//==============================================================================
+std::vector<Eigen::VectorXd> makeStates(
+    std::size_t numFrames, const std::vector<int>& numDofs)
+{
+  int totalDofs = 0;
+  for (const int dofs : numDofs)
+    totalDofs += dofs;
+
+  std::vector<Eigen::VectorXd> states;
+  Eigen::VectorXd state = Eigen::VectorXd::Random(totalDofs);
+  for (std::size_t i = 0u; i < numFrames; ++i)
+  {
+    // Only a few values change between frames, and the number of contacts
+    // (appended after the DOFs) varies
+    state[static_cast<int>(i) % totalDofs] += 0.1;
+    const int numContacts = static_cast<int>(i % 3u);
+    Eigen::VectorXd frame(totalDofs + 6 * numContacts);
+    frame.head(totalDofs) = state;
+    frame.tail(6 * numContacts).setRandom();
+    states.push_back(frame);
+  }
+
+  return states;
+}
+
+//==============================================================================
+void expectBitwiseEqual(const Eigen::VectorXd& a, const Eigen::VectorXd& b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  for (int i = 0; i < a.size(); ++i)
+    EXPECT_EQ(a[i], b[i]);
+}
+
+//==============================================================================
+void testRoundTrip(bool compress)
+{
+  const std::string path = "test_Recording.rec";
+  const std::vector<int> numDofs{6, 3, 0};
+  const auto states = makeStates(150u, numDofs);
+
+  RecordingWriter writer;
+  ASSERT_TRUE(writer.open(path, numDofs, compress, 16u));
+  for (const auto& state : states)
+    writer.write(state);
+  EXPECT_EQ(writer.getNumFrames(), states.size());
+  writer.close();
+  EXPECT_FALSE(writer.isOpen());
+
+  RecordingReader reader(path);
+  ASSERT_TRUE(reader.isOpen());
+  ASSERT_EQ(reader.getNumFrames(), states.size());
+  ASSERT_EQ(reader.getNumSkeletons(), numDofs.size());
+  for (std::size_t i = 0u; i < numDofs.size(); ++i)
+    EXPECT_EQ(reader.getNumDofs(i), numDofs[i]);
+
+  // Sequential access
+  for (std::size_t i = 0u; i < states.size(); ++i)
+    expectBitwiseEqual(reader.getState(i), states[i]);
+
+  // Random access
+  for (const std::size_t i : {97u, 3u, 149u, 0u, 16u, 15u, 98u, 64u})
+    expectBitwiseEqual(reader.getState(i), states[i]);
+
+  expectBitwiseEqual(reader.getConfig(42u, 1u), states[42].segment(6, 3));
+  EXPECT_EQ(reader.getState(states.size()).size(), 0);
+
+  reader.close();
+  std::remove(path.c_str());
+}
+
+//==============================================================================
+TEST(Recording, StreamRoundTrip)
+{
+  testRoundTrip(false);
+  testRoundTrip(true);
+}
+
+//==============================================================================
+TEST(Recording, StreamFromRecording)
+{
+  const std::string path = "test_Recording_stream.rec";
+  const std::vector<int> numDofs{4, 2};
+  const auto states = makeStates(40u, numDofs);
+
+  Recording recording(numDofs);
+  ASSERT_TRUE(recording.startStreaming(path));
+  EXPECT_TRUE(recording.isStreaming());
+  for (const auto& state : states)
+    recording.addState(state);
+  EXPECT_EQ(recording.getNumFrames(), 0);
+  recording.stopStreaming();
+  EXPECT_FALSE(recording.isStreaming());
+
+  RecordingReader reader(path);
+  ASSERT_EQ(reader.getNumFrames(), states.size());
+  for (std::size_t i = 0u; i < states.size(); ++i)
+    expectBitwiseEqual(reader.getState(i), states[i]);
+  reader.close();
+
+  std::remove(path.c_str());
+}
+
+//==============================================================================
+TEST(Recording, RecoverUnclosedFile)
+{
+  const std::string path = "test_Recording_unclosed.rec";
+  const std::vector<int> numDofs{5};
+  const auto states = makeStates(30u, numDofs);
+
+  {
+    RecordingWriter writer;
+    ASSERT_TRUE(writer.open(path, numDofs, true, 8u));
+    for (const auto& state : states)
+      writer.write(state);
+    writer.close();
+  }
+
+  // Drop the frame index as if the writer had never been closed
+  std::ifstream input(path, std::ios::binary);
+  std::string content(
+      (std::istreambuf_iterator<char>(input)),
+      std::istreambuf_iterator<char>());
+  input.close();
+  const std::size_t indexSize = (states.size() + 1u) * 8u + 8u;
+  std::ofstream output(path, std::ios::binary | std::ios::trunc);
+  output.write(content.data(), content.size() - indexSize);
+  output.close();
+
+  RecordingReader reader(path);
+  ASSERT_EQ(reader.getNumFrames(), states.size());
+  for (std::size_t i = 0u; i < states.size(); ++i)
+    expectBitwiseEqual(reader.getState(i), states[i]);
+  reader.close();
+
+  std::remove(path.c_str());
+}